@@ -46,6 +46,7 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.defaultPort  = 1883;
       proto.usesID       = false;
+      proto.allowsSendJSON = true;
       #if FEATURE_MQTT_TLS
       proto.usesTLS      = true;
       #endif
@@ -7,6 +7,8 @@
 
 
 # include "src/Globals/Nodes.h"
+# include "src/CustomBuild/CompiletimeDefines.h"
+# include "src/DataStructs/C013_p2p_SensorDataBatch.h"
 # include "src/DataStructs/C013_p2p_SensorDataStruct.h"
 # include "src/DataStructs/C013_p2p_SensorInfoStruct.h"
 # include "src/ESPEasyCore/ESPEasyRules.h"
@@ -33,6 +35,15 @@ void C013_sendUDP(uint8_t        unit,
                   const uint8_t *data,
                   size_t         size);
 void C013_Receive(struct EventStruct *event);
+void C013_ReceiveSensorData(const C013_SensorDataStruct& dataReply);
+bool C013_mayBatch(uint8_t destUnit);
+bool C013_addToBatch(const C013_SensorDataStruct& dataReply);
+void C013_flushBatch();
+
+// Samples collected to be sent in a single batch frame
+C013_SensorDataBatch C013_batch;
+uint16_t             C013_batchWindow = 0;
+unsigned long        C013_batchStart  = 0;
 
 
 bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -44,14 +55,15 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_013;
-      proto.usesMQTT     = false;
-      proto.usesTemplate = false;
-      proto.usesAccount  = false;
-      proto.usesPassword = false;
-      proto.usesHost     = false;
-      proto.defaultPort  = 8266;
-      proto.usesID       = false;
-      proto.Custom       = true;
+      proto.usesMQTT       = false;
+      proto.usesTemplate   = false;
+      proto.usesAccount    = false;
+      proto.usesPassword   = false;
+      proto.usesHost       = false;
+      proto.defaultPort    = 8266;
+      proto.usesID         = false;
+      proto.Custom         = true;
+      proto.allowsP2PBatch = true;
       break;
     }
 
@@ -61,6 +73,39 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+    case CPlugin::Function::CPLUGIN_INIT:
+    {
+      MakeControllerSettings(ControllerSettings); // -V522
+
+      if (AllocatedControllerSettings()) {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        C013_batchWindow = ControllerSettings->P2P_BatchWindow;
+      }
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_EXIT:
+    {
+      C013_flushBatch();
+      C013_batch.release();
+      C013_batchWindow = 0;
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_FIFTY_PER_SECOND:
+    {
+      if (!C013_batch.isEmpty() && (timePassedSince(C013_batchStart) >= C013_batchWindow)) {
+        C013_flushBatch();
+      }
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_FLUSH:
+    {
+      C013_flushBatch();
+      break;
+    }
+
     case CPlugin::Function::CPLUGIN_TASK_CHANGE_NOTIFICATION:
     {
       C013_SendUDPTaskInfo(0, event->TaskIndex, event->TaskIndex);
@@ -86,15 +131,6 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
-    /*
-        case CPlugin::Function::CPLUGIN_FLUSH:
-          {
-            process_c013_delay_queue(event->ControllerIndex);
-            delay(0);
-            break;
-          }
-     */
-
     default:
       break;
   }
@@ -168,10 +204,99 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
     // Send to broadcast address
     dataReply.destUnit = 255;
   }
+
+  if ((C013_batchWindow != 0) && C013_mayBatch(dataReply.destUnit)) {
+    if (C013_addToBatch(dataReply)) {
+      return;
+    }
+  }
   dataReply.prepareForSend();
   C013_sendUDP(dataReply.destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
 }
 
+/*********************************************************************************************\
+   Batch frames
+\*********************************************************************************************/
+
+// Whether the destination can decode batch frames.
+// For broadcast all other known nodes must be able to decode them.
+bool C013_mayBatch(uint8_t destUnit)
+{
+  if (destUnit != 255) {
+    const NodeStruct *node = Nodes.getNode(destUnit);
+    return (node != nullptr) && node->C013_batch;
+  }
+
+  bool nodeFound = false;
+
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if ((it->first != Settings.Unit) && !it->second.isExpired()) {
+      if (!it->second.C013_batch) {
+        return false;
+      }
+      nodeFound = true;
+    }
+  }
+  return nodeFound;
+}
+
+bool C013_addToBatch(const C013_SensorDataStruct& dataReply)
+{
+  if (!C013_batch.isEmpty() && (C013_batch.destUnit() != dataReply.destUnit)) {
+    C013_flushBatch();
+  }
+
+  uint32_t timestamp_sec{};
+  uint16_t timestamp_frac{};
+
+  if (node_time.systemTimePresent()) {
+    uint32_t unix_time_frac{};
+    timestamp_sec  = node_time.getUnixTime(unix_time_frac);
+    timestamp_frac = unix_time_frac >> 16;
+  }
+
+  // When the sample does not fit, send the collected samples and try again with an empty frame.
+  for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+    if (C013_batch.isEmpty()) {
+      if (!C013_batch.begin(Settings.Unit, dataReply.destUnit, get_build_nr())) {
+        return false;
+      }
+      C013_batchStart = millis();
+    }
+
+    if (C013_batch.add(
+          dataReply.sourceTaskIndex,
+          dataReply.destTaskIndex,
+          dataReply.deviceNumber.value,
+          static_cast<uint8_t>(dataReply.sensorType),
+          dataReply.taskValues_Data,
+          timestamp_sec,
+          timestamp_frac)) {
+      return true;
+    }
+
+    if (C013_batch.isEmpty()) {
+      return false;
+    }
+    C013_flushBatch();
+  }
+  return false;
+}
+
+void C013_flushBatch()
+{
+  if (C013_batch.isEmpty()) {
+    return;
+  }
+  size_t size{};
+  const uint8_t *frame = C013_batch.finish(size);
+
+  if (frame != nullptr) {
+    C013_sendUDP(C013_batch.destUnit(), frame, size);
+  }
+  C013_batch.clear();
+}
+
 /*********************************************************************************************\
    Send UDP message (unit 255=broadcast)
 \*********************************************************************************************/
@@ -239,8 +364,6 @@ void C013_Receive(struct EventStruct *event) {
   }
 # endif // ifndef BUILD_NO_DEBUG
 
-  START_TIMER
-
   switch (event->Data[1]) {
     case 2: // sensor info pull request
     {
@@ -348,70 +471,101 @@ void C013_Receive(struct EventStruct *event) {
     {
       struct C013_SensorDataStruct dataReply;
 
-      // FIXME TD-er: We should check for sensorType and pluginID on both sides.
-      // For example sending different sensor type data from one dummy to another is probably not going to work well
-
       if (dataReply.setData(event->Data, event->Par2)) {
-        // only if this task has a remote feed, update values
-        const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
-
-        if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
-        {
-          // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
-          // See:
-          // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
-          // Thus should not be checked
-          //
-          // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
-          // missed)
-          // Then we cannot be sure about its build.
-          const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
-
-          if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
-            // Mismatch in plugin ID from sending node
-            if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-              String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
-              log += concat(F(" from unit "), dataReply.sourceUnit);
-              log += concat(F(" remote: "), dataReply.deviceNumber.value);
-              log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
-              addLogMove(LOG_LEVEL_ERROR, log);
-            }
-          } else {
-            struct EventStruct TempEvent(dataReply.destTaskIndex);
-            TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+        C013_ReceiveSensorData(dataReply);
+      }
+      break;
+    }
+
+    case C013_BATCH_ID: // batch of sensor data
+    {
+      C013_SensorDataBatch::decode(event->Data, event->Par2, [](const C013_SensorDataBatch::Sample& sample) {
+        struct C013_SensorDataStruct dataReply;
+
+        dataReply.sourceUnit      = sample.sourceUnit;
+        dataReply.destUnit        = sample.destUnit;
+        dataReply.sourceTaskIndex = sample.sourceTaskIndex;
+        dataReply.destTaskIndex   = sample.destTaskIndex;
+        dataReply.deviceNumber    = pluginID_t::toPluginID(sample.deviceNumber);
+        dataReply.sensorType      = static_cast<Sensor_VType>(sample.sensorType);
+        memcpy(dataReply.taskValues_Data, sample.taskValues_Data, sizeof(dataReply.taskValues_Data));
+        dataReply.sourceNodeBuild = sample.sourceNodeBuild;
+        dataReply.timestamp_sec   = sample.timestamp_sec;
+        dataReply.timestamp_frac  = sample.timestamp_frac;
+
+        if (validTaskIndex(dataReply.sourceTaskIndex) &&
+            validTaskIndex(dataReply.destTaskIndex)) {
+          C013_ReceiveSensorData(dataReply);
+        }
+      });
+      break;
+    }
+  }
+}
 
-            const Sensor_VType sensorType = TempEvent.getSensorType();
+void C013_ReceiveSensorData(const C013_SensorDataStruct& dataReply)
+{
+  START_TIMER
 
-            if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
-              TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+  // FIXME TD-er: We should check for sensorType and pluginID on both sides.
+  // For example sending different sensor type data from one dummy to another is probably not going to work well
 
-              if (taskValues != nullptr) {
-                memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
-              }
-              STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
-
-              if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
-                // Only use timestamp of remote unit when we got a system time ourselves
-                // If not, then the order of samples can get messed up.
-                // timestamp_fraq is 16 bit, so need to scale it to 32 bit
-                TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
-                SensorSendTask(&TempEvent, dataReply.timestamp_sec);
-              } else {
-                SensorSendTask(&TempEvent);
-              }
-            } else {
-              // Mismatch in sensor types
-              if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-                String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
-                log += concat(F(" from unit "), dataReply.sourceUnit);
-                addLogMove(LOG_LEVEL_ERROR, log);
-              }
-            }
-          }
-        }
+  // only if this task has a remote feed, update values
+  const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+
+  if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
+  {
+    // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
+    // See:
+    // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
+    // Thus should not be checked
+    //
+    // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
+    // missed)
+    // Then we cannot be sure about its build.
+    const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
+
+    if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
+      // Mismatch in plugin ID from sending node
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
+        log += concat(F(" from unit "), dataReply.sourceUnit);
+        log += concat(F(" remote: "), dataReply.deviceNumber.value);
+        log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
+        addLogMove(LOG_LEVEL_ERROR, log);
       }
+    } else {
+      struct EventStruct TempEvent(dataReply.destTaskIndex);
+      TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
 
-      break;
+      const Sensor_VType sensorType = TempEvent.getSensorType();
+
+      if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
+        TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+
+        if (taskValues != nullptr) {
+          memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
+          UserVar.markUpdated(dataReply.destTaskIndex);
+        }
+        STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
+
+        if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
+          // Only use timestamp of remote unit when we got a system time ourselves
+          // If not, then the order of samples can get messed up.
+          // timestamp_fraq is 16 bit, so need to scale it to 32 bit
+          TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
+          SensorSendTask(&TempEvent, dataReply.timestamp_sec);
+        } else {
+          SensorSendTask(&TempEvent);
+        }
+      } else {
+        // Mismatch in sensor types
+        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+          String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
+          log += concat(F(" from unit "), dataReply.sourceUnit);
+          addLogMove(LOG_LEVEL_ERROR, log);
+        }
+      }
     }
   }
 }
@@ -62,6 +62,7 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
       proto.needsNetwork         = false;
       proto.allowsExpire         = false;
       proto.allowLocalSystemTime = true;
+      proto.usesCacheCompression = true;
       break;
     }
 
@@ -79,6 +80,7 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
         if (AllocatedControllerSettings()) {
           LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
           C016_allowLocalSystemTime = ControllerSettings->useLocalSystemTime();
+          ControllerCache.setCompression(ControllerSettings->cacheCompression());
         }
       }
       success = init_c016_delay_queue(event->ControllerIndex);
@@ -92,16 +94,6 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
-    case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
-    {
-      break;
-    }
-
-    case CPlugin::Function::CPLUGIN_WEBFORM_SAVE:
-    {
-      break;
-    }
-
     case CPlugin::Function::CPLUGIN_PROTOCOL_TEMPLATE:
     {
       event->String1 = String();
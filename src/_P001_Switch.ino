@@ -46,6 +46,7 @@ boolean Plugin_001(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
@@ -54,6 +54,7 @@ boolean Plugin_008(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount       = 1;
       Device[deviceCount].SendDataOption   = true;
       Device[deviceCount].GlobalSyncOption = true;
+      Device[deviceCount].HasOnceASecond   = true;
       break;
     }
 
@@ -50,6 +50,7 @@ boolean Plugin_011(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 1;
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       break;
     }
 
@@ -55,6 +55,8 @@ boolean Plugin_012(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].HasTenPerSecond    = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
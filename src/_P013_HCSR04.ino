@@ -59,6 +59,7 @@ boolean                    Plugin_013(uint8_t function, struct EventStruct *even
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].PluginStats      = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond  = true;
 
       break;
     }
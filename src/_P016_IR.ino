@@ -214,6 +214,8 @@ boolean Plugin_016(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].HasTenPerSecond    = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
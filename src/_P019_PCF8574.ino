@@ -38,6 +38,7 @@ boolean Plugin_019(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
@@ -102,6 +102,9 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = false;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasOnceASecond     = true;
+      Device[deviceCount].HasSerialIn        = true;
       break;
     }
     case PLUGIN_GET_DEVICENAME:
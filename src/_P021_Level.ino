@@ -117,6 +117,8 @@ boolean Plugin_021(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount     = 1;
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
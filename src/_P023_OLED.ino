@@ -47,6 +47,8 @@ boolean Plugin_023(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount    = 0;
       Device[deviceCount].TimerOption   = true;
       Device[deviceCount].TimerOptional = true;
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
@@ -46,6 +46,7 @@ boolean Plugin_028(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].ErrorStateValues   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
@@ -33,6 +33,7 @@ boolean Plugin_031(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].setPin2Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
       break;
     }
 
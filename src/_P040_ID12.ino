@@ -32,6 +32,7 @@ boolean Plugin_040(uint8_t function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].HasSerialIn      = true;
         break;
       }
 
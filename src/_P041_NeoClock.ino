@@ -42,6 +42,8 @@ boolean Plugin_041(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Ports         = 0;
       Device[deviceCount].ValueCount    = 0;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasOnceASecond = true;
+      Device[deviceCount].HasClockIn    = true;
       break;
     }
 
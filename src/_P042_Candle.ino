@@ -100,6 +100,8 @@ boolean Plugin_042(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasFiftyPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
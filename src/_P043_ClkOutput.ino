@@ -76,6 +76,7 @@ boolean Plugin_043(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::Simple;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasClockIn     = true;
       break;
     }
 
@@ -39,6 +39,9 @@ boolean Plugin_044(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Type        = DEVICE_TYPE_CUSTOM2;
       Device[deviceCount].Custom      = true;
       Device[deviceCount].TimerOption = false;
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
+      Device[deviceCount].HasSerialIn = true;
       break;
     }
 
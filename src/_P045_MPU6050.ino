@@ -90,6 +90,7 @@ boolean Plugin_045(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].FormulaOption  = false;
       Device[deviceCount].PluginStats    = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
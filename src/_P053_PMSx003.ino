@@ -61,6 +61,7 @@ boolean Plugin_053(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption      = true;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].PluginStats      = true;
+      Device[deviceCount].HasTenPerSecond  = true;
       success                              = true;
       break;
     }
@@ -94,6 +94,7 @@ boolean Plugin_054(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Ports      = 0;
       Device[deviceCount].VType      = Sensor_VType::SENSOR_TYPE_NONE;
       Device[deviceCount].ValueCount = 0;
+      Device[deviceCount].HasTenPerSecond = true;
       break;
     }
 
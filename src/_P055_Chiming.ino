@@ -99,6 +99,9 @@ boolean Plugin_055(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
       Device[deviceCount].setPin2Direction(gpio_direction::gpio_output);
       Device[deviceCount].setPin3Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasTenPerSecond    = true;
+      Device[deviceCount].HasClockIn         = true;
       break;
     }
 
@@ -50,6 +50,7 @@ boolean Plugin_056(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       break;
     }
 
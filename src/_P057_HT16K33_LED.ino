@@ -97,6 +97,8 @@ boolean Plugin_057(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasTenPerSecond    = true;
+      Device[deviceCount].HasClockIn         = true;
       break;
     }
 
@@ -57,6 +57,7 @@ boolean Plugin_062(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
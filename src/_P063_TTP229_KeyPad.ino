@@ -81,6 +81,7 @@ boolean Plugin_063(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional    = true;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond  = true;
       break;
     }
 
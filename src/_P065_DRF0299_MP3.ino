@@ -73,6 +73,7 @@ boolean Plugin_065(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = false;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
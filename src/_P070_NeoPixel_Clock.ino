@@ -45,6 +45,7 @@ boolean Plugin_070(uint8_t function, struct EventStruct *event, String& string)
 
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
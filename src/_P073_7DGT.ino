@@ -95,6 +95,8 @@ boolean Plugin_073(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
       Device[deviceCount].setPin2Direction(gpio_direction::gpio_output);
       Device[deviceCount].setPin3Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
 
       break;
     }
@@ -44,6 +44,7 @@ boolean Plugin_074(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
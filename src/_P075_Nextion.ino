@@ -64,6 +64,7 @@ boolean Plugin_075(uint8_t function, struct EventStruct *event, String& string)
 
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = false;
+      Device[deviceCount].HasTenPerSecond    = true;
 
       break;
     }
@@ -126,6 +126,7 @@ boolean Plugin_076(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
       break;
     }
 
@@ -54,6 +54,7 @@ boolean Plugin_078(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
       Device[deviceCount].TaskLogsOwnPeaks   = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
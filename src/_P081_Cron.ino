@@ -44,6 +44,8 @@ boolean Plugin_081(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].DecimalsOnly     = true;
       Device[deviceCount].HasFormatUserVar = true;
+      Device[deviceCount].HasOnceASecond   = true;
+      Device[deviceCount].HasTimeChange    = true;
       break;
     }
 
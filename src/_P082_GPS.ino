@@ -49,6 +49,7 @@ boolean Plugin_082(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       break;
     }
 
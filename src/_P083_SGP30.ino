@@ -44,6 +44,7 @@ boolean Plugin_083(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
@@ -67,6 +67,8 @@ boolean Plugin_088(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Ports         = 0;
       Device[deviceCount].ValueCount    = 0;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
 
       break;
     }
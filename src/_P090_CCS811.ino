@@ -88,6 +88,7 @@ boolean Plugin_090(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
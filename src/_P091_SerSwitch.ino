@@ -100,6 +100,7 @@ boolean Plugin_091(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasSerialIn        = true;
       break;
     }
     case PLUGIN_GET_DEVICENAME:
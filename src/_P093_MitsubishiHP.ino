@@ -51,6 +51,7 @@ boolean Plugin_093(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].TimerOptional  = true;
+      Device[deviceCount].HasTenPerSecond = true;
       break;
     }
 
@@ -69,6 +69,8 @@ boolean Plugin_094(uint8_t function, struct EventStruct *event, String& string)
 
       // FIXME TD-er: Not sure if access to any existing task data is needed when saving
       Device[deviceCount].ExitTaskBeforeSave = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
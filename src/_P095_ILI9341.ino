@@ -157,6 +157,9 @@ boolean Plugin_095(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasTenPerSecond    = true;
+      Device[deviceCount].HasOnceASecond     = true;
       success                                = true;
       break;
     }
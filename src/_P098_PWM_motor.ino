@@ -62,6 +62,7 @@ boolean Plugin_098(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       break;
     }
 
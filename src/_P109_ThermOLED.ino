@@ -94,6 +94,8 @@ boolean Plugin_109(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption   = true;
       Device[deviceCount].TimerOption      = true;
       Device[deviceCount].GlobalSyncOption = true;
+      Device[deviceCount].HasTenPerSecond  = true;
+      Device[deviceCount].HasOnceASecond   = true;
       break;
     }
 
@@ -53,6 +53,7 @@ boolean Plugin_110(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
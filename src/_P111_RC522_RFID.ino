@@ -44,6 +44,8 @@ boolean Plugin_111(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
@@ -46,6 +46,7 @@ boolean Plugin_112(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].OutputDataType     = Output_Data_type_t::All;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
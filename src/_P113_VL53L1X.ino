@@ -50,6 +50,7 @@ boolean Plugin_113(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].TimerOptional  = true;
       Device[deviceCount].PluginStats    = true;
+      Device[deviceCount].HasFiftyPerSecond = true;
       break;
     }
 
@@ -50,6 +50,7 @@ boolean Plugin_115(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].DecimalsOnly       = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
@@ -136,6 +136,8 @@ boolean Plugin_118(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
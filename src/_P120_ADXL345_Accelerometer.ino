@@ -51,6 +51,9 @@ boolean Plugin_120(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional  = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::Simple;
+      Device[deviceCount].HasFiftyPerSecond = true;
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
 
       break;
     }
@@ -66,6 +66,7 @@ boolean Plugin_122(uint8_t function, struct EventStruct *event, String& string)
       // Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats    = true;
       Device[deviceCount].OutputDataType = Output_Data_type_t::Default;
+      Device[deviceCount].HasTenPerSecond = true;
       break;
     }
 
@@ -83,6 +83,7 @@ boolean Plugin_123(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].ExitTaskBeforeSave = false;
       Device[deviceCount].I2CNoDeviceCheck   = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       success                                = true;
       break;
     }
@@ -47,6 +47,8 @@ boolean Plugin_127(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasFiftyPerSecond  = true;
+      Device[deviceCount].HasOnceASecond     = true;
       break;
     }
 
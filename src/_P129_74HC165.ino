@@ -83,6 +83,8 @@ boolean Plugin_129(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].HasFormatUserVar = true;
       Device[deviceCount].setPin2Direction(gpio_direction::gpio_output);
       Device[deviceCount].setPin3Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasFiftyPerSecond = true;
+      Device[deviceCount].HasTenPerSecond  = true;
 
       break;
     }
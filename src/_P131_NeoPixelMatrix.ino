@@ -50,6 +50,7 @@ boolean Plugin_131(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption   = true;
       Device[deviceCount].TimerOptional = true;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
 
       break;
     }
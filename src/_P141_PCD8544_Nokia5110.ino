@@ -56,6 +56,9 @@ boolean Plugin_141(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = false;
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].TimerOptional  = true;
+      Device[deviceCount].HasFiftyPerSecond = true;
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
@@ -56,6 +56,8 @@ boolean Plugin_142(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional    = true;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].PluginStats      = true;
+      Device[deviceCount].HasTenPerSecond  = true;
+      Device[deviceCount].HasOnceASecond   = true;
 
       break;
     }
@@ -133,6 +133,8 @@ boolean Plugin_145(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].TimerOption = true;
       Device[deviceCount].GlobalSyncOption = true;
+      Device[deviceCount].HasTenPerSecond  = true;
+      Device[deviceCount].HasOnceASecond   = true;
       break;
     }
     
@@ -300,6 +300,14 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
         if (equals(subcommand, F("setreadpos"))) {
           P146_data_struct::setPeekFilePos(event->Par2, event->Par3);
           success = true;
+        } else if (equals(subcommand, F("seektime"))) {
+          // cachereader,seektime,<unixtime>[,<tasknr>]
+          uint32_t unixTime = 0;
+
+          if (validUIntFromString(parseString(string, 3), unixTime)) {
+            const taskIndex_t taskIndex = (event->Par3 > 0) ? event->Par3 - 1 : INVALID_TASK_INDEX;
+            success = P146_data_struct::setPeekFilePosByTime(unixTime, taskIndex);
+          }
         } else if (equals(subcommand, F("sendtaskinfo"))) {
           P146_data_struct *P146_data = static_cast<P146_data_struct *>(getPluginTaskData(event->TaskIndex));
 
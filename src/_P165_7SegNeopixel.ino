@@ -58,6 +58,8 @@ boolean Plugin_165(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].Type          = DEVICE_TYPE_SINGLE;
       Device[deviceCount].VType         = Sensor_VType::SENSOR_TYPE_NONE;
       Device[deviceCount].setPin1Direction(gpio_direction::gpio_output);
+      Device[deviceCount].HasTenPerSecond = true;
+      Device[deviceCount].HasOnceASecond = true;
       break;
     }
 
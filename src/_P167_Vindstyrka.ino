@@ -47,6 +47,7 @@ boolean Plugin_167(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
       Device[deviceCount].OutputDataType     = Output_Data_type_t::Simple;
+      Device[deviceCount].HasFiftyPerSecond  = true;
       break;
     }
 
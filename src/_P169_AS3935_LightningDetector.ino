@@ -37,6 +37,7 @@ boolean Plugin_169(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].I2CNoDeviceCheck   = true; // Sensor may sometimes not respond immediately
       Device[deviceCount].GlobalSyncOption   = true;
       Device[deviceCount].PluginStats        = true;
+      Device[deviceCount].HasTenPerSecond    = true;
       break;
     }
 
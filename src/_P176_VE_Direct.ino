@@ -53,6 +53,7 @@ boolean Plugin_176(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption    = true;
       Device[deviceCount].TimerOptional  = true;
       Device[deviceCount].PluginStats    = true;
+      Device[deviceCount].HasFiftyPerSecond = true;
 
       break;
     }
@@ -1,5 +1,16 @@
 #include "../ControllerQueue/ControllerDelayHandlerStruct.h"
 
+#include <vector>
+
+
+// All existing queue handlers, to look them up by controller index.
+static std::vector<ControllerDelayHandlerStruct *> allDelayHandlers;
+
+
+void ControllerDelayQueueStats::clear()
+{
+  *this = ControllerDelayQueueStats();
+}
 
 ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   lastSend(0),
@@ -8,10 +19,39 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   max_queue_depth(CONTROLLER_DELAY_QUEUE_DEPTH_DFLT),
   attempt(0),
   max_retries(CONTROLLER_DELAY_QUEUE_RETRY_DFLT),
+  max_batch_size(CONTROLLER_DELAY_QUEUE_BATCH_DFLT),
+  controllerIndex(INVALID_CONTROLLER_INDEX),
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
-  useLocalSystemTime(false) {}
+  useLocalSystemTime(false)
+{
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  allDelayHandlers.push_back(this);
+}
+
+ControllerDelayHandlerStruct::~ControllerDelayHandlerStruct()
+{
+  for (auto it = allDelayHandlers.begin(); it != allDelayHandlers.end(); ++it) {
+    if (*it == this) {
+      allDelayHandlers.erase(it);
+      return;
+    }
+  }
+}
+
+ControllerDelayHandlerStruct * ControllerDelayHandlerStruct::getDelayHandler(controllerIndex_t ControllerIndex)
+{
+  for (auto it = allDelayHandlers.begin(); it != allDelayHandlers.end(); ++it) {
+    if ((*it)->controllerIndex == ControllerIndex) {
+      return *it;
+    }
+  }
+  return nullptr;
+}
 
 bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t ControllerIndex)
 {
@@ -20,6 +60,7 @@ bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t Con
   if (!AllocatedControllerSettings()) {
     return false;
   }
+  controllerIndex = ControllerIndex;
   LoadControllerSettings(ControllerIndex, *ControllerSettings);
   cacheControllerSettings(*ControllerSettings);
   return true;
@@ -29,10 +70,14 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
   minTimeBetweenMessages = settings.MinimalTimeBetweenMessages;
   max_queue_depth        = settings.MaxQueueDepth;
   max_retries            = settings.MaxRetry;
+  max_batch_size         = settings.MaxBatchSize;
   delete_oldest          = settings.DeleteOldest;
   must_check_reply       = settings.MustCheckReply;
   deduplicate            = settings.deduplicate();
   useLocalSystemTime     = settings.useLocalSystemTime();
+#if FEATURE_MQTT
+  mqtt_sendJSON          = settings.mqtt_sendJSON();
+#endif // if FEATURE_MQTT
 
   if (settings.allowExpire()) {
     expire_timeout = max_queue_depth * max_retries * (minTimeBetweenMessages + settings.ClientTimeout);
@@ -49,6 +94,8 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
 
   if (max_retries == 0) { max_retries = CONTROLLER_DELAY_QUEUE_RETRY_DFLT; }
 
+  if (max_batch_size == 0) { max_batch_size = CONTROLLER_DELAY_QUEUE_BATCH_DFLT; }
+
   if (minTimeBetweenMessages == 0) { minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT; }
 
   // No less than 10 msec between messages.
@@ -116,6 +163,7 @@ bool ControllerDelayHandlerStruct::isDuplicate(const Queue_element_base& element
   // Some controllers may receive duplicate messages, due to lost acknowledgement
   // This is actually the same message, so this should not be processed.
   if (!unitLastMessageCount.isNew(element.getUnitMessageCount())) {
+    ++stats.duplicates;
     return true;
   }
 
@@ -125,18 +173,19 @@ bool ControllerDelayHandlerStruct::isDuplicate(const Queue_element_base& element
 
   // the setting 'deduplicate' does look at the content of the message and only compares it to messages in the queue.
   if (deduplicate && !sendQueue.empty()) {
-    // Use reverse iterator here, as it is more likely a duplicate is added shortly after another.
-    auto it = sendQueue.rbegin(); // Same as back()
+    // Search backwards, as it is more likely a duplicate is added shortly after another.
+    for (size_t i = sendQueue.size(); i > 0; --i) {
+      const Queue_element_base *queued = sendQueue[i - 1].get();
 
-    for (; it != sendQueue.rend(); ++it) {
-      if (element.isDuplicate(*(it->get()))) {
+      if ((queued != nullptr) && element.isDuplicate(*queued)) {
 #ifndef BUILD_NO_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex(it->get()->_controller_idx);
+          const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex(queued->_controller_idx);
           addLogMove(LOG_LEVEL_DEBUG, concat(get_formatted_Controller_number(cpluginID), F(" : Remove duplicate")));
         }
 #endif // ifndef BUILD_NO_DEBUG
+        ++stats.duplicates;
         return true;
       }
     }
@@ -157,22 +206,20 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-    while (queueFull(element->_controller_idx)) {
+    while (!sendQueue.empty() && queueFull(element->_controller_idx)) {
       sendQueue.pop_front();
       attempt = 0;
+      ++stats.dropped;
     }
   }
 
   if (!queueFull(element->_controller_idx)) {
-    #ifdef USE_SECOND_HEAP
-    // Do not store in 2nd heap, std::list cannot handle 2nd heap well
-    HeapSelectDram ephemeral;
-    #endif // ifdef USE_SECOND_HEAP
-
-    sendQueue.push_back(std::move(element));
-
-    return true;
+    if (sendQueue.push_back(std::move(element))) {
+      ++stats.queued;
+      return true;
+    }
   }
+  ++stats.dropped;
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -191,6 +238,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
   if (attempt > max_retries) {
     sendQueue.pop_front();
     attempt = 0;
+    ++stats.dropped;
   }
 
   if (expire_timeout != 0) {
@@ -202,6 +250,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
       } else {
         sendQueue.pop_front();
         attempt = 0;
+        ++stats.dropped;
       }
     }
   }
@@ -220,12 +269,27 @@ unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue
     sendQueue.pop_front();
     attempt  = 0;
     lastSend = millis();
+    ++stats.sent;
   } else {
     ++attempt;
+    ++stats.failed;
   }
   return getNextScheduleTime();
 }
 
+bool ControllerDelayHandlerStruct::continueBatch(uint8_t nrSent) {
+  return nrSent < max_batch_size && !sendQueue.empty();
+}
+
+void ControllerDelayHandlerStruct::finishBatch(uint8_t nrSent) {
+  if (nrSent == 0) { return; }
+  ++stats.batches;
+
+  if (nrSent > stats.maxBatch) {
+    stats.maxBatch = nrSent;
+  }
+}
+
 unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
   if (sendQueue.empty()) { return 0; }
   unsigned long nextTime = lastSend + minTimeBetweenMessages;
@@ -249,9 +313,9 @@ void ControllerDelayHandlerStruct::setAdditionalDelay(unsigned long msecFromNow)
 size_t ControllerDelayHandlerStruct::getQueueMemorySize() const {
   size_t totalSize = 0;
 
-  for (auto it = sendQueue.begin(); it != sendQueue.end(); ++it) {
-    if (it->get() != nullptr) {
-      totalSize += it->get()->getSize();
+  for (size_t i = 0; i < sendQueue.size(); ++i) {
+    if (sendQueue[i].get() != nullptr) {
+      totalSize += sendQueue[i]->getSize();
     }
   }
   return totalSize;
@@ -273,11 +337,30 @@ void ControllerDelayHandlerStruct::process(
     if (AllocatedControllerSettings()) {
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
-      START_TIMER;
-      markProcessed(func(cpluginID, *element, *ControllerSettings));
-      #if FEATURE_TIMING_STATS
-      STOP_TIMER_VAR(timerstats_id);
-      #endif
+      uint8_t nrSent = 0;
+
+      while (element != nullptr) {
+        START_TIMER;
+        const bool processed = func(cpluginID, *element, *ControllerSettings);
+        markProcessed(processed);
+        #if FEATURE_TIMING_STATS
+        STOP_TIMER_VAR(timerstats_id);
+        #endif
+
+        if (!processed) { break; }
+        ++nrSent;
+
+        element = nullptr;
+
+        if (continueBatch(nrSent)) {
+          element = getNext();
+
+          if ((element != nullptr) && !readyToProcess(*element)) {
+            element = nullptr;
+          }
+        }
+      }
+      finishBatch(nrSent);
     }
   }
   Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/ControllerDelayQueue.h"
 #include "../ControllerQueue/Queue_element_base.h"
 
 #include "../DataStructs/ControllerSettingsStruct.h"
@@ -20,7 +21,6 @@
 #include "../Helpers/StringConverter.h"
 
 
-#include <list>
 #include <memory> // For std::shared_ptr
 #include <new>    // std::nothrow
 
@@ -32,12 +32,31 @@ typedef bool (*do_process_function)(cpluginID_t,
                                     const Queue_element_base&,
                                     ControllerSettingsStruct&);
 
+
+// Throughput counters of a controller queue
+struct ControllerDelayQueueStats {
+  void clear();
+
+  uint32_t queued     = 0; // Added to the queue
+  uint32_t sent       = 0; // Successfully processed
+  uint32_t failed     = 0; // Failed attempts
+  uint32_t dropped    = 0; // Removed unsent (queue full, max retries or expired)
+  uint32_t duplicates = 0; // Not added as it was a duplicate
+  uint32_t batches    = 0; // Number of calls which sent at least one element
+  uint8_t  maxBatch   = 0; // Max. number of elements sent in a single call
+};
+
 /*********************************************************************************************\
 * ControllerDelayHandlerStruct
 \*********************************************************************************************/
 struct ControllerDelayHandlerStruct {
   ControllerDelayHandlerStruct();
 
+  ~ControllerDelayHandlerStruct();
+
+  // Return the queue handler of the controller, or nullptr when the controller has no queue.
+  static ControllerDelayHandlerStruct* getDelayHandler(controllerIndex_t ControllerIndex);
+
   bool cacheControllerSettings(controllerIndex_t ControllerIndex);
   void cacheControllerSettings(const ControllerSettingsStruct& settings);
 
@@ -61,6 +80,13 @@ struct ControllerDelayHandlerStruct {
   // @param remove_from_queue indicates whether the elements should be removed from the queue.
   unsigned long markProcessed(bool remove_from_queue);
 
+  // Return whether another element may be sent in the same batch
+  // @param nrSent  number of elements sent so far in this batch
+  bool          continueBatch(uint8_t nrSent);
+
+  // Update the batch statistics after a call to process the queue.
+  void          finishBatch(uint8_t nrSent);
+
   unsigned long getNextScheduleTime() const;
 
   // Set the "lastSend" to "now" + some additional delay.
@@ -70,24 +96,31 @@ struct ControllerDelayHandlerStruct {
 
   size_t getQueueMemorySize() const;
 
+  // Process up to max_batch_size elements which are ready to be sent.
   void   process(
     cpluginID_t                        cpluginID,
     do_process_function                func,
     TimingStatsElements                timerstats_id,
     SchedulerIntervalTimer_e timerID);
 
-  std::list<std::unique_ptr<Queue_element_base> >sendQueue;
+  ControllerDelayQueue                           sendQueue;
   mutable UnitLastMessageCount_map               unitLastMessageCount;
+  mutable ControllerDelayQueueStats              stats;
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
   unsigned long                                  expire_timeout         = 0;
   uint8_t                                        max_queue_depth        = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   uint8_t                                        attempt                = 0;
   uint8_t                                        max_retries            = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
+  uint8_t                                        max_batch_size         = CONTROLLER_DELAY_QUEUE_BATCH_DFLT;
+  controllerIndex_t                              controllerIndex        = INVALID_CONTROLLER_INDEX;
   bool                                           delete_oldest          = false;
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
   bool                                           useLocalSystemTime     = false;
+#if FEATURE_MQTT
+  bool                                           mqtt_sendJSON          = false;
+#endif // if FEATURE_MQTT
 };
 
 
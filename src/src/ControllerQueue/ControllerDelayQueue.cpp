@@ -0,0 +1,73 @@
+#include "../ControllerQueue/ControllerDelayQueue.h"
+
+#include "../Helpers/Memory.h"
+
+ControllerDelayQueue::element_ptr& ControllerDelayQueue::operator[](size_t index)
+{
+  return _slots[(_head + index) % _slots.size()];
+}
+
+const ControllerDelayQueue::element_ptr& ControllerDelayQueue::operator[](size_t index) const
+{
+  return _slots[(_head + index) % _slots.size()];
+}
+
+bool ControllerDelayQueue::push_back(element_ptr&& element)
+{
+  if ((_count == _slots.size()) && !grow()) {
+    return false;
+  }
+  (*this)[_count] = std::move(element);
+  ++_count;
+  return true;
+}
+
+void ControllerDelayQueue::pop_front()
+{
+  if (_count == 0) { return; }
+  front().reset();
+  _head = (_head + 1) % _slots.size();
+  --_count;
+}
+
+void ControllerDelayQueue::pop_back()
+{
+  if (_count == 0) { return; }
+  back().reset();
+  --_count;
+}
+
+void ControllerDelayQueue::clear()
+{
+  while (_count != 0) {
+    pop_front();
+  }
+  _head = 0;
+}
+
+bool ControllerDelayQueue::grow()
+{
+  #ifdef USE_SECOND_HEAP
+
+  // Keep the queue administration in DRAM
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  const size_t newCapacity = _slots.empty() ? 4 : 2 * _slots.size();
+  std::vector<element_ptr> slots;
+
+  slots.reserve(newCapacity);
+
+  if (slots.capacity() < newCapacity) {
+    return false;
+  }
+
+  // Move the elements in queue order, so the new head is at index 0
+  for (size_t i = 0; i < _count; ++i) {
+    slots.emplace_back(std::move((*this)[i]));
+  }
+  slots.resize(newCapacity);
+  _slots.swap(slots);
+  _head = 0;
+  return true;
+}
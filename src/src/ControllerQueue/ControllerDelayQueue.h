@@ -0,0 +1,72 @@
+#ifndef CONTROLLERQUEUE_CONTROLLERDELAYQUEUE_H
+#define CONTROLLERQUEUE_CONTROLLERDELAYQUEUE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../ControllerQueue/Queue_element_base.h"
+
+#include <memory>
+#include <vector>
+
+/*********************************************************************************************\
+* ControllerDelayQueue
+*
+* FIFO of controller queue elements, stored as a ring buffer of pointers.
+* Compared to a std::list, there is no extra allocation per element
+* and the storage is only reallocated when the queue needs to grow.
+\*********************************************************************************************/
+struct ControllerDelayQueue {
+  typedef std::unique_ptr<Queue_element_base> element_ptr;
+
+  size_t size() const {
+    return _count;
+  }
+
+  bool empty() const {
+    return _count == 0;
+  }
+
+  size_t capacity() const {
+    return _slots.size();
+  }
+
+  // Index 0 is the front of the queue
+  element_ptr      & operator[](size_t index);
+  const element_ptr& operator[](size_t index) const;
+
+  element_ptr      & front()       {
+    return (*this)[0];
+  }
+
+  const element_ptr& front() const {
+    return (*this)[0];
+  }
+
+  element_ptr      & back()       {
+    return (*this)[_count - 1];
+  }
+
+  const element_ptr& back() const {
+    return (*this)[_count - 1];
+  }
+
+  // Return false when the storage could not be grown.
+  bool push_back(element_ptr&& element);
+
+  void pop_front();
+
+  void pop_back();
+
+  void clear();
+
+private:
+
+  bool grow();
+
+  std::vector<element_ptr>_slots;
+  size_t _head  = 0;
+  size_t _count = 0;
+};
+
+
+#endif // ifndef CONTROLLERQUEUE_CONTROLLERDELAYQUEUE_H
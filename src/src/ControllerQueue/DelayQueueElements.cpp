@@ -31,6 +31,7 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
     return false;
   }
   MQTTDelayHandler->cacheControllerSettings(*ControllerSettings);
+  MQTTDelayHandler->controllerIndex = ControllerIndex;
   pubname    = ControllerSettings->Publish;
   retainFlag = ControllerSettings->mqtt_retainFlag();
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon
@@ -2,45 +2,90 @@
 
 #if FEATURE_MQTT
 
+#include "../Helpers/Memory.h"
 #include "../Helpers/StringConverter.h"
 
-MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
-                                       taskIndex_t TaskIndex,
-                                       const String& topic, const String& payload,
-                                       bool retained, bool callbackTask) :
-  _retained(retained)
+MQTT_topic_pool& MQTT_queue_element::getTopicPool()
 {
-  _controller_idx                      = ctrl_idx;
-  _taskIndex                           = TaskIndex;
-  _call_PLUGIN_PROCESS_CONTROLLER_DATA = callbackTask;
-
-  // Copy in the scope of the constructor, so we might store it in the 2nd heap
-  move_special(_topic, String(topic));
-  move_special(_payload, String(payload));
+  static MQTT_topic_pool pool;
 
-  removeEmptyTopics();
+  return pool;
 }
 
-MQTT_queue_element::MQTT_queue_element(int         ctrl_idx,
-                                       taskIndex_t TaskIndex,
-                                       String   && topic,
-                                       String   && payload,
-                                       bool        retained,
-                                       bool        callbackTask)
-  : _retained(retained)
+MQTT_queue_element::MQTT_queue_element(int                        ctrl_idx,
+                                       taskIndex_t                TaskIndex,
+                                       const MQTT_interned_topic *topic,
+                                       size_t                     payloadLength,
+                                       bool                       retained,
+                                       bool                       callbackTask) :
+  _retained(retained), _topic(topic), _payloadLength(payloadLength)
 {
   _controller_idx                      = ctrl_idx;
   _taskIndex                           = TaskIndex;
   _call_PLUGIN_PROCESS_CONTROLLER_DATA = callbackTask;
+}
 
-  // Copy in the scope of the constructor, so we might store it in the 2nd heap
-  move_special(_topic, std::move(topic));
-  move_special(_payload, std::move(payload));
-  removeEmptyTopics();
+MQTT_queue_element::~MQTT_queue_element()
+{
+  getTopicPool().release(_topic);
+}
+
+std::unique_ptr<MQTT_queue_element>MQTT_queue_element::create(int         ctrl_idx,
+                                                              taskIndex_t TaskIndex,
+                                                              const char *topic,
+                                                              const char *payload,
+                                                              size_t      payloadLength,
+                                                              bool        retained,
+                                                              bool        callbackTask)
+{
+  if (topic == nullptr) {
+    topic = "";
+  }
+  const MQTT_interned_topic *interned = nullptr;
+
+  if (strstr(topic, "//") == nullptr) {
+    interned = getTopicPool().acquire(topic, strlen(topic));
+  } else {
+    String tmp(topic);
+    removeEmptyTopics(tmp);
+    interned = getTopicPool().acquire(tmp.c_str(), tmp.length());
+  }
+
+  if (interned == nullptr) {
+    return nullptr;
+  }
+
+  // Element and payload in a single allocation, which may be stored in the 2nd heap
+  void *mem = special_malloc(sizeof(MQTT_queue_element) + payloadLength + 1);
+
+  if (mem == nullptr) {
+    getTopicPool().release(interned);
+    return nullptr;
+  }
+  char *text = static_cast<char *>(mem) + sizeof(MQTT_queue_element);
+
+  if (payloadLength != 0) {
+    memcpy(text, payload, payloadLength);
+  }
+  text[payloadLength] = '\0';
+
+  return std::unique_ptr<MQTT_queue_element>(
+    new (mem) MQTT_queue_element(ctrl_idx, TaskIndex, interned, payloadLength, retained, callbackTask));
+}
+
+void MQTT_queue_element::operator delete(void *ptr)
+{
+  free(ptr);
 }
 
 size_t MQTT_queue_element::getSize() const {
-  return sizeof(*this) + _topic.length() + _payload.length();
+  size_t size = sizeof(*this) + _payloadLength + 1;
+
+  if ((_topic != nullptr) && (_topic->refCount != 0)) {
+    // Only count our share of the topic
+    size += (sizeof(MQTT_interned_topic) + _topic->length + 1) / _topic->refCount;
+  }
+  return size;
 }
 
 bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
@@ -51,21 +96,21 @@ bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
 
   // TD-er: We do not compare the taskindex.
   // If it were to make a difference, the topic would be different.
+  // Topics are interned, so equal topics have the same pointer.
   if ((oth._controller_idx != _controller_idx) ||
       (oth._retained != _retained) ||
       (oth._topic != _topic) ||
-      (oth._payload != _payload)) {
+      (oth._payloadLength != _payloadLength) ||
+      (memcmp(oth.getPayload(), getPayload(), _payloadLength) != 0)) {
     return false;
   }
   return true;
 }
 
-void MQTT_queue_element::removeEmptyTopics() {
-  // some parts of the topic may have been replaced by empty strings,
-  // or "/status" may have been appended to a topic ending with a "/"
+void MQTT_queue_element::removeEmptyTopics(String& topic) {
   // Get rid of "//"
-  while (_topic.indexOf(F("//")) != -1) {
-    _topic.replace(F("//"), F("/"));
+  while (topic.indexOf(F("//")) != -1) {
+    topic.replace(F("//"), F("/"));
   }
 }
 
@@ -5,35 +5,40 @@
 
 #if FEATURE_MQTT
 
+# include "../ControllerQueue/MQTT_topic_pool.h"
 # include "../ControllerQueue/Queue_element_base.h"
 # include "../DataStructs/UnitMessageCount.h"
 # include "../Globals/CPlugins.h"
 
+# include <memory>
+
 /*********************************************************************************************\
 * MQTT_queue_element for all MQTT base controllers
+*
+* The topic is shared with other queued messages via the topic pool.
+* The payload is stored directly after the element, so each element is a single allocation.
+* Therefore elements can only be created via create().
 \*********************************************************************************************/
 class MQTT_queue_element : public Queue_element_base {
 public:
 
-  MQTT_queue_element() = default;
-
   MQTT_queue_element(const MQTT_queue_element& other) = delete;
 
-  MQTT_queue_element(MQTT_queue_element&& other) = default;
+  MQTT_queue_element& operator=(const MQTT_queue_element& other) = delete;
 
-  explicit MQTT_queue_element(int           ctrl_idx,
-                              taskIndex_t   TaskIndex,
-                              const String& topic,
-                              const String& payload,
-                              bool          retained,
-                              bool          callbackTask);
+  ~MQTT_queue_element();
 
-  explicit MQTT_queue_element(int         ctrl_idx,
-                              taskIndex_t TaskIndex,
-                              String   && topic,
-                              String   && payload,
-                              bool        retained,
-                              bool        callbackTask);
+  // Return nullptr when out of memory.
+  static std::unique_ptr<MQTT_queue_element>create(int         ctrl_idx,
+                                                   taskIndex_t TaskIndex,
+                                                   const char *topic,
+                                                   const char *payload,
+                                                   size_t      payloadLength,
+                                                   bool        retained,
+                                                   bool        callbackTask);
+
+  // Free memory allocated by create()
+  static void operator delete(void *ptr);
 
   size_t                    getSize() const;
 
@@ -47,12 +52,44 @@ public:
     return &UnitMessageCount;
   }
 
-  void removeEmptyTopics();
+  const char* getTopic() const {
+    return _topic == nullptr ? "" : _topic->c_str();
+  }
+
+  const char* getPayload() const {
+    return reinterpret_cast<const char *>(this + 1);
+  }
+
+  size_t getPayloadLength() const {
+    return _payloadLength;
+  }
+
+  // Topics of all queued MQTT messages
+  static MQTT_topic_pool& getTopicPool();
 
-  String _topic{};
-  String _payload{};
   UnitMessageCount_t UnitMessageCount{};
-  bool _retained = false; 
+  bool _retained = false;
+
+private:
+
+  MQTT_queue_element(int                        ctrl_idx,
+                     taskIndex_t                TaskIndex,
+                     const MQTT_interned_topic *topic,
+                     size_t                     payloadLength,
+                     bool                       retained,
+                     bool                       callbackTask);
+
+  static void* operator new(size_t size,
+                            void  *ptr) noexcept {
+    return ptr;
+  }
+
+  // Some parts of the topic may have been replaced by empty strings,
+  // or "/status" may have been appended to a topic ending with a "/"
+  static void removeEmptyTopics(String& topic);
+
+  const MQTT_interned_topic *_topic = nullptr;
+  size_t _payloadLength             = 0;
 };
 
 #endif // if FEATURE_MQTT
@@ -0,0 +1,77 @@
+#include "../ControllerQueue/MQTT_topic_pool.h"
+
+#if FEATURE_MQTT
+
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/Memory.h"
+
+MQTT_topic_pool::~MQTT_topic_pool()
+{
+  for (MQTT_interned_topic *topic : _topics) {
+    free(topic);
+  }
+}
+
+const MQTT_interned_topic * MQTT_topic_pool::acquire(const char *topic, size_t length)
+{
+  if ((topic == nullptr) || (length > 0xFFFF)) {
+    return nullptr;
+  }
+  const uint32_t hash = calc_CRC32(reinterpret_cast<const uint8_t *>(topic), length);
+
+  for (MQTT_interned_topic *interned : _topics) {
+    if ((interned->hash == hash) &&
+        (interned->length == length) &&
+        (memcmp(interned->c_str(), topic, length) == 0)) {
+      ++interned->refCount;
+      return interned;
+    }
+  }
+
+  MQTT_interned_topic *interned = static_cast<MQTT_interned_topic *>(special_malloc(sizeof(MQTT_interned_topic) + length + 1));
+
+  if (interned == nullptr) {
+    return nullptr;
+  }
+  interned->hash     = hash;
+  interned->refCount = 1;
+  interned->length   = length;
+
+  char *text = reinterpret_cast<char *>(interned + 1);
+  memcpy(text, topic, length);
+  text[length] = '\0';
+
+  _topics.push_back(interned);
+  return interned;
+}
+
+void MQTT_topic_pool::release(const MQTT_interned_topic *topic)
+{
+  if (topic == nullptr) {
+    return;
+  }
+
+  for (auto it = _topics.begin(); it != _topics.end(); ++it) {
+    if (*it == topic) {
+      if ((*it)->refCount > 1) {
+        --(*it)->refCount;
+      } else {
+        free(*it);
+        _topics.erase(it);
+      }
+      return;
+    }
+  }
+}
+
+size_t MQTT_topic_pool::getMemorySize() const
+{
+  size_t res = _topics.capacity() * sizeof(MQTT_interned_topic *);
+
+  for (const MQTT_interned_topic *topic : _topics) {
+    res += sizeof(MQTT_interned_topic) + topic->length + 1;
+  }
+  return res;
+}
+
+#endif // if FEATURE_MQTT
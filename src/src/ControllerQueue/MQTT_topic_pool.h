@@ -0,0 +1,62 @@
+#ifndef CONTROLLERQUEUE_MQTT_TOPIC_POOL_H
+#define CONTROLLERQUEUE_MQTT_TOPIC_POOL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include <vector>
+
+/*********************************************************************************************\
+* MQTT_interned_topic
+*
+* Topic shared by all queued MQTT messages with the same topic.
+* The text is stored directly after this header, in the same allocation.
+\*********************************************************************************************/
+struct MQTT_interned_topic {
+  const char* c_str() const {
+    return reinterpret_cast<const char *>(this + 1);
+  }
+
+  uint32_t hash;
+
+  // 32 bit, so it cannot overflow and each topic is only stored once.
+  // Then equal topics always have the same pointer.
+  uint32_t refCount;
+  uint16_t length;
+};
+
+/*********************************************************************************************\
+* MQTT_topic_pool
+*
+* Reference counted topics of the queued MQTT messages.
+* Most messages are published to the same few topics, so store each topic only once.
+\*********************************************************************************************/
+class MQTT_topic_pool {
+public:
+
+  ~MQTT_topic_pool();
+
+  // Return the topic with its reference count incremented.
+  // Return nullptr when out of memory or the topic is too long.
+  const MQTT_interned_topic* acquire(const char *topic,
+                                     size_t      length);
+
+  // Decrement the reference count, the topic is freed when no longer used.
+  void                       release(const MQTT_interned_topic *topic);
+
+  size_t                     size() const {
+    return _topics.size();
+  }
+
+  // Memory used by the topics, including the allocation headers
+  size_t getMemorySize() const;
+
+private:
+
+  std::vector<MQTT_interned_topic *> _topics;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // CONTROLLERQUEUE_MQTT_TOPIC_POOL_H
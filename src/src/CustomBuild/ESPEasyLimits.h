@@ -132,6 +132,15 @@
   #define RULES_IF_MAX_NESTING_LEVEL          4
 #endif
 
+// Max. number of events waiting in the rules event queue.
+#ifndef EVENT_QUEUE_MAX_SIZE
+  #ifdef ESP32
+    #define EVENT_QUEUE_MAX_SIZE            160
+  #else
+    #define EVENT_QUEUE_MAX_SIZE             64
+  #endif
+#endif
+
 
 // ***********************************************************************
 // * Extended SecuritySettings
@@ -3200,6 +3200,18 @@ To create/register a plugin, you have to :
 #define FEATURE_PLUGIN_STATS                  0
 #endif
 
+#ifndef FEATURE_PLUGIN_STATS_ROLLUP
+  #if FEATURE_PLUGIN_STATS && defined(ESP32) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_PLUGIN_STATS_ROLLUP       1
+  #else
+    #define FEATURE_PLUGIN_STATS_ROLLUP       0
+  #endif
+#endif
+#if FEATURE_PLUGIN_STATS_ROLLUP && !FEATURE_PLUGIN_STATS
+  #undef FEATURE_PLUGIN_STATS_ROLLUP
+  #define FEATURE_PLUGIN_STATS_ROLLUP         0
+#endif
+
 #ifndef FEATURE_REPORTING
 #define FEATURE_REPORTING                     0
 #endif
@@ -3474,6 +3486,14 @@ To create/register a plugin, you have to :
   #endif
 #endif
 
+#ifndef FEATURE_RULES_COMPILER
+  #if defined(LIMIT_BUILD_SIZE) || defined(BUILD_MINIMAL_OTA)
+    #define FEATURE_RULES_COMPILER 0
+  #else
+    #define FEATURE_RULES_COMPILER 1
+  #endif
+#endif
+
 #ifndef FEATURE_TARSTREAM_SUPPORT
   #define FEATURE_TARSTREAM_SUPPORT   1
 #endif // FEATURE_TARSTREAM_SUPPORT
@@ -0,0 +1,175 @@
+#include "../DataStructs/C013_p2p_SensorDataBatch.h"
+
+#ifdef USES_C013
+
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/Memory.h"
+
+# include <stddef.h>
+
+static_assert(sizeof(C013_SensorDataBatchHeader) + sizeof(C013_SensorDataBatchSample) <= C013_BATCH_MAX_SIZE,
+              "C013_BATCH_MAX_SIZE too small");
+
+C013_SensorDataBatch::~C013_SensorDataBatch()
+{
+  release();
+}
+
+bool C013_SensorDataBatch::begin(uint8_t sourceUnit, uint8_t destUnit, uint16_t sourceNodeBuild)
+{
+  if (_frame == nullptr) {
+    _frame = static_cast<uint8_t *>(special_calloc(1, C013_BATCH_MAX_SIZE));
+
+    if (_frame == nullptr) {
+      _size = 0;
+      return false;
+    }
+  }
+  C013_SensorDataBatchHeader header;
+
+  header.sampleSize      = sizeof(C013_SensorDataBatchSample);
+  header.sourceUnit      = sourceUnit;
+  header.destUnit        = destUnit;
+  header.sourceNodeBuild = sourceNodeBuild;
+
+  memcpy(_frame, &header, sizeof(C013_SensorDataBatchHeader));
+  _size = sizeof(C013_SensorDataBatchHeader);
+  return true;
+}
+
+bool C013_SensorDataBatch::add(
+  taskIndex_t    sourceTaskIndex,
+  taskIndex_t    destTaskIndex,
+  uint8_t        deviceNumber,
+  uint8_t        sensorType,
+  const uint8_t *taskValues_Data,
+  uint32_t       timestamp_sec,
+  uint16_t       timestamp_frac)
+{
+  if ((_frame == nullptr) ||
+      (_size + sizeof(C013_SensorDataBatchSample) > C013_BATCH_MAX_SIZE)) {
+    return false;
+  }
+  C013_SensorDataBatchHeader *header = getHeader();
+  C013_SensorDataBatchSample  sample;
+
+  if (header->nrSamples == 0) {
+    header->timestamp_sec  = timestamp_sec;
+    header->timestamp_frac = timestamp_sec == 0 ? 0 : timestamp_frac;
+  } else if ((header->timestamp_sec == 0) != (timestamp_sec == 0)) {
+    // System time was set or lost after the first sample
+    return false;
+  }
+
+  if (timestamp_sec != 0) {
+    // Timestamps as seconds in 16.16 fixed point
+    const int64_t base = (static_cast<int64_t>(header->timestamp_sec) << 16) | header->timestamp_frac;
+    const int64_t time = (static_cast<int64_t>(timestamp_sec) << 16) | timestamp_frac;
+    const int64_t delta_msec = ((time - base) * 1000 + 32768) >> 16;
+
+    if ((delta_msec < 0) || (delta_msec > 65535)) {
+      // Time went back (e.g. time sync) or too long after the first sample
+      return false;
+    }
+    sample.timestamp_delta = delta_msec;
+  }
+
+  sample.sourceTaskIndex = sourceTaskIndex;
+  sample.destTaskIndex   = destTaskIndex;
+  sample.deviceNumber    = deviceNumber;
+  sample.sensorType      = sensorType;
+
+  if (taskValues_Data != nullptr) {
+    memcpy(sample.taskValues_Data, taskValues_Data, sizeof(sample.taskValues_Data));
+  }
+
+  memcpy(_frame + _size, &sample, sizeof(C013_SensorDataBatchSample));
+  _size += sizeof(C013_SensorDataBatchSample);
+  ++header->nrSamples;
+  return true;
+}
+
+const uint8_t * C013_SensorDataBatch::finish(size_t& size)
+{
+  if (_frame == nullptr) {
+    size = 0;
+    return nullptr;
+  }
+  getHeader()->checksum = computeChecksum(_frame, _size);
+  size                  = _size;
+  return _frame;
+}
+
+void C013_SensorDataBatch::clear()
+{
+  if (_frame != nullptr) {
+    getHeader()->nrSamples = 0;
+    _size                  = sizeof(C013_SensorDataBatchHeader);
+  }
+}
+
+void C013_SensorDataBatch::release()
+{
+  if (_frame != nullptr) {
+    free(_frame);
+    _frame = nullptr;
+  }
+  _size = 0;
+}
+
+uint8_t C013_SensorDataBatch::nrSamples() const
+{
+  return _frame == nullptr ? 0 : getHeader()->nrSamples;
+}
+
+uint8_t C013_SensorDataBatch::destUnit() const
+{
+  return _frame == nullptr ? 0 : getHeader()->destUnit;
+}
+
+bool C013_SensorDataBatch::validate(const uint8_t *data, size_t size, C013_SensorDataBatchHeader& header)
+{
+  if ((data == nullptr) || (size < sizeof(C013_SensorDataBatchHeader))) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(C013_SensorDataBatchHeader));
+
+  if ((header.header != 255) ||
+      (header.ID != C013_BATCH_ID) ||
+      (header.version != C013_BATCH_VERSION) ||
+      (header.sampleSize < sizeof(C013_SensorDataBatchSample)) ||
+      (header.nrSamples == 0)) {
+    return false;
+  }
+
+  if (size < sizeof(C013_SensorDataBatchHeader) + static_cast<size_t>(header.nrSamples) * header.sampleSize) {
+    return false;
+  }
+  return header.checksum == computeChecksum(data, size);
+}
+
+uint32_t C013_SensorDataBatch::computeChecksum(const uint8_t *data, size_t size)
+{
+  constexpr size_t checksumPos = offsetof(C013_SensorDataBatchHeader, checksum);
+  constexpr size_t checksumEnd = checksumPos + sizeof(uint32_t);
+
+  const uint32_t crc = calc_CRC32(data, checksumPos);
+
+  return calc_CRC32(data + checksumEnd, size - checksumEnd, crc);
+}
+
+void C013_SensorDataBatch::addDelta(
+  uint32_t  timestamp_sec,
+  uint16_t  timestamp_frac,
+  uint16_t  delta_msec,
+  uint32_t& res_sec,
+  uint16_t& res_frac)
+{
+  const uint64_t time = ((static_cast<uint64_t>(timestamp_sec) << 16) | timestamp_frac) +
+                        ((static_cast<uint64_t>(delta_msec) << 16) + 500) / 1000;
+
+  res_sec  = time >> 16;
+  res_frac = time & 0xFFFF;
+}
+
+#endif // ifdef USES_C013
@@ -0,0 +1,189 @@
+#ifndef DATASTRUCTS_C013_P2P_SENSORDATABATCH_H
+#define DATASTRUCTS_C013_P2P_SENSORDATABATCH_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USES_C013
+
+# include "../CustomBuild/ESPEasyLimits.h"
+# include "../DataTypes/TaskIndex.h"
+
+/*********************************************************************************************\
+* C013 batch frame (message ID 7)
+*
+* Several task samples sent in a single datagram, instead of one C013_SensorDataStruct
+* datagram (message ID 5) per task sample.
+*   [C013_SensorDataBatchHeader][C013_SensorDataBatchSample]...
+*
+* - Timestamps are stored per sample as delta in msec to the timestamp in the header.
+* - The header contains the size of a sample, so later versions may append members
+*   to C013_SensorDataBatchSample without breaking older receivers.
+* - Nodes which can receive batch frames announce this via NodeStruct::C013_batch,
+*   all other nodes still receive a datagram per sample.
+* - A frame never exceeds C013_BATCH_MAX_SIZE, which must fit in the UDP receive buffers
+*   of the receiving node (UDP_PACKETSIZE_MAX)
+\*********************************************************************************************/
+
+# define C013_BATCH_ID       7
+# define C013_BATCH_VERSION  1
+
+# ifndef C013_BATCH_MAX_SIZE
+#  define C013_BATCH_MAX_SIZE  (UDP_PACKETSIZE_MAX - 1)
+# endif // ifndef C013_BATCH_MAX_SIZE
+
+// These structs are sent to other nodes, so make sure not to change order or offset in struct.
+struct __attribute__((__packed__)) C013_SensorDataBatchHeader
+{
+  uint8_t  header          = 255;
+  uint8_t  ID              = C013_BATCH_ID;
+  uint8_t  version         = C013_BATCH_VERSION;
+  uint8_t  sampleSize      = 0;
+  uint8_t  sourceUnit      = 0;
+  uint8_t  destUnit        = 0;
+  uint8_t  nrSamples       = 0;
+  uint16_t sourceNodeBuild = 0;
+
+  // Time of the first sample, 0 when the sending node has no system time
+  uint32_t timestamp_sec  = 0;
+  uint16_t timestamp_frac = 0;
+
+  // CRC32 of the entire frame, excluding the checksum itself
+  uint32_t checksum = 0;
+};
+
+struct __attribute__((__packed__)) C013_SensorDataBatchSample
+{
+  uint8_t  sourceTaskIndex = INVALID_TASK_INDEX;
+  uint8_t  destTaskIndex   = INVALID_TASK_INDEX;
+  uint8_t  deviceNumber    = 0;
+  uint8_t  sensorType      = 0;
+  uint16_t timestamp_delta = 0; // msec after the timestamp in the header
+  uint8_t  taskValues_Data[VARS_PER_TASK * sizeof(float)]{};
+};
+
+
+class C013_SensorDataBatch {
+public:
+
+  // Sample as decoded from a received frame.
+  // taskValues_Data points into the received frame.
+  struct Sample {
+    uint8_t        sourceUnit{};
+    uint8_t        destUnit{};
+    uint16_t       sourceNodeBuild{};
+    taskIndex_t    sourceTaskIndex = INVALID_TASK_INDEX;
+    taskIndex_t    destTaskIndex   = INVALID_TASK_INDEX;
+    uint8_t        deviceNumber{};
+    uint8_t        sensorType{};
+    uint32_t       timestamp_sec{};
+    uint16_t       timestamp_frac{};
+    const uint8_t *taskValues_Data = nullptr;
+  };
+
+  C013_SensorDataBatch() = default;
+
+  C013_SensorDataBatch(const C013_SensorDataBatch&) = delete;
+
+  C013_SensorDataBatch& operator=(const C013_SensorDataBatch&) = delete;
+
+  ~C013_SensorDataBatch();
+
+  // Start a new frame, any collected samples are discarded.
+  // Returns false when the frame buffer could not be allocated.
+  bool begin(uint8_t  sourceUnit,
+             uint8_t  destUnit,
+             uint16_t sourceNodeBuild);
+
+  // Returns false when the sample does not fit in the current frame.
+  // Then the frame must be sent and a new frame started.
+  // @param timestamp_sec  0 when there is no system time.
+  bool add(taskIndex_t    sourceTaskIndex,
+           taskIndex_t    destTaskIndex,
+           uint8_t        deviceNumber,
+           uint8_t        sensorType,
+           const uint8_t *taskValues_Data,
+           uint32_t       timestamp_sec,
+           uint16_t       timestamp_frac);
+
+  // Set the checksum and return the frame to send.
+  const uint8_t* finish(size_t& size);
+
+  // Discard the collected samples
+  void           clear();
+
+  // Discard the collected samples and free the frame buffer
+  void           release();
+
+  bool           isEmpty() const {
+    return nrSamples() == 0;
+  }
+
+  uint8_t        nrSamples() const;
+
+  uint8_t        destUnit() const;
+
+  // Call handler(const C013_SensorDataBatch::Sample&) for every sample in the frame.
+  // Returns false when the frame is not a valid batch frame, then handler is not called.
+  template<typename Handler>
+  static bool decode(const uint8_t *data, size_t size, Handler handler) {
+    C013_SensorDataBatchHeader header;
+
+    if (!validate(data, size, header)) {
+      return false;
+    }
+
+    Sample sample;
+
+    sample.sourceUnit      = header.sourceUnit;
+    sample.destUnit        = header.destUnit;
+    sample.sourceNodeBuild = header.sourceNodeBuild;
+
+    for (uint8_t i = 0; i < header.nrSamples; ++i) {
+      const C013_SensorDataBatchSample *encoded =
+        reinterpret_cast<const C013_SensorDataBatchSample *>(data + sizeof(C013_SensorDataBatchHeader) + i * header.sampleSize);
+
+      sample.sourceTaskIndex = encoded->sourceTaskIndex;
+      sample.destTaskIndex   = encoded->destTaskIndex;
+      sample.deviceNumber    = encoded->deviceNumber;
+      sample.sensorType      = encoded->sensorType;
+      sample.taskValues_Data = encoded->taskValues_Data;
+      sample.timestamp_sec   = 0;
+      sample.timestamp_frac  = 0;
+
+      if (header.timestamp_sec != 0) {
+        addDelta(header.timestamp_sec, header.timestamp_frac, encoded->timestamp_delta,
+                 sample.timestamp_sec, sample.timestamp_frac);
+      }
+      handler(sample);
+    }
+    return true;
+  }
+
+private:
+
+  C013_SensorDataBatchHeader* getHeader() const {
+    return reinterpret_cast<C013_SensorDataBatchHeader *>(_frame);
+  }
+
+  // Check format, size and checksum of a received frame and copy its header.
+  static bool     validate(const uint8_t              *data,
+                           size_t                      size,
+                           C013_SensorDataBatchHeader& header);
+
+  static uint32_t computeChecksum(const uint8_t *data,
+                                  size_t         size);
+
+  static void     addDelta(uint32_t  timestamp_sec,
+                           uint16_t  timestamp_frac,
+                           uint16_t  delta_msec,
+                           uint32_t& res_sec,
+                           uint16_t& res_frac);
+
+  uint8_t *_frame = nullptr;
+  size_t   _size  = 0;
+};
+
+
+#endif // ifdef USES_C013
+
+#endif // ifndef DATASTRUCTS_C013_P2P_SENSORDATABATCH_H
@@ -2,7 +2,9 @@
 
 #include "../Globals/Device.h"
 #include "../Globals/ExtraTaskSettings.h"
+#include "../Globals/RulesCalculate.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SyslogQueue.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
 #include "../Helpers/ESPEasy_Storage.h"
@@ -21,24 +23,48 @@ void Caches::clearAllCaches()
 void Caches::clearAllButTaskCaches() {
   clearFileCaches();
   WiFi_AP_Candidates.clearCache();
+  syslogQueue.clearHeaderCache();
+  #if FEATURE_MQTT
+  mqttTopics.clear();
+  #endif // if FEATURE_MQTT
   rulesHelper.closeAllFiles();
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
 }
 
 void Caches::clearAllTaskCaches() {
   taskIndexName.clear();
   taskIndexValueName.clear();
   extraTaskSettings_cache.clear();
+  #if FEATURE_MQTT
+  mqttTopics.clear();
+  #endif // if FEATURE_MQTT
+  #ifndef LIMIT_BUILD_SIZE
+  taskDeviceFormulaPrograms.clear();
+  #endif // ifndef LIMIT_BUILD_SIZE
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  ++taskSettingsGeneration;
   updateActiveTaskUseSerial0();
 }
 
 void Caches::clearTaskCache(taskIndex_t TaskIndex) {
   clearTaskIndexFromMaps(TaskIndex);
+  clearTaskDeviceFormulaPrograms(TaskIndex);
 
   auto it = extraTaskSettings_cache.find(TaskIndex);
 
   if (it != extraTaskSettings_cache.end()) {
     extraTaskSettings_cache.erase(it);
   }
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  // Templates may refer to the old name of the task or its values
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  ++taskSettingsGeneration;
   updateActiveTaskUseSerial0();
 }
 
@@ -209,6 +235,42 @@ String Caches::getTaskDeviceFormula(taskIndex_t TaskIndex, uint8_t rel_index)
   return EMPTY_STRING;
 }
 
+#ifndef LIMIT_BUILD_SIZE
+const RulesCalculate_program * Caches::getTaskDeviceFormulaProgram(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (!hasFormula(TaskIndex, rel_index)) {
+    return nullptr;
+  }
+  const uint16_t key = makeWord(TaskIndex, rel_index);
+  auto it            = taskDeviceFormulaPrograms.find(key);
+
+  if (it == taskDeviceFormulaPrograms.end()) {
+    const __FlashStringHelper * const slotNames[] = { F("%value%"), F("%pvalue%") };
+    const String formula                          = RulesCalculate_t::preProces(getTaskDeviceFormula(TaskIndex, rel_index));
+
+    RulesCalculate_program program;
+
+    // Any other reference like [task#value], %sysvar% or {...} needs parseTemplate()
+    // and thus cannot be compiled.
+    String check(formula);
+
+    for (size_t i = 0; i < NR_ELEMENTS(slotNames); ++i) {
+      check.replace(slotNames[i], EMPTY_STRING);
+    }
+
+    if ((check.indexOf('%') == -1) &&
+        (check.indexOf('[') == -1) &&
+        (check.indexOf('{') == -1)) {
+      RulesCalculate.compile(formula, slotNames, NR_ELEMENTS(slotNames), program);
+    }
+
+    it = taskDeviceFormulaPrograms.emplace(key, std::move(program)).first;
+  }
+  return &(it->second);
+}
+
+#endif // ifndef LIMIT_BUILD_SIZE
+
 long Caches::getTaskDevicePluginConfigLong(taskIndex_t TaskIndex, uint8_t rel_index)
 {
   if (validTaskIndex(TaskIndex) && (rel_index < PLUGIN_EXTRACONFIGVAR_MAX)) {
@@ -313,6 +375,9 @@ void Caches::updateExtraTaskSettingsCache()
       extraTaskSettings_cache.erase(it);
       clearTaskIndexFromMaps(TaskIndex);
     }
+
+    // Formula may have changed
+    clearTaskDeviceFormulaPrograms(TaskIndex);
     move_special(tmp.TaskDeviceName, String(ExtraTaskSettings.TaskDeviceName));
 
     for (size_t i = 0; i < VARS_PER_TASK; ++i) {
@@ -421,6 +486,33 @@ void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
       }
     }
   }
+  #if FEATURE_MQTT
+  {
+    auto it = mqttTopics.begin();
+
+    for (; it != mqttTopics.end();) {
+      if (((it->first >> 8) & 0xFF) == TaskIndex) {
+        it = mqttTopics.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  #endif // if FEATURE_MQTT
+}
+
+void Caches::clearTaskDeviceFormulaPrograms(taskIndex_t TaskIndex)
+{
+  #ifndef LIMIT_BUILD_SIZE
+
+  for (uint8_t rel_index = 0; rel_index < VARS_PER_TASK; ++rel_index) {
+    auto it = taskDeviceFormulaPrograms.find(makeWord(TaskIndex, rel_index));
+
+    if (it != taskDeviceFormulaPrograms.end()) {
+      taskDeviceFormulaPrograms.erase(it);
+    }
+  }
+  #endif // ifndef LIMIT_BUILD_SIZE
 }
 
   #ifdef ESP32
@@ -461,3 +553,43 @@ void Caches::clearControllerSettings(controllerIndex_t index)
 }
 
   #endif // ifdef ESP32
+
+#if FEATURE_MQTT
+static uint32_t makeMQTTtopicKey(controllerIndex_t controllerIndex, taskIndex_t TaskIndex, uint8_t valueIndex)
+{
+  return (static_cast<uint32_t>(controllerIndex) << 16) | (static_cast<uint32_t>(TaskIndex) << 8) | valueIndex;
+}
+
+bool Caches::getMQTTtopic(controllerIndex_t controllerIndex,
+                          taskIndex_t       TaskIndex,
+                          uint8_t           valueIndex,
+                          const String    & pubname,
+                          String          & topic) const
+{
+  if (!mqttTopics_pubname.equals(pubname)) {
+    return false;
+  }
+  auto it = mqttTopics.find(makeMQTTtopicKey(controllerIndex, TaskIndex, valueIndex));
+
+  if (it == mqttTopics.end()) {
+    return false;
+  }
+  topic = it->second;
+  return true;
+}
+
+void Caches::setMQTTtopic(controllerIndex_t controllerIndex,
+                          taskIndex_t       TaskIndex,
+                          uint8_t           valueIndex,
+                          const String    & pubname,
+                          const String    & topic)
+{
+  if (!mqttTopics_pubname.equals(pubname)) {
+    // Publish template has changed
+    mqttTopics.clear();
+    mqttTopics_pubname = pubname;
+  }
+  mqttTopics[makeMQTTtopicKey(controllerIndex, TaskIndex, valueIndex)] = topic;
+}
+
+#endif // if FEATURE_MQTT
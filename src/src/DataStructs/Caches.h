@@ -5,9 +5,9 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#include "../DataTypes/ControllerIndex.h"
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
-# include "../DataTypes/ControllerIndex.h"
 #endif // ifdef ESP32
 
 #if FEATURE_PLUGIN_STATS
@@ -16,6 +16,8 @@
 
 #include "../Globals/Plugins.h"
 #include "../Helpers/RulesHelper.h"
+#include "../Helpers/Rules_calculate.h"
+#include "../Helpers/TemplateProgram.h"
 
 #include <map>
 
@@ -57,11 +59,22 @@ typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
 typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
 typedef std::map<String, uint8_t>                        FilePresenceMap;
 typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
+#ifndef LIMIT_BUILD_SIZE
+
+// Key is makeWord(TaskIndex, rel_index)
+typedef std::map<uint16_t, RulesCalculate_program>       TaskDeviceFormulaProgramMap;
+#endif // ifndef LIMIT_BUILD_SIZE
 
 #ifdef ESP32
 typedef std::map<controllerIndex_t, ControllerSettingsStruct> ControllerSettingsMap;
 #endif // ifdef ESP32
 
+#if FEATURE_MQTT
+
+// Key is combination of controller index, task index and value index
+typedef std::map<uint32_t, String>                       MQTTtopicMap;
+#endif // if FEATURE_MQTT
+
 struct Caches {
   void    clearAllCaches();
   void    clearAllButTaskCaches();
@@ -93,6 +106,16 @@ struct Caches {
   String  getTaskDeviceFormula(taskIndex_t TaskIndex,
                                uint8_t     rel_index);
 
+#ifndef LIMIT_BUILD_SIZE
+
+  // Formula compiled to a RPN program with %value% and %pvalue% as slot 0 and 1.
+  // Program is not valid when the formula cannot be compiled,
+  // e.g. when referring to other task values or system variables.
+  // Return nullptr when there is no formula.
+  const RulesCalculate_program* getTaskDeviceFormulaProgram(taskIndex_t TaskIndex,
+                                                            uint8_t     rel_index);
+#endif // ifndef LIMIT_BUILD_SIZE
+
   long    getTaskDevicePluginConfigLong(taskIndex_t TaskIndex,
                                         uint8_t     rel_index);
 
@@ -127,12 +150,32 @@ struct Caches {
   void clearControllerSettings(controllerIndex_t index);
   #endif // ifdef ESP32
 
+  #if FEATURE_MQTT
+
+  // Topic of a task value as published by MQTT_protocol_send(), with all variables replaced.
+  // valueIndex VARS_PER_TASK is used for the topic of all values of a task.
+  // Return false when not present or when cached for another publish template.
+  bool getMQTTtopic(controllerIndex_t controllerIndex,
+                    taskIndex_t       TaskIndex,
+                    uint8_t           valueIndex,
+                    const String    & pubname,
+                    String          & topic) const;
+
+  void setMQTTtopic(controllerIndex_t controllerIndex,
+                    taskIndex_t       TaskIndex,
+                    uint8_t           valueIndex,
+                    const String    & pubname,
+                    const String    & topic);
+  #endif // if FEATURE_MQTT
+
 private:
 
   ExtraTaskSettingsMap::const_iterator getExtraTaskSettings(taskIndex_t TaskIndex);
 
   void                                 clearTaskIndexFromMaps(taskIndex_t TaskIndex);
 
+  void                                 clearTaskDeviceFormulaPrograms(taskIndex_t TaskIndex);
+
 public:
 
   TaskIndexNameMap      taskIndexName;
@@ -140,21 +183,42 @@ public:
   FilePresenceMap       fileExistsMap;  // Filesize. -1 if not present
   RulesHelperClass      rulesHelper;
 
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  // Compiled templates of parseTemplate(), refer to task and value names
+  TemplateProgramCache templatePrograms;
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
 private:
 
   ExtraTaskSettingsMap extraTaskSettings_cache;
 
+  #ifndef LIMIT_BUILD_SIZE
+  TaskDeviceFormulaProgramMap taskDeviceFormulaPrograms;
+  #endif // ifndef LIMIT_BUILD_SIZE
+
   #ifdef ESP32
 
   // Only cache Controller Settings on ESP32 due to memory restrictions on ESP8266
   ControllerSettingsMap controllerSetings_cache;
   #endif // ifdef ESP32
 
+  #if FEATURE_MQTT
+  MQTTtopicMap mqttTopics;
+
+  // Publish template used for the cached topics
+  String mqttTopics_pubname;
+  #endif // if FEATURE_MQTT
+
 public:
 
   ChecksumType controllerSettings_checksums[CONTROLLER_MAX] = {};
   uint32_t     fileCacheClearMoment                         = 0;
 
+  // Incremented whenever task caches are cleared, e.g. when task settings are saved.
+  // Used to detect changed task settings, like in the ETag of /json
+  uint32_t     taskSettingsGeneration = 0;
+
 
   bool activeTaskUseSerial0 = false;
 };
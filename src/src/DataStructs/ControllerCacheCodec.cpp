@@ -0,0 +1,354 @@
+#include "../DataStructs/ControllerCacheCodec.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+namespace {
+const uint8_t controllerCacheFileHeader[CONTROLLER_CACHE_FILE_HEADER_SIZE] PROGMEM = {
+  'E', 'E', 'c', 'a', 'c', 'h', 'e', 1 // Last byte is the version
+};
+
+// Write bits, most significant bit first
+class CacheBitWriter {
+public:
+
+  explicit CacheBitWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+  void write(uint32_t value, uint8_t nrBits) {
+    while (nrBits > 0) {
+      if (_bitPos == 0) {
+        _out.push_back(0);
+      }
+      const uint8_t freeBits = 8 - _bitPos;
+      const uint8_t n        = nrBits < freeBits ? nrBits : freeBits;
+      const uint8_t bits     = (value >> (nrBits - n)) & ((1u << n) - 1);
+
+      _out.back() |= bits << (freeBits - n);
+      _bitPos      = (_bitPos + n) & 7;
+      nrBits      -= n;
+    }
+  }
+
+  void writeBit(bool bit) {
+    write(bit ? 1 : 0, 1);
+  }
+
+private:
+
+  std::vector<uint8_t>& _out;
+  uint8_t _bitPos = 0;
+};
+
+class CacheBitReader {
+public:
+
+  CacheBitReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+  uint32_t read(uint8_t nrBits) {
+    uint32_t value = 0;
+
+    while (nrBits > 0) {
+      if (_bytePos >= _size) {
+        _error = true;
+        return 0;
+      }
+      const uint8_t freeBits = 8 - _bitPos;
+      const uint8_t n        = nrBits < freeBits ? nrBits : freeBits;
+      const uint8_t bits     = (_data[_bytePos] >> (freeBits - n)) & ((1u << n) - 1);
+
+      value   = (value << n) | bits;
+      _bitPos = _bitPos + n;
+
+      if (_bitPos == 8) {
+        _bitPos = 0;
+        ++_bytePos;
+      }
+      nrBits -= n;
+    }
+    return value;
+  }
+
+  bool readBit() {
+    return read(1) != 0;
+  }
+
+  bool error() const {
+    return _error;
+  }
+
+  void setError() {
+    _error = true;
+  }
+
+private:
+
+  const uint8_t *_data;
+  size_t         _size;
+  size_t         _bytePos = 0;
+  uint8_t        _bitPos  = 0;
+  bool           _error   = false;
+};
+
+struct CacheTaskState {
+  ControllerCacheRecord record{};
+  int32_t               delta{};
+  uint8_t               leading[4]  = { 0xFF, 0xFF, 0xFF, 0xFF }; // 0xFF = no previous window
+  uint8_t               trailing[4] = {};
+};
+
+// Nr. of bits needed to store an index in a list of nrItems items
+uint8_t indexBits(size_t nrItems) {
+  uint8_t bits = 0;
+
+  while ((static_cast<size_t>(1) << bits) < nrItems) { ++bits; }
+  return bits;
+}
+
+// Delta-of-delta ranges: nr. of bits and the offset to make the value positive.
+struct DeltaRange {
+  uint8_t nrBits;
+  int32_t offset;
+};
+
+const DeltaRange deltaRanges[] = { { 7, 63 }, { 9, 255 }, { 12, 2047 } };
+
+void writeDeltaOfDelta(CacheBitWriter& writer, int32_t dod) {
+  if (dod == 0) {
+    writer.writeBit(false);
+    return;
+  }
+
+  for (const DeltaRange& range : deltaRanges) {
+    writer.writeBit(true);
+
+    if ((dod >= -range.offset) && (dod <= (range.offset + 1))) {
+      writer.writeBit(false);
+      writer.write(static_cast<uint32_t>(dod + range.offset), range.nrBits);
+      return;
+    }
+  }
+  writer.writeBit(true);
+  writer.write(static_cast<uint32_t>(dod), 32);
+}
+
+int32_t readDeltaOfDelta(CacheBitReader& reader) {
+  if (!reader.readBit()) {
+    return 0;
+  }
+
+  for (const DeltaRange& range : deltaRanges) {
+    if (!reader.readBit()) {
+      return static_cast<int32_t>(reader.read(range.nrBits)) - range.offset;
+    }
+  }
+  return static_cast<int32_t>(reader.read(32));
+}
+
+void writeValue(CacheBitWriter& writer, CacheTaskState& state, uint8_t varNr, uint32_t value) {
+  const uint32_t xorValue = value ^ state.record.values[varNr];
+
+  if (xorValue == 0) {
+    writer.writeBit(false);
+    return;
+  }
+  writer.writeBit(true);
+  const uint8_t leading  = __builtin_clz(xorValue);
+  const uint8_t trailing = __builtin_ctz(xorValue);
+
+  if ((state.leading[varNr] != 0xFF) &&
+      (leading >= state.leading[varNr]) &&
+      (trailing >= state.trailing[varNr])) {
+    // Fits in the window of the previous value
+    writer.writeBit(false);
+    writer.write(xorValue >> state.trailing[varNr], 32 - state.leading[varNr] - state.trailing[varNr]);
+    return;
+  }
+  const uint8_t nrBits = 32 - leading - trailing;
+
+  writer.writeBit(true);
+  writer.write(leading,    5);
+  writer.write(nrBits - 1, 5);
+  writer.write(xorValue >> trailing, nrBits);
+  state.leading[varNr]  = leading;
+  state.trailing[varNr] = trailing;
+}
+
+uint32_t readValue(CacheBitReader& reader, CacheTaskState& state, uint8_t varNr) {
+  uint32_t xorValue = 0;
+
+  if (reader.readBit()) {
+    if (reader.readBit()) {
+      state.leading[varNr] = reader.read(5);
+      const uint8_t nrBits = reader.read(5) + 1;
+
+      if ((state.leading[varNr] + nrBits) > 32) {
+        reader.setError();
+        return 0;
+      }
+      state.trailing[varNr] = 32 - state.leading[varNr] - nrBits;
+      xorValue              = reader.read(nrBits) << state.trailing[varNr];
+    } else {
+      if (state.leading[varNr] == 0xFF) {
+        // Corrupt data, no previous window
+        reader.setError();
+        return 0;
+      }
+      xorValue = reader.read(32 - state.leading[varNr] - state.trailing[varNr]) << state.trailing[varNr];
+    }
+  }
+  return state.record.values[varNr] ^ xorValue;
+}
+
+void writeMeta(CacheBitWriter& writer, const ControllerCacheRecord& record) {
+  writer.write(record.pluginID,   8);
+  writer.write(record.sensorType, 8);
+  writer.write(record.valueCount, 8);
+}
+
+void readMeta(CacheBitReader& reader, ControllerCacheRecord& record) {
+  record.pluginID   = reader.read(8);
+  record.sensorType = reader.read(8);
+  record.valueCount = reader.read(8);
+}
+
+bool sameMeta(const ControllerCacheRecord& a, const ControllerCacheRecord& b) {
+  return a.pluginID == b.pluginID &&
+         a.sensorType == b.sensorType &&
+         a.valueCount == b.valueCount;
+}
+} // namespace
+
+const uint8_t * ControllerCacheCodec::getFileHeader() {
+  return controllerCacheFileHeader;
+}
+
+bool ControllerCacheCodec::isFileHeader(const uint8_t *data) {
+  return memcmp_P(data, controllerCacheFileHeader, CONTROLLER_CACHE_FILE_HEADER_SIZE) == 0;
+}
+
+bool ControllerCacheCodec::encodeFrame(const uint8_t *records, size_t nrRecords, std::vector<uint8_t>& frame)
+{
+  if ((nrRecords == 0) || (nrRecords > 255)) { return false; }
+  const size_t rawSize = nrRecords * sizeof(ControllerCacheRecord);
+
+  frame.clear();
+  frame.reserve(sizeof(ControllerCacheFrameHeader) + rawSize);
+  frame.resize(sizeof(ControllerCacheFrameHeader));
+
+  std::vector<CacheTaskState> states;
+  CacheBitWriter writer(frame);
+
+  for (size_t i = 0; i < nrRecords; ++i) {
+    ControllerCacheRecord record;
+    memcpy(&record, records + i * sizeof(ControllerCacheRecord), sizeof(ControllerCacheRecord));
+
+    size_t stateIndex = 0;
+
+    while (stateIndex < states.size() && states[stateIndex].record.TaskIndex != record.TaskIndex) {
+      ++stateIndex;
+    }
+
+    if (!states.empty()) {
+      writer.writeBit(stateIndex < states.size());
+    }
+
+    if (stateIndex >= states.size()) {
+      // First record of this task in the frame
+      writer.write(record.TaskIndex, 8);
+      writeMeta(writer, record);
+      writer.write(record.unixTime, 32);
+
+      for (uint8_t varNr = 0; varNr < 4; ++varNr) {
+        writer.write(record.values[varNr], 32);
+      }
+      CacheTaskState state;
+      state.record = record;
+      states.push_back(state);
+      continue;
+    }
+    writer.write(stateIndex, indexBits(states.size()));
+    CacheTaskState& state = states[stateIndex];
+
+    const bool metaChanged = !sameMeta(record, state.record);
+    writer.writeBit(metaChanged);
+
+    if (metaChanged) {
+      writeMeta(writer, record);
+    }
+
+    const int32_t delta = static_cast<int32_t>(record.unixTime - state.record.unixTime);
+    writeDeltaOfDelta(writer, delta - state.delta);
+    state.delta = delta;
+
+    for (uint8_t varNr = 0; varNr < 4; ++varNr) {
+      writeValue(writer, state, varNr, record.values[varNr]);
+    }
+    state.record = record;
+  }
+
+  ControllerCacheFrameHeader header;
+
+  header.type        = CONTROLLER_CACHE_FRAME_COMPRESSED;
+  header.nrRecords   = nrRecords;
+  header.payloadSize = frame.size() - sizeof(ControllerCacheFrameHeader);
+
+  if (header.payloadSize >= rawSize) {
+    // Not compressible, store as-is
+    header.type        = CONTROLLER_CACHE_FRAME_STORED;
+    header.payloadSize = rawSize;
+    frame.resize(sizeof(ControllerCacheFrameHeader));
+    frame.insert(frame.end(), records, records + rawSize);
+  }
+  memcpy(&frame[0], &header, sizeof(header));
+  return true;
+}
+
+bool ControllerCacheCodec::decodeFrame(const ControllerCacheFrameHeader& header, const uint8_t *payload, uint8_t *records)
+{
+  if (header.type == CONTROLLER_CACHE_FRAME_STORED) {
+    if (header.payloadSize != (header.nrRecords * sizeof(ControllerCacheRecord))) { return false; }
+    memcpy(records, payload, header.payloadSize);
+    return true;
+  }
+
+  if (header.type != CONTROLLER_CACHE_FRAME_COMPRESSED) { return false; }
+
+  std::vector<CacheTaskState> states;
+  CacheBitReader reader(payload, header.payloadSize);
+
+  for (size_t i = 0; i < header.nrRecords && !reader.error(); ++i) {
+    const bool knownTask = !states.empty() && reader.readBit();
+
+    if (!knownTask) {
+      CacheTaskState state;
+      state.record.TaskIndex = reader.read(8);
+      readMeta(reader, state.record);
+      state.record.unixTime = reader.read(32);
+
+      for (uint8_t varNr = 0; varNr < 4; ++varNr) {
+        state.record.values[varNr] = reader.read(32);
+      }
+      states.push_back(state);
+      memcpy(records + i * sizeof(ControllerCacheRecord), &state.record, sizeof(ControllerCacheRecord));
+      continue;
+    }
+    const size_t stateIndex = reader.read(indexBits(states.size()));
+
+    if (stateIndex >= states.size()) { return false; }
+    CacheTaskState& state = states[stateIndex];
+
+    if (reader.readBit()) {
+      readMeta(reader, state.record);
+    }
+
+    state.delta           += readDeltaOfDelta(reader);
+    state.record.unixTime += state.delta;
+
+    for (uint8_t varNr = 0; varNr < 4; ++varNr) {
+      state.record.values[varNr] = readValue(reader, state, varNr);
+    }
+    memcpy(records + i * sizeof(ControllerCacheRecord), &state.record, sizeof(ControllerCacheRecord));
+  }
+  return !reader.error();
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
@@ -0,0 +1,72 @@
+#ifndef DATASTRUCTS_CONTROLLERCACHECODEC_H
+#define DATASTRUCTS_CONTROLLERCACHECODEC_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include <vector>
+
+/*********************************************************************************************\
+* Compressed encoding of Cache Controller records
+*
+* Records are encoded per frame, which is the content of the RTC cache written in a single flush.
+* Per task in a frame:
+* - The first record is stored as-is.
+* - Timestamps are stored as delta-of-delta (typically 1 bit for a fixed interval)
+* - Values are XOR-ed with the previous value of the same task and only the meaningful bits are stored.
+*   (As described in "Gorilla: A Fast, Scalable, In-Memory Time Series Database")
+*
+* Each frame can be decoded on its own, so a reader only needs to decode the frame containing
+* the requested record.
+*
+* A compressed cache file starts with a file header, followed by frames:
+*   [ControllerCacheFrameHeader][payload]...
+\*********************************************************************************************/
+
+// Same layout as C016_binary_element
+// Do NOT change order of members!
+struct ControllerCacheRecord {
+  uint32_t values[4];
+  uint32_t unixTime;
+  uint8_t  TaskIndex;
+  uint8_t  pluginID;
+  uint8_t  sensorType;
+  uint8_t  valueCount;
+};
+
+# define CONTROLLER_CACHE_FILE_HEADER_SIZE   8
+
+# define CONTROLLER_CACHE_FRAME_COMPRESSED   0xC6
+# define CONTROLLER_CACHE_FRAME_STORED       0xC7 // Payload contains the records as-is
+
+// Do NOT change order of members!
+struct ControllerCacheFrameHeader {
+  uint8_t  type{};
+  uint8_t  nrRecords{};
+  uint16_t payloadSize{};
+};
+
+
+class ControllerCacheCodec {
+public:
+
+  // Header to mark a cache file as containing compressed frames.
+  static const uint8_t* getFileHeader();
+
+  static bool           isFileHeader(const uint8_t *data);
+
+  // Encode nrRecords records (max 255) as a single frame, including the frame header.
+  static bool           encodeFrame(const uint8_t         *records,
+                                    size_t                 nrRecords,
+                                    std::vector<uint8_t>& frame);
+
+  // Decode the payload of a frame into header.nrRecords records.
+  static bool           decodeFrame(const ControllerCacheFrameHeader& header,
+                                    const uint8_t                    *payload,
+                                    uint8_t                          *records);
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_CONTROLLERCACHECODEC_H
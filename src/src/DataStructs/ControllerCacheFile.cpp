@@ -0,0 +1,187 @@
+#include "../DataStructs/ControllerCacheFile.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../Helpers/ESPEasy_Storage.h"
+
+bool ControllerCacheFile::open(const String& fname)
+{
+  close();
+  _file = tryOpenFile(fname, "r");
+
+  if (!_file) { return false; }
+
+  uint8_t header[CONTROLLER_CACHE_FILE_HEADER_SIZE];
+
+  _compressed = (_file.read(header, sizeof(header)) == sizeof(header)) &&
+                ControllerCacheCodec::isFileHeader(header);
+
+  if (!_compressed) {
+    _file.seek(0);
+    return true;
+  }
+  _frameFilePos = CONTROLLER_CACHE_FILE_HEADER_SIZE;
+  _frameValid   = readFrameHeader(_frameFilePos, _frameHeader);
+  return true;
+}
+
+void ControllerCacheFile::close()
+{
+  if (_file) {
+    _file.close();
+  }
+  std::vector<uint8_t>().swap(_frame);
+  _frameFilePos = 0;
+  _frameStart   = 0;
+  _pos          = 0;
+  _size         = 0;
+  _sizeKnown    = false;
+  _compressed   = false;
+  _frameValid   = false;
+}
+
+size_t ControllerCacheFile::read(uint8_t *data, size_t size)
+{
+  if (!_compressed) {
+    return _file.read(data, size);
+  }
+  size_t bytesRead = 0;
+
+  while (bytesRead < size && _frameValid) {
+    const uint32_t frameEnd = _frameStart + _frameHeader.nrRecords * sizeof(ControllerCacheRecord);
+
+    if (_pos >= frameEnd) {
+      nextFrame();
+      continue;
+    }
+
+    if (!decodeFrame()) { break; }
+
+    const size_t nrBytes = std::min<size_t>(size - bytesRead, frameEnd - _pos);
+    memcpy(data + bytesRead, &_frame[_pos - _frameStart], nrBytes);
+    bytesRead += nrBytes;
+    _pos      += nrBytes;
+  }
+  return bytesRead;
+}
+
+bool ControllerCacheFile::seek(uint32_t pos, fs::SeekMode mode)
+{
+  if (!_compressed) {
+    return _file.seek(pos, mode);
+  }
+
+  if (mode == fs::SeekCur) {
+    pos += _pos;
+  } else if (mode == fs::SeekEnd) {
+    pos += size();
+  }
+
+  if (pos < _frameStart) {
+    // Frames can only be walked forward, start at the first frame
+    std::vector<uint8_t>().swap(_frame);
+    _frameFilePos = CONTROLLER_CACHE_FILE_HEADER_SIZE;
+    _frameStart   = 0;
+    _frameValid   = readFrameHeader(_frameFilePos, _frameHeader);
+  }
+
+  while (_frameValid && pos >= (_frameStart + _frameHeader.nrRecords * sizeof(ControllerCacheRecord))) {
+    nextFrame();
+  }
+
+  if (!_frameValid && (pos > _frameStart)) {
+    // Beyond the end of the file
+    return false;
+  }
+  _pos = pos;
+  return true;
+}
+
+size_t ControllerCacheFile::position() const
+{
+  if (!_compressed) {
+    return _file.position();
+  }
+  return _pos;
+}
+
+size_t ControllerCacheFile::size() const
+{
+  if (!_compressed) {
+    return _file.size();
+  }
+
+  if (!_sizeKnown) {
+    // Walk the frame headers, starting at the current frame
+    ControllerCacheFrameHeader header = _frameHeader;
+    uint32_t filePos                  = _frameFilePos;
+    bool     valid                    = _frameValid;
+
+    _size = _frameStart;
+
+    while (valid) {
+      _size   += header.nrRecords * sizeof(ControllerCacheRecord);
+      filePos += sizeof(ControllerCacheFrameHeader) + header.payloadSize;
+      valid    = readFrameHeader(filePos, header);
+    }
+    _sizeKnown = true;
+  }
+  return _size;
+}
+
+bool ControllerCacheFile::isCompressedFile(const String& fname)
+{
+  fs::File f = tryOpenFile(fname, "r");
+
+  if (!f) { return false; }
+  uint8_t header[CONTROLLER_CACHE_FILE_HEADER_SIZE];
+  const bool compressed = (f.read(header, sizeof(header)) == sizeof(header)) &&
+                          ControllerCacheCodec::isFileHeader(header);
+
+  f.close();
+  return compressed;
+}
+
+bool ControllerCacheFile::readFrameHeader(uint32_t filePos, ControllerCacheFrameHeader& header) const
+{
+  if (!_file.seek(filePos) ||
+      (_file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header))) {
+    return false;
+  }
+
+  // An incomplete last frame (e.g. power loss while writing) is considered the end of the file.
+  return (header.type == CONTROLLER_CACHE_FRAME_COMPRESSED || header.type == CONTROLLER_CACHE_FRAME_STORED) &&
+         header.nrRecords != 0 &&
+         (filePos + sizeof(header) + header.payloadSize) <= _file.size();
+}
+
+bool ControllerCacheFile::nextFrame()
+{
+  if (!_frameValid) { return false; }
+  _frameStart   += _frameHeader.nrRecords * sizeof(ControllerCacheRecord);
+  _frameFilePos += sizeof(ControllerCacheFrameHeader) + _frameHeader.payloadSize;
+  _frame.clear();
+  _frameValid = readFrameHeader(_frameFilePos, _frameHeader);
+  return _frameValid;
+}
+
+bool ControllerCacheFile::decodeFrame()
+{
+  if (!_frame.empty()) { return true; }
+
+  std::vector<uint8_t> payload(_frameHeader.payloadSize);
+
+  _frame.resize(_frameHeader.nrRecords * sizeof(ControllerCacheRecord));
+
+  if (!_file.seek(_frameFilePos + sizeof(ControllerCacheFrameHeader)) ||
+      (_file.read(&payload[0], payload.size()) != payload.size()) ||
+      !ControllerCacheCodec::decodeFrame(_frameHeader, &payload[0], &_frame[0])) {
+    // Treat a corrupt frame as the end of the file
+    _frame.clear();
+    _frameValid = false;
+    return false;
+  }
+  return true;
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
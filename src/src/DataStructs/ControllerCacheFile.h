@@ -0,0 +1,78 @@
+#ifndef DATASTRUCTS_CONTROLLERCACHEFILE_H
+#define DATASTRUCTS_CONTROLLERCACHEFILE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../DataStructs/ControllerCacheCodec.h"
+
+# include <FS.h>
+# include <vector>
+
+/*********************************************************************************************\
+* Read access to a cache file of the Cache Controller
+*
+* Offers the same interface as fs::File for reading.
+* For compressed cache files, the frames are decoded on the fly and positions and size
+* are in decoded bytes, as if the file contains the records as-is.
+* Thus readers do not need to know whether a cache file is compressed.
+\*********************************************************************************************/
+class ControllerCacheFile {
+public:
+
+  bool open(const String& fname);
+
+  void close();
+
+  explicit operator bool() const {
+    return static_cast<bool>(_file);
+  }
+
+  bool   isCompressed() const {
+    return _compressed;
+  }
+
+  size_t read(uint8_t *data,
+              size_t   size);
+
+  bool   seek(uint32_t     pos,
+              fs::SeekMode mode = fs::SeekSet);
+
+  size_t position() const;
+
+  // Size of the (decoded) content.
+  // For compressed files, the first call needs to walk all frame headers.
+  size_t size() const;
+
+  // Check the header of a cache file without opening it as ControllerCacheFile
+  static bool isCompressedFile(const String& fname);
+
+private:
+
+  // Read the header of the frame starting at filePos
+  bool readFrameHeader(uint32_t                    filePos,
+                       ControllerCacheFrameHeader& header) const;
+
+  // Move to the frame following the current frame
+  bool nextFrame();
+
+  bool decodeFrame();
+
+  mutable fs::File _file;
+
+  // Decoded records of the current frame
+  std::vector<uint8_t>_frame;
+  ControllerCacheFrameHeader _frameHeader;
+  uint32_t _frameFilePos = 0; // Position in the file of the current frame header
+  uint32_t _frameStart   = 0; // Decoded position of the first record in the current frame
+  uint32_t _pos          = 0; // Decoded read position
+  mutable uint32_t _size = 0;
+  mutable bool _sizeKnown = false;
+  bool _compressed        = false;
+  bool _frameValid        = false;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_CONTROLLERCACHEFILE_H
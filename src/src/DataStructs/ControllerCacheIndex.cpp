@@ -0,0 +1,136 @@
+#include "../DataStructs/ControllerCacheIndex.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+bool ControllerCacheBlock::hasTask(taskIndex_t taskIndex) const {
+  if (taskIndex >= 32) {
+    // Any task
+    return recordCount != 0;
+  }
+  return (taskBitmap >> taskIndex) & 1;
+}
+
+bool ControllerCacheBlock::overlaps(uint32_t from, uint32_t to) const {
+  return recordCount != 0 && lastTime >= from && firstTime <= to;
+}
+
+ControllerCacheIndex::ControllerCacheIndex(uint16_t recordSize)
+  : _recordSize(recordSize) {}
+
+void ControllerCacheIndex::clear() {
+  _blocks.clear();
+  _firstRecordTime = 0;
+}
+
+void ControllerCacheIndex::add(uint32_t unixTime, taskIndex_t taskIndex) {
+  if (_blocks.empty() || (_blocks.back().recordCount >= CONTROLLER_CACHE_INDEX_BLOCK_RECORDS)) {
+    if (_blocks.empty()) {
+      _firstRecordTime = unixTime;
+    }
+    ControllerCacheBlock block;
+    block.offset    = indexedSize();
+    block.firstTime = unixTime;
+    block.lastTime  = unixTime;
+    _blocks.push_back(block);
+  }
+  ControllerCacheBlock& block = _blocks.back();
+
+  if (unixTime < block.firstTime) { block.firstTime = unixTime; }
+
+  if (unixTime > block.lastTime) { block.lastTime = unixTime; }
+
+  if (taskIndex < 32) {
+    block.taskBitmap |= (1u << taskIndex);
+  }
+  ++block.recordCount;
+}
+
+uint32_t ControllerCacheIndex::indexedSize() const {
+  if (_blocks.empty()) { return 0; }
+  const ControllerCacheBlock& block = _blocks.back();
+
+  return block.offset + block.recordCount * _recordSize;
+}
+
+size_t ControllerCacheIndex::nrCompleteBlocks() const {
+  if (_blocks.empty()) { return 0; }
+
+  if (_blocks.back().recordCount < CONTROLLER_CACHE_INDEX_BLOCK_RECORDS) {
+    return _blocks.size() - 1;
+  }
+  return _blocks.size();
+}
+
+bool ControllerCacheIndex::find(uint32_t    from,
+                                uint32_t    to,
+                                taskIndex_t taskIndex,
+                                size_t    & blockNr) const
+{
+  // Timestamps are not strictly increasing (e.g. on NTP updates),
+  // so check all blocks instead of a binary search.
+  for (; blockNr < _blocks.size(); ++blockNr) {
+    const ControllerCacheBlock& block = _blocks[blockNr];
+
+    if (block.overlaps(from, to) && block.hasTask(taskIndex)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ControllerCacheIndex::getSummary(ControllerCacheBlock& summary) const {
+  summary = ControllerCacheBlock();
+
+  if (_blocks.empty()) { return false; }
+
+  summary.firstTime = _blocks.front().firstTime;
+
+  for (const ControllerCacheBlock& block : _blocks) {
+    if (block.firstTime < summary.firstTime) { summary.firstTime = block.firstTime; }
+
+    if (block.lastTime > summary.lastTime) { summary.lastTime = block.lastTime; }
+    summary.taskBitmap  |= block.taskBitmap;
+    summary.recordCount += block.recordCount;
+  }
+  return true;
+}
+
+ControllerCacheIndexHeader ControllerCacheIndex::getHeader() const {
+  ControllerCacheIndexHeader header;
+
+  header.recordSize      = _recordSize;
+  header.firstRecordTime = _firstRecordTime;
+  header.nrBlocks        = nrCompleteBlocks();
+  return header;
+}
+
+bool ControllerCacheIndex::initFromHeader(const ControllerCacheIndexHeader& header,
+                                          uint32_t                          firstRecordTime,
+                                          uint32_t                          fileSize)
+{
+  clear();
+
+  if ((header.magic != CONTROLLER_CACHE_INDEX_MAGIC) ||
+      (header.recordSize != _recordSize) ||
+      (header.blockRecords != CONTROLLER_CACHE_INDEX_BLOCK_RECORDS) ||
+      (header.firstRecordTime != firstRecordTime) ||
+      ((static_cast<uint64_t>(header.nrBlocks) * CONTROLLER_CACHE_INDEX_BLOCK_RECORDS * _recordSize) > fileSize)) {
+    return false;
+  }
+  _firstRecordTime = firstRecordTime;
+  _blocks.reserve(header.nrBlocks);
+  return true;
+}
+
+bool ControllerCacheIndex::addBlock(const ControllerCacheBlock& block, uint32_t fileSize) {
+  if ((block.offset != indexedSize()) ||
+      (block.recordCount != CONTROLLER_CACHE_INDEX_BLOCK_RECORDS) ||
+      (block.firstTime > block.lastTime) ||
+      ((block.offset + block.recordCount * _recordSize) > fileSize)) {
+    return false;
+  }
+  _blocks.push_back(block);
+  return true;
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
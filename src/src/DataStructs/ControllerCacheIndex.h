@@ -0,0 +1,127 @@
+#ifndef DATASTRUCTS_CONTROLLERCACHEINDEX_H
+#define DATASTRUCTS_CONTROLLERCACHEINDEX_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <vector>
+
+/*********************************************************************************************\
+* Sparse index of a cache file of the Cache Controller
+*
+* The cache files contain fixed size records, appended in chronological order.
+* The index splits a cache file in blocks of CONTROLLER_CACHE_INDEX_BLOCK_RECORDS records
+* and keeps per block the time range and the tasks present in that block.
+* This allows to skip blocks which cannot contain a record of interest,
+* without reading them from the file system.
+*
+* The cache files themselves are not changed, so existing files and readers remain compatible.
+* The index is stored in a separate file ("cache_<nr>.idx"), next to the cache file.
+* It is derived data; when missing or not matching the cache file, it is rebuilt by scanning the cache file.
+\*********************************************************************************************/
+
+# ifndef CONTROLLER_CACHE_INDEX_BLOCK_RECORDS
+
+// 128 records of 24 bytes = 3 kB of cache file per index entry of 20 bytes
+#  define CONTROLLER_CACHE_INDEX_BLOCK_RECORDS 128
+# endif // ifndef CONTROLLER_CACHE_INDEX_BLOCK_RECORDS
+
+# define CONTROLLER_CACHE_INDEX_MAGIC          0x49433643 // "C6CI"
+
+
+// Summary of a block of consecutive records in a cache file
+// Do NOT change order of members, as it is stored in the index file.
+struct ControllerCacheBlock {
+  bool hasTask(taskIndex_t taskIndex) const;
+
+  // Block has a record in the time range [from ... to] (including)
+  bool overlaps(uint32_t from,
+                uint32_t to) const;
+
+  uint32_t offset{};      // Position in the cache file of the first record
+  uint32_t firstTime{};   // Lowest unixTime in the block
+  uint32_t lastTime{};    // Highest unixTime in the block
+  uint32_t taskBitmap{};  // Bit set for each task index present in the block
+  uint16_t recordCount{};
+  uint16_t reserved{};
+};
+
+// Header of the index file
+// Do NOT change order of members!
+struct ControllerCacheIndexHeader {
+  uint32_t magic{ CONTROLLER_CACHE_INDEX_MAGIC };
+  uint16_t recordSize{};
+  uint16_t blockRecords{ CONTROLLER_CACHE_INDEX_BLOCK_RECORDS };
+
+  // unixTime of the first record in the cache file, to detect an index of a different cache file
+  uint32_t firstRecordTime{};
+  uint32_t nrBlocks{};
+};
+
+
+class ControllerCacheIndex {
+public:
+
+  explicit ControllerCacheIndex(uint16_t recordSize);
+
+  void     clear();
+
+  // Add the next record of the cache file to the index
+  void     add(uint32_t    unixTime,
+               taskIndex_t taskIndex);
+
+  // Number of bytes of the cache file covered by the index
+  uint32_t indexedSize() const;
+
+  // Only complete blocks will not change when records are appended to the cache file.
+  size_t   nrCompleteBlocks() const;
+
+  uint16_t getRecordSize() const {
+    return _recordSize;
+  }
+
+  uint32_t getFirstRecordTime() const {
+    return _firstRecordTime;
+  }
+
+  const std::vector<ControllerCacheBlock>& getBlocks() const {
+    return _blocks;
+  }
+
+  // Find the first block, starting at block index 'blockNr', which may contain a record
+  // in the time range [from ... to] for the given task (INVALID_TASK_INDEX = any task).
+  // Return false when no such block exists.
+  bool find(uint32_t    from,
+            uint32_t    to,
+            taskIndex_t taskIndex,
+            size_t    & blockNr) const;
+
+  // Summary of the whole cache file
+  bool getSummary(ControllerCacheBlock& summary) const;
+
+  // Serialization of the complete blocks, as stored in the index file
+  ControllerCacheIndexHeader getHeader() const;
+
+  // Start loading a stored index, return false when it cannot be used for
+  // a cache file of 'fileSize' bytes, starting with a record of 'firstRecordTime'.
+  bool initFromHeader(const ControllerCacheIndexHeader& header,
+                      uint32_t                          firstRecordTime,
+                      uint32_t                          fileSize);
+
+  // Append a block read from the index file, return false when it does not follow the previous block.
+  bool addBlock(const ControllerCacheBlock& block,
+                uint32_t                    fileSize);
+
+private:
+
+  std::vector<ControllerCacheBlock>_blocks;
+  uint32_t _firstRecordTime{};
+  uint16_t _recordSize{};
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_CONTROLLERCACHEINDEX_H
@@ -33,6 +33,7 @@ void ControllerSettingsStruct::reset() {
   MaxQueueDepth                                 = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   MaxRetry                                      = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
   DeleteOldest                                  = DEFAULT_CONTROLLER_DELETE_OLDEST;
+  MaxBatchSize                                  = CONTROLLER_DELAY_QUEUE_BATCH_DFLT;
   ClientTimeout                                 = CONTROLLER_CLIENTTIMEOUT_DFLT;
   MustCheckReply                                = DEFAULT_CONTROLLER_MUST_CHECK_REPLY;
   SampleSetInitiator                            = INVALID_TASK_INDEX;
@@ -48,6 +49,8 @@ void ControllerSettingsStruct::reset() {
   VariousBits1.deduplicate                      = 0;
   VariousBits1.useLocalSystemTime               = 0;
   VariousBits1.TLStype                          = 0;
+  VariousBits1.cacheCompression                 = 0;
+  VariousBits1.mqtt_sendJSON                    = 0;
 
   safe_strncpy(ClientID, F(CONTROLLER_DEFAULT_CLIENTID), sizeof(ClientID));
 }
@@ -74,6 +77,10 @@ void ControllerSettingsStruct::validate() {
 
   if (MaxRetry == 0) { MaxRetry = CONTROLLER_DELAY_QUEUE_RETRY_DFLT; }
 
+  if ((MaxBatchSize == 0) || (MaxBatchSize > CONTROLLER_DELAY_QUEUE_BATCH_MAX)) { MaxBatchSize = CONTROLLER_DELAY_QUEUE_BATCH_DFLT; }
+
+  if (P2P_BatchWindow > CONTROLLER_P2P_BATCH_WINDOW_MAX) { P2P_BatchWindow = CONTROLLER_P2P_BATCH_WINDOW_MAX; }
+
   if ((ClientTimeout < 10) || (ClientTimeout > CONTROLLER_CLIENTTIMEOUT_MAX)) {
     ClientTimeout = CONTROLLER_CLIENTTIMEOUT_DFLT;
   }
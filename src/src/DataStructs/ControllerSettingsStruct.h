@@ -37,6 +37,14 @@
 # define CONTROLLER_DELAY_QUEUE_DEPTH_DFLT  10
 #endif // ifndef CONTROLLER_DELAY_QUEUE_DEPTH_DFLT
 
+// Max. number of queued messages sent in one go, when the controller is ready to send.
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+# define CONTROLLER_DELAY_QUEUE_BATCH_MAX   25
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_DFLT
+# define CONTROLLER_DELAY_QUEUE_BATCH_DFLT  1
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_DFLT
+
 // Number of retries to send a message by a controller.
 // N.B. Retries without a connection to wifi do not count as retry.
 #ifndef CONTROLLER_DELAY_QUEUE_RETRY_MAX
@@ -62,6 +70,11 @@
 # define CONTROLLER_KEEP_ALIVE_TIME_DFLT      60
 #endif // ifndef CONTROLLER_KEEP_ALIVE_TIME_DFLT
 
+// C013 time to collect samples before sending them in a single batch frame, 0 = not batched
+#ifndef CONTROLLER_P2P_BATCH_WINDOW_MAX
+# define CONTROLLER_P2P_BATCH_WINDOW_MAX   5000
+#endif // ifndef CONTROLLER_P2P_BATCH_WINDOW_MAX
+
 #ifndef CONTROLLER_DEFAULT_CLIENTID
 # define CONTROLLER_DEFAULT_CLIENTID  "%sysname%_%unit%"
 #endif // ifndef CONTROLLER_DEFAULT_CLIENTID
@@ -87,6 +100,7 @@ struct ControllerSettingsStruct
     CONTROLLER_PASS,
     CONTROLLER_MIN_SEND_INTERVAL,
     CONTROLLER_MAX_QUEUE_DEPTH,
+    CONTROLLER_MAX_BATCH_SIZE,
     CONTROLLER_MAX_RETRIES,
     CONTROLLER_FULL_QUEUE_ACTION,
     CONTROLLER_ALLOW_EXPIRE,
@@ -97,6 +111,7 @@ struct ControllerSettingsStruct
 #if FEATURE_MQTT
     CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT,
     CONTROLLER_RETAINFLAG,
+    CONTROLLER_SEND_JSON,
 #endif
     CONTROLLER_SUBSCRIBE,
     CONTROLLER_PUBLISH,
@@ -112,6 +127,12 @@ struct ControllerSettingsStruct
     CONTROLLER_TIMEOUT,
     CONTROLLER_SAMPLE_SET_INITIATOR,
     CONTROLLER_SEND_BINARY,
+#ifdef USES_C013
+    CONTROLLER_P2P_BATCH_WINDOW,
+#endif
+#ifdef USES_C016
+    CONTROLLER_CACHE_COMPRESSION,
+#endif
 
     // Keep this as last, is used to loop over all parameters
     CONTROLLER_ENABLED
@@ -179,6 +200,12 @@ struct ControllerSettingsStruct
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
+  bool         cacheCompression() const { return VariousBits1.cacheCompression; }
+  void         cacheCompression(bool value) { VariousBits1.cacheCompression = value; }
+
+  bool         mqtt_sendJSON() const { return VariousBits1.mqtt_sendJSON; }
+  void         mqtt_sendJSON(bool value) { VariousBits1.mqtt_sendJSON = value; }
+
 #if FEATURE_MQTT_TLS
   TLS_types TLStype() const { return static_cast<TLS_types>(VariousBits1.TLStype); }
   void      TLStype(TLS_types tls_type) { VariousBits1.TLStype = static_cast<uint8_t>(tls_type); }
@@ -198,12 +225,13 @@ struct ControllerSettingsStruct
   char         MQTTLwtTopic[129];
   char         LWTMessageConnect[129];
   char         LWTMessageDisconnect[129];
-  uint8_t      UNUSED_2[2];
+  uint16_t     P2P_BatchWindow;    // C013 only, msec to collect samples for a batch frame, 0 = send each sample
   unsigned int MinimalTimeBetweenMessages;
   unsigned int MaxQueueDepth;
   unsigned int MaxRetry;
   bool         DeleteOldest;       // Action to perform when buffer full, delete oldest, or ignore newest.
-  uint8_t      UNUSED_3[3];
+  uint8_t      MaxBatchSize;       // Max. number of messages sent per queue run, 0 = default
+  uint8_t      UNUSED_3[2];
   unsigned int ClientTimeout;
   bool         MustCheckReply;     // When set to false, a sent message is considered always successful.
   taskIndex_t  SampleSetInitiator; // The first task to start a sample set.
@@ -223,8 +251,8 @@ struct ControllerSettingsStruct
     uint32_t deduplicate                      : 1; // Bit 10
     uint32_t useLocalSystemTime               : 1; // Bit 11
     uint32_t TLStype                          : 4; // Bit 12...15: TLS type
-    uint32_t unused_16                        : 1; // Bit 16
-    uint32_t unused_17                        : 1; // Bit 17
+    uint32_t cacheCompression                 : 1; // Bit 16, Cache Controller only
+    uint32_t mqtt_sendJSON                    : 1; // Bit 17
     uint32_t unused_18                        : 1; // Bit 18
     uint32_t unused_19                        : 1; // Bit 19
     uint32_t unused_20                        : 1; // Bit 20
@@ -14,7 +14,9 @@ DeviceStruct::DeviceStruct() :
   DuplicateDetection(false), ExitTaskBeforeSave(true), ErrorStateValues(false), 
   PluginStats(false), PluginLogsPeaks(false), PowerManager(false),
   TaskLogsOwnPeaks(false), I2CNoDeviceCheck(false),
-  I2CMax100kHz(false), HasFormatUserVar(false) 
+  I2CMax100kHz(false), HasFormatUserVar(false),
+  HasFiftyPerSecond(false), HasTenPerSecond(false), HasOnceASecond(false),
+  HasSerialIn(false), HasUdpIn(false), HasClockIn(false), HasTimeChange(false)
 {}
 
 bool DeviceStruct::connectedToGPIOpins() const {
@@ -110,6 +110,15 @@ struct __attribute__((__packed__)) DeviceStruct
   bool I2CMax100kHz       : 1;       // When enabled, the device is only able to handle 100 kHz bus-clock speed, shows warning and enables "Force Slow I2C speed" by default
 
   bool HasFormatUserVar   : 1;       // Optimization to only call this when PLUGIN_FORMAT_USERVAR is implemented
+
+  // Periodic and broadcast functions are only called for plugins which implement them.
+  bool HasFiftyPerSecond  : 1;       // Implements PLUGIN_FIFTY_PER_SECOND
+  bool HasTenPerSecond    : 1;       // Implements PLUGIN_TEN_PER_SECOND
+  bool HasOnceASecond     : 1;       // Implements PLUGIN_ONCE_A_SECOND
+  bool HasSerialIn        : 1;       // Implements PLUGIN_SERIAL_IN
+  bool HasUdpIn           : 1;       // Implements PLUGIN_UDP_IN
+  bool HasClockIn         : 1;       // Implements PLUGIN_CLOCK_IN
+  bool HasTimeChange      : 1;       // Implements PLUGIN_TIME_CHANGE
 };
 
 
@@ -56,9 +56,19 @@ struct ControllerCache_struct {
 
   String getNextCacheFileName(int& fileNr, bool& islast);
 
+  // Write new cache files compressed, see ControllerCacheCodec.
+  void   setCompression(bool compress);
+
+  bool   getCompression() const {
+    return _compress;
+  }
+
+  ControllerCacheCompressionStats getCompressionStats() const;
+
 private:
 
   RTC_cache_handler_struct *_RTC_cache_handler = nullptr;
+  bool _compress                               = false;
 };
 
 #endif
@@ -39,6 +39,7 @@ void ControllerCache_struct::init() {
 
     _RTC_cache_handler = new (std::nothrow) RTC_cache_handler_struct;
     if (_RTC_cache_handler != nullptr) {
+      _RTC_cache_handler->setCompression(_compress);
       _RTC_cache_handler->init();
     }
   }
@@ -128,4 +129,19 @@ String ControllerCache_struct::getNextCacheFileName(int& fileNr, bool& islast) {
   return _RTC_cache_handler->getNextCacheFileName(fileNr, islast);
 }
 
+void ControllerCache_struct::setCompression(bool compress) {
+  _compress = compress;
+
+  if (_RTC_cache_handler != nullptr) {
+    _RTC_cache_handler->setCompression(compress);
+  }
+}
+
+ControllerCacheCompressionStats ControllerCache_struct::getCompressionStats() const {
+  if (_RTC_cache_handler == nullptr) {
+    return ControllerCacheCompressionStats();
+  }
+  return _RTC_cache_handler->getCompressionStats();
+}
+
 #endif
\ No newline at end of file
@@ -2,28 +2,33 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/StringConverter.h"
 
 
+#define EVENT_QUEUE_EMPTY_SLOT  0xFFFF
 
-void EventQueueStruct::add(const String& event, bool deduplicate)
-{
-  if (!deduplicate || !isDuplicate(event)) {
-    #ifdef USE_SECOND_HEAP
-    String tmp;
-    reserve_special(tmp, event.length());
-    tmp = event;
-
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
 
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.push_back(event);
-    #endif // ifdef USE_SECOND_HEAP
+const __FlashStringHelper* toString(EventQueuePriority_e priority) {
+  switch (priority) {
+    case EventQueuePriority_e::System:     return F("System");
+    case EventQueuePriority_e::Timer:      return F("Timer");
+    case EventQueuePriority_e::User:       return F("User");
+    case EventQueuePriority_e::NrElements: break;
   }
+  return F("Unknown");
+}
+
+void EventQueueStats::clear()
+{
+  *this = EventQueueStats();
+}
+
+void EventQueueStruct::add(const String& event, bool deduplicate)
+{
+  addRecord(event, deduplicate);
 }
 
 void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
@@ -37,18 +42,8 @@ void EventQueueStruct::addMove(String&& event, bool deduplicate)
 {
   if (!event.length()) { return; }
 
-  if (!deduplicate || !isDuplicate(event)) {
-    #ifdef USE_SECOND_HEAP
-    String tmp;
-    move_special(tmp, std::move(event));
-
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.emplace_back(std::move(event));
-    #endif // ifdef USE_SECOND_HEAP
-  }
+  // The event is copied into a pooled record, so its buffer can be reused.
+  addRecord(event, deduplicate);
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const String& eventValue)
@@ -56,14 +51,14 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const S
   if (Settings.UseRules) {
     if (eventValue.isEmpty()) {
       addMove(strformat(
-        F("%s#%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
+        F("%s#%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
         varName.c_str()));
     } else {
       addMove(strformat(
-        F("%s#%s=%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
-        varName.c_str(), 
+        F("%s#%s=%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
+        varName.c_str(),
         eventValue.c_str()));
     }
   }
@@ -92,24 +87,370 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *var
 
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  if (_count == 0) {
     return false;
   }
-  event = std::move(_eventQueue.front());
-  _eventQueue.pop_front();
-  return true;
+
+  for (uint8_t p = 0; p < static_cast<uint8_t>(EventQueuePriority_e::NrElements); ++p) {
+    if (_rings[p].count != 0) {
+      const uint16_t index = popFront(_rings[p]);
+      Record& record       = _records[index];
+      eraseHash(index);
+
+      if ((index < EVENT_QUEUE_POOL_SIZE) &&
+          (record.event.length() <= EVENT_QUEUE_POOLED_STRING_MAX)) {
+        // Keep the buffer of the record
+        event = record.event;
+      } else {
+        event = std::move(record.event);
+      }
+      releaseRecord(index);
+      ++_stats.processed;
+      return true;
+    }
+  }
+  return false;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  if (_count == 0) {
+    return;
+  }
+
+  for (uint8_t p = 0; p < static_cast<uint8_t>(EventQueuePriority_e::NrElements); ++p) {
+    while (_rings[p].count != 0) {
+      const uint16_t index = popFront(_rings[p]);
+      eraseHash(index);
+      releaseRecord(index);
+    }
+  }
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return _count == 0;
+}
+
+std::size_t EventQueueStruct::size(EventQueuePriority_e priority) const
+{
+  if (priority == EventQueuePriority_e::NrElements) {
+    return 0;
+  }
+  return _rings[static_cast<uint8_t>(priority)].count;
+}
+
+void EventQueueStruct::resetStats()
+{
+  _stats.clear();
+  _stats.peakLength = _count;
+}
+
+EventQueuePriority_e EventQueueStruct::getPriority(const String& event)
+{
+  const int hashPos = event.indexOf('#');
+
+  if (hashPos <= 0) {
+    return EventQueuePriority_e::User;
+  }
+
+  const __FlashStringHelper *systemPrefixes[] = {
+    F("System#"),
+    F("WiFi#"),
+    F("Ethernet#")
+  };
+
+  for (size_t i = 0; i < NR_ELEMENTS(systemPrefixes); ++i) {
+    if (event.startsWith(systemPrefixes[i])) {
+      return EventQueuePriority_e::System;
+    }
+  }
+
+  if (event.startsWith(F("Rules#")) || event.startsWith(F("Clock#"))) {
+    return EventQueuePriority_e::Timer;
+  }
+  return EventQueuePriority_e::User;
+}
+
+void EventQueueStruct::addRecord(const String& event, bool deduplicate)
+{
+  if (event.isEmpty() || !init()) {
+    return;
+  }
+
+  uint32_t hash{};
+  uint32_t nameHash{};
+  uint16_t nameLength{};
+
+  computeHash(event, hash, nameHash, nameLength);
+
+  if (deduplicate && findDuplicate(event, hash)) {
+    ++_stats.deduplicated;
+    return;
+  }
+
+  const EventQueuePriority_e priority = getPriority(event);
+
+  if (_count >= EVENT_QUEUE_MAX_SIZE) {
+    // System and timer events (e.g. Rules#Timer=1 and Rules#Timer=2) are distinct events, never merge them.
+    if ((Settings.EventQueueOverflowPolicy() == EventQueueOverflowPolicy_e::Coalesce) &&
+        (priority == EventQueuePriority_e::User)) {
+      if (coalesce(event, nameHash, nameLength)) {
+        ++_stats.coalesced;
+        return;
+      }
+    }
+
+    if (!makeRoom(event, priority)) {
+      return;
+    }
+  }
+
+  const uint16_t index = acquireRecord();
+  Record& record       = _records[index];
+
+  #ifdef USE_SECOND_HEAP
+
+  // Only allocates when the pooled buffer is too small
+  reserve_special(record.event, event.length());
+  #endif // ifdef USE_SECOND_HEAP
+  record.event      = event;
+  record.hash       = hash;
+  record.nameHash   = nameHash;
+  record.nameLength = nameLength;
+  insertHash(index);
+
+  Ring& ring = _rings[static_cast<uint8_t>(priority)];
+  ring.items[(ring.head + ring.count) % EVENT_QUEUE_MAX_SIZE] = index;
+  ++ring.count;
+  ++_count;
+  ++_stats.added;
+
+  if (_count > _stats.peakLength) {
+    _stats.peakLength = _count;
+  }
+}
+
+bool EventQueueStruct::init()
+{
+  if (!_records.empty()) {
+    return true;
+  }
+  #ifdef USE_SECOND_HEAP
+
+  // Do not allocate the queue administration on the 2nd heap
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  size_t hashTableSize = 32;
+
+  while (hashTableSize < (2 * EVENT_QUEUE_MAX_SIZE)) {
+    hashTableSize <<= 1;
+  }
+
+  _records.resize(EVENT_QUEUE_MAX_SIZE);
+  _hashTable.resize(hashTableSize, EVENT_QUEUE_EMPTY_SLOT);
+
+  for (uint8_t p = 0; p < static_cast<uint8_t>(EventQueuePriority_e::NrElements); ++p) {
+    _rings[p].items.resize(EVENT_QUEUE_MAX_SIZE);
+  }
+
+  _freePooled.reserve(EVENT_QUEUE_POOL_SIZE);
+  _freeRecords.reserve(EVENT_QUEUE_MAX_SIZE);
+
+  // Free lists are used as a stack, lowest index on top.
+  for (uint16_t i = EVENT_QUEUE_MAX_SIZE; i > 0; --i) {
+    _freeRecords.push_back(i - 1);
+  }
+
+  if (_records.size() != EVENT_QUEUE_MAX_SIZE) {
+    _records.clear();
+    return false;
+  }
+  return true;
+}
+
+void EventQueueStruct::computeHash(const String& event,
+                                   uint32_t    & hash,
+                                   uint32_t    & nameHash,
+                                   uint16_t    & nameLength)
+{
+  // FNV-1a, the hash of the name is the intermediate value at the '=' character
+  const char  *str = event.c_str();
+  const size_t len = event.length();
+
+  hash       = 2166136261ul;
+  nameLength = len;
+  nameHash   = 0;
+  bool nameFound = false;
+
+  for (size_t i = 0; i < len; ++i) {
+    if (!nameFound && (str[i] == '=')) {
+      nameHash   = hash;
+      nameLength = i;
+      nameFound  = true;
+    }
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619ul;
+  }
+
+  if (!nameFound) {
+    nameHash = hash;
+  }
+}
+
+bool EventQueueStruct::makeRoom(const String& event, EventQueuePriority_e priority)
+{
+  if (Settings.EventQueueOverflowPolicy() != EventQueueOverflowPolicy_e::DropNewest) {
+    // Drop the oldest event of the least important class, but never one more important than the new event.
+    for (uint8_t p = static_cast<uint8_t>(EventQueuePriority_e::User);; --p) {
+      if (_rings[p].count != 0) {
+        const uint16_t index = popFront(_rings[p]);
+        eraseHash(index);
+        logDropped(_records[index].event);
+        releaseRecord(index);
+        return true;
+      }
+
+      if (p <= static_cast<uint8_t>(priority)) {
+        break;
+      }
+    }
+  }
+  logDropped(event);
+  return false;
+}
+
+void EventQueueStruct::logDropped(const String& event)
+{
+  ++_stats.dropped;
+
+  if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+    addLog(LOG_LEVEL_ERROR, concat(F("EventQueue: Full, dropped "), event));
+  }
+}
+
+bool EventQueueStruct::coalesce(const String& event,
+                                uint32_t      nameHash,
+                                uint16_t      nameLength)
+{
+  // Only events of the User class are merged
+  const Ring& ring = _rings[static_cast<uint8_t>(EventQueuePriority_e::User)];
+
+  for (uint16_t i = 0; i < ring.count; ++i) {
+    const uint16_t index = ring.items[(ring.head + i) % EVENT_QUEUE_MAX_SIZE];
+    Record& record       = _records[index];
+
+    if ((record.nameHash == nameHash) &&
+        (record.nameLength == nameLength) &&
+        (strncmp(record.event.c_str(), event.c_str(), nameLength) == 0)) {
+      // Keep the position in the queue, only update the value.
+      eraseHash(index);
+      record.event = event;
+      computeHash(record.event, record.hash, record.nameHash, record.nameLength);
+      insertHash(index);
+      return true;
+    }
+  }
+  return false;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+uint16_t EventQueueStruct::acquireRecord()
+{
+  uint16_t index;
+
+  if (!_freePooled.empty()) {
+    index = _freePooled.back();
+    _freePooled.pop_back();
+  } else {
+    index = _freeRecords.back();
+    _freeRecords.pop_back();
+  }
+  return index;
+}
+
+void EventQueueStruct::releaseRecord(uint16_t index)
+{
+  Record& record = _records[index];
+
+  if ((index < EVENT_QUEUE_POOL_SIZE) &&
+      (record.event.length() <= EVENT_QUEUE_POOLED_STRING_MAX)) {
+    // Assigning an empty string keeps the allocated buffer
+    record.event = "";
+    _freePooled.push_back(index);
+  } else {
+    record.event = String();
+    _freeRecords.push_back(index);
+  }
+  --_count;
+}
+
+uint16_t EventQueueStruct::popFront(Ring& ring)
+{
+  const uint16_t index = ring.items[ring.head];
+
+  ring.head = (ring.head + 1) % EVENT_QUEUE_MAX_SIZE;
+  --ring.count;
+  return index;
+}
+
+size_t EventQueueStruct::getHashSlot(uint32_t hash) const
+{
+  return hash & (_hashTable.size() - 1);
+}
+
+bool EventQueueStruct::findDuplicate(const String& event, uint32_t hash) const
+{
+  const size_t mask = _hashTable.size() - 1;
+
+  for (size_t slot = getHashSlot(hash);
+       _hashTable[slot] != EVENT_QUEUE_EMPTY_SLOT;
+       slot = (slot + 1) & mask) {
+    const Record& record = _records[_hashTable[slot]];
+
+    if ((record.hash == hash) && record.event.equals(event)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventQueueStruct::insertHash(uint16_t index)
+{
+  const size_t mask = _hashTable.size() - 1;
+  size_t slot       = getHashSlot(_records[index].hash);
+
+  while (_hashTable[slot] != EVENT_QUEUE_EMPTY_SLOT) {
+    slot = (slot + 1) & mask;
+  }
+  _hashTable[slot] = index;
+}
+
+void EventQueueStruct::eraseHash(uint16_t index)
+{
+  const size_t mask = _hashTable.size() - 1;
+  size_t slot       = getHashSlot(_records[index].hash);
+
+  while (_hashTable[slot] != index) {
+    if (_hashTable[slot] == EVENT_QUEUE_EMPTY_SLOT) {
+      // Not present, should not happen
+      return;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  // Backward shift deletion, keeps probe sequences intact without tombstones
+  size_t next = (slot + 1) & mask;
+
+  while (_hashTable[next] != EVENT_QUEUE_EMPTY_SLOT) {
+    const size_t home = getHashSlot(_records[_hashTable[next]].hash);
+
+    // Move the entry when its home slot is not in the (cyclic) range (slot, next]
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      _hashTable[slot] = _hashTable[next];
+      slot             = next;
+    }
+    next = (next + 1) & mask;
+  }
+  _hashTable[slot] = EVENT_QUEUE_EMPTY_SLOT;
 }
@@ -2,12 +2,67 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
+#include <vector>
 
 
+#include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataTypes/EventQueueOverflowPolicy.h"
 #include "../Globals/Plugins.h"
 
 
+// Number of event records which keep their allocated string buffer for reuse.
+#ifndef EVENT_QUEUE_POOL_SIZE
+# ifdef ESP32
+#  define EVENT_QUEUE_POOL_SIZE          16
+# else // ifdef ESP32
+#  define EVENT_QUEUE_POOL_SIZE           8
+# endif // ifdef ESP32
+#endif // ifndef EVENT_QUEUE_POOL_SIZE
+
+// Longer events will not keep their buffer after being processed.
+#ifndef EVENT_QUEUE_POOLED_STRING_MAX
+# define EVENT_QUEUE_POOLED_STRING_MAX   96
+#endif // ifndef EVENT_QUEUE_POOLED_STRING_MAX
+
+// Max. time spent processing queued events per call to processNextEvent()
+#ifndef EVENT_QUEUE_PROCESS_BUDGET_MSEC
+# define EVENT_QUEUE_PROCESS_BUDGET_MSEC  5
+#endif // ifndef EVENT_QUEUE_PROCESS_BUDGET_MSEC
+
+
+// Events are processed in order of priority, then in order of arrival.
+enum class EventQueuePriority_e : uint8_t {
+  System = 0, // System#..., WiFi#..., Ethernet#...
+  Timer  = 1, // Rules#..., Clock#...
+  User   = 2, // All other events (task values, asyncevent, MQTT import, etc.)
+
+  NrElements  // Keep as last
+};
+
+const __FlashStringHelper* toString(EventQueuePriority_e priority);
+
+
+struct EventQueueStats {
+  void clear();
+
+  uint32_t added        = 0;
+  uint32_t processed    = 0;
+  uint32_t dropped      = 0; // Discarded due to a full queue, every dropped event is logged
+  uint32_t deduplicated = 0; // Not added as the exact same event was already queued
+  uint32_t coalesced    = 0; // Replaced the value of a queued User event with the same name
+  uint16_t peakLength   = 0;
+};
+
+
+/*********************************************************************************************\
+* EventQueueStruct
+*
+* Bounded queue of rules events.
+* - Event records are allocated once and reused, short events keep their string buffer.
+* - Per priority class a ring buffer of record indices.
+* - Hash table on the event string for O(1) duplicate checks.
+* - When full, the overflow policy (see Settings) decides which event is discarded.
+\*********************************************************************************************/
 struct EventQueueStruct {
   EventQueueStruct() = default;
 
@@ -32,15 +87,94 @@ struct EventQueueStruct {
 
   bool        isEmpty() const;
 
-  std::size_t size() {
-    return _eventQueue.size();
+  std::size_t size() const {
+    return _count;
+  }
+
+  std::size_t size(EventQueuePriority_e priority) const;
+
+  std::size_t capacity() const {
+    return EVENT_QUEUE_MAX_SIZE;
+  }
+
+  const EventQueueStats& getStats() const {
+    return _stats;
   }
 
+  void                        resetStats();
+
+  static EventQueuePriority_e getPriority(const String& event);
+
 private:
 
-  bool isDuplicate(const String& event);
+  struct Record {
+    String   event;
+    uint32_t hash       = 0; // Hash of the entire event
+    uint32_t nameHash   = 0; // Hash of the event name (part before '=')
+    uint16_t nameLength = 0;
+  };
+
+  struct Ring {
+    uint16_t              head  = 0;
+    uint16_t              count = 0;
+    std::vector<uint16_t> items;
+  };
+
+  void     addRecord(const String& event,
+                     bool          deduplicate);
+
+  // Allocate the record pool, rings and hash table.
+  bool     init();
+
+  static void computeHash(const String& event,
+                          uint32_t    & hash,
+                          uint32_t    & nameHash,
+                          uint16_t    & nameLength);
+
+  // Make room for an event with given priority, according to the overflow policy.
+  // Return false when the new event must be discarded.
+  bool     makeRoom(const String       & event,
+                    EventQueuePriority_e priority);
+
+  // Count and log an event discarded due to a full queue.
+  void     logDropped(const String& event);
+
+  // Find a queued User event with the same name and replace it.
+  // System and Timer events are never merged.
+  bool     coalesce(const String& event,
+                    uint32_t      nameHash,
+                    uint16_t      nameLength);
+
+  uint16_t acquireRecord();
+
+  void     releaseRecord(uint16_t index);
+
+  uint16_t popFront(Ring& ring);
+
+  size_t   getHashSlot(uint32_t hash) const;
+
+  bool     findDuplicate(const String& event,
+                         uint32_t      hash) const;
+
+  void     insertHash(uint16_t index);
+
+  void     eraseHash(uint16_t index);
+
+  std::vector<Record>_records;
+
+  // Free records, which still have a string buffer allocated
+  std::vector<uint16_t>_freePooled;
+
+  // Free records, without string buffer
+  std::vector<uint16_t>_freeRecords;
+
+  Ring _rings[static_cast<uint8_t>(EventQueuePriority_e::NrElements)];
+
+  // Record index per slot, open addressing. Size is a power of 2
+  std::vector<uint16_t>_hashTable;
 
-  std::list<String>_eventQueue;
+  EventQueueStats _stats;
+  uint16_t        _count = 0;
 };
 
 
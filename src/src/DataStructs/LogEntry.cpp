@@ -3,69 +3,389 @@
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/StringConverter.h"
 
-#define LOG_STRUCT_MESSAGE_SIZE 128
-
 #ifdef ESP32
   #define LOG_BUFFER_EXPIRE         30000  // Time after which a buffered log item is considered expired.
 #else
   #define LOG_BUFFER_EXPIRE         5000  // Time after which a buffered log item is considered expired.
 #endif
 
+// First byte of _data
+#define LOG_ENTRY_TEXT        'T'
+#define LOG_ENTRY_FORMAT      'P'
+
+// Tags of the packed arguments
+#define LOG_ARG_INT32         'i'
+#define LOG_ARG_INT64         'I'
+#define LOG_ARG_UINT32        'u'
+#define LOG_ARG_UINT64        'U'
+#define LOG_ARG_FLOAT         'f'
+#define LOG_ARG_DOUBLE        'd'
+#define LOG_ARG_STRING        's'
+#define LOG_ARG_STRING_REF    'r'
+#define LOG_ARG_FLASH_STRING  'F'
 
-bool LogEntry_t::add(const uint8_t loglevel, const String& line)
+
+bool LogEntry_t::setText(uint8_t loglevel, const String& line)
 {
   if (line.length() == 0) {
     return false;
   }
+  size_t length = line.length();
 
-  {
-    #ifdef USE_SECOND_HEAP
-
-    // Need to make a substring or a copy, which is a new allocation, on the 2nd heap
-    HeapSelectIram ephemeral;
-    #endif // ifdef USE_SECOND_HEAP
-
-    if (line.length() > LOG_STRUCT_MESSAGE_SIZE - 1) {
-      _message = std::move(line.substring(0, LOG_STRUCT_MESSAGE_SIZE - 1));
-    } else {
-      _message = line;
-    }
+  if (length > (sizeof(_data) - 1)) {
+    length = sizeof(_data) - 1;
   }
+  _data[0] = LOG_ENTRY_TEXT;
+  memcpy(&_data[1], line.c_str(), length);
+  _size      = length + 1;
   _loglevel  = loglevel;
   _timestamp = millis();
   return true;
 }
 
-bool LogEntry_t::add(const uint8_t loglevel, String&& line)
+void LogEntry_t::setFormat(uint8_t loglevel, const __FlashStringHelper *format, bool copyStrings)
 {
-  if (line.length() == 0) {
-    return false;
+  PGM_P ptr = reinterpret_cast<PGM_P>(format);
+
+  _data[0] = LOG_ENTRY_FORMAT;
+  memcpy(&_data[1], &ptr, sizeof(ptr));
+  _size        = 1 + sizeof(ptr);
+  _loglevel    = loglevel;
+  _timestamp   = millis();
+  _copyStrings = copyStrings;
+}
+
+void LogEntry_t::addArg(float value)
+{
+  addData(LOG_ARG_FLOAT, &value, sizeof(value));
+}
+
+void LogEntry_t::addArg(double value)
+{
+  addData(LOG_ARG_DOUBLE, &value, sizeof(value));
+}
+
+void LogEntry_t::addArg(const char *value)
+{
+  if (value == nullptr) {
+    addString(value, 0);
+  } else {
+    addString(value, strlen_P(value));
   }
+}
+
+void LogEntry_t::addArg(const String& value)
+{
+  addString(value.c_str(), value.length());
+}
+
+void LogEntry_t::addArg(const __FlashStringHelper *value)
+{
+  addData(LOG_ARG_FLASH_STRING, &value, sizeof(value));
+}
 
-  if (line.length() > LOG_STRUCT_MESSAGE_SIZE - 1) {
-      #ifdef USE_SECOND_HEAP
+void LogEntry_t::addInt(int64_t value)
+{
+  if ((value >= INT32_MIN) && (value <= INT32_MAX)) {
+    const int32_t value32 = static_cast<int32_t>(value);
+    addData(LOG_ARG_INT32, &value32, sizeof(value32));
+  } else {
+    addData(LOG_ARG_INT64, &value, sizeof(value));
+  }
+}
 
-    // Need to make a substring, which is a new allocation, on the 2nd heap
-    HeapSelectIram ephemeral;
-      #endif // ifdef USE_SECOND_HEAP
-    _message = std::move(line.substring(0, LOG_STRUCT_MESSAGE_SIZE - 1));
+void LogEntry_t::addUInt(uint64_t value)
+{
+  if (value <= UINT32_MAX) {
+    const uint32_t value32 = static_cast<uint32_t>(value);
+    addData(LOG_ARG_UINT32, &value32, sizeof(value32));
   } else {
-    move_special(_message, std::move(line));
+    addData(LOG_ARG_UINT64, &value, sizeof(value));
   }
-  _loglevel  = loglevel;
-  _timestamp = millis();
+}
+
+bool LogEntry_t::addData(char tag, const void *value, size_t size)
+{
+  if ((_size == 0) || ((_size + 1 + size) > sizeof(_data))) {
+    return false;
+  }
+  _data[_size++] = tag;
+  memcpy(&_data[_size], value, size);
+  _size += size;
   return true;
 }
 
-void LogEntry_t::clear()
+void LogEntry_t::addString(const char *value, size_t length)
 {
-  _message   = String();
-  _timestamp = 0;
-  _loglevel  = 0;
+  if (!_copyStrings) {
+    struct {
+      const char *ptr;
+      size_t      length;
+    } ref{ value, length };
+
+    addData(LOG_ARG_STRING_REF, &ref, sizeof(ref));
+    return;
+  }
+
+  if ((_size == 0) || ((_size + 2u) > sizeof(_data))) {
+    return;
+  }
+  const size_t available = sizeof(_data) - _size - 2;
+
+  if (length > available) {
+    length = available;
+  }
+  _data[_size++] = LOG_ARG_STRING;
+  _data[_size++] = length;
+
+  if (length != 0) {
+    // Use memcpy_P as a char pointer may also point to flash
+    memcpy_P(&_data[_size], value, length);
+  }
+  _size += length;
 }
 
-bool LogEntry_t::isExpired() const
+String LogEntry_t::toString() const
 {
-    return timePassedSince(_timestamp) >= LOG_BUFFER_EXPIRE;
+  String res;
+
+  if (_size == 0) {
+    return res;
+  }
+
+  if (_data[0] == LOG_ENTRY_TEXT) {
+    res.concat(reinterpret_cast<const char *>(&_data[1]), _size - 1);
+    return res;
+  }
+
+  PGM_P format{};
+
+  memcpy(&format, &_data[1], sizeof(format));
+  size_t pos = 1 + sizeof(format);
+  size_t i   = 0;
 
-}
\ No newline at end of file
+  auto next = [&]() -> char {
+                return static_cast<char>(pgm_read_byte(format + i++));
+              };
+
+  // The length modifiers are skipped, the rest of the specification is kept.
+  char spec[12];
+
+  for (char c = next(); c != 0; c = next()) {
+    if (c != '%') {
+      res += c;
+      continue;
+    }
+    c = next();
+
+    if (c == '%') {
+      res += c;
+      continue;
+    }
+    size_t specLength = 0;
+    spec[specLength++] = '%';
+
+    while ((c != 0) && (strchr("-+ #0123456789.", c) != nullptr)) {
+      if (specLength < (sizeof(spec) - 1)) {
+        spec[specLength++] = c;
+      }
+      c = next();
+    }
+
+    while ((c != 0) && (strchr("hlLqjzt", c) != nullptr)) {
+      c = next();
+    }
+
+    if (c == 0) {
+      break;
+    }
+    spec[specLength] = 0;
+    pos              = renderArg(pos, spec, c, res);
+  }
+  return res;
+}
+
+size_t LogEntry_t::renderArg(size_t pos, const char *spec, char conversion, String& output) const
+{
+  if (pos >= _size) {
+    // Missing argument
+    return pos;
+  }
+
+  enum class ArgType { Signed, Unsigned, Floating, Text };
+
+  ArgType  type = ArgType::Signed;
+  int64_t  i64{};
+  uint64_t u64{};
+  double   dbl{};
+  String   str;
+
+  const char tag = _data[pos++];
+
+  switch (tag) {
+    case LOG_ARG_INT32:
+    {
+      int32_t value{};
+      memcpy(&value, &_data[pos], sizeof(value));
+      pos += sizeof(value);
+      i64  = value;
+      break;
+    }
+    case LOG_ARG_INT64:
+      memcpy(&i64, &_data[pos], sizeof(i64));
+      pos += sizeof(i64);
+      break;
+    case LOG_ARG_UINT32:
+    {
+      uint32_t value{};
+      memcpy(&value, &_data[pos], sizeof(value));
+      pos += sizeof(value);
+      u64  = value;
+      type = ArgType::Unsigned;
+      break;
+    }
+    case LOG_ARG_UINT64:
+      memcpy(&u64, &_data[pos], sizeof(u64));
+      pos += sizeof(u64);
+      type = ArgType::Unsigned;
+      break;
+    case LOG_ARG_FLOAT:
+    {
+      float value{};
+      memcpy(&value, &_data[pos], sizeof(value));
+      pos += sizeof(value);
+      dbl  = value;
+      type = ArgType::Floating;
+      break;
+    }
+    case LOG_ARG_DOUBLE:
+      memcpy(&dbl, &_data[pos], sizeof(dbl));
+      pos += sizeof(dbl);
+      type = ArgType::Floating;
+      break;
+    case LOG_ARG_STRING:
+    {
+      const size_t length = _data[pos++];
+      str.concat(reinterpret_cast<const char *>(&_data[pos]), length);
+      pos += length;
+      type = ArgType::Text;
+      break;
+    }
+    case LOG_ARG_STRING_REF:
+    {
+      const char *value{};
+      size_t      length{};
+      memcpy(&value,  &_data[pos],                 sizeof(value));
+      memcpy(&length, &_data[pos + sizeof(value)], sizeof(length));
+      pos += sizeof(value) + sizeof(length);
+
+      if (str.reserve(length)) {
+        // A char pointer may also point to flash
+        for (size_t c = 0; c < length; ++c) {
+          str += static_cast<char>(pgm_read_byte(value + c));
+        }
+      }
+      type = ArgType::Text;
+      break;
+    }
+    case LOG_ARG_FLASH_STRING:
+    {
+      const __FlashStringHelper *value{};
+      memcpy(&value, &_data[pos], sizeof(value));
+      pos += sizeof(value);
+      str  = value;
+      type = ArgType::Text;
+      break;
+    }
+    default:
+      // Corrupt data, stop rendering arguments
+      return _size;
+  }
+
+  char fmt[24];
+  char buf[LOG_STRUCT_MESSAGE_SIZE];
+
+  buf[0] = 0;
+
+  if (strchr("fFeEgGaA", conversion) != nullptr) {
+    if (type == ArgType::Text) {
+      output += str;
+      return pos;
+    }
+
+    if (type == ArgType::Signed) {
+      dbl = i64;
+    } else if (type == ArgType::Unsigned) {
+      dbl = u64;
+    }
+    snprintf(fmt, sizeof(fmt), "%s%c", spec, conversion);
+    snprintf(buf, sizeof(buf), fmt, dbl);
+  } else if (strchr("diouxXcp", conversion) != nullptr) {
+    if (type == ArgType::Text) {
+      output += str;
+      return pos;
+    }
+
+    if (type == ArgType::Floating) {
+      i64  = static_cast<int64_t>(dbl);
+      type = ArgType::Signed;
+    }
+
+    if (type == ArgType::Signed) {
+      u64 = static_cast<uint64_t>(i64);
+    }
+    const bool fits32 = (type == ArgType::Signed)
+                        ? ((i64 >= INT32_MIN) && (i64 <= INT32_MAX))
+                        : (u64 <= UINT32_MAX);
+
+    if (!fits32) {
+      // 64 bit values are not supported by printf on all platforms, width and precision are ignored.
+      if ((conversion == 'x') || (conversion == 'X')) {
+        output += ull2String(u64, 16);
+      } else if ((conversion == 'd') || (conversion == 'i')) {
+        output += ll2String(i64);
+      } else {
+        output += ull2String(u64);
+      }
+      return pos;
+    }
+    const uint32_t value32 = static_cast<uint32_t>(u64);
+
+    if (conversion == 'p') {
+      snprintf(buf, sizeof(buf), "%p", reinterpret_cast<void *>(static_cast<uintptr_t>(value32)));
+    } else if (conversion == 'c') {
+      snprintf(fmt, sizeof(fmt), "%sc", spec);
+      snprintf(buf, sizeof(buf), fmt, static_cast<int>(value32));
+    } else if ((conversion == 'd') || (conversion == 'i')) {
+      snprintf(fmt, sizeof(fmt), "%sl%c", spec, conversion);
+      snprintf(buf, sizeof(buf), fmt, static_cast<long>(static_cast<int32_t>(value32)));
+    } else {
+      snprintf(fmt, sizeof(fmt), "%sl%c", spec, conversion);
+      snprintf(buf, sizeof(buf), fmt, static_cast<unsigned long>(value32));
+    }
+  } else if (conversion == 's') {
+    if (type == ArgType::Signed) {
+      str = ll2String(i64);
+    } else if (type == ArgType::Unsigned) {
+      str = ull2String(u64);
+    } else if (type == ArgType::Floating) {
+      str = String(dbl);
+    }
+
+    if ((spec[1] == 0) || (str.length() >= sizeof(buf))) {
+      // No width or precision, no need to use snprintf
+      // Also do not truncate long strings to the size of buf.
+      output += str;
+      return pos;
+    }
+    snprintf(fmt, sizeof(fmt), "%ss", spec);
+    snprintf(buf, sizeof(buf), fmt, str.c_str());
+  }
+  output += buf;
+  return pos;
+}
+
+bool LogEntry_t::isExpired() const
+{
+  return timePassedSince(_timestamp) >= LOG_BUFFER_EXPIRE;
+}
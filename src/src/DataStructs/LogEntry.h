@@ -1,26 +1,98 @@
 #ifndef DATASTRUCT_LOGENTRY_H
 #define DATASTRUCT_LOGENTRY_H
 
-#include "../../ESPEasy_common.h"
+// Do not include ESPEasy_common.h here, as this file is included via ESPEasy_Log.h
+#include <Arduino.h>
 
+#include <type_traits>
+
+#define LOG_STRUCT_MESSAGE_SIZE 128
+
+/*********************************************************************************************\
+ * LogEntry_t
+ *
+ * Binary representation of a log line, as stored in the log buffer (LogStruct).
+ * The data is either the text itself, or a pointer to a printf style format string in flash
+ * followed by the packed arguments.
+ * Formatting the text of a formatted entry is deferred until the text is needed.
+\*********************************************************************************************/
 class LogEntry_t {
 public:
 
   LogEntry_t() = default;
 
-  bool add(const uint8_t loglevel,
-           const String& line);
-  bool add(const uint8_t loglevel,
-           String     && line);
+  // Text will be truncated to LOG_STRUCT_MESSAGE_SIZE - 1 characters
+  bool setText(uint8_t       loglevel,
+               const String& line);
+
+  // Arguments must be added in the order of the format string.
+  // The type of the argument is stored, so length modifiers in the format string are ignored.
+  // When copyStrings is false, only a reference to string arguments is stored.
+  // Such an entry must be rendered before the string arguments go out of scope
+  // and must not be stored in the log buffer, but its text is never truncated.
+  void setFormat(uint8_t                     loglevel,
+                 const __FlashStringHelper *format,
+                 bool                        copyStrings = true);
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value, void>::type addArg(T value) {
+    if (std::is_signed<T>::value) {
+      addInt(static_cast<int64_t>(value));
+    } else {
+      addUInt(static_cast<uint64_t>(value));
+    }
+  }
+
+  void addArg(float value);
+  void addArg(double value);
+
+  // Strings are copied, truncated when they do not fit
+  void addArg(const char *value);
+  void addArg(const String& value);
+
+  // Only the pointer is stored
+  void addArg(const __FlashStringHelper *value);
+
+  template<typename ... Args>
+  void addArgs(const Args& ... args) {
+    // Add the arguments in order
+    const int dummy[] = { 0, (addArg(args), 0)... };
+    (void)dummy;
+  }
+
+  // Render the text
+  String toString() const;
+
+  bool   isExpired() const;
+
+  uint32_t _timestamp{};
+  uint8_t  _loglevel{};
+
+  // Nr of bytes used in _data
+  uint8_t _size{};
+  uint8_t _data[LOG_STRUCT_MESSAGE_SIZE]{};
+
+  // Not stored in the log buffer
+  bool _copyStrings = true;
+
+private:
 
-  void clear();
+  void   addInt(int64_t value);
+  void   addUInt(uint64_t value);
 
-  bool isExpired() const;
+  // Add tag + value, returns false when it does not fit.
+  bool   addData(char        tag,
+                 const void *value,
+                 size_t      size);
 
+  void   addString(const char *value,
+                   size_t      length);
 
-  String _message;
-  unsigned long _timestamp{};
-  uint8_t _loglevel{};
+  // Append a single argument at position 'pos' in _data, using the format specification 'spec'
+  size_t renderArg(size_t      pos,
+                   const char *spec,
+                   char        conversion,
+                   String    & output) const;
 };
 
 
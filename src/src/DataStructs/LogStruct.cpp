@@ -1,26 +1,52 @@
 #include "../DataStructs/LogStruct.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/StringConverter.h"
 
-void LogStruct::add_end() {
-  if (isFull()) {
-    read_idx = nextIndex(read_idx);
-  }
-  write_idx = nextIndex(write_idx);
-  is_full   = (write_idx == read_idx);
-}
-
 void LogStruct::add(const uint8_t loglevel, const String& line) {
-  if (Message[write_idx].add(loglevel, line)) {
-    add_end();
+  LogEntry_t entry;
+
+  if (entry.setText(loglevel, line)) {
+    add(entry);
   }
 }
 
 void LogStruct::add(const uint8_t loglevel, String&& line) {
-  if (Message[write_idx].add(loglevel, std::move(line))) {
-    add_end();
+  add(loglevel, static_cast<const String&>(line));
+}
+
+void LogStruct::add(const LogEntry_t& entry) {
+  if ((entry._size == 0) || !entry._copyStrings) {
+    // Do not store references to strings which may no longer exist when read
+    return;
   }
+
+  if (_buffer == nullptr) {
+    _buffer = static_cast<uint8_t *>(special_calloc(1, LOG_STRUCT_BUFFER_SIZE));
+
+    if (_buffer == nullptr) {
+      return;
+    }
+  }
+  const size_t storedSize = getStoredSize(entry);
+
+  while (!isEmpty() && ((_used + storedSize) > LOG_STRUCT_BUFFER_SIZE)) {
+    clearOldest();
+  }
+
+  const uint32_t timestamp = entry._timestamp;
+  const size_t   write_pos = (_read_pos + _used) % LOG_STRUCT_BUFFER_SIZE;
+
+  write(write_pos,              &timestamp,       sizeof(timestamp));
+  write(write_pos + 4,          &entry._loglevel, 1);
+  write(write_pos + 5,          &entry._size,     1);
+  write(write_pos + headerSize, entry._data,      entry._size);
+
+  _used += storedSize;
+  ++_nrEntries;
+  ++_nrAdded;
+  _bytesAdded += storedSize;
 }
 
 bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel) {
@@ -30,11 +56,19 @@ bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, Strin
   if (isEmpty()) {
     return false;
   }
-  timestamp = Message[read_idx]._timestamp;
-  message   = std::move(Message[read_idx]._message);
-  loglevel  = Message[read_idx]._loglevel;
+  LogEntry_t entry;
+  uint32_t   entry_timestamp{};
+
+  read(_read_pos,              &entry_timestamp, sizeof(entry_timestamp));
+  read(_read_pos + 4,          &entry._loglevel,  1);
+  read(_read_pos + 5,          &entry._size,      1);
+  read(_read_pos + headerSize, entry._data,       entry._size);
   clearOldest();
 
+  timestamp = entry_timestamp;
+  message   = entry.toString();
+  loglevel  = entry._loglevel;
+
   if (!isEmpty()) {
     logLinesAvailable = true;
   }
@@ -47,15 +81,19 @@ bool LogStruct::logActiveRead() {
   return timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
 }
 
-void LogStruct::clearExpiredEntries() {
-  unsigned int maxLoops = LOG_STRUCT_MESSAGE_LINES;
+uint32_t LogStruct::getEstimatedCapacity() const {
+  if (_bytesAdded == 0) {
+    return 0;
+  }
+  return (static_cast<uint64_t>(LOG_STRUCT_BUFFER_SIZE) * _nrAdded) / _bytesAdded;
+}
 
-  while (maxLoops > 0) {
-    --maxLoops;
+void LogStruct::clearExpiredEntries() {
+  while (!isEmpty()) {
+    LogEntry_t entry;
+    read(_read_pos, &entry._timestamp, sizeof(entry._timestamp));
 
-    if (isEmpty() || // Nothing left
-        !Message[read_idx].isExpired())
-    {
+    if (!entry.isExpired()) {
       return;
     }
     clearOldest();
@@ -64,8 +102,29 @@ void LogStruct::clearExpiredEntries() {
 
 void LogStruct::clearOldest() {
   if (!isEmpty()) {
-    is_full = false;
-    Message[read_idx].clear();
-    read_idx = nextIndex(read_idx);
+    uint8_t size{};
+    read(_read_pos + 5, &size, 1);
+
+    const size_t storedSize = headerSize + size;
+
+    _read_pos = (_read_pos + storedSize) % LOG_STRUCT_BUFFER_SIZE;
+    _used    -= storedSize;
+    --_nrEntries;
+  }
+}
+
+void LogStruct::write(size_t pos, const void *data, size_t size) {
+  const uint8_t *src = static_cast<const uint8_t *>(data);
+
+  for (size_t i = 0; i < size; ++i) {
+    _buffer[(pos + i) % LOG_STRUCT_BUFFER_SIZE] = src[i];
+  }
+}
+
+void LogStruct::read(size_t pos, void *data, size_t size) const {
+  uint8_t *dst = static_cast<uint8_t *>(data);
+
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = _buffer[(pos + i) % LOG_STRUCT_BUFFER_SIZE];
   }
 }
@@ -8,17 +8,24 @@
 
 /*********************************************************************************************\
  * LogStruct
+ *
+ * Ring buffer of log entries for the web log.
+ * Entries are stored in binary form (see LogEntry_t) with a variable size,
+ * so the number of entries depends on the size of the entries.
+ * Entries with a format string are only formatted when read.
 \*********************************************************************************************/
-#ifdef ESP32
-  #define LOG_STRUCT_MESSAGE_LINES 60
-#else
-  #ifdef USE_SECOND_HEAP
-    #define LOG_STRUCT_MESSAGE_LINES 60
+#ifndef LOG_STRUCT_BUFFER_SIZE
+  #ifdef ESP32
+    #define LOG_STRUCT_BUFFER_SIZE 6144
   #else
-    #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
-      #define LOG_STRUCT_MESSAGE_LINES 10
+    #ifdef USE_SECOND_HEAP
+      #define LOG_STRUCT_BUFFER_SIZE 3072
     #else
-      #define LOG_STRUCT_MESSAGE_LINES 15
+      #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
+        #define LOG_STRUCT_BUFFER_SIZE 768
+      #else
+        #define LOG_STRUCT_BUFFER_SIZE 1024
+      #endif
     #endif
   #endif
 #endif
@@ -31,45 +38,52 @@
 
 
 struct LogStruct {
-    
+
     void add(const uint8_t loglevel, const String& line);
     void add(const uint8_t loglevel, String&& line);
-
-    // Read the next item and append it to the given string.
-    // Returns whether new lines are available.
-//    bool get(String& output, const String& lineEnd);
+    void add(const LogEntry_t& entry);
 
     // Returns whether a line was retrieved.
     bool getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel);
 
     bool isEmpty() const {
-      return !is_full && (write_idx == read_idx);
+      return _nrEntries == 0;
     }
 
-    bool isFull() const { return is_full; }
-
     bool logActiveRead();
 
-  private:
+    // Estimate of the number of entries fitting in the buffer, based on the average size of the added entries.
+    uint32_t getEstimatedCapacity() const;
 
-    void add_end();
+  private:
 
     void clearExpiredEntries();
 
     void clearOldest();
 
-    static int nextIndex(int idx) {
-//      return ((++idx) == LOG_STRUCT_MESSAGE_LINES) ? 0 : idx;
-      return (idx + 1) % LOG_STRUCT_MESSAGE_LINES;
+    // Size of the entry in the buffer, including the header.
+    static size_t getStoredSize(const LogEntry_t& entry) {
+      return headerSize + entry._size;
     }
 
-    LogEntry_t Message[LOG_STRUCT_MESSAGE_LINES];
-    int write_idx = 0;
-    int read_idx = 0;
+    void write(size_t pos, const void *data, size_t size);
+
+    void read(size_t pos, void *data, size_t size) const;
+
+    // Timestamp, loglevel and size of the data
+    static constexpr size_t headerSize = sizeof(uint32_t) + 2;
+
+    // Only allocated when the web log is used
+    uint8_t *_buffer = nullptr;
+    uint16_t _read_pos = 0;
+    uint16_t _used = 0;
+    uint16_t _nrEntries = 0;
+
+    uint32_t _nrAdded = 0;
+    uint32_t _bytesAdded = 0;
     unsigned long lastReadTimeStamp = 0;
-    bool is_full = false;
 };
 
 
 
-#endif // DATASTRUCTS_LOGSTRUCT_H
\ No newline at end of file
+#endif // DATASTRUCTS_LOGSTRUCT_H
@@ -19,8 +19,11 @@ NodeStruct::NodeStruct() :
    ,hasIPv4(0)
    ,hasIPv6_mac_based_link_local(0)
    ,hasIPv6_mac_based_link_global(0)
-   ,unused(0)
+#else
+   ,unused_IPv6(0)
 #endif
+   ,C013_batch(0)
+   ,unused(0)
 {}
 
 bool NodeStruct::valid() const {
@@ -50,11 +53,11 @@ bool NodeStruct::validate(const IPAddress& remoteIP) {
     hasIPv4                       = 0;
     hasIPv6_mac_based_link_local  = 0;
     hasIPv6_mac_based_link_global = 0;
-
-    unused = 0;
 #else
-    unused = 0;
+    unused_IPv6 = 0;
 #endif
+    C013_batch = 0;
+    unused     = 0;
 
     unix_time_frac = 0;
     unix_time_sec = 0;
@@ -109,11 +109,13 @@ struct __attribute__((__packed__)) NodeStruct
   // Whether the IPv6 address can be derived from the given sta_mac member
   uint8_t hasIPv6_mac_based_link_local  : 1;
   uint8_t hasIPv6_mac_based_link_global : 1;
-
-  uint8_t unused : 5;
   #else
-  uint8_t unused = 0;
+  // Keep the same bit positions as builds with IPv6 support
+  uint8_t unused_IPv6 : 3;
   #endif
+  // Node can receive C013 batch frames (C013_SensorDataBatch, message ID 7)
+  uint8_t C013_batch : 1;
+  uint8_t unused     : 4;
   uint32_t unix_time_sec  = 0;
   uint32_t unix_time_frac = 0;
 };
@@ -496,6 +496,9 @@ void NodesHandler::updateThisNode() {
   thisNode.hasIPv6_mac_based_link_local = is_IPv6_link_local_from_MAC(thisNode.sta_mac);
   thisNode.hasIPv6_mac_based_link_global = is_IPv6_global_from_MAC(thisNode.sta_mac);
   #endif
+  #ifdef USES_C013
+  thisNode.C013_batch = 1;
+  #endif
 
   #ifdef USES_ESPEASY_NOW
   addNode(thisNode, thisTraceRoute);
@@ -18,11 +18,11 @@ PluginStats::PluginStats(uint8_t nrDecimals, float errorValue) :
 
 {
   // Try to allocate in PSRAM if possible
-  void *ptr = special_calloc(1, sizeof(PluginStatsBuffer_t));
+  void *ptr = special_calloc(1, sizeof(PluginStats_samples));
 
   if (ptr == nullptr) { _samples = nullptr; }
   else {
-    _samples = new (ptr) PluginStatsBuffer_t();
+    _samples = new (ptr) PluginStats_samples(errorValue);
   }
   _errorValueIsNaN   = isnan(_errorValue);
   _minValue          = std::numeric_limits<float>::max();
@@ -147,29 +147,12 @@ float PluginStats::getSampleAvg() const {
 
 float PluginStats::getSampleAvg(PluginStatsBuffer_t::index_t lastNrSamples) const
 {
-  const size_t nrSamples = getNrSamples();
-
-  if (nrSamples == 0) { return _errorValue; }
-  float sum = 0.0f;
-
-  PluginStatsBuffer_t::index_t i = 0;
-
-  if (lastNrSamples < nrSamples) {
-    i = nrSamples - lastNrSamples;
-  }
-  PluginStatsBuffer_t::index_t samplesUsed = 0;
-
-  for (; i < nrSamples; ++i) {
-    const float sample((*_samples)[i]);
+  PluginStats_samples::Summary summary;
 
-    if (usableValue(sample)) {
-      ++samplesUsed;
-      sum += sample;
-    }
+  if ((_samples == nullptr) || !_samples->getSummary(lastNrSamples, summary, false)) {
+    return _errorValue;
   }
-
-  if (samplesUsed == 0) { return _errorValue; }
-  return sum / samplesUsed;
+  return summary.mean;
 }
 
 float PluginStats::getSampleAvg_time(PluginStatsBuffer_t::index_t lastNrSamples, uint64_t& totalDuration_usec) const
@@ -222,66 +205,26 @@ float PluginStats::getSampleAvg_time(PluginStatsBuffer_t::index_t lastNrSamples,
 
 float PluginStats::getSampleStdDev(PluginStatsBuffer_t::index_t lastNrSamples) const
 {
-  const size_t nrSamples = getNrSamples();
-  float variance         = 0.0f;
-  const float average    = getSampleAvg(lastNrSamples);
-
-  if (!usableValue(average)) { return 0.0f; }
-
-  PluginStatsBuffer_t::index_t i = 0;
-
-  if (lastNrSamples < nrSamples) {
-    i = nrSamples - lastNrSamples;
-  }
-  PluginStatsBuffer_t::index_t samplesUsed = 0;
-
-  for (; i < nrSamples; ++i) {
-    const float sample((*_samples)[i]);
+  PluginStats_samples::Summary summary;
 
-    if (usableValue(sample)) {
-      ++samplesUsed;
-      const float diff = sample - average;
-      variance += diff * diff;
-    }
+  if ((_samples == nullptr) || !_samples->getSummary(lastNrSamples, summary, false)) {
+    return 0.0f;
   }
 
-  if (samplesUsed < 2) { return 0.0f; }
+  if (!usableValue(summary.mean) || (summary.count < 2)) { return 0.0f; }
 
-  variance /= samplesUsed;
-  return sqrtf(variance);
+  return sqrtf(summary.m2 / summary.count);
 }
 
 float PluginStats::getSampleExtreme(PluginStatsBuffer_t::index_t lastNrSamples, bool getMax) const
 {
-  const size_t nrSamples = getNrSamples();
-
-  if (nrSamples == 0) { return _errorValue; }
-
-  PluginStatsBuffer_t::index_t i = 0;
-
-  if (lastNrSamples < nrSamples) {
-    i = nrSamples - lastNrSamples;
-  }
-
-  bool changed = false;
-
-  float res = getMax ? INT_MIN : INT_MAX;
-
-  for (; i < nrSamples; ++i) {
-    const float sample((*_samples)[i]);
+  PluginStats_samples::Summary summary;
 
-    if (usableValue(sample)) {
-      if ((getMax && (sample > res)) ||
-          (!getMax && (sample < res))) {
-        changed = true;
-        res     = sample;
-      }
-    }
+  if ((_samples == nullptr) || !_samples->getSummary(lastNrSamples, summary, true)) {
+    return _errorValue;
   }
 
-  if (!changed) { return _errorValue; }
-
-  return res;
+  return getMax ? summary.max : summary.min;
 }
 
 float PluginStats::getSample(int lastNrSamples) const
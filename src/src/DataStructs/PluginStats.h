@@ -6,6 +6,7 @@
 #if FEATURE_PLUGIN_STATS
 
 # include "../DataStructs/ChartJS_dataset_config.h"
+# include "../DataStructs/PluginStats_samples.h"
 # include "../DataStructs/PluginStats_size.h"
 # include "../DataStructs/PluginStats_timestamp.h"
 # include "../DataTypes/TaskIndex.h"
@@ -18,7 +19,7 @@
 class PluginStats {
 public:
 
-  typedef CircularBuffer<float, PLUGIN_STATS_NR_ELEMENTS> PluginStatsBuffer_t;
+  typedef PluginStats_samples::PluginStatsBuffer_t PluginStatsBuffer_t;
 
   PluginStats() = delete;
   PluginStats(uint8_t nrDecimals,
@@ -175,16 +176,21 @@ public:
 
 # endif // if FEATURE_CHART_JS
 
-private:
+  // Not NaN and not the error value
+  bool    usableValue(float value) const;
+
+  uint8_t getNrDecimals() const {
+    return _nrDecimals;
+  }
 
-  bool usableValue(float value) const;
+private:
 
   float _minValue;
   float _maxValue;
   int64_t _minValueTimestamp;
   int64_t _maxValueTimestamp;
 
-  PluginStatsBuffer_t *_samples = nullptr;
+  PluginStats_samples *_samples = nullptr;
   float _errorValue;
   bool _errorValueIsNaN;
 
@@ -64,6 +64,15 @@ struct PluginStats_Config_t {
     bits.hidden = enable;
   }
 
+  // Keep long term statistics in rollup files, see PluginStats_rollup
+  bool rollupEnabled() const {
+    return bits.rollup;
+  }
+
+  void setRollupEnabled(bool enable) {
+    bits.rollup = enable;
+  }
+
 private:
 
   uint8_t getStored() const {
@@ -83,7 +92,7 @@ private:
     uint8_t hidden            : 1; // Bit 02  Hidden/Displayed state on initial showing of the chart
     uint8_t chartAxisIndex    : 2; // Bit 03 ... 04
     uint8_t chartAxisPosition : 1; // Bit 05
-    uint8_t unused_06         : 1; // Bit 06
+    uint8_t rollup            : 1; // Bit 06
     uint8_t unused_07         : 1; // Bit 07
   } bits;
 };
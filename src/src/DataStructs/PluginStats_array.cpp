@@ -24,6 +24,10 @@ PluginStats_array::~PluginStats_array()
     free(_plugin_stats_timestamps);
     _plugin_stats_timestamps = nullptr;
   }
+# if FEATURE_PLUGIN_STATS_ROLLUP
+  delete _plugin_stats_rollup;
+  _plugin_stats_rollup = nullptr;
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
 }
 
 void PluginStats_array::initPluginStats(taskIndex_t taskIndex, taskVarIndex_t taskVarIndex)
@@ -88,6 +92,26 @@ void PluginStats_array::initPluginStats(taskIndex_t taskIndex, taskVarIndex_t ta
       }
     }
   }
+# if FEATURE_PLUGIN_STATS_ROLLUP
+  _rollupEnabledMask = 0;
+
+  for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+    if ((_plugin_stats[i] != nullptr) && ExtraTaskSettings.getPluginStatsConfig(i).rollupEnabled()) {
+      _rollupEnabledMask |= (1 << i);
+    }
+  }
+
+  if (_rollupEnabledMask == 0) {
+    delete _plugin_stats_rollup;
+    _plugin_stats_rollup = nullptr;
+  } else if (_plugin_stats_rollup == nullptr) {
+    _plugin_stats_rollup = new (std::nothrow) PluginStats_rollup();
+
+    if (_plugin_stats_rollup != nullptr) {
+      _plugin_stats_rollup->init(taskIndex);
+    }
+  }
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
 }
 
 void PluginStats_array::clearPluginStats(taskVarIndex_t taskVarIndex)
@@ -104,6 +128,11 @@ void PluginStats_array::clearPluginStats(taskVarIndex_t taskVarIndex)
       free(_plugin_stats_timestamps);
       _plugin_stats_timestamps = nullptr;
     }
+# if FEATURE_PLUGIN_STATS_ROLLUP
+    delete _plugin_stats_rollup;
+    _plugin_stats_rollup = nullptr;
+    _rollupEnabledMask   = 0;
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
   }
 }
 
@@ -185,6 +214,28 @@ void PluginStats_array::pushPluginStatsValues(
 
       const int64_t timestamp_sysmicros = event->getTimestamp_as_systemMicros();
 
+# if FEATURE_PLUGIN_STATS_ROLLUP
+
+      // Every sample counts for the rollup, also when only the timestamp would be updated.
+      if ((_plugin_stats_rollup != nullptr) && node_time.systemTimePresent()) {
+        float values[VARS_PER_TASK];
+
+        for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+          values[i] = NAN;
+
+          if ((i < valueCount) && rollupEnabled(i)) {
+            const float value = UserVar.getAsDouble(event->TaskIndex, i, sensorType);
+
+            if (_plugin_stats[i]->usableValue(value)) {
+              values[i] = value;
+            }
+          }
+        }
+        uint32_t unix_time_frac{};
+        _plugin_stats_rollup->push(node_time.systemMicros_to_Unixtime(timestamp_sysmicros, unix_time_frac), values);
+      }
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
       if (onlyUpdateTimestampWhenSame && (_plugin_stats_timestamps != nullptr)) {
         // When only updating the timestamp of the last entry,
         // we should look at the last 2 entries to see if they are the same.
@@ -241,6 +292,13 @@ bool PluginStats_array::plugin_get_config_value_base(struct EventStruct *event,
       // Check case insensitive, since the user entered value name can have any case.
       if (valueName.equalsIgnoreCase(Cache.getTaskDeviceValueName(event->TaskIndex, i)))
       {
+# if FEATURE_PLUGIN_STATS_ROLLUP
+        const String period = parseString(fullValueName, 3, '.');
+
+        if (!period.isEmpty()) {
+          return getRollupValue(i, parseString(fullValueName, 2, '.'), period, string);
+        }
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
         return _plugin_stats[i]->plugin_get_config_value_base(event, string);
       }
     }
@@ -248,6 +306,36 @@ bool PluginStats_array::plugin_get_config_value_base(struct EventStruct *event,
   return false;
 }
 
+# if FEATURE_PLUGIN_STATS_ROLLUP
+bool PluginStats_array::getRollupValue(taskVarIndex_t taskVarIndex,
+                                       const String & command,
+                                       const String & period,
+                                       String       & string) const
+{
+  if (!rollupEnabled(taskVarIndex)) { return false; }
+
+  PluginStats_rollup_aggregate aggregate;
+
+  if (!_plugin_stats_rollup->getAggregate(PluginStats_rollup::parsePeriod(period), taskVarIndex, aggregate)) {
+    return false;
+  }
+  float value{};
+
+  if (equals(command, F("avg"))) {
+    value = aggregate.getAvg();
+  } else if (equals(command, F("min"))) {
+    value = aggregate.min;
+  } else if (equals(command, F("max"))) {
+    value = aggregate.max;
+  } else {
+    return false;
+  }
+  string = toString(value, _plugin_stats[taskVarIndex]->getNrDecimals());
+  return true;
+}
+
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
 bool PluginStats_array::plugin_write_base(struct EventStruct *event, const String& string)
 {
   bool success     = false;
@@ -489,6 +577,117 @@ void PluginStats_array::plot_ChartJS_scatter(
   add_ChartJS_chart_footer(onlyJSON);
 }
 
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+bool PluginStats_array::plot_ChartJS_rollup(uint8_t tier, bool onlyJSON) const
+{
+  if ((_plugin_stats_rollup == nullptr) ||
+      (tier >= PLUGIN_STATS_ROLLUP_NR_TIERS) ||
+      !node_time.systemTimePresent()) {
+    return false;
+  }
+
+  const PluginStats_rollup_tier& rollupTier = _plugin_stats_rollup->getTier(tier);
+  const uint32_t unixTime                   = node_time.getUnixTime();
+  const uint32_t from                       = unixTime - rollupTier.getSpan();
+
+  // Chart Header
+  {
+    ChartJS_options_scales scales;
+    {
+      ChartJS_options_scale scaleOption(F("x"));
+      scaleOption.scaleType = F("time");
+      scales.add(scaleOption);
+    }
+
+    for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+      if (rollupEnabled(i)) {
+        ChartJS_options_scale scaleOption(
+          _plugin_stats[i]->_ChartJS_dataset_config.displayConfig,
+          _plugin_stats[i]->getLabel());
+        scaleOption.axisTitle.color = _plugin_stats[i]->_ChartJS_dataset_config.color;
+        scales.add(scaleOption);
+
+        _plugin_stats[i]->_ChartJS_dataset_config.axisID = scaleOption.axisID;
+      }
+    }
+
+    scales.update_Yaxis_TickCount();
+
+    const bool enableZoom = true;
+
+    add_ChartJS_chart_header(
+      F("line"),
+      concat(F("TaskStatsRollup_"), PluginStats_rollup_tier::getTierName(tier)),
+      {},
+      500 + (70 * (scales.nr_Y_scales() - 1)),
+      500,
+      scales.toString(),
+      enableZoom,
+      rollupTier.getNrBuckets(),
+      onlyJSON);
+  }
+
+  // Add labels
+  // Every pass reads the buckets from the file, so no buckets need to be kept in memory.
+  bool first = true;
+
+  addHtml(F("\"labels\":["));
+  rollupTier.forEachBucket(from, unixTime, [&first](const PluginStats_rollup_bucket& bucket) {
+    if (!first) {
+      addHtml(',');
+    }
+    first = false;
+    struct tm ts;
+    breakTime(time_zone.toLocal(bucket.startTime), ts);
+    addHtml('"');
+    addHtml(formatDateTimeString(ts));
+    addHtml('"');
+  });
+  addHtml(F("],\n\"datasets\":["));
+
+  // Data sets, avg/min/max per task value
+  first = true;
+
+  for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (rollupEnabled(i)) {
+      const uint8_t nrDecimals = _plugin_stats[i]->getNrDecimals();
+
+      for (uint8_t set = 0; set < 3; ++set) {
+        if (!first) {
+          addHtml(',');
+        }
+        first = false;
+
+        ChartJS_dataset_config config = _plugin_stats[i]->_ChartJS_dataset_config;
+
+        if (set != 0) {
+          config.label += (set == 1) ? F(" min") : F(" max");
+        }
+        add_ChartJS_dataset_header(config);
+
+        bool firstValue = true;
+        rollupTier.forEachBucket(from, unixTime, [&firstValue, i, set, nrDecimals](const PluginStats_rollup_bucket& bucket) {
+          if (!firstValue) {
+            addHtml(',');
+          }
+          firstValue = false;
+
+          if (bucket.count[i] == 0) {
+            addHtml(F("null"));
+          } else {
+            addHtmlFloat(set == 0 ? bucket.avg[i] : (set == 1 ? bucket.min[i] : bucket.max[i]), nrDecimals);
+          }
+        });
+        add_ChartJS_dataset_footer((set == 0) ? EMPTY_STRING : String(F("\"borderDash\":[4,4],\"pointRadius\":0")));
+      }
+    }
+  }
+  add_ChartJS_chart_footer(onlyJSON);
+  return true;
+}
+
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
 # endif // if FEATURE_CHART_JS
 
 
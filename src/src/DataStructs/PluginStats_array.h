@@ -6,6 +6,7 @@
 #if FEATURE_PLUGIN_STATS
 
 # include "../DataStructs/PluginStats.h"
+# include "../DataStructs/PluginStats_rollup.h"
 # include "../DataStructs/PluginStats_timestamp.h"
 
 # include "../DataStructs/ChartJS_dataset_config.h"
@@ -68,6 +69,12 @@ public:
     const String                & options     = EMPTY_STRING,
     bool                          onlyJSON    = false) const;
 
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+
+  // Chart of the buckets of a rollup tier, read directly from the rollup file
+  bool plot_ChartJS_rollup(uint8_t tier,
+                           bool    onlyJSON = false) const;
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
 
 # endif // if FEATURE_CHART_JS
 
@@ -78,6 +85,22 @@ public:
 
 private:
 
+# if FEATURE_PLUGIN_STATS_ROLLUP
+
+  // [taskname#valuename.avg.1h] Average over the last hour, from the rollup tiers
+  bool getRollupValue(taskVarIndex_t taskVarIndex,
+                      const String & command,
+                      const String & period,
+                      String       & string) const;
+
+  bool rollupEnabled(taskVarIndex_t taskVarIndex) const {
+    return (_plugin_stats_rollup != nullptr) && ((_rollupEnabledMask >> taskVarIndex) & 1);
+  }
+
+  PluginStats_rollup *_plugin_stats_rollup = nullptr;
+  uint8_t _rollupEnabledMask               = 0;
+# endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
   PluginStats *_plugin_stats[VARS_PER_TASK]       = {};
   PluginStats_timestamp *_plugin_stats_timestamps = nullptr;
 };
@@ -0,0 +1,424 @@
+#include "../DataStructs/PluginStats_rollup.h"
+
+#if FEATURE_PLUGIN_STATS_ROLLUP
+
+# include "../Globals/Cache.h"
+# include "../Globals/ESPEasy_time.h"
+# include "../Globals/Plugins.h"
+# include "../Globals/Settings.h"
+
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Numerical.h"
+# include "../Helpers/StringConverter.h"
+
+void PluginStats_rollup_bucket::add(const float values[VARS_PER_TASK])
+{
+  for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (!isnan(values[i]) && (count[i] < UINT16_MAX)) {
+      if (count[i] == 0) {
+        min[i] = values[i];
+        max[i] = values[i];
+        avg[i] = 0.0f;
+      } else {
+        if (values[i] < min[i]) { min[i] = values[i]; }
+
+        if (values[i] > max[i]) { max[i] = values[i]; }
+      }
+      ++count[i];
+      avg[i] += (values[i] - avg[i]) / count[i];
+    }
+  }
+}
+
+bool PluginStats_rollup_bucket::hasSamples() const
+{
+  for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (count[i] != 0) { return true; }
+  }
+  return false;
+}
+
+void PluginStats_rollup_aggregate::add(const PluginStats_rollup_bucket& bucket, taskVarIndex_t taskVarIndex)
+{
+  const uint16_t bucketCount = bucket.count[taskVarIndex];
+
+  if (bucketCount == 0) { return; }
+
+  if ((count == 0) || (bucket.min[taskVarIndex] < min)) { min = bucket.min[taskVarIndex]; }
+
+  if ((count == 0) || (bucket.max[taskVarIndex] > max)) { max = bucket.max[taskVarIndex]; }
+  count += bucketCount;
+  sum   += static_cast<double>(bucket.avg[taskVarIndex]) * bucketCount;
+}
+
+/*********************************************************************************************\
+* PluginStats_rollup_tier
+\*********************************************************************************************/
+PluginStats_rollup_tier::~PluginStats_rollup_tier()
+{
+  store(true);
+}
+
+void PluginStats_rollup_tier::init(taskIndex_t taskIndex, uint8_t tier)
+{
+  store(true);
+  _bucket = PluginStats_rollup_bucket();
+  _pending.clear();
+  _taskIndex      = taskIndex;
+  _tier           = tier;
+  _valuesChecksum = computeValuesChecksum(taskIndex);
+}
+
+void PluginStats_rollup_tier::push(uint32_t unixTime, const float values[VARS_PER_TASK])
+{
+  if (!validTaskIndex(_taskIndex) || (unixTime == 0)) { return; }
+  const uint32_t startTime = unixTime - (unixTime % getBucketDuration());
+
+  if (startTime != _bucket.startTime) {
+    if (_bucket.startTime == 0) {
+      // First sample since the task was started.
+      // Continue a bucket which was stored when the task was stopped.
+      if (!readBucket(startTime, _bucket)) {
+        _bucket           = PluginStats_rollup_bucket();
+        _bucket.startTime = startTime;
+      }
+    } else {
+      if (_changed) {
+        if (_pending.empty()) {
+          _pending.reserve(getWriteBatchSize());
+        }
+        _pending.push_back(_bucket);
+        _changed = false;
+      }
+      _bucket           = PluginStats_rollup_bucket();
+      _bucket.startTime = startTime;
+
+      if (_pending.size() >= getWriteBatchSize()) {
+        store(false);
+      }
+    }
+  }
+  _bucket.add(values);
+  _changed = true;
+}
+
+void PluginStats_rollup_tier::forEachBucket(uint32_t from, uint32_t unixTime, const BucketHandler& handler) const
+{
+  const uint32_t duration = getBucketDuration();
+  const uint32_t current  = unixTime - (unixTime % duration);
+
+  // Only the last nrBuckets slots can hold the buckets of interest.
+  const uint32_t oldest = current - (getNrBuckets() - 1) * duration;
+
+  if (from < oldest) {
+    from = oldest;
+  }
+
+  // Start of the first bucket starting at or after 'from'
+  uint32_t startTime = from + duration - 1;
+
+  startTime -= startTime % duration;
+
+  fs::File f        = openFile(false);
+  bool     mustSeek = true;
+
+  for (; startTime <= current; startTime += duration) {
+    if (startTime == _bucket.startTime) {
+      // Open bucket, may not yet be stored
+      if (_bucket.hasSamples()) {
+        handler(_bucket);
+      }
+      mustSeek = true;
+      continue;
+    }
+    const PluginStats_rollup_bucket *pending = getPendingBucket(startTime);
+
+    if (pending != nullptr) {
+      handler(*pending);
+      mustSeek = true;
+      continue;
+    }
+
+    if (!f) { continue; }
+    const uint32_t filePos = getFilePos(startTime);
+
+    if (filePos == sizeof(PluginStats_rollup_header)) {
+      // Wrapped to the first slot
+      mustSeek = true;
+    }
+
+    if (mustSeek) {
+      if (!f.seek(filePos)) { continue; }
+      mustSeek = false;
+    }
+    PluginStats_rollup_bucket bucket;
+
+    if (f.read(reinterpret_cast<uint8_t *>(&bucket), sizeof(bucket)) != sizeof(bucket)) {
+      // Not yet written that far in the file
+      mustSeek = true;
+      continue;
+    }
+
+    if (bucket.startTime == startTime) {
+      handler(bucket);
+    }
+  }
+
+  if (f) {
+    f.close();
+  }
+}
+
+uint32_t PluginStats_rollup_tier::getBucketDuration() const
+{
+  return _tier == 0 ? 60 : 3600;
+}
+
+uint16_t PluginStats_rollup_tier::getNrBuckets() const
+{
+  return _tier == 0 ? PLUGIN_STATS_ROLLUP_1M_BUCKETS : PLUGIN_STATS_ROLLUP_1H_BUCKETS;
+}
+
+const __FlashStringHelper * PluginStats_rollup_tier::getTierName(uint8_t tier)
+{
+  return tier == 0 ? F("1m") : F("1h");
+}
+
+uint8_t PluginStats_rollup_tier::getTierIndex(const String& tierName)
+{
+  for (uint8_t tier = 0; tier < PLUGIN_STATS_ROLLUP_NR_TIERS; ++tier) {
+    if (tierName.equalsIgnoreCase(getTierName(tier))) {
+      return tier;
+    }
+  }
+  return PLUGIN_STATS_ROLLUP_NR_TIERS;
+}
+
+String PluginStats_rollup_tier::getFilename(taskIndex_t taskIndex, uint8_t tier)
+{
+  return strformat(F("stats_%d_%s.bin"), taskIndex + 1, String(getTierName(tier)).c_str());
+}
+
+uint16_t PluginStats_rollup_tier::getWriteBatchSize() const
+{
+  return _tier == 0 ? PLUGIN_STATS_ROLLUP_1M_WRITE_BATCH : 1;
+}
+
+uint32_t PluginStats_rollup_tier::computeValuesChecksum(taskIndex_t taskIndex)
+{
+  uint32_t crc = 0xffffffff;
+
+  for (taskVarIndex_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (Cache.enabledPluginStats(taskIndex, i) && Cache.getPluginStatsConfig(taskIndex, i).rollupEnabled()) {
+      const String valueName = Cache.getTaskDeviceValueName(taskIndex, i);
+      crc = calc_CRC32(reinterpret_cast<const uint8_t *>(&i),                 sizeof(i),          crc);
+      crc = calc_CRC32(reinterpret_cast<const uint8_t *>(valueName.c_str()), valueName.length(), crc);
+    }
+  }
+  return crc;
+}
+
+bool PluginStats_rollup_tier::isValidHeader(const PluginStats_rollup_header& header) const
+{
+  return header.magic == PLUGIN_STATS_ROLLUP_MAGIC &&
+         header.bucketDuration == getBucketDuration() &&
+         header.nrBuckets == getNrBuckets() &&
+         header.pluginID == Settings.getPluginID_for_task(_taskIndex).value &&
+         header.valuesChecksum == _valuesChecksum;
+}
+
+fs::File PluginStats_rollup_tier::openFile(bool forWrite) const
+{
+  const String fname = getFilename(_taskIndex, _tier);
+  fs::File     f;
+
+  if (fileExists(fname)) {
+    f = tryOpenFile(fname, forWrite ? "r+" : "r");
+
+    if (f) {
+      PluginStats_rollup_header header;
+
+      if ((f.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) == sizeof(header)) &&
+          isValidHeader(header)) {
+        return f;
+      }
+      f.close();
+    }
+  }
+
+  if (!forWrite) {
+    return f;
+  }
+
+  // Missing or written for another task, start a new file.
+  f = tryOpenFile(fname, "w+");
+
+  if (f) {
+    PluginStats_rollup_header header;
+    header.bucketDuration = getBucketDuration();
+    header.nrBuckets      = getNrBuckets();
+    header.pluginID       = Settings.getPluginID_for_task(_taskIndex).value;
+    header.valuesChecksum = _valuesChecksum;
+
+    if (f.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header)) != sizeof(header)) {
+      f.close();
+    }
+  }
+  return f;
+}
+
+uint32_t PluginStats_rollup_tier::getFilePos(uint32_t startTime) const
+{
+  const uint32_t slot = (startTime / getBucketDuration()) % getNrBuckets();
+
+  return sizeof(PluginStats_rollup_header) + slot * sizeof(PluginStats_rollup_bucket);
+}
+
+bool PluginStats_rollup_tier::readBucket(uint32_t startTime, PluginStats_rollup_bucket& bucket) const
+{
+  fs::File f = openFile(false);
+
+  if (!f) { return false; }
+  const bool res = f.seek(getFilePos(startTime)) &&
+                   (f.read(reinterpret_cast<uint8_t *>(&bucket), sizeof(bucket)) == sizeof(bucket)) &&
+                   (bucket.startTime == startTime);
+
+  f.close();
+  return res;
+}
+
+const PluginStats_rollup_bucket * PluginStats_rollup_tier::getPendingBucket(uint32_t startTime) const
+{
+  for (const PluginStats_rollup_bucket& bucket : _pending) {
+    if (bucket.startTime == startTime) {
+      return &bucket;
+    }
+  }
+  return nullptr;
+}
+
+bool PluginStats_rollup_tier::writeBucket(fs::File& f, const PluginStats_rollup_bucket& bucket) const
+{
+  const uint32_t filePos = getFilePos(bucket.startTime);
+
+  if (f.size() < filePos) {
+    // Slots are written for the first time, fill the gap with empty slots.
+    const PluginStats_rollup_bucket empty;
+    f.seek(0, fs::SeekEnd);
+
+    while (f.size() < filePos) {
+      if (f.write(reinterpret_cast<const uint8_t *>(&empty), sizeof(empty)) != sizeof(empty)) {
+        return false;
+      }
+    }
+  }
+  return f.seek(filePos) &&
+         (f.write(reinterpret_cast<const uint8_t *>(&bucket), sizeof(bucket)) == sizeof(bucket));
+}
+
+void PluginStats_rollup_tier::store(bool includeOpenBucket)
+{
+  const bool storeOpenBucket = includeOpenBucket && _changed;
+
+  if ((_pending.empty() && !storeOpenBucket) || !validTaskIndex(_taskIndex)) { return; }
+
+  fs::File f = openFile(true);
+
+  if (f) {
+    bool success = true;
+
+    for (auto it = _pending.begin(); success && it != _pending.end(); ++it) {
+      success = writeBucket(f, *it);
+    }
+
+    if (success && storeOpenBucket) {
+      writeBucket(f, _bucket);
+    }
+    f.close();
+  }
+
+  // Also drop the buckets when the file could not be written, to not run out of memory.
+  _pending.clear();
+
+  if (storeOpenBucket) {
+    _changed = false;
+  }
+}
+
+/*********************************************************************************************\
+* PluginStats_rollup
+\*********************************************************************************************/
+void PluginStats_rollup::init(taskIndex_t taskIndex)
+{
+  for (uint8_t tier = 0; tier < PLUGIN_STATS_ROLLUP_NR_TIERS; ++tier) {
+    _tiers[tier].init(taskIndex, tier);
+  }
+}
+
+void PluginStats_rollup::push(uint32_t unixTime, const float values[VARS_PER_TASK])
+{
+  for (uint8_t tier = 0; tier < PLUGIN_STATS_ROLLUP_NR_TIERS; ++tier) {
+    _tiers[tier].push(unixTime, values);
+  }
+}
+
+bool PluginStats_rollup::getAggregate(uint32_t period, taskVarIndex_t taskVarIndex, PluginStats_rollup_aggregate& aggregate) const
+{
+  if ((period == 0) || !validTaskVarIndex(taskVarIndex) || !node_time.systemTimePresent()) {
+    return false;
+  }
+
+  uint8_t tier = 0;
+
+  while ((tier < (PLUGIN_STATS_ROLLUP_NR_TIERS - 1)) && (period > _tiers[tier].getSpan())) {
+    ++tier;
+  }
+
+  const uint32_t unixTime = node_time.getUnixTime();
+
+  aggregate = PluginStats_rollup_aggregate();
+  _tiers[tier].forEachBucket(
+    unixTime - period,
+    unixTime,
+    [&aggregate, taskVarIndex](const PluginStats_rollup_bucket& bucket) {
+    aggregate.add(bucket, taskVarIndex);
+  });
+  return aggregate.count != 0;
+}
+
+void PluginStats_rollup::removeFiles(taskIndex_t taskIndex)
+{
+  if (!validTaskIndex(taskIndex)) { return; }
+
+  for (uint8_t tier = 0; tier < PLUGIN_STATS_ROLLUP_NR_TIERS; ++tier) {
+    const String fname = PluginStats_rollup_tier::getFilename(taskIndex, tier);
+
+    if (fileExists(fname)) {
+      tryDeleteFile(fname);
+    }
+  }
+}
+
+uint32_t PluginStats_rollup::parsePeriod(const String& period)
+{
+  if (period.length() < 2) { return 0; }
+  uint32_t factor = 0;
+
+  switch (tolower(period[period.length() - 1])) {
+    case 'm': factor = 60; break;
+    case 'h': factor = 3600; break;
+    case 'd': factor = 86400; break;
+    case 'w': factor = 604800; break;
+  }
+  int32_t nr{};
+
+  if ((factor == 0) ||
+      !validIntFromString(period.substring(0, period.length() - 1), nr) ||
+      (nr <= 0)) {
+    return 0;
+  }
+  return static_cast<uint32_t>(nr) * factor;
+}
+
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP
@@ -0,0 +1,188 @@
+#ifndef DATASTRUCTS_PLUGINSTATS_ROLLUP_H
+#define DATASTRUCTS_PLUGINSTATS_ROLLUP_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_PLUGIN_STATS_ROLLUP
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <FS.h>
+# include <functional>
+# include <vector>
+
+/*********************************************************************************************\
+* Long term statistics of task values, downsampled in tiers
+*
+* Per tier, the samples of a task are combined in buckets of a fixed duration (1 minute, 1 hour),
+* keeping the nr of samples and min/avg/max per task value.
+* Completed buckets are stored in a fixed size ring file per task and tier on the file system
+* ("stats_<tasknr>_1m.bin"), so long term trends do not need raw samples in RAM.
+*
+* The slot of a bucket in the ring file is derived from its start time,
+* so there is no write position to keep track of.
+* A slot holding a bucket of another start time is considered empty.
+*
+* To limit flash wear, completed buckets are kept in RAM and written in batches
+* (PLUGIN_STATS_ROLLUP_1M_WRITE_BATCH for the 1 minute tier, every bucket for the 1 hour tier).
+* The pending buckets and the open bucket are written when the task is stopped.
+\*********************************************************************************************/
+
+# ifndef PLUGIN_STATS_ROLLUP_1M_BUCKETS
+#  define PLUGIN_STATS_ROLLUP_1M_BUCKETS  720 // 12 hours
+# endif // ifndef PLUGIN_STATS_ROLLUP_1M_BUCKETS
+# ifndef PLUGIN_STATS_ROLLUP_1H_BUCKETS
+#  define PLUGIN_STATS_ROLLUP_1H_BUCKETS  336 // 14 days
+# endif // ifndef PLUGIN_STATS_ROLLUP_1H_BUCKETS
+
+# ifndef PLUGIN_STATS_ROLLUP_1M_WRITE_BATCH
+#  define PLUGIN_STATS_ROLLUP_1M_WRITE_BATCH  15 // Write the 1 minute tier every 15 minutes
+# endif // ifndef PLUGIN_STATS_ROLLUP_1M_WRITE_BATCH
+
+# define PLUGIN_STATS_ROLLUP_NR_TIERS     2
+# define PLUGIN_STATS_ROLLUP_MAGIC        0x52535045 // "EPSR"
+
+
+// Do NOT change order of members, as it is stored in the rollup files.
+struct PluginStats_rollup_bucket {
+  // Add a sample, NaN values are skipped.
+  void add(const float values[VARS_PER_TASK]);
+
+  bool hasSamples() const;
+
+  uint32_t startTime{}; // Unix time of the start of the bucket, 0 = empty slot
+  uint16_t count[VARS_PER_TASK]{};
+  float    min[VARS_PER_TASK]{};
+  float    avg[VARS_PER_TASK]{};
+  float    max[VARS_PER_TASK]{};
+};
+
+// Header of a rollup file
+// Do NOT change order of members!
+struct PluginStats_rollup_header {
+  uint32_t magic{ PLUGIN_STATS_ROLLUP_MAGIC };
+  uint32_t bucketDuration{};
+  uint16_t nrBuckets{};
+  uint16_t pluginID{}; // To detect a file of a previous task at the same task index
+  uint32_t valuesChecksum{}; // To detect a file written with other value names or trend flags
+};
+
+// Combined buckets of a single task value
+struct PluginStats_rollup_aggregate {
+  void  add(const PluginStats_rollup_bucket& bucket,
+            taskVarIndex_t                   taskVarIndex);
+
+  float getAvg() const {
+    return count == 0 ? NAN : sum / count;
+  }
+
+  uint32_t count = 0;
+  double   sum   = 0.0;
+  float    min   = NAN;
+  float    max   = NAN;
+};
+
+
+class PluginStats_rollup_tier {
+public:
+
+  typedef std::function<void (const PluginStats_rollup_bucket&)> BucketHandler;
+
+  PluginStats_rollup_tier() = default;
+
+  // Store the pending buckets and the open bucket, so it can be continued when the task is started again.
+  ~PluginStats_rollup_tier();
+
+  void     init(taskIndex_t taskIndex,
+                uint8_t     tier);
+
+  void     push(uint32_t    unixTime,
+                const float values[VARS_PER_TASK]);
+
+  // Call handler for all buckets starting at or after 'from', in chronological order,
+  // including the pending buckets and the open bucket.
+  void     forEachBucket(uint32_t             from,
+                         uint32_t             unixTime,
+                         const BucketHandler& handler) const;
+
+  uint32_t getBucketDuration() const;
+
+  uint16_t getNrBuckets() const;
+
+  // Time span covered by the ring file
+  uint32_t getSpan() const {
+    return getBucketDuration() * getNrBuckets();
+  }
+
+  static const __FlashStringHelper* getTierName(uint8_t tier);
+
+  // Return PLUGIN_STATS_ROLLUP_NR_TIERS when not matching any tier name
+  static uint8_t                    getTierIndex(const String& tierName);
+
+  static String                     getFilename(taskIndex_t taskIndex,
+                                                uint8_t     tier);
+
+private:
+
+  uint16_t getWriteBatchSize() const;
+
+  static uint32_t computeValuesChecksum(taskIndex_t taskIndex);
+
+  bool     isValidHeader(const PluginStats_rollup_header& header) const;
+
+  fs::File openFile(bool forWrite) const;
+
+  uint32_t getFilePos(uint32_t startTime) const;
+
+  bool     readBucket(uint32_t                   startTime,
+                      PluginStats_rollup_bucket& bucket) const;
+
+  const PluginStats_rollup_bucket* getPendingBucket(uint32_t startTime) const;
+
+  bool     writeBucket(fs::File&                        f,
+                       const PluginStats_rollup_bucket& bucket) const;
+
+  // Write the pending buckets and optionally the open bucket.
+  void     store(bool includeOpenBucket);
+
+  PluginStats_rollup_bucket _bucket;
+  std::vector<PluginStats_rollup_bucket> _pending; // Completed buckets, not yet stored
+  uint32_t    _valuesChecksum = 0;
+  taskIndex_t _taskIndex      = INVALID_TASK_INDEX;
+  uint8_t     _tier           = 0;
+  bool        _changed        = false;
+};
+
+
+class PluginStats_rollup {
+public:
+
+  void init(taskIndex_t taskIndex);
+
+  void push(uint32_t    unixTime,
+            const float values[VARS_PER_TASK]);
+
+  // Aggregate of the buckets of the last 'period' seconds, using the most detailed tier covering the period.
+  bool getAggregate(uint32_t                      period,
+                    taskVarIndex_t                taskVarIndex,
+                    PluginStats_rollup_aggregate& aggregate) const;
+
+  const PluginStats_rollup_tier& getTier(uint8_t tier) const {
+    return _tiers[tier];
+  }
+
+  // Parse a period like "15m", "1h", "7d" or "2w" into seconds. Return 0 when not valid.
+  static uint32_t parsePeriod(const String& period);
+
+  // Delete the rollup files of a task, e.g. when the task is deleted or another plugin is selected.
+  // Must be called after the task has been stopped, as it stores its buckets when stopped.
+  static void     removeFiles(taskIndex_t taskIndex);
+
+private:
+
+  PluginStats_rollup_tier _tiers[PLUGIN_STATS_ROLLUP_NR_TIERS];
+};
+
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
+#endif // ifndef DATASTRUCTS_PLUGINSTATS_ROLLUP_H
@@ -0,0 +1,246 @@
+#include "../DataStructs/PluginStats_samples.h"
+
+#if FEATURE_PLUGIN_STATS
+
+# include "../Helpers/ESPEasy_math.h"
+
+void PluginStats_samples::Summary::add(float value)
+{
+  if (count == 0) {
+    min = value;
+    max = value;
+  } else {
+    if (value < min) { min = value; }
+
+    if (value > max) { max = value; }
+  }
+  ++count;
+  const double delta = value - mean;
+
+  mean += delta / count;
+  m2   += delta * (value - mean);
+}
+
+void PluginStats_samples::Summary::add(const Summary& other)
+{
+  if (other.count == 0) { return; }
+
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+
+  // Combine mean and M2 of both parts, see Chan et al.
+  const uint32_t total = count + other.count;
+  const double   delta = other.mean - mean;
+
+  m2   += other.m2 + delta * delta * count * other.count / total;
+  mean += delta * other.count / total;
+  count = total;
+
+  if (other.min < min) { min = other.min; }
+
+  if (other.max > max) { max = other.max; }
+}
+
+void PluginStats_samples::ExtremeQueue::clear()
+{
+  _head = 0;
+  _size = 0;
+}
+
+void PluginStats_samples::ExtremeQueue::push(const PluginStats_samples& samples, index_t index, float value, bool isMax)
+{
+  while (_size > 0) {
+    const uint32_t back = (static_cast<uint32_t>(_head) + _size - 1) % PLUGIN_STATS_NR_ELEMENTS;
+    const float    last = samples[samples.toBufferIndex(_indices[back])];
+
+    if (isMax ? (last > value) : (last < value)) {
+      break;
+    }
+    --_size;
+  }
+  _indices[(static_cast<uint32_t>(_head) + _size) % PLUGIN_STATS_NR_ELEMENTS] = index;
+  ++_size;
+}
+
+void PluginStats_samples::ExtremeQueue::evict(index_t index)
+{
+  if ((_size > 0) && (_indices[_head] == index)) {
+    _head = (static_cast<uint32_t>(_head) + 1) % PLUGIN_STATS_NR_ELEMENTS;
+    --_size;
+  }
+}
+
+PluginStats_samples::PluginStats_samples(float errorValue) :
+  _errorValue(errorValue)
+{
+  _errorValueIsNaN = isnan(_errorValue);
+}
+
+bool PluginStats_samples::push(float value)
+{
+  const bool full = _samples.isFull();
+
+  if (full) {
+    const float oldest = _samples.first();
+
+    if (usableValue(oldest)) {
+      evict(oldest);
+    }
+    _minQueue.evict(_firstIndex);
+    _maxQueue.evict(_firstIndex);
+    ++_firstIndex;
+  }
+  const bool res = _samples.push(value);
+
+  Block& block = _blocks[(_nrPushed / PLUGIN_STATS_BLOCK_SIZE) % nrBlocks];
+
+  if ((_nrPushed % PLUGIN_STATS_BLOCK_SIZE) == 0) {
+    block = Block();
+  }
+  ++_nrPushed;
+
+  if (usableValue(value)) {
+    if (block.count == 0) {
+      block.min = value;
+      block.max = value;
+    } else {
+      if (value < block.min) { block.min = value; }
+
+      if (value > block.max) { block.max = value; }
+    }
+    ++block.count;
+    const float blockDelta = value - block.mean;
+    block.mean += blockDelta / block.count;
+    block.m2   += blockDelta * (value - block.mean);
+
+    ++_count;
+    const double delta = value - _mean;
+    _mean += delta / _count;
+    _m2   += delta * (value - _mean);
+
+    const index_t index = _firstIndex + _samples.size() - 1;
+    _minQueue.push(*this, index, value, false);
+    _maxQueue.push(*this, index, value, true);
+  }
+
+  if (full) {
+    ++_nrEvicted;
+
+    if (_nrEvicted >= PLUGIN_STATS_NR_ELEMENTS) {
+      recompute();
+    }
+  }
+  return res;
+}
+
+void PluginStats_samples::clear()
+{
+  _samples.clear();
+  _count     = 0;
+  _mean      = 0.0;
+  _m2        = 0.0;
+  _nrEvicted = 0;
+  _minQueue.clear();
+  _maxQueue.clear();
+  _firstIndex = 0;
+  _nrPushed   = 0;
+}
+
+bool PluginStats_samples::getSummary(index_t lastNrSamples, Summary& summary, bool withExtremes) const
+{
+  summary = Summary();
+  const index_t nrSamples = _samples.size();
+
+  if (lastNrSamples >= nrSamples) {
+    if (_count == 0) { return false; }
+    summary.count = _count;
+    summary.mean  = _mean;
+    summary.m2    = _m2;
+
+    if (withExtremes) {
+      summary.min = _samples[toBufferIndex(_minQueue.front())];
+      summary.max = _samples[toBufferIndex(_maxQueue.front())];
+    }
+    return true;
+  }
+
+  // Samples up to the first complete block
+  uint32_t sampleNr = _nrPushed - lastNrSamples;
+  index_t  i        = nrSamples - lastNrSamples;
+
+  for (; i < nrSamples && (sampleNr % PLUGIN_STATS_BLOCK_SIZE) != 0; ++i, ++sampleNr) {
+    const float sample(_samples[i]);
+
+    if (usableValue(sample)) {
+      summary.add(sample);
+    }
+  }
+
+  // Remaining blocks, including the last (partial) block
+  for (; sampleNr < _nrPushed; sampleNr += PLUGIN_STATS_BLOCK_SIZE) {
+    const Block& block = _blocks[(sampleNr / PLUGIN_STATS_BLOCK_SIZE) % nrBlocks];
+
+    if (block.count != 0) {
+      Summary blockSummary;
+      blockSummary.count = block.count;
+      blockSummary.mean  = block.mean;
+      blockSummary.m2    = block.m2;
+      blockSummary.min   = block.min;
+      blockSummary.max   = block.max;
+      summary.add(blockSummary);
+    }
+  }
+  return summary.count != 0;
+}
+
+bool PluginStats_samples::usableValue(float value) const
+{
+  if (!isnan(value)) {
+    if (_errorValueIsNaN || !essentiallyEqual(_errorValue, value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PluginStats_samples::evict(float value)
+{
+  if (_count <= 1) {
+    _count = 0;
+    _mean  = 0.0;
+    _m2    = 0.0;
+    return;
+  }
+  const double delta = value - _mean;
+
+  --_count;
+  _mean -= delta / _count;
+  _m2   -= delta * (value - _mean);
+
+  if (_m2 < 0.0) { _m2 = 0.0; }
+}
+
+void PluginStats_samples::recompute()
+{
+  _count     = 0;
+  _mean      = 0.0;
+  _m2        = 0.0;
+  _nrEvicted = 0;
+
+  const index_t nrSamples = _samples.size();
+
+  for (index_t i = 0; i < nrSamples; ++i) {
+    const float sample(_samples[i]);
+
+    if (usableValue(sample)) {
+      ++_count;
+      const double delta = sample - _mean;
+      _mean += delta / _count;
+      _m2   += delta * (sample - _mean);
+    }
+  }
+}
+
+#endif // if FEATURE_PLUGIN_STATS
@@ -0,0 +1,144 @@
+#ifndef HELPERS_PLUGINSTATS_SAMPLES_H
+#define HELPERS_PLUGINSTATS_SAMPLES_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_PLUGIN_STATS
+
+# include "../DataStructs/PluginStats_size.h"
+
+# ifndef PLUGIN_STATS_BLOCK_SIZE
+#  define PLUGIN_STATS_BLOCK_SIZE 16
+# endif // ifndef PLUGIN_STATS_BLOCK_SIZE
+
+/*********************************************************************************************\
+* Sample buffer of PluginStats with incremental statistics
+*
+* Statistics are updated when a sample is pushed or evicted, so they do not need a scan
+* of the sample buffer when used in rules:
+* - Mean and variance over all samples: running mean/M2 (Welford), also removing evicted samples.
+* - Min/max over all samples: monotonic queues of sample indices.
+* - Over the last N samples: per block of PLUGIN_STATS_BLOCK_SIZE samples the count, mean, M2,
+*   min and max are kept and combined.
+*   Only the samples in the (partial) first block of the range need to be visited.
+*
+* Only 'usable' samples are taken into account, e.g. not NaN and not the error value.
+\*********************************************************************************************/
+class PluginStats_samples {
+public:
+
+  typedef CircularBuffer<float, PLUGIN_STATS_NR_ELEMENTS> PluginStatsBuffer_t;
+  typedef PluginStatsBuffer_t::index_t                    index_t;
+
+  struct Summary {
+    void add(float value);
+
+    void add(const Summary& other);
+
+    uint32_t count = 0;
+    double   mean  = 0.0;
+    double   m2    = 0.0;
+    float    min   = 0.0f;
+    float    max   = 0.0f;
+  };
+
+  PluginStats_samples() = delete;
+
+  explicit PluginStats_samples(float errorValue);
+
+  // Returns false when the oldest sample was overwritten
+  bool    push(float value);
+
+  void    clear();
+
+  index_t size() const {
+    return _samples.size();
+  }
+
+  float operator[](index_t index) const {
+    return _samples[index];
+  }
+
+  // Compute the statistics over the last N samples.
+  // Min/max are only computed when 'withExtremes' is set.
+  // Returns false when there is no usable sample.
+  bool getSummary(index_t  lastNrSamples,
+                  Summary& summary,
+                  bool     withExtremes) const;
+
+  bool usableValue(float value) const;
+
+private:
+
+  struct Block {
+    uint8_t count{};
+    float   mean{};
+    float   m2{};
+    float   min{};
+    float   max{};
+  };
+
+  // Monotonic queue of indices of samples, with the front being the min (or max)
+  struct ExtremeQueue {
+    void    clear();
+
+    // Remove indices of samples which will no longer be the extreme when adding 'value'
+    void    push(const PluginStats_samples& samples,
+                 index_t                    index,
+                 float                      value,
+                 bool                       isMax);
+
+    // Remove the front when this is the evicted sample
+    void    evict(index_t index);
+
+    index_t front() const {
+      return _indices[_head];
+    }
+
+    bool    isEmpty() const {
+      return _size == 0;
+    }
+
+    index_t _indices[PLUGIN_STATS_NR_ELEMENTS]{};
+    index_t _head{};
+    index_t _size{};
+  };
+
+  // Index into _samples of a sample index as used in the queues
+  index_t toBufferIndex(index_t index) const {
+    return static_cast<index_t>(index - _firstIndex);
+  }
+
+  // Update the running mean/M2 for the evicted sample
+  void    evict(float value);
+
+  // Recompute the running mean/M2 from the stored samples, to prevent accumulating rounding errors.
+  void    recompute();
+
+  static constexpr uint32_t nrBlocks = (PLUGIN_STATS_NR_ELEMENTS / PLUGIN_STATS_BLOCK_SIZE) + 2;
+
+  PluginStatsBuffer_t _samples;
+
+  // Running statistics over all usable samples in _samples
+  uint32_t _count{};
+  double   _mean{};
+  double   _m2{};
+  uint32_t _nrEvicted{};
+
+  ExtremeQueue _minQueue;
+  ExtremeQueue _maxQueue;
+
+  // Sample index of _samples[0], wraps around and thus only valid modulo the index type range.
+  index_t _firstIndex{};
+
+  // Total nr of samples pushed, to find the block of a sample.
+  uint32_t _nrPushed{};
+
+  Block _blocks[nrBlocks];
+
+  float _errorValue;
+  bool  _errorValueIsNaN;
+};
+
+#endif // if FEATURE_PLUGIN_STATS
+#endif // ifndef HELPERS_PLUGINSTATS_SAMPLES_H
@@ -170,6 +170,17 @@ void PluginTaskData_base::plot_ChartJS_scatter(
   }
 }
 
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+bool PluginTaskData_base::plot_ChartJS_rollup(uint8_t tier, bool onlyJSON) const
+{
+  if (_plugin_stats_array != nullptr) {
+    return _plugin_stats_array->plot_ChartJS_rollup(tier, onlyJSON);
+  }
+  return false;
+}
+
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
 # endif // if FEATURE_CHART_JS
 
 
@@ -70,6 +70,11 @@ struct PluginTaskData_base {
     const String                & options     = EMPTY_STRING,
     bool                          onlyJSON    = false) const;
 
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+  bool plot_ChartJS_rollup(uint8_t tier,
+                           bool    onlyJSON = false) const;
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
+
 # endif // if FEATURE_CHART_JS
 #endif  // if FEATURE_PLUGIN_STATS
 
@@ -7,5 +7,14 @@ ProtocolStruct::ProtocolStruct() :
     usesExtCreds(false), needsNetwork(true), allowsExpire(true), allowLocalSystemTime(false)
   #if FEATURE_MQTT_TLS
   , usesTLS(false)
+  #endif
+  #if FEATURE_MQTT
+  , allowsSendJSON(false)
+  #endif
+  #ifdef USES_C013
+  , allowsP2PBatch(false)
+  #endif
+  #ifdef USES_C016
+  , usesCacheCompression(false)
   #endif
     {}
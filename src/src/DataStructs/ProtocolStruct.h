@@ -42,6 +42,15 @@ struct ProtocolStruct
 #if FEATURE_MQTT_TLS
   bool     usesTLS              : 1; // May offer TLS related settings and options
 #endif
+#if FEATURE_MQTT
+  bool     allowsSendJSON       : 1; // MQTT controller may publish all values of a task as a single JSON message
+#endif
+#ifdef USES_C013
+  bool     allowsP2PBatch       : 1; // p2p controller may combine task values sent within a time window in a single message
+#endif
+#ifdef USES_C016
+  bool     usesCacheCompression : 1; // Cache controller may compress its cache files
+#endif
 
 //  uint8_t Number{};
 };
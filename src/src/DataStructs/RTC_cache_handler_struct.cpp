@@ -144,7 +144,7 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
 
     if (fname.isEmpty()) { return; }
 
-    fp = tryOpenFile(fname, "r");
+    fp.open(fname);
   }
 
   if (fp) {
@@ -273,7 +273,21 @@ bool RTC_cache_handler_struct::flush() {
         fp.close();
       }
 
-      int bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      const size_t nrSamples = RTC_cache.writePos / sizeof(ControllerCacheRecord);
+      int bytesToWrite       = RTC_cache.writePos;
+      int bytesWritten       = 0;
+
+      if (_writeCompressed && (nrSamples > 0)) {
+        // Only complete samples can be encoded, the cache controller only writes complete samples.
+        std::vector<uint8_t> frame;
+
+        if (ControllerCacheCodec::encodeFrame(&RTC_cache_data[0], nrSamples, frame)) {
+          bytesToWrite = frame.size();
+          bytesWritten = fw.write(&frame[0], frame.size());
+        }
+      } else {
+        bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      }
 
       delay(0);
       fw.flush();
@@ -281,8 +295,13 @@ bool RTC_cache_handler_struct::flush() {
       addLog(LOG_LEVEL_INFO, F("RTC  : flush RTC cache"));
         #endif // ifdef RTC_STRUCT_DEBUG
 
+      if (bytesWritten >= bytesToWrite) {
+        _compressionStats.samples     += nrSamples;
+        _compressionStats.rawBytes    += RTC_cache.writePos;
+        _compressionStats.storedBytes += bytesWritten;
+      }
 
-      if ((bytesWritten < RTC_cache.writePos) /*|| (fw.size() == filesize)*/) {
+      if ((bytesWritten < bytesToWrite) /*|| (fw.size() == filesize)*/) {
           #ifdef RTC_STRUCT_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -390,6 +409,7 @@ bool RTC_cache_handler_struct::deleteAllCacheBlocks()
         String fname = createCacheFilename(fileNr);
 
         if (tryDeleteFile(fname)) {
+          tryDeleteFile(createCacheIndexFilename(fileNr));
           ++count;
           fileDeleted = true;
           #ifdef RTC_STRUCT_DEBUG
@@ -432,6 +452,7 @@ bool RTC_cache_handler_struct::deleteCacheBlock(int fileNr)
       }
 
       if (tryDeleteFile(fname)) {
+        tryDeleteFile(createCacheIndexFilename(RTC_cache.readFileNr));
         fileDeleted = true;
         #ifdef RTC_STRUCT_DEBUG
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -621,6 +642,19 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
       String fname = createCacheFilename(RTC_cache.writeFileNr);
       fw = tryOpenFile(fname, "a+");
 
+      if (fw) {
+        if (fw.size() == 0) {
+          _writeCompressed = _compress;
+
+          if (_writeCompressed) {
+            fw.write(ControllerCacheCodec::getFileHeader(), CONTROLLER_CACHE_FILE_HEADER_SIZE);
+          }
+        } else {
+          // Keep appending in the format of the existing file
+          _writeCompressed = ControllerCacheFile::isCompressedFile(fname);
+        }
+      }
+
       if (!fw) {
           #ifdef RTC_STRUCT_DEBUG
         addLog(LOG_LEVEL_ERROR, F("RTC  : error opening file"));
@@ -7,6 +7,7 @@
 
 #if FEATURE_RTC_CACHE_STORAGE
 
+#include "../DataStructs/ControllerCacheFile.h"
 #include "../DataStructs/RTCCacheStruct.h"
 
 #include <FS.h>
@@ -29,6 +30,13 @@
 
 // #define RTC_STRUCT_DEBUG
 
+// Statistics of the samples flushed to the cache files since boot
+struct ControllerCacheCompressionStats {
+  uint32_t samples     = 0; // Nr. of samples written to the cache files
+  uint32_t rawBytes    = 0; // Size of these samples when not compressed
+  uint32_t storedBytes = 0; // Nr. of bytes written to the cache files
+};
+
 /********************************************************************************************\
    RTC located cache
  \*********************************************************************************************/
@@ -75,6 +83,20 @@ struct RTC_cache_handler_struct
   // When trying to access cache files, like deleting them, these files must be closed first.
   void   closeOpenFiles();
 
+  // Compress new cache files, see ControllerCacheCodec.
+  // An existing cache file keeps its format until a new file is started.
+  void   setCompression(bool compress) {
+    _compress = compress;
+  }
+
+  bool   getCompression() const {
+    return _compress;
+  }
+
+  const ControllerCacheCompressionStats& getCompressionStats() const {
+    return _compressionStats;
+  }
+
 private:
 
   bool     loadMetaData();
@@ -110,12 +132,16 @@ private:
 #endif // ifdef ESP8266
   fs::File fw;  // File handler Write
   fs::File fr;  // File handler Read
-  fs::File fp;  // File handler Peek
+  ControllerCacheFile fp;  // File handler Peek
   size_t   _peekfilenr  = 0;
   size_t   _peekreadpos = 0;
 
+  ControllerCacheCompressionStats _compressionStats;
+
   uint8_t storageLocation = CACHE_STORAGE_SPIFFS;
   bool    writeError      = false;
+  bool    _compress       = false;
+  bool    _writeCompressed = false; // Format of the file opened for writing
 };
 
 #endif
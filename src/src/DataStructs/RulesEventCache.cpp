@@ -1,6 +1,7 @@
 #include "../DataStructs/RulesEventCache.h"
 
 #include "../DataStructs/TimingStats.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/RulesMatcher.h"
 #include "../Helpers/StringConverter.h"
 
@@ -21,9 +22,84 @@ RulesEventCache_element::RulesEventCache_element(
 }
 
 
+void RulesEventCache_stats::clear()
+{
+  lookups    = 0;
+  hits       = 0;
+  misses     = 0;
+  candidates = 0;
+}
+
+float RulesEventCache_stats::getAvgCandidates() const
+{
+  if (lookups == 0) { return 0.0f; }
+  return static_cast<float>(candidates) / static_cast<float>(lookups);
+}
+
+RulesEventKey_e getRulesEventKey(const String& str, bool isRule, uint32_t& key)
+{
+  // Skip leading and trailing spaces, as ruleMatch() does trim both event and rule.
+  int start = 0;
+  int end   = str.length();
+
+  while (start < end && isspace(str[start])) { ++start; }
+
+  if (start < end && str[start] == '!') {
+    // Literal string event or rule, matched using a prefix match.
+    return RulesEventKey_e::Generic;
+  }
+
+  for (int i = start; i < end; ++i) {
+    const char c = str[i];
+
+    if (isRule) {
+      switch (c) {
+        case '*': // Wildcard
+        case '%': // System variable or standard conversion
+        case '[': // Task value
+        case '{': // Formatting
+          return RulesEventKey_e::Generic;
+        case '=':
+        case '<':
+        case '>':
+          end = i;
+          break;
+        case '!':
+
+          if (((i + 1) < end) && (str[i + 1] == '=')) {
+            end = i;
+          }
+          break;
+      }
+    } else {
+      if (c == '=') {
+        end = i;
+      } else if ((c == '<') || (c == '>') || (c == '!')) {
+        // Event name may be matched against a compare condition in a rule
+        return RulesEventKey_e::None;
+      }
+    }
+  }
+
+  while (end > start && isspace(str[end - 1])) { --end; }
+
+  if (end == start) {
+    // Compare condition at the start of a rule is not recognized by findCompareCondition()
+    return isRule ? RulesEventKey_e::Generic : RulesEventKey_e::None;
+  }
+
+  String name = str.substring(start, end);
+
+  name.toLowerCase();
+  key = calc_CRC32(reinterpret_cast<const uint8_t *>(name.c_str()), name.length());
+  return RulesEventKey_e::Keyed;
+}
+
 void RulesEventCache::clear()
 {
   _eventCache.clear();
+  _eventIndex.clear();
+  _genericRules.clear();
   _initialized = false;
 }
 
@@ -42,6 +118,15 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
     HeapSelectDram ephemeral;
     # endif // ifdef USE_SECOND_HEAP
 
+    const uint16_t index = _eventCache.size();
+    uint32_t key{};
+
+    if (getRulesEventKey(event, true, key) == RulesEventKey_e::Keyed) {
+      _eventIndex[key].push_back(index);
+    } else {
+      _genericRules.push_back(index);
+    }
+
     _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
@@ -50,49 +135,69 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
 
 RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
-
-  // FIXME TD-er: Disable optimize as it has some side effects.
+  // N.B. 'optimize' is no longer used.
+  // Reordering rules based on the number of matches did have side effects.
   // For example, matching a specific event first and then a more generic one is perfectly normal to do.
-  // But this optimization will then put the generic one in front as it will be matched more often.
+  // But the reordering would then put the generic one in front as it will be matched more often.
   // Thus it will never match the more specific one anymore.
+  // Instead the candidates are looked up via the event name, keeping the order as in the rules files.
+  ++_stats.lookups;
+
+  uint32_t key{};
+  const RulesEventKey_e keyType = getRulesEventKey(event, false, key);
+
+  if (keyType == RulesEventKey_e::None) {
+    // Check all rules
+    for (auto it = _eventCache.cbegin(); it != _eventCache.cend(); ++it) {
+      ++_stats.candidates;
+      START_TIMER
+      const bool match = ruleMatch(event, it->_event);
+      STOP_TIMER(RULES_MATCH);
+
+      if (match) {
+        ++_stats.hits;
+        return it;
+      }
+    }
+    ++_stats.misses;
+    return _eventCache.cend();
+  }
+
+  const RulesEventCache_indexList *keyed = nullptr;
 
+  if (keyType == RulesEventKey_e::Keyed) {
+    auto it = _eventIndex.find(key);
 
-  for (; it != _eventCache.end(); ++it)
-  {
+    if (it != _eventIndex.end()) {
+      keyed = &(it->second);
+    }
+  }
+
+  // Merge both sorted lists, to check the candidates in file order.
+  size_t k = 0;
+  size_t g = 0;
+  const size_t nrKeyed   = keyed == nullptr ? 0 : keyed->size();
+  const size_t nrGeneric = _genericRules.size();
+
+  while (k < nrKeyed || g < nrGeneric) {
+    uint16_t index;
+
+    if ((g >= nrGeneric) || ((k < nrKeyed) && ((*keyed)[k] < _genericRules[g]))) {
+      index = (*keyed)[k++];
+    } else {
+      index = _genericRules[g++];
+    }
+
+    ++_stats.candidates;
     START_TIMER
-    const bool match = ruleMatch(event, it->_event);
+    const bool match = ruleMatch(event, _eventCache[index]._event);
     STOP_TIMER(RULES_MATCH);
 
     if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
-    }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
-      }
+      ++_stats.hits;
+      return _eventCache.cbegin() + index;
     }
-    */
   }
-  return it;
+  ++_stats.misses;
+  return _eventCache.cend();
 }
@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
 struct RulesEventCache_element {
@@ -20,6 +21,37 @@ struct RulesEventCache_element {
 
 typedef std::vector<RulesEventCache_element> RulesEventCache_vector;
 
+// Indices in the RulesEventCache_vector, sorted in file order.
+typedef std::vector<uint16_t> RulesEventCache_indexList;
+
+// Key is a hash of the normalized event name (part before '=' or compare operator)
+// Hash collisions only result in more candidates to check.
+typedef std::map<uint32_t, RulesEventCache_indexList> RulesEventCache_index;
+
+struct RulesEventCache_stats {
+  void     clear();
+
+  float    getAvgCandidates() const;
+
+  uint32_t lookups    = 0;
+  uint32_t hits       = 0;
+  uint32_t misses     = 0;
+  uint32_t candidates = 0; // Nr of rules checked using ruleMatch()
+};
+
+enum class RulesEventKey_e : uint8_t {
+  Keyed,   // Key can be used to look up candidates
+  Generic, // Literal string event ("!..."), only generic rules can match
+  None     // Cannot determine a key, must check all rules
+};
+
+// Compute the lookup key of an event or the event part of a rule.
+// Rules using a wildcard, template notation or literal string match ('!') can
+// only be matched by calling ruleMatch() and are thus considered 'Generic'.
+RulesEventKey_e getRulesEventKey(const String& str,
+                                 bool          isRule,
+                                 uint32_t    & key);
+
 class RulesEventCache {
 public:
 
@@ -37,15 +69,36 @@ public:
                const String& filename,
                size_t        pos);
 
+  // Return the first matching rule in file order.
+  // Only rules with the same event name and the 'generic' rules are checked.
   RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
 
+  RulesEventCache_vector::const_iterator begin() const {
+    return _eventCache.begin();
+  }
+
   RulesEventCache_vector::const_iterator end() const {
     return _eventCache.end();
   }
 
+  size_t size() const {
+    return _eventCache.size();
+  }
+
+  const RulesEventCache_stats& getStats() const {
+    return _stats;
+  }
+
+  void resetStats() {
+    _stats.clear();
+  }
+
 private:
 
   RulesEventCache_vector _eventCache;
+  RulesEventCache_index _eventIndex;
+  RulesEventCache_indexList _genericRules;
+  RulesEventCache_stats _stats;
   bool _initialized = false;
 };
 
@@ -0,0 +1,488 @@
+#include "../DataStructs/RulesProgram.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include "../ESPEasyCore/ESPEasyRules.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/Plugins_other.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+
+
+/********************************************************************************************\
+   RulesProgram_segment
+ \*********************************************************************************************/
+RulesProgram_segment::RulesProgram_segment(
+  Type          type,
+  const String& text,
+  uint8_t       argNr,
+  uint8_t       defaultPos)
+  : text(text), type(type), argNr(argNr), defaultPos(defaultPos)
+{}
+
+String RulesProgram_segment::getDefaultValue() const
+{
+  if ((defaultPos == 0) || (defaultPos >= text.length())) {
+    return String('0');
+  }
+
+  // Strip the trailing '%'
+  return text.substring(defaultPos, text.length() - 1);
+}
+
+/********************************************************************************************\
+   RulesProgram_line
+ \*********************************************************************************************/
+String RulesProgram_line::getRawText() const
+{
+  if (segments.size() == 1) {
+    return segments[0].text;
+  }
+  String res;
+  size_t expectedSize = 0;
+
+  for (auto it = segments.begin(); it != segments.end(); ++it) {
+    expectedSize += it->text.length();
+  }
+  res.reserve(expectedSize);
+
+  for (auto it = segments.begin(); it != segments.end(); ++it) {
+    res += it->text;
+  }
+  return res;
+}
+
+/********************************************************************************************\
+   Split a line into literal text and references to the event.
+   Return the line flags.
+ \*********************************************************************************************/
+uint8_t compileRulesSegments(const String& text, std::vector<RulesProgram_segment>& segments)
+{
+  uint8_t flags = 0;
+  int     pos   = 0;
+  int     event_pos = text.indexOf(F("%event"));
+
+  while (event_pos != -1) {
+    RulesProgram_segment::Type type = RulesProgram_segment::Type::Literal;
+    int     end_pos    = -1;
+    uint8_t argNr      = 0;
+    uint8_t defaultPos = 0;
+
+    if (text.startsWith(F("%eventname%"), event_pos)) {
+      type    = RulesProgram_segment::Type::EventName;
+      end_pos = event_pos + 11;
+    } else if (text.startsWith(F("%eventpar%"), event_pos)) {
+      type    = RulesProgram_segment::Type::EventPar;
+      end_pos = event_pos + 10;
+    } else if (text.startsWith(F("%eventvalue"), event_pos)) {
+      const int percent_pos = text.indexOf('%', event_pos + 1);
+
+      if ((percent_pos == -1) || ((percent_pos - event_pos) > 255)) {
+        // Syntax error, or too long to store the position of the default value.
+        // Let substitute_eventvalue() deal with it at runtime.
+        flags |= RULES_PROGRAM_LINE_LEGACY_SUBST;
+        break;
+      }
+      int or_else_pos = text.indexOf('|', event_pos);
+
+      if ((or_else_pos == -1) || (or_else_pos > percent_pos)) {
+        or_else_pos = percent_pos;
+      } else {
+        defaultPos = or_else_pos + 1 - event_pos;
+      }
+      const String nr = text.substring(event_pos + 11, or_else_pos);
+
+      if (nr.isEmpty()) {
+        if (defaultPos != 0) {
+          // %eventvalue|Y% is not the same as %eventvalue1|Y%,
+          // substitute_eventvalue() removes it as invalid variable.
+          flags |= RULES_PROGRAM_LINE_LEGACY_SUBST;
+          break;
+        }
+
+        // %eventvalue% is the same as %eventvalue1%
+        type  = RulesProgram_segment::Type::EventValue;
+        argNr = 1;
+      } else if (equals(nr, '0')) {
+        type = RulesProgram_segment::Type::EventValueAll;
+      } else {
+        const int argc = nr.toInt();
+
+        if ((argc <= 0) || (argc > 255)) {
+          flags |= RULES_PROGRAM_LINE_LEGACY_SUBST;
+          break;
+        }
+        type  = RulesProgram_segment::Type::EventValue;
+        argNr = argc;
+      }
+      end_pos = percent_pos + 1;
+    }
+
+    if (type == RulesProgram_segment::Type::Literal) {
+      // Something like "%eventfoo", not an event reference
+      event_pos = text.indexOf(F("%event"), event_pos + 1);
+    } else {
+      if (event_pos > pos) {
+        segments.emplace_back(RulesProgram_segment::Type::Literal, text.substring(pos, event_pos));
+      }
+      segments.emplace_back(type, text.substring(event_pos, end_pos), argNr, defaultPos);
+      flags    |= RULES_PROGRAM_LINE_HAS_EVENT_REF;
+      pos       = end_pos;
+      event_pos = text.indexOf(F("%event"), pos);
+    }
+  }
+
+  if (flags & RULES_PROGRAM_LINE_LEGACY_SUBST) {
+    // Keep the complete line as-is
+    segments.clear();
+    segments.emplace_back(RulesProgram_segment::Type::Literal, text);
+    return RULES_PROGRAM_LINE_LEGACY_SUBST;
+  }
+
+  if ((pos < static_cast<int>(text.length())) || segments.empty()) {
+    segments.emplace_back(RulesProgram_segment::Type::Literal, text.substring(pos));
+  }
+  return flags;
+}
+
+/********************************************************************************************\
+   RulesProgram_block
+ \*********************************************************************************************/
+bool RulesProgram_block::addLine(const String& line)
+{
+  if (_error) { return false; }
+
+  if (lines.size() >= 0xFFFF) {
+    _error = true;
+    return false;
+  }
+  const uint16_t index = lines.size();
+
+  RulesProgram_line progLine;
+  String lcLine = line;
+
+  lcLine.toLowerCase();
+
+  String text;
+
+  if (lcLine.startsWith(F("elseif "))) {
+    progLine.opcode = RulesProgram_opcode::ElseIf;
+    text            = line.substring(7);
+  } else if (lcLine.startsWith(F("if "))) {
+    progLine.opcode = RulesProgram_opcode::If;
+    text            = line.substring(3);
+  } else if (equals(lcLine, F("else"))) {
+    progLine.opcode = RulesProgram_opcode::Else;
+  } else if (equals(lcLine, F("endif"))) {
+    progLine.opcode = RulesProgram_opcode::EndIf;
+  } else if (lcLine.startsWith(F("on "))) {
+    // New "on" while the previous block did not end with "endon".
+    // The text based rules engine handles this (odd) construct.
+    _error = true;
+    return false;
+  } else {
+    progLine.opcode = RulesProgram_opcode::Action;
+
+    if (line.startsWith(F("%event"))) {
+      text = concat(F("restrict,"), line);
+
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        addLogMove(LOG_LEVEL_ERROR,
+                   concat(F("Rules : Prefix command with 'restrict': "), text));
+      }
+    } else {
+      text = line;
+    }
+  }
+  text.trim();
+
+  switch (progLine.opcode) {
+    case RulesProgram_opcode::If:
+    {
+      if (_openIfs.size() >= RULES_IF_MAX_NESTING_LEVEL) {
+        progLine.flags |= RULES_PROGRAM_LINE_IF_OVERFLOW;
+      }
+      OpenIf openIf;
+      openIf.lastClause = index;
+      openIf.pendingEnd.push_back(index);
+      _openIfs.push_back(std::move(openIf));
+      break;
+    }
+    case RulesProgram_opcode::ElseIf:
+    case RulesProgram_opcode::Else:
+    {
+      if (_openIfs.empty() ||
+          (lines[_openIfs.back().lastClause].opcode == RulesProgram_opcode::Else)) {
+        _error = true;
+        return false;
+      }
+      OpenIf& openIf = _openIfs.back();
+      lines[openIf.lastClause].jumpTarget = index;
+      openIf.lastClause                   = index;
+      openIf.pendingEnd.push_back(index);
+      break;
+    }
+    case RulesProgram_opcode::EndIf:
+    {
+      if (_openIfs.empty()) {
+        _error = true;
+        return false;
+      }
+      const OpenIf& openIf = _openIfs.back();
+
+      if (lines[openIf.lastClause].opcode != RulesProgram_opcode::Else) {
+        lines[openIf.lastClause].jumpTarget = index;
+      }
+
+      for (auto it = openIf.pendingEnd.begin(); it != openIf.pendingEnd.end(); ++it) {
+        lines[*it].endTarget = index;
+      }
+      _openIfs.pop_back();
+      break;
+    }
+    case RulesProgram_opcode::Action:
+      break;
+  }
+
+  if (!text.isEmpty()) {
+    progLine.flags |= compileRulesSegments(text, progLine.segments);
+  }
+  lines.push_back(std::move(progLine));
+  return true;
+}
+
+bool RulesProgram_block::finalize()
+{
+  const bool res = !_error && _openIfs.empty() && !lines.empty();
+
+  _openIfs.clear();
+  lines.shrink_to_fit();
+  return res;
+}
+
+bool RulesProgram_block::hasEventReference() const
+{
+  for (auto it = lines.begin(); it != lines.end(); ++it) {
+    if (it->flags & (RULES_PROGRAM_LINE_HAS_EVENT_REF | RULES_PROGRAM_LINE_LEGACY_SUBST)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/********************************************************************************************\
+   Binary format (native byte order):
+   uint32_t size of the block (excluding this field)
+   uint16_t nr lines
+   Per line:
+     uint8_t  opcode
+     uint8_t  flags
+     uint16_t jumpTarget
+     uint16_t endTarget
+     uint8_t  nr segments
+     Per segment:
+       uint8_t  type
+       uint8_t  argNr
+       uint8_t  defaultPos
+       uint16_t text length
+       text (not 0-terminated)
+ \*********************************************************************************************/
+template<typename T>
+void rulesProgram_append(std::vector<uint8_t>& buffer, T value)
+{
+  const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&value);
+
+  buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+}
+
+template<typename T>
+bool rulesProgram_extract(const std::vector<uint8_t>& buffer, size_t& pos, T& value)
+{
+  if ((pos + sizeof(T)) > buffer.size()) {
+    return false;
+  }
+  memcpy(&value, &buffer[pos], sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+size_t RulesProgram_block::serialize(fs::File& f) const
+{
+  std::vector<uint8_t> buffer;
+
+  rulesProgram_append<uint32_t>(buffer, 0); // Placeholder for size
+  rulesProgram_append<uint16_t>(buffer, lines.size());
+
+  for (auto line = lines.begin(); line != lines.end(); ++line) {
+    rulesProgram_append<uint8_t>(buffer, static_cast<uint8_t>(line->opcode));
+    rulesProgram_append<uint8_t>(buffer, line->flags);
+    rulesProgram_append<uint16_t>(buffer, line->jumpTarget);
+    rulesProgram_append<uint16_t>(buffer, line->endTarget);
+    rulesProgram_append<uint8_t>(buffer, line->segments.size());
+
+    for (auto seg = line->segments.begin(); seg != line->segments.end(); ++seg) {
+      rulesProgram_append<uint8_t>(buffer, static_cast<uint8_t>(seg->type));
+      rulesProgram_append<uint8_t>(buffer, seg->argNr);
+      rulesProgram_append<uint8_t>(buffer, seg->defaultPos);
+      rulesProgram_append<uint16_t>(buffer, seg->text.length());
+      const uint8_t *text = reinterpret_cast<const uint8_t *>(seg->text.c_str());
+      buffer.insert(buffer.end(), text, text + seg->text.length());
+    }
+  }
+  const uint32_t size = buffer.size() - sizeof(uint32_t);
+
+  memcpy(&buffer[0], &size, sizeof(uint32_t));
+
+  if (f.write(&buffer[0], buffer.size()) != buffer.size()) {
+    return 0;
+  }
+  return buffer.size();
+}
+
+bool RulesProgram_block::deserialize(fs::File& f)
+{
+  lines.clear();
+  uint32_t size = 0;
+
+  if (f.read(reinterpret_cast<uint8_t *>(&size), sizeof(size)) != sizeof(size)) {
+    return false;
+  }
+  std::vector<uint8_t> buffer;
+
+  buffer.resize(size);
+
+  if ((size == 0) || (f.read(&buffer[0], size) != size)) {
+    return false;
+  }
+  size_t   pos     = 0;
+  uint16_t nrLines = 0;
+
+  if (!rulesProgram_extract(buffer, pos, nrLines)) { return false; }
+  lines.resize(nrLines);
+
+  for (auto line = lines.begin(); line != lines.end(); ++line) {
+    uint8_t opcode{};
+    uint8_t nrSegments{};
+
+    if (!rulesProgram_extract(buffer, pos, opcode) ||
+        !rulesProgram_extract(buffer, pos, line->flags) ||
+        !rulesProgram_extract(buffer, pos, line->jumpTarget) ||
+        !rulesProgram_extract(buffer, pos, line->endTarget) ||
+        !rulesProgram_extract(buffer, pos, nrSegments)) {
+      return false;
+    }
+    line->opcode = static_cast<RulesProgram_opcode>(opcode);
+    line->segments.resize(nrSegments);
+
+    for (auto seg = line->segments.begin(); seg != line->segments.end(); ++seg) {
+      uint8_t  type{};
+      uint16_t length{};
+
+      if (!rulesProgram_extract(buffer, pos, type) ||
+          !rulesProgram_extract(buffer, pos, seg->argNr) ||
+          !rulesProgram_extract(buffer, pos, seg->defaultPos) ||
+          !rulesProgram_extract(buffer, pos, length) ||
+          ((pos + length) > buffer.size())) {
+        return false;
+      }
+      seg->type = static_cast<RulesProgram_segment::Type>(type);
+      seg->text.concat(reinterpret_cast<const char *>(&buffer[pos]), length);
+      pos += length;
+    }
+  }
+  return pos == buffer.size();
+}
+
+/********************************************************************************************\
+   RulesProgram_eventData
+ \*********************************************************************************************/
+RulesProgram_eventData::RulesProgram_eventData(const String& event)
+  : event(event)
+{
+  const int equalsPos = event.indexOf('=');
+
+  if (equalsPos == -1) {
+    eventName = event;
+  } else {
+    eventName = event.substring(0, equalsPos);
+
+    if (equalsPos > 0) {
+      argString = event.substring(equalsPos + 1);
+    }
+  }
+  const int hash_pos = eventName.indexOf('#');
+
+  if (hash_pos != -1) {
+    eventPar = eventName.substring(hash_pos + 1);
+  }
+}
+
+void RulesProgram_eventData::splitArguments()
+{
+  _argsSplit = true;
+  String tmpParam;
+
+  for (unsigned int argc = 1; GetArgv(argString.c_str(), tmpParam, argc); ++argc) {
+    _args.push_back(tmpParam);
+  }
+}
+
+String RulesProgram_eventData::render(const RulesProgram_line& line)
+{
+  if ((substitute_eventvalue_CallBack_ptr != nullptr) ||
+      line.hasFlag(RULES_PROGRAM_LINE_LEGACY_SUBST) ||
+      (line.hasFlag(RULES_PROGRAM_LINE_HAS_EVENT_REF) && (event.charAt(0) == '!'))) {
+    // Literal string events and plugin specific substitutions
+    // are handled by the text based substitution.
+    String res = line.getRawText();
+    substitute_eventvalue(res, event);
+    return res;
+  }
+
+  if (!line.hasFlag(RULES_PROGRAM_LINE_HAS_EVENT_REF)) {
+    return line.getRawText();
+  }
+
+  String res;
+  size_t expectedSize = 0;
+
+  for (auto it = line.segments.begin(); it != line.segments.end(); ++it) {
+    expectedSize += it->text.length();
+  }
+  res.reserve(expectedSize);
+
+  for (auto it = line.segments.begin(); it != line.segments.end(); ++it) {
+    switch (it->type) {
+      case RulesProgram_segment::Type::Literal:
+        res += it->text;
+        break;
+      case RulesProgram_segment::Type::EventValue:
+      {
+        if (!_argsSplit) {
+          splitArguments();
+        }
+
+        if (it->argNr <= _args.size()) {
+          res += _args[it->argNr - 1];
+        } else {
+          // Replace with default value for non existing event values
+          String defaultValue = it->getDefaultValue();
+          res += parseTemplate(defaultValue);
+        }
+        break;
+      }
+      case RulesProgram_segment::Type::EventValueAll:
+        res += argString;
+        break;
+      case RulesProgram_segment::Type::EventName:
+        res += eventName;
+        break;
+      case RulesProgram_segment::Type::EventPar:
+        res += eventPar;
+        break;
+    }
+  }
+  return res;
+}
+
+#endif // if FEATURE_RULES_COMPILER
@@ -0,0 +1,150 @@
+#ifndef DATASTRUCTS_RULESPROGRAM_H
+#define DATASTRUCTS_RULESPROGRAM_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include <FS.h>
+# include <memory>
+# include <vector>
+
+/*********************************************************************************************\
+* RulesProgram
+*
+* Compiled representation of a single "on ... do ... endon" rules block.
+* - Every line is classified once (action, if, elseif, else, endif)
+* - Jump targets for if/elseif/else/endif are resolved at compile time,
+*   so lines in a branch which is not taken are never parsed.
+* - References to the event (%eventvalueN%, %eventname%, %eventpar%)
+*   are stored as slots, so they can be filled in without searching the line.
+\*********************************************************************************************/
+
+// Part of a compiled rules line.
+struct RulesProgram_segment {
+  enum class Type : uint8_t {
+    Literal,       // Plain text
+    EventValue,    // %eventvalueN% or %eventvalueN|default%
+    EventValueAll, // %eventvalue0%
+    EventName,     // %eventname%
+    EventPar       // %eventpar%
+
+  };
+
+  RulesProgram_segment() = default;
+
+  RulesProgram_segment(Type          type,
+                       const String& text,
+                       uint8_t       argNr      = 0,
+                       uint8_t       defaultPos = 0);
+
+  // Default value for a non existing event value.
+  // Returns "0" when no default was given.
+  String getDefaultValue() const;
+
+  // The original text, also for event references.
+  // Used when the event must be substituted using the text based substitution.
+  String  text;
+  Type    type  = Type::Literal;
+  uint8_t argNr = 0;
+
+  // Position in text of the default value of an event value (0 = not set)
+  uint8_t defaultPos = 0;
+};
+
+
+enum class RulesProgram_opcode : uint8_t {
+  Action,
+  If,
+  ElseIf,
+  Else,
+  EndIf
+
+};
+
+# define RULES_PROGRAM_LINE_HAS_EVENT_REF   0x01 // At least one segment is an event reference
+# define RULES_PROGRAM_LINE_LEGACY_SUBST    0x02 // Use substitute_eventvalue() on the raw line
+# define RULES_PROGRAM_LINE_IF_OVERFLOW     0x04 // if-statement exceeds RULES_IF_MAX_NESTING_LEVEL
+
+
+struct RulesProgram_line {
+  // Render the raw line text, without substituting any event reference.
+  String getRawText() const;
+
+  bool   hasFlag(uint8_t flag) const {
+    return (flags & flag) != 0;
+  }
+
+  // Action: the command
+  // If/ElseIf: the condition
+  std::vector<RulesProgram_segment>segments;
+
+  // If/ElseIf: Line index of next elseif/else/endif when condition is false
+  uint16_t jumpTarget = 0;
+
+  // If/ElseIf/Else: Line index of the matching endif
+  uint16_t endTarget = 0;
+
+  RulesProgram_opcode opcode = RulesProgram_opcode::Action;
+  uint8_t             flags  = 0;
+};
+
+
+struct RulesProgram_block {
+  // Parse a single (trimmed, comment stripped) rules line and add it to the block.
+  // Return false when the line cannot be compiled.
+  bool   addLine(const String& line);
+
+  // Resolve the jump targets of if/elseif/else/endif.
+  // Return false when the if/endif structure is not balanced.
+  bool   finalize();
+
+  bool   hasEventReference() const;
+
+  // Serialize to a (binary) file, return nr of bytes written.
+  // Return 0 when not all data could be written.
+  size_t serialize(fs::File& f) const;
+
+  bool   deserialize(fs::File& f);
+
+  std::vector<RulesProgram_line>lines;
+
+private:
+
+  struct OpenIf {
+    uint16_t              lastClause;
+    std::vector<uint16_t> pendingEnd;
+  };
+
+  // Only used during compilation
+  std::vector<OpenIf>_openIfs;
+  bool _error = false;
+};
+
+typedef std::shared_ptr<const RulesProgram_block> RulesProgram_block_ptr;
+
+
+// Event split into its parts, so each %eventvalueN% reference only needs a lookup.
+struct RulesProgram_eventData {
+  explicit RulesProgram_eventData(const String& event);
+
+  // Fill in the event references of the line
+  String render(const RulesProgram_line& line);
+
+  const String& event;
+  String        eventName;
+  String        eventPar;
+  String        argString;
+
+private:
+
+  void                splitArguments();
+
+  std::vector<String> _args;
+  bool                _argsSplit = false;
+};
+
+
+#endif // if FEATURE_RULES_COMPILER
+
+#endif // ifndef DATASTRUCTS_RULESPROGRAM_H
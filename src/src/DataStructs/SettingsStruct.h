@@ -8,6 +8,7 @@
 #include "../DataStructs/ChecksumType.h"
 #include "../DataStructs/DeviceStruct.h"
 #include "../DataTypes/EthernetParameters.h"
+#include "../DataTypes/EventQueueOverflowPolicy.h"
 #include "../DataTypes/NetworkMedium.h"
 #include "../DataTypes/NPluginID.h"
 #include "../DataTypes/PluginID.h"
@@ -212,6 +213,14 @@ class SettingsStruct_tmpl
   void DisableSaveConfigAsTar(bool value) { VariousBits_2.DisableSaveConfigAsTar = value; }
   #endif // if FEATURE_TARSTREAM_SUPPORT
 
+  // What to do when the rules event queue is full.
+  EventQueueOverflowPolicy_e EventQueueOverflowPolicy() const { return static_cast<EventQueueOverflowPolicy_e>(VariousBits_2.EventQueueOverflowPolicy); }
+  void EventQueueOverflowPolicy(EventQueueOverflowPolicy_e value) { VariousBits_2.EventQueueOverflowPolicy = static_cast<uint8_t>(value); }
+
+  // Send several syslog lines in a single datagram
+  bool SyslogCombineLines() const { return VariousBits_2.SyslogCombineLines; }
+  void SyslogCombineLines(bool value) { VariousBits_2.SyslogCombineLines = value; }
+
   // Flag indicating whether all task values should be sent in a single event or one event per task value (default behavior)
   bool CombineTaskValues_SingleEvent(taskIndex_t taskIndex) const;
   void CombineTaskValues_SingleEvent(taskIndex_t taskIndex, bool value);
@@ -535,9 +544,8 @@ public:
     uint32_t EnableIPv6                       : 1; // Bit 04  // inverted
     uint32_t DisableSaveConfigAsTar           : 1; // Bit 05
     uint32_t PassiveWiFiScan                  : 1; // Bit 06  // inverted
-    uint32_t unused_07                        : 1; // Bit 07
-    uint32_t unused_08                        : 1; // Bit 08
-    uint32_t unused_09                        : 1; // Bit 09
+    uint32_t EventQueueOverflowPolicy         : 2; // Bit 07 & 08
+    uint32_t SyslogCombineLines               : 1; // Bit 09
     uint32_t unused_10                        : 1; // Bit 10
     uint32_t unused_11                        : 1; // Bit 11
     uint32_t unused_12                        : 1; // Bit 12
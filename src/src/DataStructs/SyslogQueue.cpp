@@ -0,0 +1,150 @@
+#include "../DataStructs/SyslogQueue.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
+
+bool SyslogQueue::add(uint8_t prio, const String& message)
+{
+  ++_stats.added;
+
+  size_t length = message.length();
+
+  if (length > SYSLOG_MAX_MESSAGE_LENGTH) {
+    length = SYSLOG_MAX_MESSAGE_LENGTH;
+  }
+
+  if (_buffer == nullptr) {
+    _buffer = static_cast<uint8_t *>(special_calloc(1, SYSLOG_QUEUE_BUFFER_SIZE));
+  }
+  uint16_t pos{};
+
+  if ((_buffer == nullptr) || !reserve(recordHeaderSize + length, pos)) {
+    ++_stats.dropped;
+    return false;
+  }
+  _buffer[pos]     = prio;
+  _buffer[pos + 1] = length & 0xFF;
+  _buffer[pos + 2] = length >> 8;
+  memcpy(&_buffer[pos + recordHeaderSize], message.c_str(), length);
+
+  ++_count;
+  _usage += recordHeaderSize + length;
+
+  if (_usage > _stats.peakUsage) {
+    _stats.peakUsage = _usage;
+  }
+  return true;
+}
+
+void SyslogQueue::clear()
+{
+  _read    = 0;
+  _write   = 0;
+  _end     = SYSLOG_QUEUE_BUFFER_SIZE;
+  _wrapped = false;
+  _count   = 0;
+  _usage   = 0;
+}
+
+bool SyslogQueue::allowDatagram()
+{
+  constexpr uint32_t cost = 1000 / SYSLOG_MAX_DATAGRAMS_PER_SEC;
+
+  _budget += timePassedSince(_lastBudgetUpdate);
+
+  if (_budget > 1000) {
+    // Allow bursts of at most 1 second worth of datagrams
+    _budget = 1000;
+  }
+  _lastBudgetUpdate = millis();
+
+  if (_budget < cost) {
+    return false;
+  }
+  _budget -= cost;
+  return true;
+}
+
+bool SyslogQueue::front(uint8_t& prio, const char *& text, uint16_t& length) const
+{
+  if (isEmpty()) {
+    return false;
+  }
+  prio   = _buffer[_read];
+  length = _buffer[_read + 1] | (_buffer[_read + 2] << 8);
+  text   = reinterpret_cast<const char *>(&_buffer[_read + recordHeaderSize]);
+  return true;
+}
+
+void SyslogQueue::pop()
+{
+  if (isEmpty()) {
+    return;
+  }
+  const uint16_t recordSize = recordHeaderSize + (_buffer[_read + 1] | (_buffer[_read + 2] << 8));
+
+  _read  += recordSize;
+  _usage -= recordSize;
+  --_count;
+
+  if (_count == 0) {
+    clear();
+  } else if (_wrapped && (_read >= _end)) {
+    // Continue with the records at the start of the buffer
+    _read    = 0;
+    _end     = SYSLOG_QUEUE_BUFFER_SIZE;
+    _wrapped = false;
+  }
+}
+
+size_t SyslogQueue::formatPrio(char *dest, uint8_t prio)
+{
+  size_t length = 0;
+
+  dest[length++] = '<';
+
+  if (prio >= 100) {
+    dest[length++] = '0' + (prio / 100);
+  }
+
+  if (prio >= 10) {
+    dest[length++] = '0' + ((prio / 10) % 10);
+  }
+  dest[length++] = '0' + (prio % 10);
+  dest[length++] = '>';
+  return length;
+}
+
+bool SyslogQueue::reserve(size_t size, uint16_t& pos)
+{
+  if (isEmpty()) {
+    clear();
+  }
+
+  if (!_wrapped) {
+    // Data is in [_read, _write)
+    if ((_write + size) <= SYSLOG_QUEUE_BUFFER_SIZE) {
+      pos     = _write;
+      _write += size;
+      return true;
+    }
+
+    if (size <= _read) {
+      // Continue at the start of the buffer
+      _end     = _write;
+      _wrapped = true;
+      pos      = 0;
+      _write   = size;
+      return true;
+    }
+    return false;
+  }
+
+  // Data is in [_read, _end) and [0, _write)
+  if ((_write + size) <= _read) {
+    pos     = _write;
+    _write += size;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,179 @@
+#ifndef DATASTRUCTS_SYSLOGQUEUE_H
+#define DATASTRUCTS_SYSLOGQUEUE_H
+
+
+#include "../../ESPEasy_common.h"
+
+/*********************************************************************************************\
+ * SyslogQueue
+ *
+ * Bounded queue of syslog lines, waiting to be sent from the background tasks.
+ * Lines are stored contiguously in a byte buffer, which is only allocated when syslog is used.
+ * When the buffer is full, new lines are dropped so the lines which are sent stay in order.
+ * Sending is rate limited to SYSLOG_MAX_DATAGRAMS_PER_SEC datagrams per second.
+\*********************************************************************************************/
+#ifndef SYSLOG_QUEUE_BUFFER_SIZE
+  #ifdef ESP32
+    #define SYSLOG_QUEUE_BUFFER_SIZE 4096
+  #else
+    #ifdef USE_SECOND_HEAP
+      #define SYSLOG_QUEUE_BUFFER_SIZE 2048
+    #else
+      #define SYSLOG_QUEUE_BUFFER_SIZE 1024
+    #endif
+  #endif
+#endif
+
+// Longer messages are truncated
+#ifndef SYSLOG_MAX_MESSAGE_LENGTH
+  #define SYSLOG_MAX_MESSAGE_LENGTH 480
+#endif
+
+// Max. size of a datagram when combining several lines (RFC3164: 1024 bytes)
+#ifndef SYSLOG_MAX_DATAGRAM_SIZE
+  #define SYSLOG_MAX_DATAGRAM_SIZE 1024
+#endif
+
+#ifndef SYSLOG_MAX_DATAGRAMS_PER_SEC
+  #define SYSLOG_MAX_DATAGRAMS_PER_SEC 20
+#endif
+
+// Max. number of datagrams sent per call to the background tasks
+#ifndef SYSLOG_MAX_DATAGRAMS_PER_CALL
+  #define SYSLOG_MAX_DATAGRAMS_PER_CALL 4
+#endif
+
+
+class SyslogQueue {
+public:
+
+  struct Stats {
+    uint32_t added{};
+    uint32_t sent{};
+    uint32_t datagrams{};
+    uint32_t dropped{};
+    uint16_t peakUsage{};
+  };
+
+  // Returns false when the line was dropped.
+  bool add(uint8_t       prio,
+           const String& message);
+
+  bool isEmpty() const {
+    return _count == 0;
+  }
+
+  uint16_t size() const {
+    return _count;
+  }
+
+  // Nr of bytes in use
+  uint16_t getUsage() const {
+    return _usage;
+  }
+
+  void clear();
+
+  // Pre-rendered header, sent after the priority of each line.
+  // Must be cleared when the settings change.
+  const String& getHeader() const {
+    return _header;
+  }
+
+  void setHeader(const String& header) {
+    _header = header;
+  }
+
+  void clearHeaderCache() {
+    _header = String();
+  }
+
+  // Rate limit, returns whether the next datagram may be sent.
+  bool allowDatagram();
+
+  // Calls write(const char* data, size_t length) for all parts of the next datagram
+  // and removes the sent lines from the queue.
+  // When combineLines is set, lines are added to the datagram as long as the datagram does not exceed maxSize.
+  // Returns the number of lines in the datagram.
+  template<typename Writer>
+  uint32_t nextDatagram(bool combineLines, size_t maxSize, Writer write) {
+    uint32_t nrLines = 0;
+    size_t   datagramSize = 0;
+    uint8_t  prio{};
+    const char *text = nullptr;
+    uint16_t length{};
+
+    while (front(prio, text, length)) {
+      char prioStr[8];
+      const size_t prioLength = formatPrio(prioStr, prio);
+      const size_t lineSize   = prioLength + _header.length() + length + (nrLines == 0 ? 0 : 1);
+
+      if ((nrLines != 0) && ((datagramSize + lineSize) > maxSize)) {
+        break;
+      }
+
+      if (nrLines != 0) {
+        write("\n", 1);
+      }
+      write(prioStr,         prioLength);
+      write(_header.c_str(), _header.length());
+      write(text,            length);
+      datagramSize += lineSize;
+      ++nrLines;
+      pop();
+
+      if (!combineLines) {
+        break;
+      }
+    }
+
+    if (nrLines != 0) {
+      _stats.sent += nrLines;
+      ++_stats.datagrams;
+    }
+    return nrLines;
+  }
+
+  const Stats& getStats() const {
+    return _stats;
+  }
+
+private:
+
+  // Record header: prio and length of the text
+  static constexpr size_t recordHeaderSize = 3;
+
+  bool   front(uint8_t    & prio,
+               const char*& text,
+               uint16_t   & length) const;
+
+  void   pop();
+
+  // Write "<prio>", returns the length.
+  static size_t formatPrio(char   *dest,
+                           uint8_t prio);
+
+  // Position for a new record of 'size' bytes, returns false when it does not fit.
+  bool   reserve(size_t    size,
+                 uint16_t& pos);
+
+  uint8_t *_buffer = nullptr;
+  uint16_t _read   = 0;
+  uint16_t _write  = 0;
+
+  // End of the data at the end of the buffer, when new records are written at the start of the buffer.
+  uint16_t _end     = SYSLOG_QUEUE_BUFFER_SIZE;
+  bool     _wrapped = false;
+  uint16_t _count   = 0;
+  uint16_t _usage   = 0;
+
+  // Rate limit budget in msec, every datagram costs 1000 / SYSLOG_MAX_DATAGRAMS_PER_SEC msec.
+  uint32_t _budget           = 1000;
+  uint32_t _lastBudgetUpdate = 0;
+
+  String _header;
+  Stats  _stats;
+};
+
+
+#endif // DATASTRUCTS_SYSLOGQUEUE_H
@@ -10,6 +10,7 @@
 std::map<int, TimingStats> pluginStats;
 std::map<int, TimingStats> controllerStats;
 std::map<TimingStatsElements, TimingStats> miscStats;
+std::map<String, WebPageStats> webPageStats;
 unsigned long timingstats_last_reset(0);
 
 
@@ -22,6 +23,16 @@ void TimingStats::add(int64_t time) {
   if (time > static_cast<int64_t>(_maxVal)) { _maxVal = time; }
 
   if (time < static_cast<int64_t>(_minVal)) { _minVal = time; }
+
+  const uint8_t index = getBucketIndex(time < 0 ? 0 : time);
+
+  if (_histogram[index] == UINT16_MAX) {
+    // Round up, so rare outliers do not disappear from the histogram.
+    for (uint8_t i = 0; i < TIMING_STATS_HISTOGRAM_BUCKETS; ++i) {
+      _histogram[i] = (_histogram[i] + 1) >> 1;
+    }
+  }
+  ++_histogram[index];
 }
 
 void TimingStats::reset() {
@@ -29,6 +40,7 @@ void TimingStats::reset() {
   _count     = 0;
   _maxVal    = 0;
   _minVal    = 4294967295;
+  memset(_histogram, 0, sizeof(_histogram));
 }
 
 bool TimingStats::isEmpty() const {
@@ -58,6 +70,72 @@ bool TimingStats::thresholdExceeded(const uint64_t& threshold) const {
   return _maxVal > threshold;
 }
 
+uint64_t TimingStats::getPercentile(float percentile) const {
+  if (_count == 0) {
+    return 0;
+  }
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < TIMING_STATS_HISTOGRAM_BUCKETS; ++i) {
+    total += _histogram[i];
+  }
+
+  // Rank of the requested sample, 1 ... total
+  float rank = percentile * total / 100.0f;
+
+  if (rank < 1.0f) { rank = 1.0f; }
+
+  uint32_t cumulative = 0;
+
+  for (uint8_t i = 0; i < TIMING_STATS_HISTOGRAM_BUCKETS; ++i) {
+    if (_histogram[i] != 0) {
+      if ((cumulative + _histogram[i]) >= rank) {
+        // Interpolate within the bucket, assuming the samples are evenly spread.
+        const uint64_t lower = getBucketLowerBound(i);
+        const uint64_t upper = (i + 1) < TIMING_STATS_HISTOGRAM_BUCKETS ? getBucketLowerBound(i + 1) : _maxVal + 1;
+        uint64_t res         = lower;
+
+        if (upper > lower) {
+          res += static_cast<uint64_t>((upper - lower) * (rank - cumulative) / _histogram[i]);
+        }
+
+        // Estimate can never be outside the recorded range.
+        if (res > _maxVal) { res = _maxVal; }
+
+        if (res < _minVal) { res = _minVal; }
+        return res;
+      }
+      cumulative += _histogram[i];
+    }
+  }
+  return _maxVal;
+}
+
+uint8_t TimingStats::getBucketIndex(uint64_t time) {
+  if (time < 2) {
+    return time;
+  }
+
+  if (time >= (1ull << 24)) {
+    return TIMING_STATS_HISTOGRAM_BUCKETS - 1;
+  }
+
+  // Bucket 2*e holds [2^e, 1.5 * 2^e), bucket 2*e+1 holds [1.5 * 2^e, 2^(e+1))
+  const uint32_t value    = static_cast<uint32_t>(time);
+  const uint8_t  exponent = 31 - __builtin_clz(value);
+
+  return 2 * exponent + ((value >> (exponent - 1)) & 1);
+}
+
+uint64_t TimingStats::getBucketLowerBound(uint8_t index) {
+  if (index < 2) {
+    return index;
+  }
+  const uint8_t exponent = index / 2;
+
+  return (1ull << exponent) + ((index & 1) ? (1ull << (exponent - 1)) : 0);
+}
+
 /********************************************************************************************\
    Functions used for displaying timing stats
  \*********************************************************************************************/
@@ -250,6 +328,8 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::RULES_PARSE_LINE:           return F("parseCompleteNonCommentLine()");
     case TimingStatsElements::RULES_PROCESS_MATCHED:      return F("processMatchedRule()");
     case TimingStatsElements::RULES_MATCH:                return F("rulesMatch()");
+    case TimingStatsElements::RULES_COMPILE:              return F("Compile rules");
+    case TimingStatsElements::RULES_PROCESS_COMPILED:     return F("rulesProcessingProgram()");
     case TimingStatsElements::GRAT_ARP_STATS:             return F("sendGratuitousARP()");
     case TimingStatsElements::SAVE_TO_RTC:                return F("saveToRTC()");
     case TimingStatsElements::BACKGROUND_TASKS:           return F("backgroundtasks()");
@@ -265,6 +345,8 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::HANDLE_SCHEDULER_IDLE:      return F("handle_schedule() idle");
     case TimingStatsElements::HANDLE_SCHEDULER_TASK:      return F("handle_schedule() task");
     case TimingStatsElements::PARSE_TEMPLATE_PADDED:      return F("parseTemplate_padded()");
+    case TimingStatsElements::PARSE_TEMPLATE_COMPILE:     return F("parseTemplate_padded() compile");
+    case TimingStatsElements::PARSE_TEMPLATE_RENDER:      return F("parseTemplate_padded() render");
     case TimingStatsElements::PARSE_SYSVAR:               return F("parseSystemVariables()");
     case TimingStatsElements::PARSE_SYSVAR_NOCHANGE:      return F("parseSystemVariables() No change");
     case TimingStatsElements::HANDLE_SERVING_WEBPAGE:     return F("handle webpage");
@@ -341,4 +423,30 @@ void addMiscTimerStat(TimingStatsElements L, int64_t T)
   if (Settings.EnableTimingStats()) { miscStats[L].add(T); }
 }
 
+void WebPageStats::add(uint32_t sentBytes_, uint32_t nrChunks_, uint32_t duration_ms_)
+{
+  ++count;
+  sentBytes   += sentBytes_;
+  nrChunks    += nrChunks_;
+  duration_ms += duration_ms_;
+}
+
+float WebPageStats::getBytesPerMsec() const
+{
+  if (duration_ms == 0) { return 0.0f; }
+  return static_cast<float>(sentBytes) / duration_ms;
+}
+
+void addWebPageStat(const String& url, uint32_t sentBytes, uint32_t nrChunks, uint32_t duration_ms)
+{
+  if (!Settings.EnableTimingStats()) { return; }
+  auto it = webPageStats.find(url);
+
+  if (it == webPageStats.end()) {
+    if (webPageStats.size() >= TIMING_STATS_MAX_WEB_PAGES) { return; }
+    it = webPageStats.emplace(url, WebPageStats()).first;
+  }
+  it->second.add(sentBytes, nrChunks, duration_ms);
+}
+
 #endif // if FEATURE_TIMING_STATS
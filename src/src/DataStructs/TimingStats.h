@@ -72,6 +72,8 @@ enum class TimingStatsElements {
   PARSE_SYSVAR,
   PARSE_SYSVAR_NOCHANGE,
   PARSE_TEMPLATE_PADDED,
+  PARSE_TEMPLATE_COMPILE,
+  PARSE_TEMPLATE_RENDER,
   IS_NUMERICAL,
   FORMAT_USER_VAR,
   PROCESS_SYSTEM_EVENT_QUEUE,
@@ -79,6 +81,8 @@ enum class TimingStatsElements {
   RULES_PROCESSING,
   RULES_PROCESS_MATCHED,
   RULES_PARSE_LINE,
+  RULES_COMPILE,
+  RULES_PROCESS_COMPILED,
   COMMAND_EXEC_INTERNAL,
   COMMAND_DECODE_INTERNAL,
   CONSOLE_LOOP,
@@ -139,6 +143,11 @@ enum class TimingStatsElements {
 
 #if FEATURE_TIMING_STATS
 
+// Log-linear histogram of the recorded times in usec.
+// 2 buckets per power of 2: [2^e, 1.5 * 2^e) and [1.5 * 2^e, 2^(e+1)).
+// The last bucket starts at 1.5 * 2^23 usec (~12.6 sec), it also counts all values of 2^24 usec (~16.8 sec) and more.
+# define TIMING_STATS_HISTOGRAM_BUCKETS  48
+
 class TimingStats {
 public:
 
@@ -152,12 +161,41 @@ public:
                      uint64_t& maxVal) const;
   bool     thresholdExceeded(const uint64_t& threshold) const;
 
+  // Estimate of the recorded time in usec at the given percentile (0 ... 100)
+  // Accuracy is limited by the bucket width, which is 1/3 ... 1/2 of the value.
+  uint64_t getPercentile(float percentile) const;
+
 private:
 
+  static uint8_t  getBucketIndex(uint64_t time);
+
+  // Smallest time in usec counted in the bucket
+  static uint64_t getBucketLowerBound(uint8_t index);
+
   float _timeTotal;
   uint32_t _count;
   uint64_t _maxVal;
   uint64_t _minVal;
+
+  // Bucket counts are halved when one would overflow, keeping the shape of the distribution.
+  uint16_t _histogram[TIMING_STATS_HISTOGRAM_BUCKETS]{};
+};
+
+// Max. number of different URLs to keep web page stats for
+# define TIMING_STATS_MAX_WEB_PAGES  32
+
+// Streaming statistics of a web page, as sent by the Web_StreamingBuffer
+struct WebPageStats {
+  void  add(uint32_t sentBytes,
+            uint32_t nrChunks,
+            uint32_t duration_ms);
+
+  float getBytesPerMsec() const;
+
+  uint32_t count       = 0;
+  uint32_t sentBytes   = 0;
+  uint32_t nrChunks    = 0;
+  uint32_t duration_ms = 0;
 };
 
 
@@ -177,10 +215,15 @@ void                       stopTimer(TimingStatsElements L,
                                      uint64_t            statisticsTimerStart);
 void                       addMiscTimerStat(TimingStatsElements L,
                                             int64_t             T);
+void                       addWebPageStat(const String& url,
+                                          uint32_t      sentBytes,
+                                          uint32_t      nrChunks,
+                                          uint32_t      duration_ms);
 
 extern std::map<int, TimingStats> pluginStats;
 extern std::map<int, TimingStats> controllerStats;
 extern std::map<TimingStatsElements, TimingStats> miscStats;
+extern std::map<String, WebPageStats> webPageStats;
 extern unsigned long timingstats_last_reset;
 
 # define START_TIMER const uint64_t statisticsTimerStart(getMicros64());
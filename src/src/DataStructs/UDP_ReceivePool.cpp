@@ -0,0 +1,42 @@
+#include "../DataStructs/UDP_ReceivePool.h"
+
+#include "../Helpers/Memory.h"
+
+UDP_ReceivePool::~UDP_ReceivePool()
+{
+  if (_buffer != nullptr) {
+    free(_buffer);
+    _buffer = nullptr;
+  }
+}
+
+uint8_t * UDP_ReceivePool::acquire()
+{
+  if (isFull()) {
+    return nullptr;
+  }
+
+  if (_buffer == nullptr) {
+    _buffer = static_cast<uint8_t *>(special_calloc(UDP_RECEIVE_POOL_SIZE, bufferSize));
+
+    if (_buffer == nullptr) {
+      return nullptr;
+    }
+  }
+  return getData(_count);
+}
+
+void UDP_ReceivePool::commit(uint16_t length, const IPAddress& remoteIP)
+{
+  if (isFull() || (_buffer == nullptr)) {
+    return;
+  }
+
+  if (length > UDP_PACKETSIZE_MAX) {
+    length = UDP_PACKETSIZE_MAX;
+  }
+  getData(_count)[length]   = 0;
+  _packets[_count].length   = length;
+  _packets[_count].remoteIP = remoteIP;
+  ++_count;
+}
@@ -0,0 +1,112 @@
+#ifndef DATASTRUCTS_UDP_RECEIVEPOOL_H
+#define DATASTRUCTS_UDP_RECEIVEPOOL_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include "../CustomBuild/ESPEasyLimits.h"
+
+#include <IPAddress.h>
+
+/*********************************************************************************************\
+ * UDP_ReceivePool
+ *
+ * Preallocated buffers for packets received on the ESPEasy p2p UDP port.
+ * checkUDP() first reads as many pending packets as there are buffers, so lwIP can release
+ * its packet buffers quickly, and then dispatches the packets directly from these buffers.
+ * The buffers are allocated once, on the first received packet.
+\*********************************************************************************************/
+#ifndef UDP_RECEIVE_POOL_SIZE
+  #ifdef ESP32
+    #define UDP_RECEIVE_POOL_SIZE 4
+  #else
+    #define UDP_RECEIVE_POOL_SIZE 2
+  #endif
+#endif
+
+// Max. number of packets handled per call to checkUDP()
+#ifndef UDP_RECEIVE_MAX_PACKETS_PER_CALL
+  #define UDP_RECEIVE_MAX_PACKETS_PER_CALL 8
+#endif
+
+// No new packets are read from lwIP when checkUDP() has been running for this long
+#ifndef UDP_RECEIVE_TIME_BUDGET_USEC
+  #define UDP_RECEIVE_TIME_BUDGET_USEC 5000
+#endif
+
+
+class UDP_ReceivePool {
+public:
+
+  // received = processed + dropped + oversized
+  struct Stats {
+    uint32_t received{};
+    uint32_t processed{};
+    uint32_t dropped{};   // Too short, unexpected NTP reply or no buffer available
+    uint32_t oversized{}; // Not smaller than UDP_PACKETSIZE_MAX
+    uint8_t  maxPerCall{};
+  };
+
+  struct Packet {
+    IPAddress remoteIP;
+    uint16_t  length{};
+  };
+
+  ~UDP_ReceivePool();
+
+  // Buffer to read the next packet into, with room for UDP_PACKETSIZE_MAX bytes.
+  // Returns nullptr when all buffers are in use or could not be allocated.
+  uint8_t* acquire();
+
+  // Store the packet read into the buffer returned by acquire().
+  // The data is 0-terminated, so plain text commands can be used as a C-string.
+  void     commit(uint16_t         length,
+                  const IPAddress& remoteIP);
+
+  uint8_t size() const {
+    return _count;
+  }
+
+  bool isFull() const {
+    return _count >= UDP_RECEIVE_POOL_SIZE;
+  }
+
+  const Packet& getPacket(uint8_t index) const {
+    return _packets[index];
+  }
+
+  uint8_t* getData(uint8_t index) const {
+    return _buffer + (index * bufferSize);
+  }
+
+  // Release all buffers, to be called after all packets have been dispatched.
+  void clear() {
+    _count = 0;
+  }
+
+  Stats& getStats() {
+    return _stats;
+  }
+
+  const Stats& getStats() const {
+    return _stats;
+  }
+
+  size_t getMemorySize() const {
+    return _buffer == nullptr ? 0 : UDP_RECEIVE_POOL_SIZE * bufferSize;
+  }
+
+private:
+
+  // One extra byte for the 0-termination
+  static constexpr size_t bufferSize = UDP_PACKETSIZE_MAX + 1;
+
+  uint8_t *_buffer = nullptr;
+  Packet   _packets[UDP_RECEIVE_POOL_SIZE];
+  uint8_t  _count = 0;
+
+  Stats _stats;
+};
+
+
+#endif // DATASTRUCTS_UDP_RECEIVEPOOL_H
@@ -8,6 +8,7 @@
 #include "../Globals/RulesCalculate.h"
 #include "../Helpers/_Plugin_SensorTypeHelper.h"
 #include "../Helpers/CRC_functions.h"
+#include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
@@ -17,6 +18,7 @@ void UserVarStruct::clear()
 {
   for (size_t i = 0; i < TASKS_MAX; ++i) {
     _rawData[i].clear();
+    markUpdated(i);
   }
   _computed.clear();
 #ifndef LIMIT_BUILD_SIZE
@@ -64,6 +66,7 @@ void UserVarStruct::setSensorTypeLong(taskIndex_t taskIndex, unsigned long value
     } else {
       _rawData[taskIndex].setSensorTypeLong(value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -92,6 +95,7 @@ void UserVarStruct::setInt32(taskIndex_t    taskIndex,
     } else {
       _rawData[taskIndex].setInt32(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -126,6 +130,7 @@ void UserVarStruct::setUint32(taskIndex_t taskIndex, taskVarIndex_t varNr, uint3
     {
       _rawData[taskIndex].setUint32(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -158,6 +163,7 @@ void UserVarStruct::setInt64(taskIndex_t    taskIndex,
     } else {
       _rawData[taskIndex].setInt64(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -188,6 +194,7 @@ void UserVarStruct::setUint64(taskIndex_t    taskIndex,
     } else {
       _rawData[taskIndex].setUint64(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -216,6 +223,7 @@ void UserVarStruct::setFloat(taskIndex_t    taskIndex,
     } else {
       _rawData[taskIndex].setFloat(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -242,6 +250,7 @@ void UserVarStruct::setDouble(taskIndex_t    taskIndex,
     } else {
       _rawData[taskIndex].setDouble(varNr, value);
     }
+    markUpdated(taskIndex);
   }
 }
 
@@ -280,6 +289,7 @@ String UserVarStruct::getAsString(taskIndex_t taskIndex, taskVarIndex_t varNr, S
 void UserVarStruct::set(taskIndex_t taskIndex, taskVarIndex_t varNr, const ESPEASY_RULES_FLOAT_TYPE& value, Sensor_VType sensorType)
 {
   applyFormulaAndSet(taskIndex, varNr, value, sensorType);
+  markUpdated(taskIndex);
 }
 
 bool UserVarStruct::isValid(taskIndex_t    taskIndex,
@@ -367,6 +377,27 @@ void UserVarStruct::markPluginRead(taskIndex_t taskIndex)
   }
 }
 
+void UserVarStruct::markUpdated(taskIndex_t taskIndex)
+{
+  if (validTaskIndex(taskIndex)) {
+    ++_updateCounter;
+
+    if (_updateCounter == 0) {
+      // Wrapped around, 0 is used for 'not updated'
+      ++_updateCounter;
+    }
+    _lastUpdate[taskIndex] = _updateCounter;
+  }
+}
+
+uint32_t UserVarStruct::getLastUpdate(taskIndex_t taskIndex) const
+{
+  if (validTaskIndex(taskIndex)) {
+    return _lastUpdate[taskIndex];
+  }
+  return 0u;
+}
+
 const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
   taskIndex_t    taskIndex,
   taskVarIndex_t varNr,
@@ -381,13 +412,11 @@ const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
       // FIXME TD-er: This may yield unexpected results when formula contains references to %pvalue%
 
 
-      // Should not apply set nr. of decimals when calculating a formula
-      const uint8_t nrDecimals = 254;
-      const String value   = getAsString(taskIndex, varNr, sensorType, nrDecimals, true);
+      const TaskValues_Data_t *value = getRawTaskValues_Data(taskIndex);
 
       constexpr bool applyNow = true;
 
-      if (applyFormula(taskIndex, varNr, value, sensorType, applyNow)) {
+      if ((value != nullptr) && applyFormula(taskIndex, varNr, *value, sensorType, applyNow)) {
         it = _computed.find(taskIndex);
       }
     }
@@ -401,11 +430,11 @@ const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
   return getRawTaskValues_Data(taskIndex);
 }
 
-bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
-                                 taskVarIndex_t varNr,
-                                 const String & value,
-                                 Sensor_VType   sensorType,
-                                 bool           applyNow) const
+bool UserVarStruct::applyFormula(taskIndex_t              taskIndex,
+                                 taskVarIndex_t           varNr,
+                                 const TaskValues_Data_t& value,
+                                 Sensor_VType             sensorType,
+                                 bool                     applyNow) const
 {
   if (!validTaskIndex(taskIndex) ||
       !validTaskVarIndex(varNr) ||
@@ -428,6 +457,39 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
   }
 
 
+#ifndef LIMIT_BUILD_SIZE
+  {
+    const RulesCalculate_program *program = Cache.getTaskDeviceFormulaProgram(taskIndex, varNr);
+
+    if ((program != nullptr) && program->valid) {
+      START_TIMER;
+
+      // Slot 0: %value%, slot 1: %pvalue%
+      ESPEASY_RULES_FLOAT_TYPE slotValues[2]{};
+      slotValues[0] = value.getAsDouble(varNr, sensorType);
+      slotValues[1] = slotValues[0];
+
+      if (formula_has_prevvalue) {
+        const String prev_str = getPreviousValue(taskIndex, varNr, sensorType);
+
+        if (!prev_str.isEmpty()) {
+          validDoubleFromString(prev_str, slotValues[1]);
+        }
+      }
+
+      ESPEASY_RULES_FLOAT_TYPE result{};
+      const bool res = !isError(RulesCalculate.evaluate(*program, slotValues, NR_ELEMENTS(slotValues), result));
+
+      if (res) {
+        _computed[taskIndex].set(varNr, result, sensorType);
+      }
+
+      STOP_TIMER(COMPUTE_FORMULA_STATS);
+      return res;
+    }
+  }
+#endif // ifndef LIMIT_BUILD_SIZE
+
   String formula = getPreprocessedFormula(taskIndex, varNr);
   bool   res     = true;
 
@@ -435,13 +497,17 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
   {
     START_TIMER;
 
-    formula.replace(F("%value%"), value);
+    // Should not apply set nr. of decimals when calculating a formula
+    const uint8_t nrDecimals = 254;
+    const String  value_str  = value.getAsString(varNr, sensorType, nrDecimals);
+
+    formula.replace(F("%value%"), value_str);
 
     // TD-er: Should we use the set nr of decimals here, or not round at all?
     // See: https://github.com/letscontrolit/ESPEasy/issues/3721#issuecomment-889649437
     if (formula_has_prevvalue) {
       const String prev_str = getPreviousValue(taskIndex, varNr, sensorType);
-      formula.replace(F("%pvalue%"), prev_str.isEmpty() ? value : prev_str);
+      formula.replace(F("%pvalue%"), prev_str.isEmpty() ? value_str : prev_str);
       /*
       addLog(LOG_LEVEL_INFO, 
         strformat(
@@ -481,13 +547,9 @@ bool UserVarStruct::applyFormulaAndSet(taskIndex_t                     taskIndex
 
   tmp.set(varNr, value, sensorType);
 
-  // Should not apply set nr. of decimals when calculating a formula
-  const uint8_t nrDecimals = 254;
-  const String  value_str  = tmp.getAsString(varNr, sensorType, nrDecimals);
-
   constexpr bool applyNow = false;
 
-  if (applyFormula(taskIndex, varNr, value_str, sensorType, applyNow)) {
+  if (applyFormula(taskIndex, varNr, tmp, sensorType, applyNow)) {
     _rawData[taskIndex].set(varNr, value, sensorType);
     return true;
   }
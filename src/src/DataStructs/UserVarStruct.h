@@ -125,6 +125,8 @@ struct UserVarStruct {
                Sensor_VType   sensorType,
                bool           raw = false) const;
 
+  // Raw access to the stored values.
+  // Call markUpdated() for the task(s) after writing values via the returned pointer.
   uint8_t                * get(size_t& sizeInBytes);
 
   const TaskValues_Data_t* getRawTaskValues_Data(taskIndex_t taskIndex) const;
@@ -136,6 +138,17 @@ struct UserVarStruct {
 
   void                     markPluginRead(taskIndex_t taskIndex);
 
+  // Each time values of a task are set, the task gets the next value of an update counter.
+  // Clients can use the counter as a token to only request tasks updated since then.
+  void                     markUpdated(taskIndex_t taskIndex);
+
+  uint32_t                 getUpdateCounter() const {
+    return _updateCounter;
+  }
+
+  // Value of the update counter at the last update of the task, 0 = not updated since boot
+  uint32_t                 getLastUpdate(taskIndex_t taskIndex) const;
+
 private:
 
   const TaskValues_Data_t* getRawOrComputed(taskIndex_t    taskIndex,
@@ -143,11 +156,12 @@ private:
                                             Sensor_VType   sensorType,
                                             bool           raw) const;
 
-  bool applyFormula(taskIndex_t    taskIndex,
-                    taskVarIndex_t varNr,
-                    const String & value,
-                    Sensor_VType   sensorType,
-                    bool           applyNow) const;
+  // Apply formula on the value for varNr stored in 'value'
+  bool applyFormula(taskIndex_t              taskIndex,
+                    taskVarIndex_t           varNr,
+                    const TaskValues_Data_t& value,
+                    Sensor_VType             sensorType,
+                    bool                     applyNow) const;
 
   bool applyFormulaAndSet(taskIndex_t                     taskIndex,
                           taskVarIndex_t                  varNr,
@@ -164,6 +178,9 @@ private:
   // we need to apply the formula when updating any value.
   mutable std::map<taskIndex_t, TaskValues_Data_cache>_computed;
 
+  uint32_t _updateCounter{};
+  uint32_t _lastUpdate[TASKS_MAX]{};
+
   String getPreprocessedFormula(taskIndex_t    taskIndex,
                                 taskVarIndex_t varNr) const;
   String getPreviousValue(taskIndex_t    taskIndex,
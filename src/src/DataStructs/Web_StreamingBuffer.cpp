@@ -1,6 +1,7 @@
 #include "../DataStructs/Web_StreamingBuffer.h"
 
 #include "../DataStructs/tcp_cleanup.h"
+#include "../DataStructs/TimingStats.h"
 #include "../DataTypes/ESPEasyTimeSource.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
@@ -20,37 +21,56 @@
 #define CHUNKED_BUFFER_SIZE         1200
 #endif
 
+// Max. overhead of chunked transfer encoding per chunk: "4B0\r\n" + "\r\n"
+#define CHUNKED_ENCODING_OVERHEAD   8
+
 Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false),
   initialRam(0), beforeTXRam(0), duringTXRam(0), finalRam(0), maxCoreUsage(0),
-  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0)
-{
-  // Make sure this is allocated on the DRAM since access to primary heap is faster
-  # ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  # endif // ifdef USE_SECOND_HEAP
-
-  buf.reserve(CHUNKED_BUFFER_SIZE + 50);
-  buf.clear();
-}
+  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0), nrChunks(0),
+  _chunks(nullptr), _chunkLength{}, _activeChunk(0), _pendingChunk(false), _streamStart(0)
+{}
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(char a)                   {
-  if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
-    flush();
+  if (_chunks == nullptr) { return *this; }
+
+  if (freeInActiveChunk() == 0) {
+    nextChunk();
   }
-  this->buf += a;
+  activeChunk()[_chunkLength[_activeChunk]++] = a;
   return *this;
 }
 
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int32_t a) {
+  return addUInt64(a < 0 ? -static_cast<int64_t>(a) : a, a < 0);
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(uint32_t a) {
+  return addUInt64(a, false);
+}
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+#ifndef __riscv
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int a) {
+  return addUInt64(a < 0 ? -static_cast<int64_t>(a) : a, a < 0);
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::operator+=(unsigned int a) {
+  return addUInt64(a, false);
+}
+#endif
+#endif
+
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(uint64_t a) {
-  return addString(ull2String(a));
+  return addUInt64(a, false);
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int64_t a) {
-  return addString(ll2String(a));
+  // Negate as unsigned, so INT64_MIN does not overflow
+  return addUInt64(a < 0 ? (~static_cast<uint64_t>(a) + 1) : a, a < 0);
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(const float& a)           {
-  return addString(toString(a, 2));
+  return addFloat(a, 2);
 }
 
 #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
@@ -72,12 +92,7 @@ Web_StreamingBuffer& Web_StreamingBuffer::operator+=(const __FlashStringHelper*
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length) {
-  #ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  #endif
-
-
-  if (!str) { 
+  if (!str || (_chunks == nullptr)) { 
     return *this; // return if the pointer is void
   }
 
@@ -85,16 +100,14 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
   if (mmu_is_iram(str)) {
     // Have to copy the string using mmu_get functions
     // This is not a flash string.
-    bool done = false;
     const char* cur_char = str;
-    while (!done) {
+    while (length != 0) {
       const uint8_t ch = mmu_get_uint8(cur_char++);
-      if (ch == 0) return *this;
-      if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
-        flush();
-      }
-      this->buf += (char)ch;
+      if (ch == 0 && length < 0) return *this;
+      *this += (char)ch;
+      --length;
     }
+    return *this;
   }
   #endif
 
@@ -102,87 +115,157 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 
   if (lowMemorySkip) { return *this; }
 
-  checkFull();
+  // Only check for \0 when no length was given (e.g. binary data)
+  size_t remaining = length < 0 ? strlen_P(str) : static_cast<size_t>(length);
+  flashStringData += remaining;
 
-  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
-  if (flush_step < 1) { flush_step = 0; }
+  #if !(defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0))
+  if (remaining >= getChunkSize()) {
+    // Send large flash strings directly, without copying them into the chunks.
+    flush();
+    web_server.sendContent_P(str, remaining);
+    sentBytes += remaining;
+    ++nrChunks;
+    return *this;
+  }
+  #endif
 
-  {
-    // Copy to internal buffer and send in chunks
-    PGM_P pos = str;
-    while (length != 0) {
-      if (flush_step == 0) {
-        flush();
-        flush_step = CHUNKED_BUFFER_SIZE;
-      }
-      const char c = (char)pgm_read_byte(pos);
-      if (c == '\0' && length < 0) {
-        // Only check for \0 when length was given (e.g. binary data)
-        return *this;
+  PGM_P pos = str;
+  while (remaining > 0) {
+    if (freeInActiveChunk() == 0) {
+      nextChunk();
+    }
+    const size_t copyLength = remaining < freeInActiveChunk() ? remaining : freeInActiveChunk();
+    memcpy_P(activeChunk() + _chunkLength[_activeChunk], pos, copyLength);
+    _chunkLength[_activeChunk] += copyLength;
+    pos       += copyLength;
+    remaining -= copyLength;
+  }
+  return *this;
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::addFloat(const double& value, unsigned int nrDecimals) {
+  #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+  // Same rounding as in doubleToString, as long as the value fits in a 64-bit int
+  if (!isnan(value) && !isinf(value) && (nrDecimals <= 9)) {
+    const uint64_t factor    = computeDecimalFactorForDecimals(nrDecimals);
+    const double   tmp_value = std::abs(value * factor);
+
+    if (tmp_value < 1e18) {
+      const uint64_t int_value = round(tmp_value);
+
+      addUInt64(int_value / factor, value < 0);
+
+      if (nrDecimals > 0) {
+        // Format the fraction with leading zeroes, backwards into a local buffer
+        char     fraction[10];
+        uint64_t fraction_value = int_value % factor;
+
+        fraction[0] = '.';
+        for (unsigned int i = nrDecimals; i > 0; --i) {
+          fraction[i]     = '0' + (fraction_value % 10);
+          fraction_value /= 10;
+        }
+        addData(fraction, nrDecimals + 1);
       }
-      this->buf += c;
-      ++flashStringData;
-      ++pos;
-      --length;
-      --flush_step;
+      return *this;
     }
   }
+  #endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+  return addString(doubleToString(value, nrDecimals));
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::addUInt64(uint64_t value, bool negative) {
+  // Max. 20 digits and a minus sign, formatted backwards
+  char   digits[21];
+  size_t pos = sizeof(digits);
+
+  do {
+    digits[--pos] = '0' + (value % 10);
+    value        /= 10;
+  } while (value > 0);
+
+  if (negative) {
+    digits[--pos] = '-';
+  }
+  addData(digits + pos, sizeof(digits) - pos);
   return *this;
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
-  # ifdef USE_SECOND_HEAP
-  HeapSelectDram ephemeral;
-  # endif // ifdef USE_SECOND_HEAP
+  addData(a.c_str(), a.length());
+  return *this;
+}
 
-  if (lowMemorySkip) { return *this; }
-  const unsigned int length = a.length();
-  if (length == 0) { return *this; }
+void Web_StreamingBuffer::addData(const char *data, size_t length) {
+  if (lowMemorySkip || (_chunks == nullptr)) { return; }
 
-  checkFull();
-  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
+  while (length > 0) {
+    if (freeInActiveChunk() == 0) {
+      nextChunk();
+    }
+    const size_t copyLength = length < freeInActiveChunk() ? length : freeInActiveChunk();
+    memcpy(activeChunk() + _chunkLength[_activeChunk], data, copyLength);
+    _chunkLength[_activeChunk] += copyLength;
+    data   += copyLength;
+    length -= copyLength;
+  }
+}
 
-  if (flush_step < 1) { flush_step = 0; }
+size_t Web_StreamingBuffer::getChunkSize() {
+  return CHUNKED_BUFFER_SIZE;
+}
 
-  if (length < static_cast<unsigned int>(flush_step)) {
-    // Just use the faster String operator to copy flash strings.
-    this->buf += a;
-    return *this;
+void Web_StreamingBuffer::nextChunk() {
+  trackTotalMem();
+
+  // Make sure the other chunk is free
+  sendPendingChunk(true);
+
+  _pendingChunk = true;
+  _activeChunk  = 1 - _activeChunk;
+
+  // Send right away when possible, else continue filling the other chunk.
+  sendPendingChunk(false);
+}
+
+void Web_StreamingBuffer::sendPendingChunk(bool mustSend) {
+  if (!_pendingChunk) { return; }
+  const uint8_t pending = 1 - _activeChunk;
+  const size_t  length  = _chunkLength[pending];
+
+  #ifdef ESP8266
+  if (!mustSend && 
+      (static_cast<size_t>(web_server.client().availableForWrite()) < (length + CHUNKED_ENCODING_OVERHEAD))) {
+    // Writing now would block until the client has acknowledged previous data.
+    return;
   }
+  #endif // ifdef ESP8266
 
-  unsigned int pos = 0;
-  while (pos < length) {
-    if (flush_step <= 0) {
-      flush();
-      flush_step = CHUNKED_BUFFER_SIZE;
-    } else {
-      const int remaining = length - pos;
-      const int fetchLength = flush_step >= remaining ? remaining : flush_step;
-      const char* ch = a.begin() + pos;
-      this->buf.concat(ch, static_cast<unsigned int>(fetchLength));
-      pos += fetchLength;
-      flush_step -= fetchLength;
-    }
+  if (!lowMemorySkip) {
+    sendContentBlocking(_chunks + (pending * getChunkSize()), length);
   }
-  return *this;
+  _chunkLength[pending] = 0;
+  _pendingChunk         = false;
 }
 
 void Web_StreamingBuffer::flush() {
-  if (lowMemorySkip) {
-    this->buf.clear();
-  } else {
-    if (this->buf.length() > 0) {
-      sendContentBlocking(this->buf);
+  if (_chunks == nullptr) { return; }
+  sendPendingChunk(true);
+
+  if (_chunkLength[_activeChunk] > 0) {
+    if (!lowMemorySkip) {
+      sendContentBlocking(activeChunk(), _chunkLength[_activeChunk]);
     }
+    _chunkLength[_activeChunk] = 0;
   }
 }
 
 void Web_StreamingBuffer::checkFull() {
-  if (lowMemorySkip) { this->buf.clear(); }
+  if (_chunks == nullptr) { return; }
 
-  if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
-    trackTotalMem();
-    flush();
+  if (freeInActiveChunk() == 0) {
+    nextChunk();
   }
 }
 
@@ -219,15 +302,22 @@ void Web_StreamingBuffer::startStream(bool allowOriginAll,
   initialRam   = ESP.getFreeHeap();
   beforeTXRam  = initialRam;
   sentBytes    = 0;
-  buf.clear();
-  buf.reserve(CHUNKED_BUFFER_SIZE);
+  nrChunks     = 0;
+  _streamStart = millis();
+  freeChunks();
   web_server.client().setNoDelay(true);
 #ifdef ESP32
   web_server.client().setSSE(false);
 #endif
   
-  if (beforeTXRam < 3000) {
+  if (beforeTXRam >= 3000) {
+    // Make sure this is allocated on the DRAM since access to primary heap is faster
+    _chunks = static_cast<char *>(malloc(2 * getChunkSize()));
+  }
+
+  if (_chunks == nullptr) {
     lowMemorySkip = true;
+    _etag         = String();
     web_server.send_P(200, (PGM_P)F("text/plain"), (PGM_P)F("Low memory. Cannot display webpage :-("));
       #if defined(ESP8266)
     tcpCleanup();
@@ -268,14 +358,20 @@ void Web_StreamingBuffer::endStream() {
   #endif
 
   if (!lowMemorySkip) {
-    if (buf.length() > 0) { sendContentBlocking(buf); }
-    buf.clear();
-    sendContentBlocking(buf);
+    flush();
+    freeChunks();
+
+    // Empty chunk to mark the end of the chunked transfer
+    sendContentBlocking(nullptr, 0);
 
     web_server.client().PR_9453_FLUSH_TO_CLEAR();
 
     finalRam = ESP.getFreeHeap();
 
+    #if FEATURE_TIMING_STATS
+    addWebPageStat(web_server.uri(), sentBytes, nrChunks, timePassedSince(_streamStart));
+    #endif // if FEATURE_TIMING_STATS
+
 /*
 #ifndef BUILD_NO_DEBUG
         if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -297,15 +393,25 @@ void Web_StreamingBuffer::endStream() {
 //  web_server.client().stop();
 }
 
+void Web_StreamingBuffer::freeChunks() {
+  if (_chunks != nullptr) {
+    free(_chunks);
+    _chunks = nullptr;
+  }
+  _chunkLength[0] = 0;
+  _chunkLength[1] = 0;
+  _activeChunk    = 0;
+  _pendingChunk   = false;
+}
+
 
-void Web_StreamingBuffer::sendContentBlocking(String& data) {
+void Web_StreamingBuffer::sendContentBlocking(const char *data, size_t length) {
   #ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
   #endif
 
   delay(0); // Try to prevent WDT reboots
 
-  const uint32_t length   = data.length();
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
     addLogMove(LOG_LEVEL_DEBUG_DEV, strformat(
@@ -330,19 +436,14 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
   // do chunked transfer encoding ourselves (WebServer doesn't support it)
   web_server.sendContent(size);
 
-  if (length > 0) { web_server.sendContent(data); }
+  if (length > 0) { web_server.client().write(reinterpret_cast<const uint8_t *>(data), length); }
   web_server.sendContent("\r\n");
 #else // ESP8266 2.4.0rc2 and higher and the ESP32 webserver supports chunked http transfer
-  web_server.sendContent(data);
-
-  if (data.length() > (CHUNKED_BUFFER_SIZE + 1)) {
-    data = String(); // Clear also allocated memory
-  } else {
-    data.clear();
-  }
+  web_server.sendContent(data == nullptr ? "" : data, length);
 
+  // Give the network stack some time to free memory of pending transfers
   const uint32_t timeout = millis() + 100;
-  while ((!data.reserve(CHUNKED_BUFFER_SIZE) || (ESP.getFreeHeap() < 4000 /*freeBeforeSend*/ )) &&
+  while ((ESP.getFreeHeap() < 4000 /*freeBeforeSend*/ ) &&
          !timeOutReached(timeout)) {
     if (ESP.getFreeHeap() < duringTXRam) {
       duringTXRam = ESP.getFreeHeap();
@@ -357,6 +458,8 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
 #endif // if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
 
   sentBytes += length;
+
+  if (length > 0) { ++nrChunks; }
   delay(1);
 }
 
@@ -381,6 +484,11 @@ void Web_StreamingBuffer::sendHeaderBlocking(bool allowOriginAll,
   sendHeader(F("Cache-Control"),     F("no-cache"));
   sendHeader(F("Transfer-Encoding"), F("chunked"));
 
+  if (!_etag.isEmpty()) {
+    sendHeader(F("ETag"), _etag);
+    _etag = String();
+  }
+
   if (allowOriginAll) {
     sendHeader(F("Access-Control-Allow-Origin"), "*");
   }
@@ -395,6 +503,11 @@ void Web_StreamingBuffer::sendHeaderBlocking(bool allowOriginAll,
   if (!cacheable)
     web_server.sendHeader(F("Cache-Control"), F("no-cache"));
 
+  if (!_etag.isEmpty()) {
+    web_server.sendHeader(F("ETag"), _etag);
+    _etag = String();
+  }
+
 #if ESP_IDF_VERSION_MAJOR>4
   if (origin.equals("*")) {
     web_server.enableCORS(true);
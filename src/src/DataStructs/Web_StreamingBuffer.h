@@ -7,6 +7,12 @@
 
 // ********************************************************************************
 // Core part of WebServer, the chunked streaming buffer
+//
+// Content is collected in one of 2 fixed size chunks, which are allocated per stream.
+// A full chunk is sent when the client can accept it without blocking,
+// otherwise the next chunk is filled while the full chunk is pending.
+// Numbers are formatted directly into the chunk and large flash strings are sent
+// without copying them into the chunk.
 // ********************************************************************************
 
 
@@ -26,10 +32,21 @@ public:
   unsigned int sentBytes;
   uint32_t flashStringCalls;
   uint32_t flashStringData;
+  uint32_t nrChunks;
 
 private:
 
-  String buf;
+  // Both chunks in a single allocation, only allocated while streaming.
+  char *_chunks;
+  uint16_t _chunkLength[2];
+  uint8_t _activeChunk;
+
+  // The other (not active) chunk is full and waiting to be sent.
+  bool _pendingChunk;
+  uint32_t _streamStart;
+
+  // ETag header for the next stream
+  String _etag;
 
 public:
 
@@ -37,6 +54,14 @@ public:
 
   Web_StreamingBuffer& operator+=(char a);
 
+  Web_StreamingBuffer& operator+=(int32_t a);
+  Web_StreamingBuffer& operator+=(uint32_t a);
+#if ESP_IDF_VERSION_MAJOR >= 5
+#ifndef __riscv
+  Web_StreamingBuffer& operator+=(int a);
+  Web_StreamingBuffer& operator+=(unsigned int a);
+#endif
+#endif
   Web_StreamingBuffer& operator+=(uint64_t a);
   Web_StreamingBuffer& operator+=(int64_t a);
 
@@ -55,11 +80,36 @@ template <typename T>
   Web_StreamingBuffer& operator+=(const __FlashStringHelper* str);
 
   Web_StreamingBuffer& addFlashString(PGM_P str, int length = -1);
-  
+
+  // Format the value directly into the chunk, same format as toString(value, nrDecimals)
+  Web_StreamingBuffer& addFloat(const double& value, unsigned int nrDecimals);
+
 private:
   Web_StreamingBuffer& addString(const String& a);
 
+  Web_StreamingBuffer& addUInt64(uint64_t value, bool negative);
+
+  // Copy from RAM into the chunks
+  void addData(const char *data, size_t length);
+
+  char* activeChunk() {
+    return _chunks + (_activeChunk * getChunkSize());
+  }
+
+  size_t freeInActiveChunk() const {
+    return getChunkSize() - _chunkLength[_activeChunk];
+  }
+
+  static size_t getChunkSize();
+
+  // Active chunk is full, continue with the other chunk.
+  void nextChunk();
+
+  // Send the pending chunk, or only when this does not block the client
+  void sendPendingChunk(bool mustSend);
+
 public:
+  // Send all collected data
   void flush();
 
   void checkFull();
@@ -68,17 +118,23 @@ public:
 
   void startStream(const __FlashStringHelper * origin, int httpCode = 200);
 
-  void startStream(const __FlashStringHelper * content_type, 
-                   const __FlashStringHelper * origin, 
-                   int httpCode = 200, 
+  void startStream(const __FlashStringHelper * content_type,
+                   const __FlashStringHelper * origin,
+                   int httpCode = 200,
                    bool cacheable=false);
 
   void startJsonStream();
 
+  // Send an ETag header with the next stream.
+  // It is not sent with the "Low memory" reply, so that reply is never cached as the requested content.
+  void setETag(const String& etag) {
+    _etag = etag;
+  }
+
 private:
 
-  void startStream(bool allowOriginAll, 
-                   const __FlashStringHelper * content_type, 
+  void startStream(bool allowOriginAll,
+                   const __FlashStringHelper * content_type,
                    const __FlashStringHelper * origin,
                    int httpCode = 200,
                    bool cacheable=false);
@@ -91,13 +147,15 @@ public:
 
   void endStream();
 
-private: 
+private:
+
+  void freeChunks();
 
-  void sendContentBlocking(String& data);
+  void sendContentBlocking(const char *data, size_t length);
   void sendHeaderBlocking(bool          allowOriginAll,
                           const String& content_type,
                           const String& origin,
-                          int httpCode, 
+                          int httpCode,
                           bool cacheable);
 
 };
@@ -0,0 +1,12 @@
+#include "../DataTypes/EventQueueOverflowPolicy.h"
+
+const __FlashStringHelper* toString(EventQueueOverflowPolicy_e policy) {
+  switch (policy) {
+    case EventQueueOverflowPolicy_e::DropOldest: return F("Drop Oldest");
+    case EventQueueOverflowPolicy_e::DropNewest: return F("Drop Newest");
+    case EventQueueOverflowPolicy_e::Coalesce:   return F("Coalesce Same Name");
+
+      // Do not use default: as this allows the compiler to detect any missing cases.
+  }
+  return F("Unknown");
+}
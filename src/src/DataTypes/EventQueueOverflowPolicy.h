@@ -0,0 +1,19 @@
+#ifndef DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
+#define DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
+
+#include "../../ESPEasy_common.h"
+
+// What to do when an event is added to a full event queue.
+// Is stored in settings (2 bits)
+// Every dropped event is counted and logged at LOG_LEVEL_ERROR.
+enum class EventQueueOverflowPolicy_e : uint8_t {
+  DropOldest = 0, // Remove the oldest event of the same or lower priority
+  DropNewest = 1, // Discard the event being added
+  Coalesce   = 2  // Replace the value of a queued User event with the same name, else drop oldest
+
+};
+
+const __FlashStringHelper* toString(EventQueueOverflowPolicy_e policy);
+
+
+#endif // DATATYPES_EVENTQUEUEOVERFLOWPOLICY_H
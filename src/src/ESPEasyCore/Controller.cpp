@@ -827,9 +827,9 @@ bool MQTTpublish(controllerIndex_t controller_idx,
     return false;
   }
   const bool success =
-    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex, topic,
-                                                                                                           payload, retained,
-                                                                                                           callbackTask)));
+    MQTTDelayHandler->addToQueue(MQTT_queue_element::create(controller_idx, taskIndex, topic,
+                                                            payload, payload == nullptr ? 0 : strlen(payload), retained,
+                                                            callbackTask));
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -850,10 +850,13 @@ bool MQTTpublish(controllerIndex_t controller_idx,
   }
 
   const bool success =
-    MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (std::nothrow) MQTT_queue_element(controller_idx, taskIndex,
-                                                                                                           std::move(topic),
-                                                                                                           std::move(payload), retained,
-                                                                                                           callbackTask)));
+    MQTTDelayHandler->addToQueue(MQTT_queue_element::create(controller_idx, taskIndex, topic.c_str(),
+                                                            payload.c_str(), payload.length(), retained,
+                                                            callbackTask));
+
+  // Topic and payload are copied into the queue, release the memory now as the callers expect them to be moved.
+  topic   = String();
+  payload = String();
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -62,8 +62,18 @@ String FileNameToEvent(const String& fileName) {
 
 void checkRuleSets() {
   Cache.rulesHelper.closeAllFiles();
+#if FEATURE_RULES_COMPILER
+
+  if (Settings.UseRules && Settings.OldRulesEngine() && Settings.EnableRulesCaching()) {
+    // Compile the rules right away, not when the first event needs to be processed.
+    Cache.rulesHelper.init();
+  }
+#endif // if FEATURE_RULES_COMPILER
 }
 
+// Shared by all rules processing functions, as executing an action may trigger processing of another event.
+static uint8_t rulesNestingLevel = 0;
+
 /********************************************************************************************\
    Process next event from event queue
  \*********************************************************************************************/
@@ -73,7 +83,13 @@ bool processNextEvent() {
     String nextEvent;
 
     if (eventQueue.getNext(nextEvent)) {
-      rulesProcessing(nextEvent);
+      // Process a burst of events in one go, as long as it fits in the time budget.
+      const unsigned long start = millis();
+
+      do {
+        rulesProcessing(nextEvent);
+      } while (timePassedSince(start) < EVENT_QUEUE_PROCESS_BUDGET_MSEC &&
+               eventQueue.getNext(nextEvent));
       return true;
     }
   }
@@ -108,10 +124,23 @@ void rulesProcessing(const String& event) {
     if (Settings.EnableRulesCaching()) {
       String filename;
       size_t pos = 0;
+      #if FEATURE_RULES_COMPILER
+      RulesProgram_block_ptr program;
+
+      if (Cache.rulesHelper.findMatchingRule(event, filename, pos, program)) {
+        if (program) {
+          eventHandled = rulesProcessingProgram(*program, event);
+        } else {
+          const bool startOnMatched = true; // We already matched the event
+          eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+        }
+      }
+      #else // if FEATURE_RULES_COMPILER
       if (Cache.rulesHelper.findMatchingRule(event, filename, pos)) {
         const bool startOnMatched = true; // We already matched the event
         eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
       }
+      #endif // if FEATURE_RULES_COMPILER
     } else {
       for (uint8_t x = 0; x < RULESETS_MAX && !eventHandled; x++) {
         eventHandled = rulesProcessingFile(getRulesFileName(x), event);
@@ -136,9 +165,7 @@ void rulesProcessing(const String& event) {
 
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    addLogMove(LOG_LEVEL_DEBUG, strformat(F("EVENT: %s Processing: %d ms"), event.c_str(), timePassedSince(timer)));
-  }
+  addLogFmt(LOG_LEVEL_DEBUG, F("EVENT: %s Processing: %d ms"), event, timePassedSince(timer));
 #endif // ifndef BUILD_NO_DEBUG
   STOP_TIMER(RULES_PROCESSING);
   backgroundtasks();
@@ -166,13 +193,11 @@ bool rulesProcessingFile(const String& fileName,
   }
 #endif // ifndef BUILD_NO_DEBUG
 
-  static uint8_t nestingLevel = 0;
-
-  nestingLevel++;
+  rulesNestingLevel++;
 
-  if (nestingLevel > RULES_MAX_NESTING_LEVEL) {
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
     addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
-    nestingLevel--;
+    rulesNestingLevel--;
     return false;
   }
 
@@ -227,7 +252,7 @@ bool rulesProcessingFile(const String& fileName,
   }
 */
 
-  nestingLevel--;
+  rulesNestingLevel--;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("rulesProcessingFile2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -235,6 +260,121 @@ bool rulesProcessingFile(const String& fileName,
   return eventHandled; // && nestingLevel == 0;
 }
 
+#if FEATURE_RULES_COMPILER
+
+/********************************************************************************************\
+   Rules processing of compiled rules block
+ \*********************************************************************************************/
+bool rulesProgramCondition(const RulesProgram_line& line, RulesProgram_eventData& eventData)
+{
+  String check = eventData.render(line);
+
+  check = parseTemplate(check);
+  check.toLowerCase();
+  check.trim();
+  #ifndef BUILD_NO_DEBUG
+  const String checkLog = (loglevelActiveFor(LOG_LEVEL_DEBUG)) ? check : EMPTY_STRING;
+  #endif // ifndef BUILD_NO_DEBUG
+  const bool res = conditionMatchExtended(check);
+  #ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = line.opcode == RulesProgram_opcode::If ? F("Rules: [if ") : F("Rules: [elseif ");
+    log += checkLog;
+    log += F("]=");
+    log += boolToString(res);
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+  #endif // ifndef BUILD_NO_DEBUG
+  return res;
+}
+
+// Find the first elseif/else/endif clause to continue with after the previous condition was false.
+// Return the index of the next line to process.
+size_t rulesProgramEnterClause(const RulesProgram_block& program, size_t index, RulesProgram_eventData& eventData)
+{
+  while (index < program.lines.size()) {
+    const RulesProgram_line& clause = program.lines[index];
+
+    if (clause.opcode != RulesProgram_opcode::ElseIf) {
+      // else or endif
+      return index + 1;
+    }
+
+    if (rulesProgramCondition(clause, eventData)) {
+      return index + 1;
+    }
+    index = clause.jumpTarget;
+  }
+  return index;
+}
+
+bool rulesProcessingProgram(const RulesProgram_block& program, const String& event)
+{
+  if (!Settings.UseRules) {
+    return false;
+  }
+  START_TIMER
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("rulesProcessingProgram"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+
+  rulesNestingLevel++;
+
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    rulesNestingLevel--;
+    return false;
+  }
+
+  RulesProgram_eventData eventData(event);
+  const size_t nrLines = program.lines.size();
+  size_t index         = 0;
+
+  while (index < nrLines) {
+    const RulesProgram_line& line = program.lines[index];
+
+    switch (line.opcode) {
+      case RulesProgram_opcode::Action:
+      {
+        START_TIMER
+        String action = eventData.render(line);
+        action = parseTemplate(action);
+        processRulesAction(action);
+        STOP_TIMER(RULES_PROCESS_MATCHED);
+        ++index;
+        break;
+      }
+      case RulesProgram_opcode::If:
+
+        if (line.hasFlag(RULES_PROGRAM_LINE_IF_OVERFLOW)) {
+          addLog(LOG_LEVEL_ERROR, F("Rules: Error: IF Nesting level exceeded!"));
+          index = line.endTarget + 1;
+        } else if (rulesProgramCondition(line, eventData)) {
+          ++index;
+        } else {
+          index = rulesProgramEnterClause(program, line.jumpTarget, eventData);
+        }
+        break;
+      case RulesProgram_opcode::ElseIf:
+      case RulesProgram_opcode::Else:
+        // Reached the end of the branch which was taken.
+        index = line.endTarget + 1;
+        break;
+      case RulesProgram_opcode::EndIf:
+        ++index;
+        break;
+    }
+  }
+
+  rulesNestingLevel--;
+  STOP_TIMER(RULES_PROCESS_COMPILED);
+  backgroundtasks();
+  return true;
+}
+
+#endif // if FEATURE_RULES_COMPILER
+
 
 /********************************************************************************************\
    Parse string commands
@@ -886,6 +1026,24 @@ void parseCompleteNonCommentLine(String& line, const String& event,
 #endif // ifndef BUILD_NO_DEBUG
 }
 
+void processRulesAction(String& action) {
+  const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
+    actionlog += action;
+    addLogMove(LOG_LEVEL_INFO, actionlog);
+  }
+
+  if (executeRestricted) {
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2)});
+  } else {
+    // Use action.c_str() here as we need to preserve the action string.
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
+  }
+  delay(0);
+}
+
 void processMatchedRule(String& action, const String& event,
                         bool& isCommand, bool condition[], bool ifBranche[],
                         uint8_t& ifBlock, uint8_t& fakeIfBlock) {
@@ -1007,22 +1165,7 @@ void processMatchedRule(String& action, const String& event,
   // the condition matches the if or else block.
   if (isCommand) {
     substitute_eventvalue(action, event);
-
-    const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
-
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
-      actionlog += action;
-      addLogMove(LOG_LEVEL_INFO, actionlog);
-    }
-
-    if (executeRestricted) {
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2)});
-    } else {
-      // Use action.c_str() here as we need to preserve the action string.
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
-    }
-    delay(0);
+    processRulesAction(action);
   }
 }
 
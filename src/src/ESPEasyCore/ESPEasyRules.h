@@ -8,6 +8,10 @@
 
 #include "../CustomBuild/ESPEasyLimits.h"
 
+#if FEATURE_RULES_COMPILER
+# include "../DataStructs/RulesProgram.h"
+#endif // if FEATURE_RULES_COMPILER
+
 
 #ifdef WEBSERVER_NEW_RULES
 
@@ -38,6 +42,16 @@ bool rulesProcessingFile(const String& fileName,
                          size_t pos = 0,
                          bool   startOnMatched = false);
 
+#if FEATURE_RULES_COMPILER
+
+/********************************************************************************************\
+   Rules processing of a compiled rules block, which already matched the event.
+   Return true when event was handled.
+ \*********************************************************************************************/
+bool rulesProcessingProgram(const RulesProgram_block& program,
+                            const String            & event);
+#endif // if FEATURE_RULES_COMPILER
+
 
 
 /********************************************************************************************\
@@ -84,6 +98,9 @@ void parseCompleteNonCommentLine(String& line,
                                  uint8_t  & fakeIfBlock,
                                  bool   startOnMatched);
 
+// Execute a single rules action, which already has all variables substituted.
+void processRulesAction(String& action);
+
 void processMatchedRule(String& action,
                         const String& event,
                         bool  & isCommand,
@@ -331,6 +331,49 @@ void addLog(uint8_t logLevel, const String& string)
   }
 }
 
+bool loglevelActiveForTextLog(uint8_t logLevel)
+{
+  return loglevelActiveFor(LOG_TO_SERIAL, logLevel) ||
+         loglevelActiveFor(LOG_TO_SYSLOG, logLevel)
+#if FEATURE_SD
+         || loglevelActiveFor(LOG_TO_SDCARD, logLevel)
+#endif
+  ;
+}
+
+void addToTextLog(const LogEntry_t& entry)
+{
+  #ifdef ESP32
+  if (xPortInIsrContext()) {
+    // When called from an ISR, you should not send out logs.
+    return;
+  }
+  #endif
+
+  const uint8_t logLevel = entry._loglevel;
+  const String  string   = entry.toString();
+
+  if (string.isEmpty()) return;
+  addToSerialLog(logLevel, string);
+  addToSysLog(logLevel, string);
+  addToSDLog(logLevel, string);
+}
+
+void addToWebLog(const LogEntry_t& entry)
+{
+  #ifdef ESP32
+  if (xPortInIsrContext()) {
+    // When called from an ISR, you should not send out logs.
+    return;
+  }
+  #endif
+
+  // The web log keeps the binary entry, which is formatted when read
+  if (loglevelActiveFor(LOG_TO_WEBLOG, entry._loglevel)) {
+    Logging.add(entry);
+  }
+}
+
 void addToLogMove(uint8_t logLevel, String&& string)
 {
   #ifdef ESP32
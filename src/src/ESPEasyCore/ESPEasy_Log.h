@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/LogEntry.h"
+
 #define LOG_LEVEL_NONE                      0
 #define LOG_LEVEL_ERROR                     1
 #define LOG_LEVEL_INFO                      2
@@ -56,5 +58,40 @@ void addLog(uint8_t logLevel, String&& string);
 void addLog(uint8_t logLevel, const String& string);
 void addToLogMove(uint8_t logLevel, String&& string);
 
+// Serial, syslog and SD card log
+bool loglevelActiveForTextLog(uint8_t logLevel);
+
+// Render the entry and send it to the serial, syslog and SD card log.
+void addToTextLog(const LogEntry_t& entry);
+
+// Store the entry in the web log, without rendering it.
+void addToWebLog(const LogEntry_t& entry);
+
+// Log using a printf style format string, e.g. addLogFmt(LOG_LEVEL_INFO, F("Task %d: %s"), taskNr, name);
+// The web log only stores the format string pointer and the arguments, the text is formatted when the web log is read.
+// String arguments are then truncated to fit in LOG_STRUCT_MESSAGE_SIZE.
+// The serial, syslog and SD card log get the full text, formatted right away.
+// String arguments can be passed as String, no need to call c_str()
+template<typename ... Args>
+void addLogFmt(uint8_t logLevel, const __FlashStringHelper *format, const Args& ... args)
+{
+  if (loglevelActiveFor(logLevel)) {
+    if (loglevelActiveForTextLog(logLevel)) {
+      // Only refer to string arguments, they are still valid while rendering.
+      LogEntry_t entry;
+      entry.setFormat(logLevel, format, false);
+      entry.addArgs(args ...);
+      addToTextLog(entry);
+    }
+
+    if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+      LogEntry_t entry;
+      entry.setFormat(logLevel, format);
+      entry.addArgs(args ...);
+      addToWebLog(entry);
+    }
+  }
+}
+
 
 #endif 
\ No newline at end of file
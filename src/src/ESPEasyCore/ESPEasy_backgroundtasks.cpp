@@ -74,6 +74,7 @@ void backgroundtasks()
    */
 
   process_serialWriteBuffer();
+  process_syslog_queue();
 
   if (!UseRTOSMultitasking) {
     serial();
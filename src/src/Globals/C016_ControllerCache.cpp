@@ -4,6 +4,7 @@
 
 
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../Helpers/ESPEasy_Storage.h"
 
 ControllerCache_struct ControllerCache;
 
@@ -31,6 +32,130 @@ bool C016_getTaskSample(C016_binary_element& element) {
   return ControllerCache.peek((uint8_t *)&element, sizeof(element));
 }
 
+// Nr. of records to read at once while scanning a cache file
+# define C016_CACHE_SCAN_RECORDS  8
+
+bool C016_loadCacheIndex(int fileNr, ControllerCacheIndex& index)
+{
+  index.clear();
+  ControllerCacheFile f;
+
+  if (!f.open(createCacheFilename(fileNr))) { return false; }
+
+  const uint32_t fileSize = f.size();
+  C016_binary_element elements[C016_CACHE_SCAN_RECORDS];
+
+  if (f.read((uint8_t *)&elements[0], sizeof(C016_binary_element)) != sizeof(C016_binary_element)) {
+    f.close();
+    return false;
+  }
+
+  const String indexFilename = createCacheIndexFilename(fileNr);
+  size_t nrStoredBlocks      = 0;
+
+  {
+    fs::File fi = tryOpenFile(indexFilename, "r");
+
+    if (fi) {
+      ControllerCacheIndexHeader header;
+
+      if ((fi.read((uint8_t *)&header, sizeof(header)) == sizeof(header)) &&
+          index.initFromHeader(header, elements[0].unixTime, fileSize)) {
+        ControllerCacheBlock block;
+
+        for (uint32_t i = 0; i < header.nrBlocks; ++i) {
+          if ((fi.read((uint8_t *)&block, sizeof(block)) != sizeof(block)) ||
+              !index.addBlock(block, fileSize)) {
+            // Corrupt index, rebuild it
+            index.clear();
+            break;
+          }
+        }
+      }
+      fi.close();
+      nrStoredBlocks = index.nrCompleteBlocks();
+    }
+  }
+
+  // Scan the records which are not yet indexed
+  uint32_t pos = index.indexedSize();
+
+  if (f.seek(pos)) {
+    while ((pos + sizeof(C016_binary_element)) <= fileSize) {
+      const size_t bytesRead = f.read((uint8_t *)&elements[0], sizeof(elements));
+      const size_t nrRead    = bytesRead / sizeof(C016_binary_element);
+
+      for (size_t i = 0; i < nrRead; ++i) {
+        index.add(elements[i].unixTime, elements[i].TaskIndex);
+      }
+      pos += nrRead * sizeof(C016_binary_element);
+
+      if (bytesRead < sizeof(elements)) { break; }
+    }
+  }
+  f.close();
+
+  if (index.nrCompleteBlocks() > nrStoredBlocks) {
+    fs::File fi = tryOpenFile(indexFilename, "w");
+
+    if (fi) {
+      const ControllerCacheIndexHeader header = index.getHeader();
+      fi.write((const uint8_t *)&header, sizeof(header));
+      fi.write((const uint8_t *)&index.getBlocks()[0], header.nrBlocks * sizeof(ControllerCacheBlock));
+      fi.close();
+    }
+  }
+  return true;
+}
+
+bool C016_findCacheFilePos(uint32_t    from,
+                           uint32_t    to,
+                           taskIndex_t taskIndex,
+                           int       & peekFileNr,
+                           int       & peekReadPos)
+{
+  ControllerCacheIndex index(sizeof(C016_binary_element));
+  bool islast = false;
+  int  fileNr = 0;
+
+  while (!islast) {
+    const String fname = C016_getCacheFileName(fileNr, islast);
+
+    if (!fname.isEmpty() && C016_loadCacheIndex(fileNr, index)) {
+      ControllerCacheFile f;
+      size_t blockNr = 0;
+
+      // The index only tells which blocks may contain a matching sample,
+      // read the records of those blocks to find the exact position.
+      while (index.find(from, to, taskIndex, blockNr)) {
+        if (!f && !f.open(fname)) { break; }
+        const ControllerCacheBlock& block = index.getBlocks()[blockNr];
+
+        if (f.seek(block.offset)) {
+          C016_binary_element element;
+
+          for (uint16_t i = 0; i < block.recordCount; ++i) {
+            if (f.read((uint8_t *)&element, sizeof(element)) != sizeof(element)) { break; }
+
+            if ((element.unixTime >= from) && (element.unixTime <= to) &&
+                (!validTaskIndex(taskIndex) || (element.TaskIndex == taskIndex))) {
+              f.close();
+              peekFileNr  = fileNr;
+              peekReadPos = block.offset + i * sizeof(element);
+              return true;
+            }
+          }
+        }
+        ++blockNr;
+      }
+
+      if (f) { f.close(); }
+    }
+    ++fileNr;
+  }
+  return false;
+}
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
@@ -9,6 +9,7 @@
 # include "../DataStructs/ESPEasy_EventStruct.h"
 # include "../DataStructs/DeviceStruct.h"
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ControllerCacheIndex.h"
 
 extern ControllerCache_struct ControllerCache;
 
@@ -28,6 +29,21 @@ bool   C016_deleteAllCacheBlocks();
 
 bool   C016_getTaskSample(C016_binary_element& element);
 
+// Load the sparse index of a cache file.
+// Records appended to the cache file after the index was stored (or all records of
+// a cache file without index) are scanned and the complete blocks are stored in the index file.
+bool   C016_loadCacheIndex(int                   fileNr,
+                           ControllerCacheIndex& index);
+
+// Find the position of the first sample with a timestamp in the range [from ... to]
+// for the given task (INVALID_TASK_INDEX = any task), using the index of the cache files.
+// Only samples flushed to the cache files can be found.
+bool   C016_findCacheFilePos(uint32_t    from,
+                             uint32_t    to,
+                             taskIndex_t taskIndex,
+                             int       & peekFileNr,
+                             int       & peekReadPos);
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
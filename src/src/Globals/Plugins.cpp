@@ -302,6 +302,123 @@ void loadDefaultTaskValueNames_ifEmpty(taskIndex_t TaskIndex) {
   }
 }
 
+/*********************************************************************************************\
+* Subscription of tasks to periodic and broadcast plugin functions.
+*
+* For each of these functions a bitmap is kept of the enabled tasks whose plugin implements it.
+* This way tasks not implementing a function are skipped without calling their plugin.
+* The bitmaps are rebuilt on first use after a task was (de)initialized.
+\*********************************************************************************************/
+#define PLUGIN_SUBSCRIPTION_WORDS  ((TASKS_MAX + 31) / 32)
+
+enum class PluginSubscription_e : uint8_t {
+  FiftyPerSecond,
+  TenPerSecond,
+  OnceASecond,
+  SerialIn,
+  UdpIn,
+  ClockIn,
+  TimeChange,
+
+  NrElements // Keep as last
+};
+
+struct PluginSubscriptionBitmap {
+  uint32_t words[PLUGIN_SUBSCRIPTION_WORDS]{};
+};
+
+static PluginSubscriptionBitmap pluginSubscriptions[static_cast<uint8_t>(PluginSubscription_e::NrElements)];
+static bool pluginSubscriptionsDirty = true;
+
+void invalidatePluginSubscriptions() {
+  pluginSubscriptionsDirty = true;
+}
+
+static bool getPluginSubscription(uint8_t Function, PluginSubscription_e& subscription) {
+  switch (Function) {
+    case PLUGIN_FIFTY_PER_SECOND: subscription = PluginSubscription_e::FiftyPerSecond; return true;
+    case PLUGIN_TEN_PER_SECOND:   subscription = PluginSubscription_e::TenPerSecond;   return true;
+    case PLUGIN_ONCE_A_SECOND:    subscription = PluginSubscription_e::OnceASecond;    return true;
+    case PLUGIN_SERIAL_IN:        subscription = PluginSubscription_e::SerialIn;       return true;
+    case PLUGIN_UDP_IN:           subscription = PluginSubscription_e::UdpIn;          return true;
+    case PLUGIN_CLOCK_IN:         subscription = PluginSubscription_e::ClockIn;        return true;
+    case PLUGIN_TIME_CHANGE:      subscription = PluginSubscription_e::TimeChange;     return true;
+  }
+  return false;
+}
+
+static bool deviceImplements(const DeviceStruct& device, PluginSubscription_e subscription) {
+  switch (subscription) {
+    case PluginSubscription_e::FiftyPerSecond: return device.HasFiftyPerSecond;
+    case PluginSubscription_e::TenPerSecond:   return device.HasTenPerSecond;
+    case PluginSubscription_e::OnceASecond:    return device.HasOnceASecond;
+    case PluginSubscription_e::SerialIn:       return device.HasSerialIn;
+    case PluginSubscription_e::UdpIn:          return device.HasUdpIn;
+    case PluginSubscription_e::ClockIn:        return device.HasClockIn;
+    case PluginSubscription_e::TimeChange:     return device.HasTimeChange;
+    case PluginSubscription_e::NrElements:     break;
+  }
+  return false;
+}
+
+static void rebuildPluginSubscriptions() {
+  constexpr uint8_t nrSubscriptions = static_cast<uint8_t>(PluginSubscription_e::NrElements);
+
+  for (uint8_t i = 0; i < nrSubscriptions; ++i) {
+    pluginSubscriptions[i] = PluginSubscriptionBitmap();
+  }
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++) {
+    if (!Settings.TaskDeviceEnabled[taskIndex] ||
+        (Settings.TaskDeviceDataFeed[taskIndex] != 0)) {
+      continue;
+    }
+    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+    if (!validDeviceIndex(DeviceIndex)) {
+      continue;
+    }
+    const DeviceStruct& device = Device[DeviceIndex];
+
+    for (uint8_t i = 0; i < nrSubscriptions; ++i) {
+      if (deviceImplements(device, static_cast<PluginSubscription_e>(i))) {
+        pluginSubscriptions[i].words[taskIndex / 32] |= (1ul << (taskIndex % 32));
+      }
+    }
+  }
+  pluginSubscriptionsDirty = false;
+}
+
+// Return the bitmap of tasks subscribed to the function, or nullptr when the function is not subscription based.
+static const PluginSubscriptionBitmap* getPluginSubscriptionBitmap(uint8_t Function) {
+  PluginSubscription_e subscription;
+
+  if (!getPluginSubscription(Function, subscription)) {
+    return nullptr;
+  }
+
+  if (pluginSubscriptionsDirty) {
+    rebuildPluginSubscriptions();
+  }
+  return &pluginSubscriptions[static_cast<uint8_t>(subscription)];
+}
+
+// Return the first subscribed task >= taskIndex, or TASKS_MAX when there is none.
+static taskIndex_t getNextSubscribedTask(const PluginSubscriptionBitmap& bitmap, taskIndex_t taskIndex) {
+  while (taskIndex < TASKS_MAX) {
+    const uint32_t word = bitmap.words[taskIndex / 32] >> (taskIndex % 32);
+
+    if (word != 0) {
+      taskIndex += __builtin_ctz(word);
+      return taskIndex < TASKS_MAX ? taskIndex : TASKS_MAX;
+    }
+
+    // Continue at the start of the next word
+    taskIndex = ((taskIndex / 32) + 1) * 32;
+  }
+  return TASKS_MAX;
+}
+
 /**
  * Call the plugin of 1 task for 1 function, with standard EventStruct and optional command string
  */
@@ -485,6 +602,20 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
   checkRAM(F("PluginCall"), Function);
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
+  switch (Function)
+  {
+    case PLUGIN_INIT:
+    case PLUGIN_INIT_ALL:
+    case PLUGIN_EXIT:
+    #if FEATURE_PLUGIN_PRIORITY
+    case PLUGIN_PRIORITY_INIT:
+    case PLUGIN_PRIORITY_INIT_ALL:
+    #endif // if FEATURE_PLUGIN_PRIORITY
+      // Set of enabled tasks may change
+      invalidatePluginSubscriptions();
+      break;
+  }
+
   switch (Function)
   {
     // Unconditional calls to all plugins
@@ -642,7 +773,11 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     case PLUGIN_SERIAL_IN:
     case PLUGIN_UDP_IN:
     {
-      for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
+      const PluginSubscriptionBitmap *subscribed = getPluginSubscriptionBitmap(Function);
+
+      for (taskIndex_t taskIndex = getNextSubscribedTask(*subscribed, 0);
+           taskIndex < TASKS_MAX;
+           taskIndex = getNextSubscribedTask(*subscribed, taskIndex + 1))
       {
         if (Settings.TaskDeviceEnabled[taskIndex]) {
           if (PluginCallForTask(taskIndex, Function, &TempEvent, str)) {
@@ -669,8 +804,17 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
       }
       bool result = true;
 
+      // PLUGIN_INIT is called for all tasks, other functions only for subscribed tasks.
+      const PluginSubscriptionBitmap *subscribed = getPluginSubscriptionBitmap(Function);
+
       for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
       {
+        if (subscribed != nullptr) {
+          taskIndex = getNextSubscribedTask(*subscribed, taskIndex);
+
+          if (taskIndex >= TASKS_MAX) { break; }
+        }
+
         #ifndef BUILD_NO_DEBUG
         int freemem_begin{};
 
@@ -109,6 +109,10 @@ void loadDefaultTaskValueNames_ifEmpty(taskIndex_t TaskIndex);
 \*********************************************************************************************/
 bool PluginCall(uint8_t Function, struct EventStruct *event, String& str);
 
+// Force a rebuild of the set of tasks subscribed to periodic plugin functions.
+// Called implicitly when a task is initialized or stopped.
+void invalidatePluginSubscriptions();
+
 
 
 #endif // GLOBALS_PLUGIN_H
\ No newline at end of file
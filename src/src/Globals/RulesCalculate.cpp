@@ -61,9 +61,15 @@ CalculateReturnCode Calculate_preProcessed(const String& preprocessd_input,
 CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result)
 {
+#if RULES_CALCULATE_CACHE_SIZE > 0
+  START_TIMER;
+  CalculateReturnCode returnCode = RulesCalculate.calculateCached(input, result);
+  STOP_TIMER(COMPUTE_STATS);
+#else
   CalculateReturnCode returnCode = Calculate_preProcessed(
     RulesCalculate_t::preProces(input),
     result);
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
 #ifndef LIMIT_BUILD_SIZE
   if (isError(returnCode)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
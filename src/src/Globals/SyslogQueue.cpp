@@ -0,0 +1,4 @@
+#include "../Globals/SyslogQueue.h"
+
+
+SyslogQueue syslogQueue;
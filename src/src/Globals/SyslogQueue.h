@@ -0,0 +1,8 @@
+#ifndef GLOBALS_SYSLOGQUEUE_H
+#define GLOBALS_SYSLOGQUEUE_H
+
+#include "../DataStructs/SyslogQueue.h"
+
+extern SyslogQueue syslogQueue;
+
+#endif // GLOBALS_SYSLOGQUEUE_H
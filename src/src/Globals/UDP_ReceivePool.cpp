@@ -0,0 +1,4 @@
+#include "../Globals/UDP_ReceivePool.h"
+
+
+UDP_ReceivePool udpReceivePool;
@@ -0,0 +1,8 @@
+#ifndef GLOBALS_UDP_RECEIVEPOOL_H
+#define GLOBALS_UDP_RECEIVEPOOL_H
+
+#include "../DataStructs/UDP_ReceivePool.h"
+
+extern UDP_ReceivePool udpReceivePool;
+
+#endif // GLOBALS_UDP_RECEIVEPOOL_H
@@ -204,6 +204,9 @@ bool readUserVarFromRTC()
       TaskValues_Data_t* taskValues = UserVar.getRawTaskValues_Data(taskIndex);
       taskValues->setUint32(varNr, UserVar_RTC[i]);
     }
+    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+      UserVar.markUpdated(taskIndex);
+    }
     return true;
   }
   return false;
@@ -225,6 +228,10 @@ bool readUserVarFromRTC()
       # endif // ifdef RTC_STRUCT_DEBUG
     memset(buffer, 0, size);
   }
+  // Values are written directly in the buffer.
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    UserVar.markUpdated(taskIndex);
+  }
   return ret;
   #endif 
 }
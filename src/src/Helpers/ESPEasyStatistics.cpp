@@ -4,8 +4,10 @@
 #if FEATURE_TIMING_STATS
 
 #include "../DataStructs/TimingStats.h"
+#include "../Globals/Cache.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../Helpers/Convert.h"
+#include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -19,6 +21,10 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   json_number(F("min"),   ull2String(minVal));
   json_number(F("max"),   ull2String(maxVal));
   json_number(F("avg"),   toString(stats.getAvg(), 2));
+  json_number(F("p50"),   ull2String(stats.getPercentile(50.0f)));
+  json_number(F("p90"),   ull2String(stats.getPercentile(90.0f)));
+  json_number(F("p99"),   ull2String(stats.getPercentile(99.0f)));
+  json_number(F("p99.9"), ull2String(stats.getPercentile(99.9f)));
   json_prop(F("unit"), F("usec"));
 }
 
@@ -131,13 +137,33 @@ void jsonStatistics(bool clearStats) {
 
   json_close(true);   // Close misc list
 
+
+  json_open(true, F("webpage"));
+  for (auto& x: webPageStats) {
+    json_open(); // open new web page item
+    json_prop(F("url"), x.first);
+    json_number(F("count"), String(x.second.count));
+    json_number(F("bytes"), String(x.second.sentBytes));
+    json_number(F("chunks"), String(x.second.nrChunks));
+    json_number(F("bytes-per-msec"), toString(x.second.getBytesPerMsec(), 2));
+    json_close(); // close web page item
+  }
+  json_close(true);   // Close web page list
+
   if (clearStats) {
-    pluginStats.clear();
-    controllerStats.clear();
-    miscStats.clear();
-    timingstats_last_reset = millis();
+    resetTimingStatistics();
   }
 }
 
+void resetTimingStatistics() {
+  pluginStats.clear();
+  controllerStats.clear();
+  miscStats.clear();
+  webPageStats.clear();
+  Cache.rulesHelper.resetEventCacheStats();
+  resetSaveFileStats();
+  timingstats_last_reset = millis();
+}
+
 
 #endif // if FEATURE_TIMING_STATS
\ No newline at end of file
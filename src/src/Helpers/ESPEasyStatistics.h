@@ -15,6 +15,9 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
 
 void jsonStatistics(bool clearStats);
 
+// Clear all timing statistics and the related counters shown with them.
+void resetTimingStatistics();
+
 #endif // if FEATURE_TIMING_STATS
 
 
@@ -1723,6 +1723,26 @@ String InitFile(SettingsType::SettingsFileEnum file_type)
                   SettingsType::getInitFileSize(file_type));
 }
 
+/********************************************************************************************\
+   Statistics on saving data to files
+ \*********************************************************************************************/
+static SaveFileStats saveFileStats;
+
+void SaveFileStats::clear()
+{
+  *this = SaveFileStats();
+}
+
+const SaveFileStats& getSaveFileStats()
+{
+  return saveFileStats;
+}
+
+void resetSaveFileStats()
+{
+  saveFileStats.clear();
+}
+
 /********************************************************************************************\
    Save data into config file on file system
  \*********************************************************************************************/
@@ -1774,40 +1794,70 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
   }
   #endif // ifndef BUILD_NO_DEBUG
   delay(1);
-  unsigned long timer = millis() + 50;
-  fs::File f          = tryOpenFile(fname, mode);
+  fs::File f = tryOpenFile(fname, mode);
 
   if (f) {
     clearAllButTaskCaches();
     SPIFFS_CHECK(f,                          fname);
-    if (index > 0) {
-      SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
-    }
-    const uint8_t *pointerToByteToSave = memAddress;
 
-    for (int x = 0; x < datasize; x++)
+    // Write in chunks aligned to the file system page size.
+    // Chunks which are already stored with the same content are skipped.
+    std::vector<uint8_t> buffer;
+    buffer.resize(2 * SAVEFILE_CHUNK_SIZE);
+    uint8_t  *newData  = &buffer[0];
+    uint8_t  *oldData  = &buffer[SAVEFILE_CHUNK_SIZE];
+    const int fileSize = f.size();
+    int       filePos  = 0;
+    int       written  = 0;
+
+    for (int x = 0; x < datasize;)
     {
+      const int pos = index + x;
+      int chunkSize = SAVEFILE_CHUNK_SIZE - (pos % SAVEFILE_CHUNK_SIZE);
+
+      if (chunkSize > (datasize - x)) {
+        chunkSize = datasize - x;
+      }
+
       // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t byteToSave = *pointerToByteToSave;
-      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
-      pointerToByteToSave++;
-
-      if (x % 256 == 0) {
-        // one page written, do some background tasks
-        timer = millis() + 50;
-        delay(0);
+      memcpy(newData, memAddress + x, chunkSize);
+
+      bool changed = true;
+
+      if ((pos + chunkSize) <= fileSize) {
+        if (filePos != pos) {
+          SPIFFS_CHECK(f.seek(pos, fs::SeekSet), fname);
+        }
+        changed = (static_cast<int>(f.read(oldData, chunkSize)) != chunkSize) ||
+                  (memcmp(newData, oldData, chunkSize) != 0);
+        filePos = pos + chunkSize;
       }
 
-      if (timeOutReached(timer)) {
-        timer += 50;
-        delay(0);
+      if (changed) {
+        if (filePos != pos) {
+          SPIFFS_CHECK(f.seek(pos, fs::SeekSet), fname);
+        }
+        SPIFFS_CHECK(static_cast<int>(f.write(newData, chunkSize)) == chunkSize, fname);
+        filePos  = pos + chunkSize;
+        written += chunkSize;
       }
+      x += chunkSize;
+
+      // One page processed, do some background tasks
+      delay(0);
+    }
+    saveFileStats.bytesRequested += datasize;
+    saveFileStats.bytesWritten   += written;
+    ++saveFileStats.saves;
+
+    if (written == 0) {
+      ++saveFileStats.unchanged;
     }
     f.close();
     #ifndef BUILD_NO_DEBUG
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, strformat(F("FILE : Saved %s offset: %d size: %d"), fname, index, datasize));
+      addLogMove(LOG_LEVEL_INFO, strformat(F("FILE : Saved %s offset: %d size: %d written: %d"), fname, index, datasize, written));
     }
     #endif // ifndef BUILD_NO_DEBUG
   } else {
@@ -2280,6 +2330,13 @@ String createCacheFilename(unsigned int count) {
   return fname;
 }
 
+String createCacheIndexFilename(unsigned int count) {
+  String fname = createCacheFilename(count);
+
+  fname.replace(F(".bin"), F(".idx"));
+  return fname;
+}
+
 // Match string with an integer between '_' and ".bin"
 int getCacheFileCountFromFilename(const String& fname) {
   if (!isCacheFile(fname)) { return -1; }
@@ -2300,7 +2357,8 @@ int getCacheFileCountFromFilename(const String& fname) {
 }
 
 bool isCacheFile(const String& fname) {
-  return fname.indexOf(F("cache_")) != -1;
+  // Not the index files (cache_<nr>.idx) next to the cache files
+  return (fname.indexOf(F("cache_")) != -1) && fname.endsWith(F(".bin"));
 }
 
 // Look into the filesystem to see if there are any cache files present on the filesystem
@@ -2337,7 +2395,7 @@ bool getCacheFileCounters(uint16_t& lowest, uint16_t& highest, size_t& filesizeH
     if (!file.isDirectory()) {
       const String fname(file.name());
 
-      if (fname.startsWith(F("/cache")) || fname.startsWith(F("cache"))) {
+      if ((fname.startsWith(F("/cache")) || fname.startsWith(F("cache"))) && isCacheFile(fname)) {
         int count = getCacheFileCountFromFilename(fname);
 
         if (count >= 0) {
@@ -301,10 +301,33 @@ String SaveToFile(const char *fname, int index, const uint8_t *memAddress, int d
 
 String SaveToFile_trunc(const char *fname, int index, const uint8_t *memAddress, int datasize);
 
+// Data is written in chunks of SAVEFILE_CHUNK_SIZE bytes, aligned to the position in the file.
+// Chunks already stored with the same content are not written again.
+#ifndef SAVEFILE_CHUNK_SIZE
+# define SAVEFILE_CHUNK_SIZE  256
+#endif // ifndef SAVEFILE_CHUNK_SIZE
+
 // See for mode description: https://github.com/esp8266/Arduino/blob/master/doc/filesystem.rst
 String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize, const char *mode);
 
 
+/********************************************************************************************\
+   Statistics on saving data to files
+ \*********************************************************************************************/
+struct SaveFileStats {
+  void clear();
+
+  uint32_t saves          = 0;
+  uint32_t unchanged      = 0; // Saves which did not need to write anything
+  uint32_t bytesRequested = 0;
+  uint32_t bytesWritten   = 0;
+};
+
+const SaveFileStats& getSaveFileStats();
+
+void                 resetSaveFileStats();
+
+
 /********************************************************************************************\
    Clear a certain area in a file (set to 0)
  \*********************************************************************************************/
@@ -353,6 +376,10 @@ bool SpiffsFull();
  \*********************************************************************************************/
 String createCacheFilename(unsigned int count);
 
+// Name of the sparse index file of a cache file, see ControllerCacheIndex
+String createCacheIndexFilename(unsigned int count);
+
+// Cache file of the cache controller (cache_<nr>.bin)
 bool isCacheFile(const String& fname);
 
 // Match string with an integer between '_' and ".bin"
@@ -40,6 +40,12 @@
 
 #ifdef USES_C016
 #include "../ControllerQueue/C016_queue_element.h"
+#include "../DataStructs/ControllerCacheCodec.h"
+#include "../DataStructs/ControllerCacheIndex.h"
+#endif
+
+#if FEATURE_PLUGIN_STATS_ROLLUP
+#include "../DataStructs/PluginStats_rollup.h"
 #endif
 
 #if FEATURE_NOTIFIER
@@ -99,15 +105,8 @@ void run_compiletime_checks() {
   #endif
 
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  #if ESP_IDF_VERSION_MAJOR > 3
-  // String class has increased with 4 bytes
-  const unsigned int LogStructSize = ((13u + 24 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #else
-  const unsigned int LogStructSize = ((13u + 20 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #endif
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
+  // LogStruct buffer is allocated on the heap, only when the web log is used.
+  check_size<LogStruct,                             24u>(); // Is not stored
   check_size<DeviceStruct,                          10u>(); // Is not stored
   #if FEATURE_MQTT_TLS
   check_size<ProtocolStruct,                        6u>();
@@ -134,6 +133,14 @@ void run_compiletime_checks() {
   #endif
   #ifdef USES_C016
   check_size<C016_binary_element,                   24u>();
+  check_size<ControllerCacheRecord,                 24u>();
+  check_size<ControllerCacheFrameHeader,            4u>();
+  check_size<ControllerCacheBlock,                  20u>();
+  check_size<ControllerCacheIndexHeader,            16u>();
+  #endif
+  #if FEATURE_PLUGIN_STATS_ROLLUP
+  check_size<PluginStats_rollup_bucket,             60u>();
+  check_size<PluginStats_rollup_header,             12u>();
   #endif
 
 
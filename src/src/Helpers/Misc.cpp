@@ -3,6 +3,7 @@
 #include "../../ESPEasy-Globals.h"
 #include "../../ESPEasy_common.h"
 #include "../../_Plugin_Helper.h"
+#include "../DataStructs/PluginStats_rollup.h"
 #include "../ESPEasyCore/ESPEasy_backgroundtasks.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/ESPEasy_time.h"
@@ -138,6 +139,11 @@ void taskClear(taskIndex_t taskIndex, bool save)
     String dummy;
     PluginCall(PLUGIN_EXIT, &TempEvent, dummy);
   }
+#if FEATURE_PLUGIN_STATS_ROLLUP
+
+  // Long term stats of this task are of no use for the next task at this index.
+  PluginStats_rollup::removeFiles(taskIndex);
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP
   Settings.clearTask(taskIndex);
   clearTaskCache(taskIndex); // Invalidate any cached values.
   ExtraTaskSettings.clear();
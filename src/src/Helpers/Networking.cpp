@@ -24,6 +24,8 @@
 #include "../Globals/Nodes.h"
 #include "../Globals/ResetFactoryDefaultPref.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SyslogQueue.h"
+#include "../Globals/UDP_ReceivePool.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Hardware.h"
@@ -99,16 +101,8 @@ void etharp_gratuitous_r(struct netif *netif) {
 \*********************************************************************************************/
 void sendSyslog(uint8_t logLevel, const String& message)
 {
-  if ((Settings.Syslog_IP[0] != 0) && NetworkConnected())
+  if (Settings.Syslog_IP[0] != 0)
   {
-    IPAddress broadcastIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
-
-    FeedSW_watchdog();
-
-    if (portUDP.beginPacket(broadcastIP, Settings.SyslogPort) == 0) {
-      // problem resolving the hostname or port
-      return;
-    }
     unsigned int prio = Settings.SyslogFacility * 8;
 
     if (logLevel == LOG_LEVEL_ERROR) {
@@ -120,34 +114,60 @@ void sendSyslog(uint8_t logLevel, const String& message)
     else {
       prio += 7;
     }
+    syslogQueue.add(prio, message);
+  }
+}
+
+void process_syslog_queue()
+{
+  if (syslogQueue.isEmpty()) {
+    return;
+  }
+
+  if (Settings.Syslog_IP[0] == 0) {
+    syslogQueue.clear();
+    return;
+  }
+
+  if (!NetworkConnected()) {
+    return;
+  }
 
+  if (syslogQueue.getHeader().isEmpty()) {
     // An RFC3164 compliant message must be formated like :  "<PRIO>[TimeStamp ]Hostname TaskName: Message"
 
     // Using Settings.Name as the Hostname (Hostname must NOT content space)
-    {
-      String header;
-      header += '<';
-      header += prio;
-      header += '>';
-      header += NetworkCreateRFCCompliantHostname(true);
-      header += F(" EspEasy: ");
-      header.trim();
-      header.replace(' ', '_');
-      
-      #ifdef ESP8266
-      portUDP.write(header.c_str(),                                    header.length());
-      #endif // ifdef ESP8266
-      #ifdef ESP32
-      portUDP.write(reinterpret_cast<const uint8_t *>(header.c_str()), header.length());
-      #endif // ifdef ESP32
+    String header;
+    header += NetworkCreateRFCCompliantHostname(true);
+    header += F(" EspEasy: ");
+    header.trim();
+    header.replace(' ', '_');
+    syslogQueue.setHeader(header);
+  }
+
+  IPAddress broadcastIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
+
+  for (int i = 0; i < SYSLOG_MAX_DATAGRAMS_PER_CALL && !syslogQueue.isEmpty(); ++i) {
+    if (!syslogQueue.allowDatagram()) {
+      return;
     }
+    FeedSW_watchdog();
 
-    #ifdef ESP8266
-    portUDP.write(message.c_str(), message.length());
-    #endif // ifdef ESP8266
-    #ifdef ESP32
-    portUDP.write(reinterpret_cast<const uint8_t *>(message.c_str()), message.length());
-    #endif // ifdef ESP32
+    if (portUDP.beginPacket(broadcastIP, Settings.SyslogPort) == 0) {
+      // problem resolving the hostname or port
+      return;
+    }
+    syslogQueue.nextDatagram(
+      Settings.SyslogCombineLines(),
+      SYSLOG_MAX_DATAGRAM_SIZE,
+      [](const char *data, size_t length) {
+        #ifdef ESP8266
+        portUDP.write(data,                                    length);
+        #endif // ifdef ESP8266
+        #ifdef ESP32
+        portUDP.write(reinterpret_cast<const uint8_t *>(data), length);
+        #endif // ifdef ESP32
+      });
 
     portUDP.endPacket();
     FeedSW_watchdog();
@@ -255,6 +275,127 @@ void updateUDPport(bool force)
    Check UDP messages (ESPEasy propiertary protocol)
 \*********************************************************************************************/
 boolean runningUPDCheck = false;
+
+// Read the next pending packet into the receive pool.
+// Returns false when no packet is pending.
+bool receiveUDPpacket()
+{
+  const int packetSize = portUDP.parsePacket();
+
+  if (packetSize <= 0) {
+    return false;
+  }
+  UDP_ReceivePool::Stats& stats = udpReceivePool.getStats();
+
+  ++stats.received;
+  statusLED(true);
+
+  // UDP_PACKETSIZE_MAX should be as small as possible but still enough to hold all
+  // data for PLUGIN_UDP_IN or CPLUGIN_UDP_IN calls
+  // This node may also receive other UDP packets which may be quite large
+  // and then crash due to memory allocation failures
+  if (packetSize >= UDP_PACKETSIZE_MAX) {
+    ++stats.oversized;
+  } else if ((packetSize < 2) || (portUDP.remotePort() == 123)) {
+    // Too short or unexpected NTP reply, drop for now...
+    ++stats.dropped;
+  } else {
+    uint8_t *buffer = udpReceivePool.acquire();
+    int len         = 0;
+
+    if (buffer != nullptr) {
+      len = portUDP.read(buffer, packetSize);
+    }
+
+    if (len >= 2) {
+      udpReceivePool.commit(len, portUDP.remoteIP());
+    } else {
+      ++stats.dropped;
+    }
+  }
+
+  // Flush any remaining content of the packet.
+  while (portUDP.available()) {
+    // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
+    portUDP.read();
+  }
+  return true;
+}
+
+void dispatchUDPpacket(char *packetBuffer, int len, const IPAddress& remoteIP)
+{
+  if (static_cast<uint8_t>(packetBuffer[0]) != 255)
+  {
+    # ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLogMove(LOG_LEVEL_DEBUG,  
+        strformat(F("UDP  : %s  Command: %s"), 
+          formatIP(remoteIP, true).c_str(), 
+          wrapWithQuotesIfContainsParameterSeparatorChar(String(packetBuffer)).c_str()
+          ));
+    }
+    #endif
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_SYSTEM, packetBuffer}, true);
+    return;
+  }
+
+  // binary data!
+  switch (packetBuffer[1])
+  {
+    case 1: // sysinfo message
+    {
+      if (len < 13) {
+        break;
+      }
+      int copy_length = sizeof(NodeStruct);
+      // Older versions sent 80 bytes, regardless of the size of NodeStruct
+      // Make sure the extra data received is ignored as it was also not initialized
+      if (len == 80) {
+        copy_length = 56;
+      }
+
+      if (copy_length > (len - 2)) {
+        copy_length = (len - 2);
+      }
+      NodeStruct received;
+      memcpy(&received, &packetBuffer[2], copy_length);
+
+      if (received.validate(remoteIP)) {
+        Nodes.addNode(received); // Create a new element when not present
+
+# ifndef BUILD_NO_DEBUG
+
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+          addLogMove(LOG_LEVEL_DEBUG_MORE,  
+            strformat(F("UDP  : %s (%d) %s,%s,%d"), 
+              formatIP(remoteIP).c_str(), 
+              received.unit,
+              received.STA_MAC().toString().c_str(), 
+              formatIP(received.IP(), true).c_str(), 
+              received.unit));
+        }
+
+#endif // ifndef BUILD_NO_DEBUG
+      }
+      break;
+    }
+
+    default:
+    {
+      struct EventStruct TempEvent;
+      TempEvent.Data = reinterpret_cast<uint8_t *>(packetBuffer);
+      TempEvent.Par1 = remoteIP[3];
+      TempEvent.Par2 = len;
+      String dummy;
+      // TD-er: Disabled the PLUGIN_UDP_IN call as we don't have any plugin using this.
+      //PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
+      CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
+      break;
+    }
+  }
+}
+
 void checkUDP()
 {
   if (!NetworkConnected())
@@ -270,125 +411,41 @@ void checkUDP()
 
   runningUPDCheck = true;
 
-  // UDP events
-  int packetSize = portUDP.parsePacket();
+  // Drain the UDP events which arrived since the last call, 
+  // as checkUDP() is only called every few msec.
+  const uint64_t start   = getMicros64();
+  uint32_t nrPackets     = 0;
+  bool     packetPending = true;
 
-  if (packetSize > 0 /*&& portUDP.remotePort() == Settings.UDPPort*/)
+  while (packetPending &&
+         (nrPackets < UDP_RECEIVE_MAX_PACKETS_PER_CALL) &&
+         (usecPassedSince(start) < UDP_RECEIVE_TIME_BUDGET_USEC))
   {
-    statusLED(true);
-
-    IPAddress remoteIP = portUDP.remoteIP();
-
-    if (portUDP.remotePort() == 123)
-    {
-      // unexpected NTP reply, drop for now...
-      while (portUDP.available()) {
-        // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
-        portUDP.read();
+    // First read the pending packets into the pool, so lwIP can release its buffers
+    while (!udpReceivePool.isFull() && (nrPackets < UDP_RECEIVE_MAX_PACKETS_PER_CALL)) {
+      if (!receiveUDPpacket()) {
+        packetPending = false;
+        break;
       }
-
-      runningUPDCheck = false;
-      return;
+      ++nrPackets;
     }
 
-    // UDP_PACKETSIZE_MAX should be as small as possible but still enough to hold all
-    // data for PLUGIN_UDP_IN or CPLUGIN_UDP_IN calls
-    // This node may also receive other UDP packets which may be quite large
-    // and then crash due to memory allocation failures
-    if ((packetSize >= 2) && (packetSize < UDP_PACKETSIZE_MAX)) {
-      // Allocate buffer to process packet.
-      // Resize it to be 1 byte larger so we can 0-terminate it 
-      // in case it is some plain text string
-      std::vector<char> packetBuffer;
-      packetBuffer.resize(packetSize + 1);
-
-      if (packetBuffer.size() >= static_cast<size_t>(packetSize)) {
-        memset(&packetBuffer[0], 0, packetSize + 1);
-        int len = portUDP.read(&packetBuffer[0], packetSize);
-
-        if (len >= 2) {
-          if (static_cast<uint8_t>(packetBuffer[0]) != 255)
-          {
-            packetBuffer[len] = 0;
-            # ifndef BUILD_NO_DEBUG
-
-            if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-              addLogMove(LOG_LEVEL_DEBUG,  
-                strformat(F("UDP  : %s  Command: %s"), 
-                  formatIP(remoteIP, true).c_str(), 
-                  wrapWithQuotesIfContainsParameterSeparatorChar(String(&packetBuffer[0])).c_str()
-                  ));
-            }
-            #endif
-            ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_SYSTEM, &packetBuffer[0]}, true);
-          }
-          else
-          {
-            // binary data!
-            switch (packetBuffer[1])
-            {
-              case 1: // sysinfo message
-              {
-                if (len < 13) {
-                  break;
-                }
-                int copy_length = sizeof(NodeStruct);
-                // Older versions sent 80 bytes, regardless of the size of NodeStruct
-                // Make sure the extra data received is ignored as it was also not initialized
-                if (len == 80) {
-                  copy_length = 56;
-                }
-
-                if (copy_length > (len - 2)) {
-                  copy_length = (len - 2);
-                }
-                NodeStruct received;
-                memcpy(&received, &packetBuffer[2], copy_length);
-
-                if (received.validate(remoteIP)) {
-                  Nodes.addNode(received); // Create a new element when not present
-
-# ifndef BUILD_NO_DEBUG
-
-                  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-                    addLogMove(LOG_LEVEL_DEBUG_MORE,  
-                      strformat(F("UDP  : %s (%d) %s,%s,%d"), 
-                        formatIP(remoteIP).c_str(), 
-                        received.unit,
-                        received.STA_MAC().toString().c_str(), 
-                        formatIP(received.IP(), true).c_str(), 
-                        received.unit));
-                  }
-
-#endif // ifndef BUILD_NO_DEBUG
-                }
-                break;
-              }
-
-              default:
-              {
-                struct EventStruct TempEvent;
-                TempEvent.Data = reinterpret_cast<uint8_t *>(&packetBuffer[0]);
-                TempEvent.Par1 = remoteIP[3];
-                TempEvent.Par2 = len;
-                String dummy;
-                // TD-er: Disabled the PLUGIN_UDP_IN call as we don't have any plugin using this.
-                //PluginCall(PLUGIN_UDP_IN, &TempEvent, dummy);
-                CPluginCall(CPlugin::Function::CPLUGIN_UDP_IN, &TempEvent);
-                break;
-              }
-            }
-          }
-        }
-      }
+    // Then dispatch them, directly from the pool buffers
+    for (uint8_t i = 0; i < udpReceivePool.size(); ++i) {
+      const UDP_ReceivePool::Packet& packet = udpReceivePool.getPacket(i);
+      dispatchUDPpacket(
+        reinterpret_cast<char *>(udpReceivePool.getData(i)),
+        packet.length,
+        packet.remoteIP);
+      ++udpReceivePool.getStats().processed;
     }
+    udpReceivePool.clear();
   }
 
-  // Flush any remaining content of the packet.
-  while (portUDP.available()) {
-    // Do not call portUDP.flush() as that's meant to sending the packet (on ESP8266)
-    portUDP.read();
+  if (nrPackets > udpReceivePool.getStats().maxPerCall) {
+    udpReceivePool.getStats().maxPerCall = nrPackets;
   }
+
   runningUPDCheck = false;
   STOP_TIMER(CHECK_UDP);
 }
@@ -20,8 +20,11 @@
 /*********************************************************************************************\
    Syslog client
 \*********************************************************************************************/
+// Add the message to the syslog queue, the queue is sent from the background tasks.
 void sendSyslog(uint8_t logLevel, const String& message);
 
+void process_syslog_queue();
+
 
 #if FEATURE_ESPEASY_P2P
 
@@ -303,41 +303,53 @@ void processMQTTdelayQueue() {
 
   if (element == nullptr) { return; }
 
-  bool handled = false;
+  // Publish up to "Max Batch Size" messages in a single call.
+  uint8_t nrSent = 0;
 
-  if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
-    struct EventStruct TempEvent(element->_taskIndex);
-    String dummy;
+  while (element != nullptr) {
+    bool processed = false;
 
-    // FIXME TD-er: Do we need anything from the element in the event?
-//    TempEvent.String1 = element->_topic;
-//    TempEvent.String2 = element->_payload;
-    if (PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy)) {
-      handled = true;
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
-    }
-  } else
-  if (!handled) {
-    if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
-      if (WiFiEventData.connectionFailures > 0) {
-        --WiFiEventData.connectionFailures;
-      }
-      MQTTDelayHandler->markProcessed(true);
+    if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
+      struct EventStruct TempEvent(element->_taskIndex);
+      String dummy;
+
+      // FIXME TD-er: Do we need anything from the element in the event?
+//      TempEvent.String1 = element->_topic;
+//      TempEvent.String2 = element->_payload;
+      processed = PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy);
+      MQTTDelayHandler->markProcessed(processed);
     } else {
-      MQTTDelayHandler->markProcessed(false);
+      processed = MQTTclient.publish(element->getTopic(), element->getPayload(), element->_retained);
+
+      if (processed) {
+        if (WiFiEventData.connectionFailures > 0) {
+          --WiFiEventData.connectionFailures;
+        }
+        MQTTDelayHandler->markProcessed(true);
+      } else {
+        MQTTDelayHandler->markProcessed(false);
 #ifndef BUILD_NO_DEBUG
 
-      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        String log = F("MQTT : process MQTT queue not published, ");
-        log += MQTTDelayHandler->sendQueue.size();
-        log += F(" items left in queue");
-        addLogMove(LOG_LEVEL_DEBUG, log);
-      }
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          String log = F("MQTT : process MQTT queue not published, ");
+          log += MQTTDelayHandler->sendQueue.size();
+          log += F(" items left in queue");
+          addLogMove(LOG_LEVEL_DEBUG, log);
+        }
 #endif // ifndef BUILD_NO_DEBUG
+      }
+    }
+
+    if (!processed) { break; }
+    ++nrSent;
+
+    element = nullptr;
+
+    if (MQTTDelayHandler->continueBatch(nrSent) && MQTTclient_connected) {
+      element = static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext());
     }
   }
+  MQTTDelayHandler->finishBatch(nrSent);
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon as possible.
   scheduleNextMQTTdelayQueue();
   STOP_TIMER(MQTT_DELAY_QUEUE);
@@ -415,8 +427,8 @@ void logTimerStatistics() {
 #ifndef BUILD_NO_DEBUG
 //  logStatistics(loglevel, true);
   if (loglevelActiveFor(loglevel)) {
-    String queueLog = F("Scheduler stats: (called/tasks/max_length/idle%) ");
-    queueLog += Scheduler.getQueueStats();
+    String queueLog = F("Scheduler stats: (called/tasks/max_length/idle%/length/capacity late:0/<4/<16/<64/<256/<1024/<4096/>=4096 msec) ");
+    queueLog += Scheduler.getQueueStats(true);
     addLogMove(loglevel, queueLog);
   }
 #endif
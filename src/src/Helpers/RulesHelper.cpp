@@ -1,11 +1,19 @@
 #include "../Helpers/RulesHelper.h"
 
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/RulesMatcher.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
 
+#if FEATURE_RULES_COMPILER && !defined(CACHE_RULES_IN_MEMORY)
+# define RULES_PROGRAM_FILE_MAGIC    0x50524545 // "EERP"
+# define RULES_PROGRAM_FILE_VERSION  1
+#endif // if FEATURE_RULES_COMPILER && !defined(CACHE_RULES_IN_MEMORY)
+
 /********************************************************************************************\
    Test for common mistake
    Return true if mistake was found (and corrected)
@@ -139,10 +147,54 @@ bool RulesHelperClass::findMatchingRule(const String& event, String& filename, s
   return true;
 }
 
+#if FEATURE_RULES_COMPILER
+bool RulesHelperClass::findMatchingRule(const String          & event,
+                                        String                & filename,
+                                        size_t                & pos,
+                                        RulesProgram_block_ptr& program)
+{
+  if (!_eventCache.isInitialized()) {
+    init();
+  }
+  RulesEventCache_vector::const_iterator it = _eventCache.findMatchingRule(event, Settings.EnableRulesEventReorder());
+
+  if (it == _eventCache.end()) { return false; }
+
+  filename = it->_filename;
+  pos      = it->_posInFile;
+  program  = getProgram(std::distance(_eventCache.begin(), it));
+  return true;
+}
+
+void RulesHelperClass::getProgramStats(size_t& nrCompiled, size_t& nrBlocks) const
+{
+  nrCompiled = 0;
+  nrBlocks   = _eventCache.size();
+# ifdef CACHE_RULES_IN_MEMORY
+
+  for (auto it = _programs.begin(); it != _programs.end(); ++it) {
+    if (*it) { ++nrCompiled; }
+  }
+# else // ifdef CACHE_RULES_IN_MEMORY
+
+  for (auto it = _programOffsets.begin(); it != _programOffsets.end(); ++it) {
+    if (*it != 0) { ++nrCompiled; }
+  }
+# endif // ifdef CACHE_RULES_IN_MEMORY
+}
+
+#endif // if FEATURE_RULES_COMPILER
+
 void RulesHelperClass::init()
 {
   if (_eventCache.isInitialized()) { return; }
 
+  #if FEATURE_RULES_COMPILER
+
+  // Checksum of the rules text, to detect whether the compiled program is still valid.
+  uint32_t sourceCRC = 0xffffffff;
+  #endif // if FEATURE_RULES_COMPILER
+
   // Read all files to populate caches.
 
   for (uint8_t x = 0; x < RULESETS_MAX; x++) {
@@ -152,10 +204,25 @@ void RulesHelperClass::init()
     bool   moreAvailable         = true;
     const bool searchNextOnBlock = false;
 
+    #if FEATURE_RULES_COMPILER
+
+    // Include the file name, so moving lines to another rules file also changes the checksum.
+    sourceCRC = calc_CRC32(reinterpret_cast<const uint8_t *>(filename.c_str()), filename.length(), sourceCRC);
+    #endif // if FEATURE_RULES_COMPILER
+
     while (moreAvailable) {
       const size_t pos_start_line = pos;
       const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
 
+      #if FEATURE_RULES_COMPILER
+      {
+        // Include the line end, so moving text to the next line also changes the checksum.
+        const uint8_t lineEnd = '\n';
+        sourceCRC = calc_CRC32(reinterpret_cast<const uint8_t *>(rulesLine.c_str()), rulesLine.length(), sourceCRC);
+        sourceCRC = calc_CRC32(&lineEnd, 1, sourceCRC);
+      }
+      #endif // if FEATURE_RULES_COMPILER
+
       if (_eventCache.addLine(
             rulesLine,
             filename,
@@ -176,8 +243,218 @@ void RulesHelperClass::init()
     }
   }
   _eventCache.initialize();
+  #if FEATURE_RULES_COMPILER
+  compilePrograms(sourceCRC);
+  #endif // if FEATURE_RULES_COMPILER
+}
+
+#if FEATURE_RULES_COMPILER
+RulesProgram_block_ptr RulesHelperClass::compileBlock(const String& filename, size_t pos)
+{
+  bool moreAvailable     = true;
+  const String onLine    = readLn(filename, pos, moreAvailable, false);
+  String event, action;
+
+  if (!getEventFromRulesLine(onLine, event, action) || !action.isEmpty()) {
+    // One-liners are left to the text based rules engine.
+    return nullptr;
+  }
+
+  # ifdef USE_SECOND_HEAP
+
+  // Compiled program may be kept in 2nd heap
+  HeapSelectIram ephemeral;
+  # endif // ifdef USE_SECOND_HEAP
+
+  std::shared_ptr<RulesProgram_block> block(new (std::nothrow) RulesProgram_block());
+
+  if (!block) {
+    return nullptr;
+  }
+  bool ok = true;
+
+  while (moreAvailable && ok) {
+    const String line = readLn(filename, pos, moreAvailable, false);
+
+    if (!line.isEmpty()) {
+      if (line.equalsIgnoreCase(F("endon"))) {
+        break;
+      }
+      ok = block->addLine(line);
+    }
+  }
+
+  if (!ok || !block->finalize()) {
+    return nullptr;
+  }
+  return block;
 }
 
+void RulesHelperClass::compilePrograms(uint32_t sourceCRC)
+{
+  START_TIMER
+  # ifdef CACHE_RULES_IN_MEMORY
+  (void)sourceCRC; // Only needed to check the binary side-file
+  _programs.clear();
+  _programs.reserve(_eventCache.size());
+
+  for (auto it = _eventCache.begin(); it != _eventCache.end(); ++it) {
+    _programs.push_back(compileBlock(it->_filename, it->_posInFile));
+  }
+  # else // ifdef CACHE_RULES_IN_MEMORY
+
+  if (!loadProgramFile(sourceCRC)) {
+    writeProgramFile(sourceCRC);
+  }
+  # endif // ifdef CACHE_RULES_IN_MEMORY
+  STOP_TIMER(RULES_COMPILE);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    size_t nrCompiled{};
+    size_t nrBlocks{};
+    getProgramStats(nrCompiled, nrBlocks);
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("Rules : Compiled %u of %u rules blocks"),
+                 nrCompiled,
+                 nrBlocks));
+  }
+}
+
+RulesProgram_block_ptr RulesHelperClass::getProgram(size_t index)
+{
+  # ifdef CACHE_RULES_IN_MEMORY
+
+  if (index < _programs.size()) {
+    return _programs[index];
+  }
+  # else // ifdef CACHE_RULES_IN_MEMORY
+
+  if ((index < _programOffsets.size()) && (_programOffsets[index] != 0) && _programFile) {
+    if (_programFile.seek(_programOffsets[index])) {
+      std::shared_ptr<RulesProgram_block> block(new (std::nothrow) RulesProgram_block());
+
+      if (block && block->deserialize(_programFile)) {
+        return block;
+      }
+    }
+  }
+  # endif // ifdef CACHE_RULES_IN_MEMORY
+  return nullptr;
+}
+
+# ifndef CACHE_RULES_IN_MEMORY
+
+const __FlashStringHelper* getRulesProgramFileName() {
+  return F("rules.bin");
+}
+
+bool RulesHelperClass::loadProgramFile(uint32_t sourceCRC)
+{
+  _programOffsets.clear();
+
+  if (_programFile) {
+    _programFile.close();
+  }
+  fs::File f = tryOpenFile(getRulesProgramFileName(), "r");
+
+  if (!f) {
+    return false;
+  }
+  uint32_t magic{};
+  uint16_t version{};
+  uint16_t nrBlocks{};
+  uint32_t crc{};
+  bool     valid =
+    (f.read(reinterpret_cast<uint8_t *>(&magic), sizeof(magic)) == sizeof(magic)) &&
+    (f.read(reinterpret_cast<uint8_t *>(&version), sizeof(version)) == sizeof(version)) &&
+    (f.read(reinterpret_cast<uint8_t *>(&nrBlocks), sizeof(nrBlocks)) == sizeof(nrBlocks)) &&
+    (f.read(reinterpret_cast<uint8_t *>(&crc), sizeof(crc)) == sizeof(crc));
+
+  valid = valid &&
+          (magic == RULES_PROGRAM_FILE_MAGIC) &&
+          (version == RULES_PROGRAM_FILE_VERSION) &&
+          (nrBlocks == _eventCache.size()) &&
+          (crc == sourceCRC);
+
+  // Collect the offset of each block
+  uint32_t offset = f.position();
+
+  for (uint16_t i = 0; valid && i < nrBlocks; ++i) {
+    uint32_t size{};
+    valid = f.seek(offset) &&
+            (f.read(reinterpret_cast<uint8_t *>(&size), sizeof(size)) == sizeof(size));
+
+    if (valid) {
+      _programOffsets.push_back(size == 0 ? 0 : offset);
+      offset += sizeof(size) + size;
+    }
+  }
+
+  if (!valid || (offset != f.size())) {
+    _programOffsets.clear();
+    f.close();
+    return false;
+  }
+  _programFile = f;
+  return true;
+}
+
+void RulesHelperClass::writeProgramFile(uint32_t sourceCRC)
+{
+  _programOffsets.clear();
+
+  if (_programFile) {
+    _programFile.close();
+  }
+  fs::File f = tryOpenFile(getRulesProgramFileName(), "w");
+
+  if (!f) {
+    return;
+  }
+  const uint32_t magic    = RULES_PROGRAM_FILE_MAGIC;
+  const uint16_t version  = RULES_PROGRAM_FILE_VERSION;
+  const uint16_t nrBlocks = _eventCache.size();
+
+  f.write(reinterpret_cast<const uint8_t *>(&magic),     sizeof(magic));
+  f.write(reinterpret_cast<const uint8_t *>(&version),   sizeof(version));
+  f.write(reinterpret_cast<const uint8_t *>(&nrBlocks),  sizeof(nrBlocks));
+  f.write(reinterpret_cast<const uint8_t *>(&sourceCRC), sizeof(sourceCRC));
+
+  uint32_t offset = f.position();
+  bool     valid  = true;
+
+  for (auto it = _eventCache.begin(); valid && it != _eventCache.end(); ++it) {
+    RulesProgram_block_ptr block = compileBlock(it->_filename, it->_posInFile);
+    size_t written               = 0;
+
+    if (block) {
+      written = block->serialize(f);
+      _programOffsets.push_back(written == 0 ? 0 : offset);
+    } else {
+      const uint32_t size = 0;
+      written = f.write(reinterpret_cast<const uint8_t *>(&size), sizeof(size));
+      _programOffsets.push_back(0);
+    }
+
+    if (written == 0) {
+      // Probably file system full, use the text based rules engine.
+      valid = false;
+    }
+    offset += written;
+  }
+  f.close();
+
+  if (!valid) {
+    _programOffsets.clear();
+    tryDeleteFile(getRulesProgramFileName());
+    return;
+  }
+  _programFile = tryOpenFile(getRulesProgramFileName(), "r");
+}
+
+# endif // ifndef CACHE_RULES_IN_MEMORY
+#endif // if FEATURE_RULES_COMPILER
+
 void RulesHelperClass::closeAllFiles() {
   for (auto it = _fileHandleMap.begin(); it != _fileHandleMap.end();) {
     #ifdef CACHE_RULES_IN_MEMORY
@@ -188,6 +465,17 @@ void RulesHelperClass::closeAllFiles() {
     #endif // ifdef CACHE_RULES_IN_MEMORY
   }
   _eventCache.clear();
+  #if FEATURE_RULES_COMPILER
+  # ifdef CACHE_RULES_IN_MEMORY
+  _programs.clear();
+  # else // ifdef CACHE_RULES_IN_MEMORY
+  _programOffsets.clear();
+
+  if (_programFile) {
+    _programFile.close();
+  }
+  # endif // ifdef CACHE_RULES_IN_MEMORY
+  #endif // if FEATURE_RULES_COMPILER
 }
 
 #ifndef CACHE_RULES_IN_MEMORY
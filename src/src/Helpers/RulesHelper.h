@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/RulesEventCache.h"
+#include "../DataStructs/RulesProgram.h"
 
 #include <FS.h>
 #include <map>
@@ -40,8 +41,53 @@ public:
                         String      & filename,
                         size_t      & pos);
 
+  // Statistics of the event lookups in the rules event cache
+  const RulesEventCache_stats& getEventCacheStats() const {
+    return _eventCache.getStats();
+  }
+
+  void resetEventCacheStats() {
+    _eventCache.resetStats();
+  }
+
+#if FEATURE_RULES_COMPILER
+
+  // Same as above, but also return the compiled program of the matched rules block.
+  // program is nullptr when the block could not be compiled
+  // and thus must be processed by the text based rules engine.
+  bool findMatchingRule(const String          & event,
+                        String                & filename,
+                        size_t                & pos,
+                        RulesProgram_block_ptr& program);
+
+  // Number of compiled rules blocks and total number of rules blocks
+  void getProgramStats(size_t& nrCompiled,
+                       size_t& nrBlocks) const;
+
+#endif // if FEATURE_RULES_COMPILER
+
 private:
 
+#if FEATURE_RULES_COMPILER
+
+  // Compile the rules block starting at pos
+  RulesProgram_block_ptr compileBlock(const String& filename,
+                                      size_t        pos);
+
+  void                   compilePrograms(uint32_t sourceCRC);
+
+  RulesProgram_block_ptr getProgram(size_t index);
+
+# ifndef CACHE_RULES_IN_MEMORY
+
+  // Try to use the compiled program stored in the binary side-file.
+  bool loadProgramFile(uint32_t sourceCRC);
+
+  void writeProgramFile(uint32_t sourceCRC);
+
+# endif // ifndef CACHE_RULES_IN_MEMORY
+#endif // if FEATURE_RULES_COMPILER
+
 #ifndef CACHE_RULES_IN_MEMORY
   size_t read(const String& filename,
               size_t      & pos,
@@ -77,6 +123,20 @@ private:
   RulesEventCache _eventCache;
 
   FileHandleMap _fileHandleMap;
+
+#if FEATURE_RULES_COMPILER
+# ifdef CACHE_RULES_IN_MEMORY
+
+  // Compiled rules blocks, same index as the event cache
+  std::vector<RulesProgram_block_ptr>_programs;
+# else // ifdef CACHE_RULES_IN_MEMORY
+
+  // Offset of each compiled rules block in the binary side-file, same index as the event cache.
+  // 0 = not compiled
+  std::vector<uint32_t>_programOffsets;
+  fs::File _programFile;
+# endif // ifdef CACHE_RULES_IN_MEMORY
+#endif // if FEATURE_RULES_COMPILER
 };
 
 #endif // ifndef HELPERS_RULESHELPER_H
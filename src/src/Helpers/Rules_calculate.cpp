@@ -3,6 +3,7 @@
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/RamTracker.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasy_math.h"
 #include "../Helpers/Hardware.h"
 #include "../Helpers/Numerical.h"
@@ -295,32 +296,24 @@ ESPEASY_RULES_FLOAT_TYPE RulesCalculate_t::apply_quinary_operator(char op,
    return linep;
    }
  */
-CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
+CalculateReturnCode RulesCalculate_t::applyOperatorOnStack(char op)
 {
-  CalculateReturnCode ret = CalculateReturnCode::OK;
-
-  if (token[0] == 0) {
-    return ret; // Don't bother for an empty string
-  }
-
-  if (is_operator(token[0]) && (token[1] == 0))
+  if (is_operator(op))
   {
     ESPEASY_RULES_FLOAT_TYPE second = pop();
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
-    ret = push(apply_operator(token[0], first, second));
+    return push(apply_operator(op, first, second));
+  }
 
-// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
-//    if (isError(ret)) { return ret; }
-  } else if (is_unary_operator(token[0]) && (token[1] == 0))
+  if (is_unary_operator(op))
   {
     ESPEASY_RULES_FLOAT_TYPE first = pop();
 
-    ret = push(apply_unary_operator(token[0], first));
+    return push(apply_unary_operator(op, first));
+  }
 
-// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
-//    if (isError(ret)) { return ret; }
-  } else if (is_quinary_operator(token[0]) && (token[1] == 0))
+  if (is_quinary_operator(op))
   {
     ESPEASY_RULES_FLOAT_TYPE fifth  = pop();
     ESPEASY_RULES_FLOAT_TYPE fourth = pop();
@@ -328,8 +321,30 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE second = pop();
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
-    ret = push(apply_quinary_operator(token[0], first, second, third, fourth, fifth));
+    return push(apply_quinary_operator(op, first, second, third, fourth, fifth));
+  }
+  return CalculateReturnCode::ERROR_BAD_OPERATOR;
+}
+
+CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
+{
+  if (_compileTarget != nullptr) {
+    return compileToken(token);
+  }
+
+  CalculateReturnCode ret = CalculateReturnCode::OK;
 
+  if (token[0] == 0) {
+    return ret; // Don't bother for an empty string
+  }
+
+  if ((token[1] == 0) &&
+      (is_operator(token[0]) || is_unary_operator(token[0]) || is_quinary_operator(token[0])))
+  {
+    ret = applyOperatorOnStack(token[0]);
+
+// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
+//    if (isError(ret)) { return ret; }
   } else {
     // Fetch next if there is any
     ESPEASY_RULES_FLOAT_TYPE value{};
@@ -344,6 +359,77 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
   return ret;
 }
 
+bool RulesCalculate_t::is_slot(char c) const
+{
+  return _compileTarget != nullptr && c > 0 && c <= static_cast<char>(_compileNrSlots);
+}
+
+CalculateReturnCode RulesCalculate_t::compileToken(const char *token)
+{
+  if (token[0] == 0) {
+    return CalculateReturnCode::OK;
+  }
+
+  RulesCalculate_program::Element element;
+
+  if (token[1] == 0) {
+    const char op = token[0];
+
+    if (is_slot(op)) {
+      if (_compileStackDepth >= STACK_SIZE) {
+        return CalculateReturnCode::ERROR_STACK_OVERFLOW;
+      }
+      ++_compileStackDepth;
+      element.type = RulesCalculate_program::Type::Slot;
+      element.op   = op - 1;
+      _compileTarget->elements.push_back(element);
+      return CalculateReturnCode::OK;
+    }
+
+    const unsigned int nrArgs = op_arg_count(op);
+
+    if (nrArgs > 0) {
+      // Keep track of the stack depth as it would be when calculating.
+      // N.B. pop() on an empty stack returns 0
+      const int nrPop = nrArgs;
+      _compileStackDepth = (_compileStackDepth > nrPop ? _compileStackDepth - nrPop : 0) + 1;
+
+      auto& elements     = _compileTarget->elements;
+      const size_t size  = elements.size();
+      bool allConstant   = size >= nrArgs;
+
+      for (size_t i = size - nrArgs; allConstant && i < size; ++i) {
+        allConstant = elements[i].type == RulesCalculate_program::Type::Value;
+      }
+
+      if (allConstant) {
+        // All arguments are known, so replace them by the result.
+        sp = globalstack - 1;
+
+        for (size_t i = size - nrArgs; i < size; ++i) {
+          push(elements[i].value);
+        }
+        applyOperatorOnStack(op);
+        element.value = pop();
+        elements.resize(size - nrArgs);
+      } else {
+        element.type = RulesCalculate_program::Type::Operator;
+        element.op   = op;
+      }
+      elements.push_back(element);
+      return CalculateReturnCode::OK;
+    }
+  }
+
+  if (_compileStackDepth >= STACK_SIZE) {
+    return CalculateReturnCode::ERROR_STACK_OVERFLOW;
+  }
+  ++_compileStackDepth;
+  validDoubleFromString(token, element.value);
+  _compileTarget->elements.push_back(element);
+  return CalculateReturnCode::OK;
+}
+
 // operators
 // precedence   operators         associativity
 // 4            !                 right to left
@@ -431,6 +517,16 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
       // If the token is a number (identifier), then add it to the token queue.
       if (is_number(oc, c))
       {
+        // A slot cannot be part of a number
+        if ((TokenPos != token) && is_slot(token[0])) { return CalculateReturnCode::ERROR_UNKNOWN_TOKEN; }
+        *TokenPos = c;
+        ++TokenPos;
+      }
+
+      // Slot for a value in a compiled program
+      else if (is_slot(c))
+      {
+        if (TokenPos != token) { return CalculateReturnCode::ERROR_UNKNOWN_TOKEN; }
         *TokenPos = c;
         ++TokenPos;
       }
@@ -577,6 +673,12 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     *result = 0;
     return error;
   }
+
+  if (_compileTarget != nullptr) {
+    // Only compiled, not calculated
+    *result = 0;
+    return CalculateReturnCode::OK;
+  }
   *result = *sp;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate2"));
@@ -584,6 +686,135 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   return CalculateReturnCode::OK;
 }
 
+CalculateReturnCode RulesCalculate_t::compile(const String                    & preprocessd_input,
+                                              const __FlashStringHelper * const slotNames[],
+                                              uint8_t                           nrSlots,
+                                              RulesCalculate_program          & program)
+{
+  program.clear();
+
+  if (nrSlots > RULES_CALCULATE_MAX_SLOTS) {
+    return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+  }
+
+  // Replace the slot names by a single (non printable) char.
+  String input(preprocessd_input);
+
+  for (uint8_t i = 0; i < nrSlots; ++i) {
+    input.replace(slotNames[i], String(static_cast<char>(i + 1)));
+  }
+
+  _compileTarget     = &program;
+  _compileNrSlots    = nrSlots;
+  _compileStackDepth = 0;
+
+  ESPEASY_RULES_FLOAT_TYPE dummy{};
+  const CalculateReturnCode ret = doCalculate(input.c_str(), &dummy);
+
+  _compileTarget  = nullptr;
+  _compileNrSlots = 0;
+
+  if (isError(ret)) {
+    program.clear();
+  } else {
+    program.valid = true;
+  }
+  return ret;
+}
+
+CalculateReturnCode RulesCalculate_t::evaluate(const RulesCalculate_program  & program,
+                                               const ESPEASY_RULES_FLOAT_TYPE slotValues[],
+                                               uint8_t                        nrSlots,
+                                               ESPEASY_RULES_FLOAT_TYPE     & result)
+{
+  result = 0;
+
+  if (!program.valid) {
+    return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+  }
+  sp = globalstack - 1;
+
+  for (auto it = program.elements.begin(); it != program.elements.end(); ++it) {
+    CalculateReturnCode ret = CalculateReturnCode::OK;
+
+    switch (it->type) {
+      case RulesCalculate_program::Type::Value:
+        ret = push(it->value);
+        break;
+      case RulesCalculate_program::Type::Slot:
+        ret = push(it->op < nrSlots ? slotValues[it->op] : 0);
+        break;
+      case RulesCalculate_program::Type::Operator:
+        ret = applyOperatorOnStack(it->op);
+        break;
+    }
+
+    if (isError(ret)) {
+      return ret;
+    }
+  }
+
+  if (sp != (globalstack - 1)) {
+    result = *sp;
+  }
+  return CalculateReturnCode::OK;
+}
+
+#if RULES_CALCULATE_CACHE_SIZE > 0
+CalculateReturnCode RulesCalculate_t::calculateCached(const String& input, ESPEASY_RULES_FLOAT_TYPE& result)
+{
+  const uint32_t hash = calc_CRC32(reinterpret_cast<const uint8_t *>(input.c_str()), input.length());
+
+  RulesCalculate_cacheEntry *leastRecentlyUsed = &_cache[0];
+
+  for (size_t i = 0; i < RULES_CALCULATE_CACHE_SIZE; ++i) {
+    RulesCalculate_cacheEntry& entry = _cache[i];
+
+    if ((entry.lastUsed != 0) && (entry.hash == hash) && entry.expression.equals(input)) {
+      entry.lastUsed = ++_cacheUseCounter;
+      return evaluate(entry.program, nullptr, 0, result);
+    }
+
+    if (entry.lastUsed < leastRecentlyUsed->lastUsed) {
+      leastRecentlyUsed = &entry;
+    }
+  }
+
+  const String preprocessed = preProces(input);
+
+  if (!seenBefore(hash)) {
+    return doCalculate(preprocessed.c_str(), &result);
+  }
+  RulesCalculate_program program;
+
+  if (isError(compile(preprocessed, nullptr, 0, program))) {
+    // Let the calculation report the error
+    return doCalculate(preprocessed.c_str(), &result);
+  }
+
+  leastRecentlyUsed->expression = input;
+  leastRecentlyUsed->program    = std::move(program);
+  leastRecentlyUsed->hash       = hash;
+  leastRecentlyUsed->lastUsed   = ++_cacheUseCounter;
+  return evaluate(leastRecentlyUsed->program, nullptr, 0, result);
+}
+
+bool RulesCalculate_t::seenBefore(uint32_t hash)
+{
+  for (size_t i = 0; i < RULES_CALCULATE_SEEN_SIZE; ++i) {
+    if (_seen[i] == hash) {
+      // A hash collision only means an expression is compiled on its first use.
+      _seen[i] = 0;
+      return true;
+    }
+  }
+  _seen[_seenIndex] = hash;
+  _seenIndex        = (_seenIndex + 1) % RULES_CALCULATE_SEEN_SIZE;
+  return false;
+}
+
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
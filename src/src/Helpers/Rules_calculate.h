@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <vector>
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
@@ -62,6 +64,68 @@ void   preProcessReplace(String      & input,
 bool   angleDegree(UnaryOperator op);
 const __FlashStringHelper* toString(UnaryOperator op);
 
+
+/********************************************************************************************\
+   Compiled expression in Reverse Polish Notation.
+   Constant sub-expressions are already evaluated at compile time.
+   Slots are placeholders for numerical values (e.g. %value%) which are
+   only known when the expression is evaluated.
+ \*********************************************************************************************/
+struct RulesCalculate_program {
+  enum class Type : uint8_t {
+    Value,   // Push constant value
+    Slot,    // Push value of a slot
+    Operator // Apply operator on values on the stack
+
+  };
+
+  struct Element {
+    ESPEASY_RULES_FLOAT_TYPE value{};
+    Type                     type = Type::Value;
+
+    // Operator: the (single char) operator
+    // Slot: slot index
+    uint8_t                  op = 0;
+  };
+
+  void clear() {
+    elements.clear();
+    valid = false;
+  }
+
+  std::vector<Element>elements;
+
+  // Set when compiled successfully
+  bool valid = false;
+};
+
+#define RULES_CALCULATE_MAX_SLOTS 4
+
+// Nr. of compiled expressions kept by calculateCached()
+#ifndef RULES_CALCULATE_CACHE_SIZE
+# ifdef LIMIT_BUILD_SIZE
+#  define RULES_CALCULATE_CACHE_SIZE 0
+# elif defined(ESP32)
+#  define RULES_CALCULATE_CACHE_SIZE 16
+# else
+#  define RULES_CALCULATE_CACHE_SIZE 8
+# endif
+#endif
+
+// Nr. of expressions remembered (by hash) which were seen once, but not compiled yet.
+#ifndef RULES_CALCULATE_SEEN_SIZE
+# define RULES_CALCULATE_SEEN_SIZE (2 * RULES_CALCULATE_CACHE_SIZE)
+#endif
+
+#if RULES_CALCULATE_CACHE_SIZE > 0
+struct RulesCalculate_cacheEntry {
+  String                 expression;
+  RulesCalculate_program program;
+  uint32_t               hash     = 0;
+  uint32_t               lastUsed = 0; // 0 = never used
+};
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
+
 class RulesCalculate_t {
 private:
 
@@ -103,6 +167,36 @@ private:
 
   CalculateReturnCode RPNCalculate(char *token);
 
+  // Placeholder for a slot in the input of compile()
+  bool                is_slot(char c) const;
+
+  // Add token to the program being compiled.
+  CalculateReturnCode compileToken(const char *token);
+
+  // Apply operator on the values on the stack
+  CalculateReturnCode applyOperatorOnStack(char op);
+
+  // Program being compiled, nullptr when calculating
+  RulesCalculate_program *_compileTarget = nullptr;
+  uint8_t _compileNrSlots                = 0;
+
+  // Stack depth at the same moment during doCalculate()
+  int _compileStackDepth = 0;
+
+#if RULES_CALCULATE_CACHE_SIZE > 0
+
+  // Return true when the hash was already seen, else remember it.
+  bool seenBefore(uint32_t hash);
+
+  // Least recently used cache of compiled expressions
+  RulesCalculate_cacheEntry _cache[RULES_CALCULATE_CACHE_SIZE];
+  uint32_t _cacheUseCounter = 0;
+
+  // Ring buffer of hashes of expressions seen once
+  uint32_t _seen[RULES_CALCULATE_SEEN_SIZE]{};
+  uint16_t _seenIndex = 0;
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
+
   // operators
   // precedence   operators         associativity
   // 3            !                 right to left
@@ -121,6 +215,31 @@ public:
   CalculateReturnCode doCalculate(const char *input,
                                   ESPEASY_RULES_FLOAT_TYPE     *result);
 
+  // Compile a preprocessed expression into a RPN program.
+  // slotNames are the placeholders (e.g. "%value%") in the input
+  // which can be given a value when evaluating the program.
+  // Program is not valid when a returned error or the input contains unknown tokens.
+  CalculateReturnCode compile(const String                    & preprocessd_input,
+                              const __FlashStringHelper * const slotNames[],
+                              uint8_t                           nrSlots,
+                              RulesCalculate_program          & program);
+
+  CalculateReturnCode evaluate(const RulesCalculate_program  & program,
+                               const ESPEASY_RULES_FLOAT_TYPE slotValues[],
+                               uint8_t                        nrSlots,
+                               ESPEASY_RULES_FLOAT_TYPE     & result);
+
+#if RULES_CALCULATE_CACHE_SIZE > 0
+
+  // Same as doCalculate(preProces(input)), but keep the compiled
+  // expression so a repeated expression is only evaluated.
+  // The input usually has variables already substituted, so an expression
+  // is only compiled when it is seen for the second time.
+  // Expressions with changing values then do not evict the cached ones.
+  CalculateReturnCode calculateCached(const String            & input,
+                                      ESPEASY_RULES_FLOAT_TYPE& result);
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
@@ -95,8 +95,8 @@ void ESPEasy_Scheduler::handle_schedule() {
   STOP_TIMER(HANDLE_SCHEDULER_TASK);
 }
 
-String ESPEasy_Scheduler::getQueueStats() {
-  return msecTimerHandler.getQueueStats();
+String ESPEasy_Scheduler::getQueueStats(bool clearStats) {
+  return msecTimerHandler.getQueueStats(clearStats);
 }
 
 void ESPEasy_Scheduler::updateIdleTimeStats() {
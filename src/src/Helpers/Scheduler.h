@@ -290,7 +290,7 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
   * Statistics
   \*********************************************************************************************/
 
-  String getQueueStats();
+  String getQueueStats(bool clearStats);
 
   void   updateIdleTimeStats();
 
@@ -20,6 +20,7 @@
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_GPIO.h"
+#include "../Helpers/TemplateProgram.h"
 
 
 
@@ -58,18 +59,9 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize)
   return parseTemplate_padded(tmpString, minimal_lineSize, false);
 }
 
-String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool useURLencode)
+// Replace system variables and [...#...] in tmpString and append the result to newString.
+static void parseTemplate_replace(String& tmpString, String& newString, uint8_t minimal_lineSize, bool useURLencode)
 {
-  #ifndef BUILD_NO_RAM_TRACKER
-  checkRAM(F("parseTemplate_padded"));
-  #endif // ifndef BUILD_NO_RAM_TRACKER
-  START_TIMER;
-
-  // Keep current loaded taskSettings to restore at the end.
-  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
-  String newString;
-  newString.reserve(minimal_lineSize); // Our best guess of the new size.
-
   if (parseTemplate_CallBack_ptr != nullptr) {
     parseTemplate_CallBack_ptr(tmpString, useURLencode);
   }
@@ -244,6 +236,45 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
     MaskEscapedBracket = static_cast<char>(0x06); // ASCII 0x06 = Acknowledge ACK
     newString.replace(MaskEscapedBracket, F("\\]"));
   }
+}
+
+String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool useURLencode)
+{
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("parseTemplate_padded"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  START_TIMER;
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  String newString;
+  newString.reserve(minimal_lineSize); // Our best guess of the new size.
+
+  bool rendered = false;
+
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  if (parseTemplate_CallBack_ptr == nullptr) {
+    // Task and value names are only looked up when the template is compiled.
+    const TemplateProgram *program = Cache.templatePrograms.get(tmpString);
+
+    if (program != nullptr) {
+      START_TIMER;
+      rendered = program->render(newString, minimal_lineSize, useURLencode, tmpString);
+      STOP_TIMER(PARSE_TEMPLATE_RENDER);
+
+      if (!rendered) {
+        // Some value must be parsed again, parse the entire template.
+        newString = String();
+        newString.reserve(minimal_lineSize);
+      }
+    }
+  }
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  if (!rendered) {
+    parseTemplate_replace(tmpString, newString, minimal_lineSize, useURLencode);
+  }
 
   // Restore previous loaded taskSettings
   if (validTaskIndex(currentTaskIndex))
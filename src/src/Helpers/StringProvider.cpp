@@ -19,6 +19,7 @@
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/EventQueue.h"
 
 #if FEATURE_ETHERNET
 #include "../Globals/ESPEasyEthEvent.h"
@@ -27,6 +28,7 @@
 #include "../Globals/NetworkState.h"
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SyslogQueue.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
 #include "../Helpers/Convert.h"
@@ -72,6 +74,12 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::LOAD_PCT:               return F("Load");
     case LabelType::LOOP_COUNT:             return F("Load LC");
     case LabelType::CPU_ECO_MODE:           return F("CPU Eco Mode");
+    case LabelType::EVENT_QUEUE_LENGTH:     return F("Event Queue Length");
+    case LabelType::EVENT_QUEUE_PEAK_LENGTH: return F("Event Queue Peak Length");
+    case LabelType::EVENT_QUEUE_DROPPED:    return F("Event Queue Dropped");
+    case LabelType::EVENT_QUEUE_DEDUPLICATED: return F("Event Queue Deduplicated");
+    case LabelType::EVENT_QUEUE_COALESCED:  return F("Event Queue Coalesced");
+    case LabelType::EVENT_QUEUE_OVERFLOW_POLICY: return F("Event Queue Overflow Policy");
 #if FEATURE_SET_WIFI_TX_PWR
     case LabelType::WIFI_TX_MAX_PWR:        return F("Max WiFi TX Power");
     case LabelType::WIFI_CUR_TX_PWR:        return F("Current WiFi TX Power");
@@ -227,6 +235,8 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::I2C_BUS_CLEARED_COUNT:  return F("I2C bus cleared count");
 
     case LabelType::SYSLOG_LOG_LEVEL:       return F("Syslog Log Level");
+    case LabelType::SYSLOG_SENT:            return F("Syslog Lines Sent");
+    case LabelType::SYSLOG_DROPPED:         return F("Syslog Lines Dropped");
     case LabelType::SERIAL_LOG_LEVEL:       return F("Serial Log Level");
     case LabelType::WEB_LOG_LEVEL:          return F("Web Log Level");
   #if FEATURE_SD
@@ -358,6 +368,12 @@ String getValue(LabelType::Enum label) {
     case LabelType::LOAD_PCT:               return toString(getCPUload(), 2);
     case LabelType::LOOP_COUNT:             retval = getLoopCountPerSec(); break;
     case LabelType::CPU_ECO_MODE:           return jsonBool(Settings.EcoPowerMode());
+    case LabelType::EVENT_QUEUE_LENGTH:     retval = eventQueue.size(); break;
+    case LabelType::EVENT_QUEUE_PEAK_LENGTH: retval = eventQueue.getStats().peakLength; break;
+    case LabelType::EVENT_QUEUE_DROPPED:    return String(eventQueue.getStats().dropped);
+    case LabelType::EVENT_QUEUE_DEDUPLICATED: return String(eventQueue.getStats().deduplicated);
+    case LabelType::EVENT_QUEUE_COALESCED:  return String(eventQueue.getStats().coalesced);
+    case LabelType::EVENT_QUEUE_OVERFLOW_POLICY: return toString(Settings.EventQueueOverflowPolicy());
 #if FEATURE_SET_WIFI_TX_PWR
     case LabelType::WIFI_TX_MAX_PWR:        return toString(Settings.getWiFi_TX_power(), 2);
     case LabelType::WIFI_CUR_TX_PWR:        return toString(WiFiEventData.wifi_TX_pwr, 2);
@@ -566,6 +582,8 @@ String getValue(LabelType::Enum label) {
     case LabelType::I2C_BUS_STATE:          return toString(I2C_state);
     case LabelType::I2C_BUS_CLEARED_COUNT:  retval = I2C_bus_cleared_count; break;
     case LabelType::SYSLOG_LOG_LEVEL:       return getLogLevelDisplayString(Settings.SyslogLevel);
+    case LabelType::SYSLOG_SENT:            return String(syslogQueue.getStats().sent);
+    case LabelType::SYSLOG_DROPPED:         return String(syslogQueue.getStats().dropped);
     case LabelType::SERIAL_LOG_LEVEL:       return getLogLevelDisplayString(getSerialLogLevel());
     case LabelType::WEB_LOG_LEVEL:          return getLogLevelDisplayString(getWebLogLevel());
   #if FEATURE_SD
@@ -22,6 +22,12 @@ struct LabelType {
     LOAD_PCT,            // 15.10
     LOOP_COUNT,          // 400
     CPU_ECO_MODE,        // true
+    EVENT_QUEUE_LENGTH,  // 3
+    EVENT_QUEUE_PEAK_LENGTH,
+    EVENT_QUEUE_DROPPED,
+    EVENT_QUEUE_DEDUPLICATED,
+    EVENT_QUEUE_COALESCED,
+    EVENT_QUEUE_OVERFLOW_POLICY,
 #if FEATURE_SET_WIFI_TX_PWR
     WIFI_TX_MAX_PWR,     // Unit: 0.25 dBm, 0 = use default (do not set)
     WIFI_CUR_TX_PWR,     // Unit dBm of current WiFi TX power.
@@ -175,6 +181,8 @@ struct LabelType {
     I2C_BUS_CLEARED_COUNT,
 
     SYSLOG_LOG_LEVEL,
+    SYSLOG_SENT,
+    SYSLOG_DROPPED,
     SERIAL_LOG_LEVEL,
     WEB_LOG_LEVEL,
 #if FEATURE_SD
@@ -0,0 +1,454 @@
+#include "../Helpers/TemplateProgram.h"
+
+#if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+# include "../DataStructs/TimingStats.h"
+# include "../Globals/RuntimeData.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_math.h"
+# include "../Helpers/Numerical.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+# include "../Helpers/SystemVariables.h"
+
+// Takes the place of a system variable or %vN% while looking for [...#...]
+# define TEMPLATE_PLACEHOLDER              static_cast<char>(0x01)
+
+// Same masking of \[ and \] as in parseTemplate_padded()
+# define TEMPLATE_ESCAPED_OPEN_BRACKET     static_cast<char>(0x05)
+# define TEMPLATE_ESCAPED_CLOSE_BRACKET    static_cast<char>(0x06)
+
+namespace {
+bool isNameChar(char c) {
+  return isAlphaNumeric(c) || (c == '_') || (c == TEMPLATE_PLACEHOLDER);
+}
+}
+
+bool TemplateProgram::compile(const String& input)
+{
+  clear();
+
+  const int length = input.length();
+
+  if ((length > 0xFFFF) ||
+      (input.indexOf(F("%sunrise")) != -1) ||
+      (input.indexOf(F("%sunset")) != -1)) {
+    // %sunrise% and %sunset% may have an offset, e.g. %sunrise-1h%
+    return false;
+  }
+
+  // The input with placeholders for the system variables and %vN%
+  String masked;
+  std::vector<Span> dynamicSpans;
+
+  masked.reserve(length);
+
+  int pos = 0;
+
+  while (pos < length) {
+    const char c = input[pos];
+
+    if ((c == TEMPLATE_PLACEHOLDER) ||
+        (c == TEMPLATE_ESCAPED_OPEN_BRACKET) ||
+        (c == TEMPLATE_ESCAPED_CLOSE_BRACKET)) {
+      return false;
+    }
+
+    if (c != '%') {
+      masked += c;
+      ++pos;
+      continue;
+    }
+
+    // Same check as in parse_pct_v_num_pct()
+    const bool pct_v_num = (input.charAt(pos + 1) == 'v') && !isalpha(input.charAt(pos + 2));
+    const int  closing   = input.indexOf('%', pos + 1);
+
+    if (closing == -1) {
+      if (pct_v_num) {
+        return false;
+      }
+      masked += c;
+      ++pos;
+      continue;
+    }
+    Span span;
+    bool isDynamic = false;
+
+    if (pct_v_num) {
+      // Only plain variable numbers, no calculations or nested variables
+      if (closing == (pos + 2)) {
+        return false;
+      }
+
+      for (int i = pos + 2; i < closing; ++i) {
+        if (!isDigit(input[i])) {
+          return false;
+        }
+      }
+      span.type = SpanType::CustomVar;
+
+      if (!validUIntFromString(input.substring(pos + 2, closing), span.varNr)) {
+        return false;
+      }
+      isDynamic = true;
+    } else {
+      const String name = input.substring(pos + 1, closing);
+
+      for (uint8_t i = 0; i < SystemVariables::Enum::UNKNOWN && !isDynamic; ++i) {
+        const SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
+
+        if ((enumval != SystemVariables::Enum::SUNRISE) &&
+            (enumval != SystemVariables::Enum::SUNSET) &&
+            (enumval != SystemVariables::Enum::VARIABLE) &&
+            equals(name, SystemVariables::toFlashString(enumval))) {
+          span.type  = SpanType::SystemVariable;
+          span.index = enumval;
+          isDynamic  = true;
+        }
+      }
+    }
+
+    if (!isDynamic) {
+      masked += c;
+      ++pos;
+      continue;
+    }
+
+    // The closing '%' may also be the start of another system variable, e.g. "%unit%sysname%"
+    int next = closing + 1;
+
+    while ((next < length) && isNameChar(input[next])) {
+      ++next;
+    }
+
+    if ((next > (closing + 1)) && (next < length) && (input[next] == '%')) {
+      return false;
+    }
+
+    masked += TEMPLATE_PLACEHOLDER;
+    dynamicSpans.push_back(span);
+    pos = closing + 1;
+  }
+
+  // A value may form a new system variable with the surrounding text, e.g. "%v%unit%%"
+  const int maskedLength = masked.length();
+
+  for (int i = 0; i < maskedLength; ++i) {
+    if (masked[i] == TEMPLATE_PLACEHOLDER) {
+      int left = i - 1;
+
+      while ((left >= 0) && isNameChar(masked[left])) {
+        --left;
+      }
+      int right = i + 1;
+
+      while ((right < maskedLength) && isNameChar(masked[right])) {
+        ++right;
+      }
+
+      if ((left >= 0) && (masked[left] == '%') &&
+          (right < maskedLength) && (masked[right] == '%')) {
+        return false;
+      }
+    }
+  }
+
+  if (hasEscapedCharacter(masked, '[') || hasEscapedCharacter(masked, ']')) {
+    masked.replace(F("\\["), String(TEMPLATE_ESCAPED_OPEN_BRACKET));
+    masked.replace(F("\\]"), String(TEMPLATE_ESCAPED_CLOSE_BRACKET));
+  }
+
+  int    startpos     = 0;
+  int    lastStartpos = 0;
+  int    endpos       = 0;
+  size_t dynamicIndex = 0;
+  String deviceName, valueName, format;
+
+  while (findNextDevValNameInString(masked, startpos, endpos, deviceName, valueName, format)) {
+    for (int i = startpos; i <= endpos; ++i) {
+      if (masked[i] == TEMPLATE_PLACEHOLDER) {
+        // Task or value name depends on a system variable
+        return false;
+      }
+    }
+    addText(masked, lastStartpos, startpos, dynamicSpans, dynamicIndex);
+
+    if (!addReference(deviceName, valueName, format)) {
+      return false;
+    }
+    lastStartpos = endpos + 1;
+    startpos     = endpos + 1;
+  }
+  addText(masked, lastStartpos, masked.length(), dynamicSpans, dynamicIndex);
+
+  _spans.shrink_to_fit();
+  _valid = true;
+  return true;
+}
+
+bool TemplateProgram::render(String& output, uint8_t minimal_lineSize, bool useURLencode, const String& input) const
+{
+  if (!_valid) {
+    return false;
+  }
+
+  for (const Span& span : _spans) {
+    switch (span.type) {
+      case SpanType::Literal:
+        output.concat(_text.c_str() + span.start, span.length);
+        break;
+      case SpanType::SystemVariable:
+
+        if (!appendValue(output,
+                         SystemVariables::getSystemVariable(static_cast<SystemVariables::Enum>(span.index)),
+                         useURLencode)) {
+          return false;
+        }
+        break;
+      case SpanType::CustomVar:
+      {
+        const ESPEASY_RULES_FLOAT_TYPE floatvalue = getCustomFloatVar(span.varNr);
+        const unsigned char nr_decimals           = maxNrDecimals_fpType(floatvalue);
+        const bool trimTrailingZeros              = true;
+        # if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        const String value = doubleToString(floatvalue, nr_decimals, trimTrailingZeros);
+        # else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        const String value = floatToString(floatvalue, nr_decimals, trimTrailingZeros);
+        # endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+        if (!appendValue(output, value, useURLencode)) {
+          return false;
+        }
+        break;
+      }
+      case SpanType::CustomVarFloat:
+      case SpanType::CustomVarInt:
+      {
+        String format;
+        format.concat(_text.c_str() + span.start, span.length);
+
+        const ESPEASY_RULES_FLOAT_TYPE floatvalue = getCustomFloatVar(span.varNr);
+        unsigned char nr_decimals                 = maxNrDecimals_fpType(floatvalue);
+        bool trimTrailingZeros                    = true;
+
+        if (span.type == SpanType::CustomVarInt) {
+          nr_decimals = 0;
+        } else if (!format.isEmpty()) {
+          // There is some formatting here, so do not throw away decimals
+          trimTrailingZeros = false;
+        }
+        # if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        String value = doubleToString(floatvalue, nr_decimals, trimTrailingZeros);
+        # else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        String value = floatToString(floatvalue, nr_decimals, trimTrailingZeros);
+        # endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        transformValue(output, minimal_lineSize, std::move(value), format, input);
+        break;
+      }
+      case SpanType::TaskValue:
+
+        if (Settings.TaskDeviceEnabled[span.taskIndex]) {
+          bool   isvalid;
+          String value = formatUserVar(span.taskIndex, span.index, isvalid);
+
+          if (isvalid) {
+            String format;
+            format.concat(_text.c_str() + span.start, span.length);
+            transformValue(output, minimal_lineSize, std::move(value), format, input);
+          }
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+void TemplateProgram::clear()
+{
+  _spans.clear();
+  _text  = String();
+  _valid = false;
+}
+
+void TemplateProgram::addLiteral(const String& masked, int start, int end)
+{
+  if (start >= end) {
+    return;
+  }
+
+  if (!_spans.empty() && (_spans.back().type == SpanType::Literal) &&
+      ((_spans.back().start + _spans.back().length) == _text.length())) {
+    // Extend the previous literal
+  } else {
+    Span span;
+    span.start = _text.length();
+    _spans.push_back(span);
+  }
+
+  for (int i = start; i < end; ++i) {
+    const char c = masked[i];
+
+    if (c == TEMPLATE_ESCAPED_OPEN_BRACKET) {
+      _text += F("\\[");
+    } else if (c == TEMPLATE_ESCAPED_CLOSE_BRACKET) {
+      _text += F("\\]");
+    } else {
+      _text += c;
+    }
+  }
+  _spans.back().length = _text.length() - _spans.back().start;
+}
+
+void TemplateProgram::addText(const String     & masked,
+                              int                start,
+                              int                end,
+                              std::vector<Span>& dynamicSpans,
+                              size_t           & dynamicIndex)
+{
+  int literalStart = start;
+
+  for (int i = start; i < end; ++i) {
+    if (masked[i] == TEMPLATE_PLACEHOLDER) {
+      addLiteral(masked, literalStart, i);
+
+      if (dynamicIndex < dynamicSpans.size()) {
+        _spans.push_back(dynamicSpans[dynamicIndex]);
+        ++dynamicIndex;
+      }
+      literalStart = i + 1;
+    }
+  }
+  addLiteral(masked, literalStart, end);
+}
+
+bool TemplateProgram::addReference(const String& deviceName, const String& valueName, const String& format)
+{
+  Span span;
+
+  // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+  const bool devNameEqInt = equals(deviceName, F("int"));
+
+  if (devNameEqInt || equals(deviceName, F("var"))) {
+    if (!validUIntFromString(valueName, span.varNr)) {
+      // Not replaced by parseTemplate_padded() either
+      return true;
+    }
+    span.type = devNameEqInt ? SpanType::CustomVarInt : SpanType::CustomVarFloat;
+  } else if (equals(deviceName, F("plugin"))) {
+    // Plugin request, e.g. [Plugin#GPIO#Pinstate#N]
+    return false;
+  } else {
+    span.taskIndex = findTaskIndexByName(deviceName, true);
+
+    if (!validTaskIndex(span.taskIndex)) {
+      // Not replaced by parseTemplate_padded() either
+      // The cache is cleared when a task is added or renamed.
+      return true;
+    }
+
+    if (valueName.startsWith(F("settings."))) {
+      return false;
+    }
+    span.index = findDeviceValueIndexByName(valueName, span.taskIndex);
+
+    if (span.index == VARS_PER_TASK) {
+      // Config value, handled via PLUGIN_GET_CONFIG_VALUE
+      return false;
+    }
+    span.type = SpanType::TaskValue;
+  }
+
+  if (format.indexOf('R') != -1) {
+    // Right justify depends on the length of the entire template after replacing system variables
+    return false;
+  }
+  span.start = _text.length();
+  _text     += format;
+  span.length = format.length();
+  _spans.push_back(span);
+  return true;
+}
+
+bool TemplateProgram::appendValue(String& output, const String& value, bool useURLencode)
+{
+  if (useURLencode) {
+    // URL encoded values cannot contain characters parsed by parseTemplate_padded()
+    output += URLEncode(value);
+    return true;
+  }
+
+  for (const char c : { '%', '[', ']', '#', '\\' }) {
+    if (value.indexOf(c) != -1) {
+      // parseTemplate_padded() may parse the value itself
+      return false;
+    }
+  }
+  output += value;
+  return true;
+}
+
+const TemplateProgram * TemplateProgramCache::get(const String& input)
+{
+  const uint32_t hash = calc_CRC32(reinterpret_cast<const uint8_t *>(input.c_str()), input.length());
+
+  TemplateProgram_cacheEntry *leastRecentlyUsed = &_cache[0];
+
+  for (size_t i = 0; i < TEMPLATE_PROGRAM_CACHE_SIZE; ++i) {
+    TemplateProgram_cacheEntry& entry = _cache[i];
+
+    if ((entry.lastUsed != 0) && (entry.hash == hash) && entry.input.equals(input)) {
+      entry.lastUsed = ++_cacheUseCounter;
+      return entry.program.isValid() ? &entry.program : nullptr;
+    }
+
+    if (entry.lastUsed < leastRecentlyUsed->lastUsed) {
+      leastRecentlyUsed = &entry;
+    }
+  }
+
+  if (!seenBefore(hash)) {
+    return nullptr;
+  }
+
+  START_TIMER;
+  leastRecentlyUsed->program.compile(input);
+  leastRecentlyUsed->input    = input;
+  leastRecentlyUsed->hash     = hash;
+  leastRecentlyUsed->lastUsed = ++_cacheUseCounter;
+  STOP_TIMER(PARSE_TEMPLATE_COMPILE);
+
+  return leastRecentlyUsed->program.isValid() ? &leastRecentlyUsed->program : nullptr;
+}
+
+void TemplateProgramCache::clear()
+{
+  for (size_t i = 0; i < TEMPLATE_PROGRAM_CACHE_SIZE; ++i) {
+    _cache[i].input = String();
+    _cache[i].program.clear();
+    _cache[i].hash     = 0;
+    _cache[i].lastUsed = 0;
+  }
+
+  for (size_t i = 0; i < TEMPLATE_PROGRAM_SEEN_SIZE; ++i) {
+    _seen[i] = 0;
+  }
+  _seenIndex = 0;
+}
+
+bool TemplateProgramCache::seenBefore(uint32_t hash)
+{
+  for (size_t i = 0; i < TEMPLATE_PROGRAM_SEEN_SIZE; ++i) {
+    if (_seen[i] == hash) {
+      // A hash collision only means a template is compiled on its first use.
+      _seen[i] = 0;
+      return true;
+    }
+  }
+  _seen[_seenIndex] = hash;
+  _seenIndex        = (_seenIndex + 1) % TEMPLATE_PROGRAM_SEEN_SIZE;
+  return false;
+}
+
+#endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
@@ -0,0 +1,149 @@
+#ifndef HELPERS_TEMPLATEPROGRAM_H
+#define HELPERS_TEMPLATEPROGRAM_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+#include <vector>
+
+// Nr. of compiled templates kept by parseTemplate_padded()
+#ifndef TEMPLATE_PROGRAM_CACHE_SIZE
+# ifdef LIMIT_BUILD_SIZE
+#  define TEMPLATE_PROGRAM_CACHE_SIZE 0
+# elif defined(ESP32)
+#  define TEMPLATE_PROGRAM_CACHE_SIZE 32
+# else
+#  define TEMPLATE_PROGRAM_CACHE_SIZE 12
+# endif
+#endif
+
+// Nr. of templates remembered (by hash) which were seen once, but not compiled yet.
+#ifndef TEMPLATE_PROGRAM_SEEN_SIZE
+# define TEMPLATE_PROGRAM_SEEN_SIZE (2 * TEMPLATE_PROGRAM_CACHE_SIZE)
+#endif
+
+#if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+/*********************************************************************************************\
+ * TemplateProgram
+ *
+ * Template string as used by parseTemplate(), split in literal text and references to
+ * system variables, %vN%, [int#N], [var#N] and [task#value#format].
+ * Task and value names are resolved when compiling, so rendering is a single pass
+ * appending the literal text and the current values.
+ *
+ * Only templates which render exactly like the text replacements in parseTemplate_padded()
+ * can be compiled. For example templates with [plugin#...], %sunrise+1h% or nested %v%v1%%
+ * are not compiled and still parsed on every call.
+\*********************************************************************************************/
+struct TemplateProgram {
+  enum class SpanType : uint8_t {
+    Literal,
+    SystemVariable, // %sysname%
+    CustomVar,      // %vN%
+    CustomVarFloat, // [var#N#format]
+    CustomVarInt,   // [int#N#format]
+    TaskValue       // [task#value#format]
+  };
+
+  struct Span {
+    SpanType    type      = SpanType::Literal;
+    taskIndex_t taskIndex = INVALID_TASK_INDEX;
+
+    // SystemVariables::Enum or task value index
+    uint8_t  index{};
+
+    // Literal text or format, stored in _text
+    uint16_t start{};
+    uint16_t length{};
+
+    // Variable nr of %vN%, [int#N] and [var#N]
+    uint32_t varNr{};
+  };
+
+  // Returns false when the template cannot be compiled.
+  bool compile(const String& input);
+
+  // Append the rendered template to output, same as the replacements of system variables
+  // and [...#...] in parseTemplate_padded().
+  // Returns false when a value would have been parsed again by parseTemplate_padded(),
+  // for example a system variable with a '[' in its value.
+  // Then the output is incomplete and the template must be parsed as before.
+  bool render(String      & output,
+              uint8_t       minimal_lineSize,
+              bool          useURLencode,
+              const String& input) const;
+
+  bool isValid() const {
+    return _valid;
+  }
+
+  void clear();
+
+private:
+
+  void addLiteral(const String& masked,
+                  int           start,
+                  int           end);
+
+  // Move dynamic spans of placeholders in the literal text from 'dynamicSpans' to the program
+  void addText(const String           & masked,
+               int                      start,
+               int                      end,
+               std::vector<Span>      & dynamicSpans,
+               size_t                 & dynamicIndex);
+
+  bool addReference(const String& deviceName,
+                    const String& valueName,
+                    const String& format);
+
+  static bool appendValue(String      & output,
+                          const String& value,
+                          bool          useURLencode);
+
+  std::vector<Span> _spans;
+
+  // Literal text and format strings
+  String _text;
+  bool   _valid = false;
+};
+
+
+struct TemplateProgram_cacheEntry {
+  String          input;
+  TemplateProgram program;
+  uint32_t        hash     = 0;
+  uint32_t        lastUsed = 0; // 0 = never used
+};
+
+class TemplateProgramCache {
+public:
+
+  // Return the compiled template, or nullptr when the template cannot be compiled.
+  // Templates which cannot be compiled are also kept, so they are not compiled again.
+  // A template is only compiled when it is seen for the second time.
+  // Templates which change on every call (e.g. rules lines with substituted values)
+  // are then not compiled and do not evict compiled templates from the cache.
+  const TemplateProgram* get(const String& input);
+
+  // Must be called when task names, value names or plugins of tasks change.
+  void                   clear();
+
+private:
+
+  // Return true when the hash was already seen, else remember it.
+  bool seenBefore(uint32_t hash);
+
+  // Least recently used cache of compiled templates
+  TemplateProgram_cacheEntry _cache[TEMPLATE_PROGRAM_CACHE_SIZE];
+  uint32_t _cacheUseCounter = 0;
+
+  // Ring buffer of hashes of templates seen once
+  uint32_t _seen[TEMPLATE_PROGRAM_SEEN_SIZE]{};
+  uint16_t _seenIndex = 0;
+};
+
+#endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+#endif // ifndef HELPERS_TEMPLATEPROGRAM_H
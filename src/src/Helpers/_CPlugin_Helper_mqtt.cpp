@@ -3,6 +3,9 @@
 
 #if FEATURE_MQTT
 # include "../Commands/ExecuteCommand.h"
+# include "../Globals/Cache.h"
+# include "../Globals/ESPEasy_time.h"
+# include "../Globals/Settings.h"
 
 /***************************************************************************************
  * Parse MQTT topic for /cmd and /set ending to handle commands or TaskValueSet
@@ -185,25 +188,138 @@ void MQTT_execute_command(String& cmd,
   }
 }
 
-bool MQTT_protocol_send(EventStruct *event,
-                        String       pubname,
-                        bool         retainFlag) {
-  bool success                = false;
-  const bool contains_valname = pubname.indexOf(F("%valname%")) != -1;
+// Characters which make parseControllerVariables() replace more than the static variables
+static bool MQTT_isStaticTopicText(const String& text) {
+  for (const char c : { '%', '[', '{', '&', '\\' }) {
+    if (text.indexOf(c) != -1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Return true when the topic only refers to variables which do not change until the settings are saved.
+// For example %sysname%/%tskname%/%valname%, but not %sysname%/%systime%
+static bool MQTT_isStaticTopic(String topic, EventStruct *event, uint8_t valueIndex) {
+  const __FlashStringHelper *staticVars[] = {
+    F("%sysname%"),
+    F("%unit%"),
+    F("%tskname%"),
+    F("%valname%"),
+    F("%id%")
+  };
+
+  for (const __FlashStringHelper *var : staticVars) {
+    topic.replace(var, EMPTY_STRING);
+  }
+
+  if (!MQTT_isStaticTopicText(topic) ||
+      !MQTT_isStaticTopicText(Settings.getHostname()) ||
+      !MQTT_isStaticTopicText(getTaskDeviceName(event->TaskIndex))) {
+    return false;
+  }
+  return valueIndex >= VARS_PER_TASK ||
+         MQTT_isStaticTopicText(getTaskValueName(event->TaskIndex, valueIndex));
+}
+
+// Topic for a single task value, or for all values of a task when valueIndex is VARS_PER_TASK.
+// Topics which only depend on the settings are kept in the cache.
+static String MQTT_getTopic(const String& pubname, EventStruct *event, uint8_t valueIndex) {
+  String topic;
+
+  if (Cache.getMQTTtopic(event->ControllerIndex, event->TaskIndex, valueIndex, pubname, topic)) {
+    return topic;
+  }
+  topic = pubname;
+
+  if (valueIndex >= VARS_PER_TASK) {
+    // Publishing all values of the task, e.g. "%sysname%/%tskname%/%valname%" => "%sysname%/%tskname%"
+    if (topic.indexOf(F("/%valname%")) != -1) {
+      topic.replace(F("/%valname%"), EMPTY_STRING);
+    } else {
+      topic.replace(F("%valname%"), EMPTY_STRING);
+    }
+  }
+  const bool isStatic = MQTT_isStaticTopic(topic, event, valueIndex);
+
+  if ((valueIndex < VARS_PER_TASK) && (topic.indexOf(F("%valname%")) != -1)) {
+    parseSingleControllerVariable(topic, event, valueIndex, false);
+  }
+  parseControllerVariables(topic, event, false);
+
+  if (isStatic) {
+    Cache.setMQTTtopic(event->ControllerIndex, event->TaskIndex, valueIndex, pubname, topic);
+  }
+  return topic;
+}
 
+// Publish all values of a task as a single JSON object, e.g. {"Temperature":21.5,"Humidity":45,"timestamp":1700000000}
+static bool MQTT_protocol_send_json(EventStruct *event, const String& pubname, bool retainFlag) {
   const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+  const bool    isString   = event->sensorType == Sensor_VType::SENSOR_TYPE_STRING;
+  String json;
 
   for (uint8_t x = 0; x < valueCount; ++x) {
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
     // MFD: skip publishing for values with empty labels (removes unnecessary publishing of unwanted values)
-    if (getTaskValueName(event->TaskIndex, x).isEmpty()) {
+    if (valueName.isEmpty()) {
       continue; // we skip values with empty labels
     }
-    String tmppubname = pubname;
+    json += json.isEmpty() ? '{' : ',';
 
-    if (contains_valname) {
-      parseSingleControllerVariable(tmppubname, event, x, false);
+    if (isString) {
+      json += to_json_object_value(valueName, event->String2, true);
+    } else {
+      json += to_json_object_value(valueName, formatUserVarNoCheck(event, x));
     }
-    parseControllerVariables(tmppubname, event, false);
+  }
+
+  if (json.isEmpty()) {
+    return false;
+  }
+  uint32_t timestamp = event->timestamp_sec;
+
+  if ((timestamp == 0) && node_time.systemTimePresent()) {
+    timestamp = node_time.getUnixTime();
+  }
+
+  if (timestamp != 0) {
+    json += ',';
+    json += to_json_object_value(F("timestamp"), String(timestamp));
+  }
+  json += '}';
+
+  String topic = MQTT_getTopic(pubname, event, VARS_PER_TASK);
+  # ifndef BUILD_NO_DEBUG
+
+  addLogFmt(LOG_LEVEL_DEBUG, F("MQTT C%03d : %s %s"), event->ControllerIndex, topic, json);
+  # endif // ifndef BUILD_NO_DEBUG
+
+  // Publish using move operator, thus topic and json are empty after this call
+  return MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(topic), std::move(json), retainFlag);
+}
+
+bool MQTT_protocol_send(EventStruct  *event,
+                        const String& pubname,
+                        bool          retainFlag) {
+  if ((MQTTDelayHandler != nullptr) && MQTTDelayHandler->mqtt_sendJSON) {
+    const protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(event->ControllerIndex);
+
+    if (validProtocolIndex(ProtocolIndex) && getProtocolStruct(ProtocolIndex).allowsSendJSON) {
+      return MQTT_protocol_send_json(event, pubname, retainFlag);
+    }
+  }
+  bool success = false;
+
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+
+  for (uint8_t x = 0; x < valueCount; ++x) {
+    // MFD: skip publishing for values with empty labels (removes unnecessary publishing of unwanted values)
+    if (getTaskValueName(event->TaskIndex, x).isEmpty()) {
+      continue; // we skip values with empty labels
+    }
+    String tmppubname = MQTT_getTopic(pubname, event, x);
     String value;
 
     if (event->sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
@@ -213,9 +329,7 @@ bool MQTT_protocol_send(EventStruct *event,
     }
     # ifndef BUILD_NO_DEBUG
 
-    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-      addLog(LOG_LEVEL_DEBUG, strformat(F("MQTT C%03d : %s %s"), event->ControllerIndex, tmppubname.c_str(), value.c_str()));
-    }
+    addLogFmt(LOG_LEVEL_DEBUG, F("MQTT C%03d : %s %s"), event->ControllerIndex, tmppubname, value);
     # endif // ifndef BUILD_NO_DEBUG
 
     // Small optimization so we don't try to copy potentially large strings
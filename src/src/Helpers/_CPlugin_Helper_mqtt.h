@@ -10,9 +10,12 @@ bool MQTT_handle_topic_commands(struct EventStruct *event,
                                 bool                tryRemoteConfig = false);
 void MQTT_execute_command(String& command,
                           bool    tryRemoteConfig = false);
-bool MQTT_protocol_send(EventStruct *event,
-                        String       pubname,
-                        bool         retainFlag);
+
+// Publish the task values, one message per value or a single JSON message per task
+// when "Publish Task Values as JSON" is enabled.
+bool MQTT_protocol_send(EventStruct  *event,
+                        const String& pubname,
+                        bool          retainFlag);
 
 #endif // if FEATURE_MQTT
 #endif // ifndef CPLUGIN_HELPER_MQTT_H
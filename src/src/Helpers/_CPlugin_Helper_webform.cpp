@@ -35,6 +35,7 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
 
     case ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL:        return F("Minimum Send Interval");
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:          return F("Max Queue Depth");
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:           return F("Max Batch Size");
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:              return F("Max Retries");
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:        return F("Full Queue Action");
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:             return F("Allow Expire");
@@ -47,6 +48,7 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
 #if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT: return F("Unique Client ID on Reconnect");
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:               return F("Publish Retain Flag");
+    case ControllerSettingsStruct::CONTROLLER_SEND_JSON:                return F("Publish Task Values as JSON");
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:                return F("Controller Subscribe");
     case ControllerSettingsStruct::CONTROLLER_PUBLISH:                  return F("Controller Publish");
@@ -63,6 +65,12 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
     case ControllerSettingsStruct::CONTROLLER_SEND_BINARY:              return F("Send Binary");
     case ControllerSettingsStruct::CONTROLLER_TIMEOUT:                  return F("Client Timeout");
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:     return F("Sample Set Initiator");
+#ifdef USES_C013
+    case ControllerSettingsStruct::CONTROLLER_P2P_BATCH_WINDOW:         return F("Batch Window");
+#endif // ifdef USES_C013
+#ifdef USES_C016
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESSION:        return F("Compress Cache Files");
+#endif // ifdef USES_C016
 
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
 
@@ -293,6 +301,12 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
       addFormNumericBox(displayName, internalName, ControllerSettings.MaxQueueDepth, 1, CONTROLLER_DELAY_QUEUE_DEPTH_MAX);
       break;
     }
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:
+    {
+      addFormNumericBox(displayName, internalName, ControllerSettings.MaxBatchSize, 1, CONTROLLER_DELAY_QUEUE_BATCH_MAX);
+      addFormNote(F("Max. number of queued messages sent at once, without waiting for Minimum Send Interval"));
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:
     {
       addFormNumericBox(displayName, internalName, ControllerSettings.MaxRetry, 1, CONTROLLER_DELAY_QUEUE_RETRY_MAX);
@@ -335,6 +349,10 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_retainFlag());
       break;
+    case ControllerSettingsStruct::CONTROLLER_SEND_JSON:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_sendJSON());
+      addFormNote(F("Publish all values of a task as a single JSON object, %valname% is removed from the topic"));
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       addFormTextBox(displayName, internalName, ControllerSettings.Subscribe, sizeof(ControllerSettings.Subscribe) - 1);
@@ -379,6 +397,20 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:
       addTaskSelectBox(displayName, internalName, ControllerSettings.SampleSetInitiator);
       break;
+#ifdef USES_C013
+    case ControllerSettingsStruct::CONTROLLER_P2P_BATCH_WINDOW:
+      addFormNumericBox(displayName, internalName, ControllerSettings.P2P_BatchWindow, 0, CONTROLLER_P2P_BATCH_WINDOW_MAX);
+      addUnit(F("ms"));
+      addFormNote(F("Task values sent within this time are combined in a single message. 0 = Send each task value separately"));
+      addFormNote(F("Only used when all receiving nodes support combined messages"));
+      break;
+#endif // ifdef USES_C013
+#ifdef USES_C016
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESSION:
+      addFormCheckBox(displayName, internalName, ControllerSettings.cacheCompression());
+      addFormNote(F("Applies to new cache files. Compressed files can only be read back via the Cache Reader plugin"));
+      break;
+#endif // ifdef USES_C016
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
       addFormCheckBox(displayName, internalName, Settings.ControllerEnabled[controllerindex]);
       break;
@@ -487,6 +519,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:
       ControllerSettings.MaxQueueDepth = getFormItemInt(internalName, ControllerSettings.MaxQueueDepth);
       break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE:
+      ControllerSettings.MaxBatchSize = getFormItemInt(internalName, ControllerSettings.MaxBatchSize);
+      break;
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:
       ControllerSettings.MaxRetry = getFormItemInt(internalName, ControllerSettings.MaxRetry);
       break;
@@ -515,6 +550,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       ControllerSettings.mqtt_retainFlag(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_SEND_JSON:
+      ControllerSettings.mqtt_sendJSON(isFormItemChecked(internalName));
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       strncpy_webserver_arg(ControllerSettings.Subscribe, internalName);
@@ -557,6 +595,16 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:
       ControllerSettings.SampleSetInitiator = getFormItemInt(internalName, ControllerSettings.SampleSetInitiator);
       break;
+#ifdef USES_C013
+    case ControllerSettingsStruct::CONTROLLER_P2P_BATCH_WINDOW:
+      ControllerSettings.P2P_BatchWindow = getFormItemInt(internalName, ControllerSettings.P2P_BatchWindow);
+      break;
+#endif // ifdef USES_C013
+#ifdef USES_C016
+    case ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESSION:
+      ControllerSettings.cacheCompression(isFormItemChecked(internalName));
+      break;
+#endif // ifdef USES_C016
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
       Settings.ControllerEnabled[controllerindex] = isFormItemChecked(internalName);
       break;
@@ -17,14 +17,16 @@
   }
 
   void msecTimerHandlerStruct::registerAt(unsigned long id, unsigned long timer) {
-    timer_id_couple item(id, timer);
-
-    insert(item);
+    insert(id, timer);
   }
 
   void msecTimerHandlerStruct::remove(unsigned long id) {
-    timer_id_couple item(id, 0);
-    remove(item);
+    if (id == 0) { return; }
+    const size_t slot = findSlot(id);
+
+    if (slot < _table.size()) {
+      removeAt(_table[slot]._heapIndex);
+    }
   }
 
   // Check if timeout has been reached and also return its set timer.
@@ -32,7 +34,7 @@
   unsigned long msecTimerHandlerStruct::getNextId(unsigned long& timer) {
     ++get_called;
 
-    if (_timer_ids.empty()) {
+    if (_heap.empty()) {
       recordIdle();
 
       if (eco_mode) {
@@ -40,7 +42,7 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
+    const heapEntry item = _heap.front();
     const long passed    = timePassedSince(item._timer);
 
     if (passed < 0) {
@@ -61,10 +63,20 @@
       return 0;
     }
     recordRunning();
-    unsigned long size = _timer_ids.size();
+    unsigned long size = _heap.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+
+    {
+      // Bucket 0: 0 msec late, 1: < 4 msec, 2: < 16 msec, etc.
+      size_t bucket = 0;
+
+      for (unsigned long late = passed; late != 0 && bucket < (MSEC_TIMER_LATE_FIRE_BUCKETS - 1); late >>= 2) {
+        ++bucket;
+      }
+      ++late_fire[bucket];
+    }
+    removeAt(0);
     timer = item._timer;
     ++get_called_ret_id;
     return item._id;
@@ -72,16 +84,17 @@
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    if (id == 0) { return false; }
+    const size_t slot = findSlot(id);
+
+    if (slot < _table.size()) {
+      timer = _heap[_table[slot]._heapIndex]._timer;
+      return true;
     }
     return false;
   }
 
-  String msecTimerHandlerStruct::getQueueStats() {
+  String msecTimerHandlerStruct::getQueueStats(bool clearStats) {
     String result;
 
     result           += get_called;
@@ -91,10 +104,26 @@
     result           += max_queue_length;
     result           += '/';
     result           += idle_time_pct;
-    get_called        = 0;
-    get_called_ret_id = 0;
+    result           += '/';
+    result           += _heap.size();
+    result           += '/';
+    result           += _heap.capacity();
+    result           += F(" late:");
+
+    for (size_t i = 0; i < MSEC_TIMER_LATE_FIRE_BUCKETS; ++i) {
+      result += i == 0 ? ' ' : '/';
+      result += late_fire[i];
+    }
 
-    // max_queue_length = 0;
+    if (clearStats) {
+      for (size_t i = 0; i < MSEC_TIMER_LATE_FIRE_BUCKETS; ++i) {
+        late_fire[i] = 0;
+      }
+      get_called        = 0;
+      get_called_ret_id = 0;
+
+      // max_queue_length = 0;
+    }
     return result;
   }
 
@@ -110,38 +139,180 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(unsigned long id, unsigned long timer) {
+    if (id == 0) { return; }
+
+    // Make sure only one is present with the same id.
+    const size_t slot = findSlot(id);
+
+    if (slot < _table.size()) {
+      // Reschedule
+      const size_t heapIndex = _table[slot]._heapIndex;
+      heapEntry  & entry     = _heap[heapIndex];
+      const bool   earlier   = timeDiff(entry._timer, timer) <= 0;
+      entry._timer    = timer;
+      entry._sequence = ++_sequence;
+
+      if (earlier) {
+        siftUp(heapIndex);
+      } else {
+        siftDown(heapIndex);
+      }
+      return;
+    }
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    reserve();
+    const size_t mask = _table.size() - 1;
+    size_t newSlot    = getHashSlot(id);
+
+    while (_table[newSlot]._id != 0) {
+      newSlot = (newSlot + 1) & mask;
     }
+    _table[newSlot]._id = id;
+    _heap.push_back({ timer, id, ++_sequence, static_cast<uint16_t>(newSlot) });
+    _table[newSlot]._heapIndex = _heap.size() - 1;
+    siftUp(_heap.size() - 1);
+  }
 
-    unsigned long _id;
-  };
+  void msecTimerHandlerStruct::removeAt(size_t heapIndex) {
+    if (heapIndex >= _heap.size()) { return; }
+    eraseSlot(_heap[heapIndex]._tableSlot);
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+    const heapEntry last = _heap.back();
+    _heap.pop_back();
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    if (heapIndex < _heap.size()) {
+      setHeapEntry(heapIndex, last);
+      siftDown(heapIndex);
+      siftUp(heapIndex);
+    }
+  }
+
+  size_t msecTimerHandlerStruct::findSlot(unsigned long id) const {
+    const size_t size = _table.size();
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    if (size == 0) { return size; }
+    const size_t mask = size - 1;
+
+    for (size_t slot = getHashSlot(id); _table[slot]._id != 0; slot = (slot + 1) & mask) {
+      if (_table[slot]._id == id) {
+        return slot;
+      }
     }
+    return size;
+  }
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+  size_t msecTimerHandlerStruct::getHashSlot(unsigned long id) const {
+    // Fibonacci hashing, mixed IDs only differ in the lower bits.
+    return (static_cast<uint32_t>(id) * 2654435761u) & (_table.size() - 1);
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::eraseSlot(size_t slot) {
+    // Backward shift deletion, to keep all entries reachable from their hash slot.
+    const size_t mask = _table.size() - 1;
+    size_t next       = slot;
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+    while (true) {
+      next = (next + 1) & mask;
+
+      if (_table[next]._id == 0) {
+        break;
+      }
+      const size_t home = getHashSlot(_table[next]._id);
+
+      // Keep the entry when its home slot is cyclic in (slot, next]
+      const bool keep = (slot <= next)
+        ? ((slot < home) && (home <= next))
+        : ((slot < home) || (home <= next));
+
+      if (!keep) {
+        _table[slot]                               = _table[next];
+        _heap[_table[slot]._heapIndex]._tableSlot = slot;
+        slot                                       = next;
+      }
+    }
+    _table[slot]._id = 0;
+  }
+
+  void msecTimerHandlerStruct::reserve() {
+    // Keep the table load factor at most 50%
+    if (((_heap.size() + 1) * 2) <= _table.size()) {
+      return;
+    }
+    const size_t newSize = _table.empty() ? 32 : 2 * _table.size();
+
+    _table.clear();
+    _table.resize(newSize);
+    _heap.reserve(newSize / 2);
+
+    const size_t mask = newSize - 1;
+
+    for (size_t i = 0; i < _heap.size(); ++i) {
+      size_t slot = getHashSlot(_heap[i]._id);
+
+      while (_table[slot]._id != 0) {
+        slot = (slot + 1) & mask;
+      }
+      _table[slot]._id        = _heap[i]._id;
+      _table[slot]._heapIndex = i;
+      _heap[i]._tableSlot     = slot;
+    }
+  }
+
+  void msecTimerHandlerStruct::setHeapEntry(size_t heapIndex, const heapEntry& entry) {
+    _heap[heapIndex]                    = entry;
+    _table[entry._tableSlot]._heapIndex = heapIndex;
+  }
+
+  void msecTimerHandlerStruct::siftUp(size_t heapIndex) {
+    const heapEntry entry = _heap[heapIndex];
+
+    while (heapIndex > 0) {
+      const size_t parent = (heapIndex - 1) / 2;
+
+      if (!isBefore(entry, _heap[parent])) {
+        break;
+      }
+      setHeapEntry(heapIndex, _heap[parent]);
+      heapIndex = parent;
+    }
+    setHeapEntry(heapIndex, entry);
+  }
+
+  void msecTimerHandlerStruct::siftDown(size_t heapIndex) {
+    const heapEntry entry = _heap[heapIndex];
+    const size_t    size  = _heap.size();
+
+    while (true) {
+      size_t child = 2 * heapIndex + 1;
+
+      if (child >= size) {
+        break;
+      }
+
+      if (((child + 1) < size) && isBefore(_heap[child + 1], _heap[child])) {
+        ++child;
+      }
+
+      if (!isBefore(_heap[child], entry)) {
+        break;
+      }
+      setHeapEntry(heapIndex, _heap[child]);
+      heapIndex = child;
+    }
+    setHeapEntry(heapIndex, entry);
+  }
+
+  bool msecTimerHandlerStruct::isBefore(const heapEntry& lhs, const heapEntry& rhs) {
+    // Use the difference to deal with millis() overflow
+    const int32_t diff = timeDiff(rhs._timer, lhs._timer);
+
+    if (diff != 0) {
+      return diff < 0;
+    }
+
+    // Same moment, the last (re)scheduled timer goes first.
+    return static_cast<int32_t>(lhs._sequence - rhs._sequence) > 0;
   }
 
   void msecTimerHandlerStruct::recordIdle() {
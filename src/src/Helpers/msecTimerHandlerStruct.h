@@ -3,11 +3,27 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
-
-#include "../DataStructs/timer_id_couple.h"
-
-
+#include <vector>
+
+
+// Histogram buckets of how late a timer was handled (in msec):
+// 0, < 4, < 16, < 64, < 256, < 1024, < 4096, >= 4096
+#define MSEC_TIMER_LATE_FIRE_BUCKETS  8
+
+
+/*********************************************************************************************\
+* Set of timers, ordered by their timeout moment.
+*
+* Timers are kept in a binary min-heap, stored in a vector.
+* A hash table (open addressing) maps the ID of a timer to its position in the heap.
+* - Insert, reschedule and remove are O(log n)
+* - Lookup by ID is O(1)
+* - No allocation per insert, only when the capacity needs to grow.
+* Timers are compared using their difference, so millis() overflow is handled correctly,
+* as long as all timers are set within 2^31 msec from each other.
+* Timers set for the same moment are handled in reverse order of (re)scheduling,
+* like the sorted list used before.
+\*********************************************************************************************/
 struct msecTimerHandlerStruct {
   msecTimerHandlerStruct();
 
@@ -27,7 +43,8 @@ struct msecTimerHandlerStruct {
   bool   getTimerForId(unsigned long  id,
                        unsigned long& timer) const;
 
-  String getQueueStats();
+  // @param clearStats  Reset the call counters and the late fire histogram.
+  String getQueueStats(bool clearStats);
 
   void   updateIdleTimeStats();
 
@@ -35,9 +52,42 @@ struct msecTimerHandlerStruct {
 
 private:
 
-  void insert(const timer_id_couple& item);
+  struct heapEntry {
+    unsigned long _timer;
+    unsigned long _id;
+    uint32_t      _sequence; // Order of (re)scheduling, for timers set for the same moment
+    uint16_t      _tableSlot;
+  };
+
+  struct tableEntry {
+    unsigned long _id        = 0; // 0 = empty slot
+    uint16_t      _heapIndex = 0;
+  };
+
+  void   insert(unsigned long id,
+                unsigned long timer);
+
+  void   removeAt(size_t heapIndex);
+
+  // Return the index in _table of the ID, or _table.size() when not present.
+  size_t findSlot(unsigned long id) const;
+
+  size_t getHashSlot(unsigned long id) const;
 
-  void remove(const timer_id_couple& item);
+  void   eraseSlot(size_t slot);
+
+  // Make sure there is room for one more timer.
+  void   reserve();
+
+  void   setHeapEntry(size_t           heapIndex,
+                      const heapEntry& entry);
+
+  void   siftUp(size_t heapIndex);
+
+  void   siftDown(size_t heapIndex);
+
+  static bool isBefore(const heapEntry& lhs,
+                       const heapEntry& rhs);
 
   void recordIdle();
 
@@ -47,6 +97,9 @@ private:
   unsigned long get_called;
   unsigned long get_called_ret_id;
   unsigned long max_queue_length;
+  uint32_t      late_fire[MSEC_TIMER_LATE_FIRE_BUCKETS]{};
+
+  uint32_t      _sequence = 0;
 
   // Compute idle system time
   uint64_t last_exec_time_usec;
@@ -56,8 +109,11 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  // The set timers, ordered as binary min-heap
+  std::vector<heapEntry>_heap;
+
+  // ID -> heap index, size is a power of 2
+  std::vector<tableEntry>_table;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
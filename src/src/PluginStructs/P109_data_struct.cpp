@@ -139,6 +139,7 @@ bool P109_data_struct::plugin_init(struct EventStruct *event) {
   if (f) {
     f.read(reinterpret_cast<uint8_t *>(UserVar.getRawTaskValues_Data(event->TaskIndex)), 16);
     f.close();
+    UserVar.markUpdated(event->TaskIndex);
   }
   _save_setpoint = UserVar[event->BaseVarIndex];
   _prev_setpoint = UserVar[event->BaseVarIndex];
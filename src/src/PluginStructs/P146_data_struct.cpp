@@ -427,6 +427,22 @@ bool P146_data_struct::setPeekFilePos(int peekFileNr, int peekReadPos)
   return true;
 }
 
+bool P146_data_struct::setPeekFilePosByTime(uint32_t unixTime, taskIndex_t taskIndex)
+{
+  C016_flush();
+
+  int peekFileNr  = 0;
+  int peekReadPos = 0;
+
+  if (!C016_findCacheFilePos(unixTime, UINT32_MAX, taskIndex, peekFileNr, peekReadPos)) {
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLog(LOG_LEVEL_INFO, concat(F("CacheReader : SeekTime, no samples after "), unixTime));
+    }
+    return false;
+  }
+  return setPeekFilePos(peekFileNr, peekReadPos);
+}
+
 void P146_data_struct::flush() {
   C016_flush();
 }
@@ -78,6 +78,10 @@ public:
   static bool setPeekFilePos(int peekFileNr,
                              int peekReadPos);
 
+  // Set the read position to the first sample at or after unixTime of the given task (INVALID_TASK_INDEX = any task)
+  static bool setPeekFilePosByTime(uint32_t    unixTime,
+                                   taskIndex_t taskIndex);
+
   static void flush();
 
 private:
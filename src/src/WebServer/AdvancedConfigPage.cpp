@@ -8,6 +8,8 @@
 #include "../WebServer/Markup_Forms.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 
+#include "../DataStructs/SyslogQueue.h"
+
 #include "../ESPEasyCore/ESPEasyWifi.h"
 
 #include "../Globals/ESPEasy_time.h"
@@ -55,6 +57,7 @@ void handle_advanced() {
 
     Settings.SyslogFacility = getFormItemInt(F("syslogfacility"));
     Settings.SyslogPort     = getFormItemInt(F("syslogport"));
+    Settings.SyslogCombineLines(isFormItemChecked(F("syslogcombine")));
     Settings.UseSerial      = isFormItemChecked(LabelType::ENABLE_SERIAL_PORT_CONSOLE);
 
 #if FEATURE_DEFINE_SERIAL_CONSOLE_PORT
@@ -153,6 +156,7 @@ void handle_advanced() {
     #endif
 
     Settings.EnableRulesCaching(isFormItemChecked(LabelType::ENABLE_RULES_CACHING));
+    Settings.EventQueueOverflowPolicy(static_cast<EventQueueOverflowPolicy_e>(getFormItemInt(F("eventqueuepolicy"))));
 //    Settings.EnableRulesEventReorder(isFormItemChecked(LabelType::ENABLE_RULES_EVENT_REORDER)); // TD-er: Disabled for now
 
 #ifndef NO_HTTP_UPDATER
@@ -188,6 +192,26 @@ void handle_advanced() {
   #endif // WEBSERVER_NEW_RULES
   addFormCheckBox(LabelType::ENABLE_RULES_CACHING, Settings.EnableRulesCaching());
 //  addFormCheckBox(LabelType::ENABLE_RULES_EVENT_REORDER, Settings.EnableRulesEventReorder()); // TD-er: Disabled for now
+  {
+    const __FlashStringHelper *policyNames[] = {
+      toString(EventQueueOverflowPolicy_e::DropOldest),
+      toString(EventQueueOverflowPolicy_e::DropNewest),
+      toString(EventQueueOverflowPolicy_e::Coalesce)
+    };
+    const int policyOptions[] = {
+      static_cast<int>(EventQueueOverflowPolicy_e::DropOldest),
+      static_cast<int>(EventQueueOverflowPolicy_e::DropNewest),
+      static_cast<int>(EventQueueOverflowPolicy_e::Coalesce)
+    };
+    constexpr int nrPolicyOptions = NR_ELEMENTS(policyOptions);
+    addFormSelector(F("Event Queue Full"),
+                    F("eventqueuepolicy"),
+                    nrPolicyOptions,
+                    policyNames,
+                    policyOptions,
+                    static_cast<int>(Settings.EventQueueOverflowPolicy()));
+    addFormNote(strformat(F("Max. %d events, lower priority events are dropped first. Dropped events are logged"), EVENT_QUEUE_MAX_SIZE));
+  }
 
   addFormCheckBox(F("Tolerant last parameter"), F("tolerantargparse"), Settings.TolerantLastArgParse());
   addFormNote(F("Perform less strict parsing on last argument of some commands (e.g. publish and sendToHttp)"));
@@ -238,6 +262,8 @@ void handle_advanced() {
 
   addFormLogLevelSelect(LabelType::SYSLOG_LOG_LEVEL, Settings.SyslogLevel);
   addFormLogFacilitySelect(F("Syslog Facility"), F("syslogfacility"), Settings.SyslogFacility);
+  addFormCheckBox(F("Syslog Combine Lines"), F("syslogcombine"), Settings.SyslogCombineLines());
+  addFormNote(strformat(F("Send multiple lines per datagram, separated by a newline. Max. %d datagrams/sec"), SYSLOG_MAX_DATAGRAMS_PER_SEC));
   addFormLogLevelSelect(LabelType::SERIAL_LOG_LEVEL, Settings.SerialLogLevel);
   addFormLogLevelSelect(LabelType::WEB_LOG_LEVEL,    Settings.WebLogLevel);
 
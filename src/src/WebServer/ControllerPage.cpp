@@ -377,6 +377,7 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addTableSeparator(F("Controller Queue"), 2, 3);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH);
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_BATCH_SIZE);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_RETRIES);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION);
 
@@ -405,6 +406,12 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           if (proto.allowLocalSystemTime) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME);
           }
+          # ifdef USES_C016
+
+          if (proto.usesCacheCompression) {
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_CACHE_COMPRESSION);
+          }
+          # endif // ifdef USES_C016
 
 
           if (proto.useCredentials()) {
@@ -435,6 +442,10 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addHtml(getMQTTclientID(*ControllerSettings));
             addFormNote(F("Updated on load of this page"));
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_RETAINFLAG);
+
+            if (proto.allowsSendJSON) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_SEND_JSON);
+            }
           }
           # endif // if FEATURE_MQTT
 
@@ -462,6 +473,14 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           }
           # endif // if FEATURE_MQTT
         }
+
+        // Generic settings, also shown for custom controllers
+        # ifdef USES_C013
+
+        if (proto.allowsP2PBatch) {
+          addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_P2P_BATCH_WINDOW);
+        }
+        # endif // ifdef USES_C013
       }
 
       // End of scope for ControllerSettings, destruct it to save memory.
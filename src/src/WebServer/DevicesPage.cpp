@@ -405,6 +405,9 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
     PluginStats_Config_t pluginStats_Config;
     pluginStats_Config.setEnabled(isFormItemChecked(getPluginCustomArgName(F("TDS"), varNr)));
     pluginStats_Config.setHidden(isFormItemChecked(getPluginCustomArgName(F("TDSH"), varNr)));
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+    pluginStats_Config.setRollupEnabled(isFormItemChecked(getPluginCustomArgName(F("TDSR"), varNr)));
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
     const int selectedAxis = getFormItemInt(getPluginCustomArgName(F("TDSA"), varNr));
     pluginStats_Config.setAxisIndex(selectedAxis);
     pluginStats_Config.setAxisPosition(
@@ -1484,6 +1487,10 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
       ++colCount;
       html_table_header(F("Axis"),  30);
       ++colCount;
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+      html_table_header(F("Trend"), 30);
+      ++colCount;
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
     }
 # endif // if FEATURE_PLUGIN_STATS
 
@@ -1557,6 +1564,13 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
           nullptr,
           nullptr,
           selected);
+#  if FEATURE_PLUGIN_STATS_ROLLUP
+
+        html_TD();
+        addCheckBox(
+          getPluginCustomArgName(F("TDSR"), varNr), // ="taskdevicestats Rollup"
+          cachedConfig.rollupEnabled());
+#  endif // if FEATURE_PLUGIN_STATS_ROLLUP
       }
 # endif // if FEATURE_PLUGIN_STATS
     }
@@ -261,6 +261,9 @@ void WebServerInit()
   #endif // ifdef WEBSERVER_I2C_SCANNER
   web_server.on(F("/json"),            handle_json);     // Also part of WEBSERVER_NEW_UI
   web_server.on(F("/csv"),             handle_csvval);
+#if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
+  web_server.on(F("/stats_json"),      handle_stats_rollup_json);
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
   web_server.on(F("/log"),             handle_log);
   web_server.on(F("/logjson"),         handle_log_JSON); // Also part of WEBSERVER_NEW_UI
 #if FEATURE_NOTIFIER
@@ -398,52 +398,52 @@ void addHtml(String&& html) {
 }
 
 void addHtmlInt(int8_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<int32_t>(int_val);
 }
 
 void addHtmlInt(uint8_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<uint32_t>(int_val);
 }
 
 void addHtmlInt(int16_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<int32_t>(int_val);
 }
 
 #if ESP_IDF_VERSION_MAJOR >= 5
 #ifndef __riscv
 void addHtmlInt(int int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<int32_t>(int_val);
 }
 
 void addHtmlInt(unsigned int int_val) {
-  addHtml(String(int_val));
+  TXBuffer += static_cast<uint32_t>(int_val);
 }
 #endif
 #endif
 
 void addHtmlInt(int32_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlInt(uint32_t int_val) {
-  addHtml(String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlInt(int64_t int_val) {
-  addHtml(ll2String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlInt(uint64_t int_val) {
-  addHtml(ull2String(int_val));
+  TXBuffer += int_val;
 }
 
 void addHtmlFloat(const float& value, unsigned int nrDecimals) {
-  addHtml(toString(value, nrDecimals));
+  TXBuffer.addFloat(value, nrDecimals);
 }
 
 #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
 void addHtmlFloat(const double& value, unsigned int nrDecimals) {
-  addHtml(doubleToString(value, nrDecimals));
+  TXBuffer.addFloat(value, nrDecimals);
 }
 #endif
 
@@ -6,6 +6,7 @@
 
 #include "../CustomBuild/CompiletimeDefines.h"
 
+#include "../DataStructs/PluginStats_rollup.h"
 #include "../DataStructs/TimingStats.h"
 
 #include "../Globals/Cache.h"
@@ -13,8 +14,11 @@
 #include "../Globals/Device.h"
 #include "../Globals/Plugins.h"
 #include "../Globals/NPlugins.h"
+#include "../Globals/RTC.h"
+#include "../Globals/RuntimeData.h"
 
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Numerical.h"
@@ -107,11 +111,84 @@ void handle_csvval()
 // ********************************************************************************
 // Web Interface JSON page (no password!)
 // ********************************************************************************
+
+// Check whether the key is present in the comma separated list of "fields".
+// All keys are selected when no fields are given.
+bool json_field_selected(const String& fields, const __FlashStringHelper *key)
+{
+  if (fields.isEmpty()) {
+    return true;
+  }
+  String lc_key(key);
+
+  lc_key.toLowerCase();
+
+  for (uint8_t i = 1; i < 255; ++i) {
+    const String field = parseString(fields, i);
+
+    if (field.isEmpty()) {
+      return false;
+    }
+
+    if (field.equals(lc_key)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Check whether the task is present in a comma separated list of task numbers, like "3,5"
+bool json_task_selected(const String& taskNrList, taskIndex_t taskIndex)
+{
+  for (uint8_t i = 1; i < 255; ++i) {
+    const String taskNrStr = parseString(taskNrList, i);
+
+    if (taskNrStr.isEmpty()) {
+      return false;
+    }
+    int32_t taskNr{};
+
+    if (validIntFromString(taskNrStr, taskNr) && (taskNr == (taskIndex + 1))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Only stream the key/value pair when selected, with a separator when not the first pair of the object.
+template<typename T>
+void stream_selected_json_object_value(bool selected, bool& first, const __FlashStringHelper *object, const T& value)
+{
+  if (selected) {
+    if (!first) {
+      stream_comma_newline();
+    }
+    first = false;
+    stream_to_json_object_value(object, value);
+  }
+}
+
 void handle_json()
 {
   START_TIMER
-  const taskIndex_t taskNr    = getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
+
+  // A list of task numbers, like "tasknr=3,5", gives the "Sensors" list with only those tasks.
+  // A single task number gives only the object of that task.
+  const String taskNrList     = webArg(F("tasknr"));
+  const bool   showTaskList   = taskNrList.indexOf(',') != -1;
+  const taskIndex_t taskNr    = showTaskList ? INVALID_TASK_INDEX : getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
   const bool showSpecificTask = validTaskIndex(taskNr);
+  const String view           = webArg(F("view"));
+
+  // "view=values" only shows the task values, task name and task number
+  const bool showValuesOnly   = equals(view, F("values"));
+
+  // Keys to show in the "TaskValues" objects, like "fields=Value,Name"
+  const String fields         = webArg(F("fields"));
+  const bool   showValueNumber = json_field_selected(fields, F("ValueNumber"));
+  const bool   showValueName   = json_field_selected(fields, F("Name"));
+  const bool   showNrDecimals  = json_field_selected(fields, F("NrDecimals"));
+  const bool   showValue       = json_field_selected(fields, F("Value"));
   bool showSystem             = true;
   bool showWifi               = true;
 
@@ -127,7 +204,7 @@ void handle_json()
   bool showPluginStats     = getFormItemInt(F("showpluginstats"), 0) != 0;
   #endif
 
-  if (equals(webArg(F("view")), F("sensorupdate"))) {
+  if (showValuesOnly || equals(view, F("sensorupdate"))) {
     showSystem = false;
     showWifi   = false;
     #if FEATURE_ETHERNET
@@ -143,6 +220,46 @@ void handle_json()
     #endif
   }
 
+  // Every update of task values increments the update counter of UserVar, which is reported as "UpdateToken".
+  // With "since=<UpdateToken>" the "Sensors" list only contains the tasks updated after that token.
+  const uint32_t updateToken = UserVar.getUpdateCounter();
+  uint32_t since             = 0;
+
+  if (!validUIntFromString(webArg(F("since")), since) || (since > updateToken)) {
+    // Not given, or a token from before a reboot
+    since = 0;
+  }
+
+  // Without system info, the output only changes when task values are updated or task settings are changed.
+  // Then reply with a "304 Not Modified" when the client already has the current version.
+  bool useETag = showSpecificTask || !showSystem;
+  #if FEATURE_PLUGIN_STATS
+
+  if (showPluginStats) {
+    useETag = false;
+  }
+  #endif // if FEATURE_PLUGIN_STATS
+
+  if (useETag) {
+    const uint32_t settingsChecksum =
+      calc_CRC32(reinterpret_cast<const uint8_t *>(Settings.TaskDeviceTimer),   sizeof(Settings.TaskDeviceTimer)) ^
+      calc_CRC32(reinterpret_cast<const uint8_t *>(Settings.TaskDeviceEnabled), sizeof(Settings.TaskDeviceEnabled));
+    const String etag = strformat(
+      F("%u-%u-%u-%x"),
+      static_cast<uint32_t>(RTC.bootCounter),
+      updateToken,
+      Cache.taskSettingsGeneration,
+      settingsChecksum);
+
+    if (equals(stripQuotes(web_server.header(F("If-None-Match"))), etag)) {
+      sendHeader(F("Access-Control-Allow-Origin"), F("*"));
+      web_server.send(304, String(F("application/json")), EMPTY_STRING);
+      STOP_TIMER(HANDLE_SERVING_WEBPAGE_JSON);
+      return;
+    }
+    TXBuffer.setETag(wrap_String(etag, '"'));
+  }
+
   TXBuffer.startJsonStream();
 
   if (!showSpecificTask)
@@ -187,6 +304,11 @@ void handle_json()
         LabelType::BOOT_TYPE,
         LabelType::RESET_REASON,
         LabelType::CPU_ECO_MODE,
+        LabelType::EVENT_QUEUE_LENGTH,
+        LabelType::EVENT_QUEUE_PEAK_LENGTH,
+        LabelType::EVENT_QUEUE_DROPPED,
+        LabelType::EVENT_QUEUE_DEDUPLICATED,
+        LabelType::EVENT_QUEUE_COALESCED,
 
     #if defined(CORE_POST_2_5_0) || defined(ESP32)
       #ifndef LIMIT_BUILD_SIZE
@@ -403,13 +525,7 @@ void handle_json()
     firstTaskIndex = taskNr - 1;
     lastTaskIndex  = taskNr - 1;
   }
-  taskIndex_t lastActiveTaskIndex = 0;
-
-  for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastTaskIndex; TaskIndex++) {
-    if (validPluginID_fullcheck(Settings.getPluginID_for_task(TaskIndex))) {
-      lastActiveTaskIndex = TaskIndex;
-    }
-  }
+  bool firstTask = true;
 
   if (!showSpecificTask) {
     addHtml(F("\"Sensors\":[\n"));
@@ -418,14 +534,27 @@ void handle_json()
   // Keep track of the lowest reported TTL and use that as refresh interval.
   unsigned long lowest_ttl_json = 60;
 
-  for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastActiveTaskIndex && validTaskIndex(TaskIndex); TaskIndex++)
+  for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastTaskIndex && validTaskIndex(TaskIndex); TaskIndex++)
   {
+    if (!showSpecificTask) {
+      if (showTaskList && !json_task_selected(taskNrList, TaskIndex)) {
+        continue;
+      }
+
+      if ((since != 0) && (UserVar.getLastUpdate(TaskIndex) <= since)) {
+        continue;
+      }
+    }
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(TaskIndex);
 
     if (validDeviceIndex(DeviceIndex))
     {
       const unsigned long taskInterval = Settings.TaskDeviceTimer[TaskIndex];
       //LoadTaskSettings(TaskIndex);
+      if (!firstTask) {
+        stream_comma_newline();
+      }
+      firstTask = false;
       addHtml('{', '\n');
 
       unsigned long ttl_json = 60; // Default value
@@ -459,10 +588,12 @@ void handle_json()
             // Flag as not to treat as a float
             nrDecimals = 255;
           }
-          stream_next_json_object_value(F("ValueNumber"), x + 1);
-          stream_next_json_object_value(F("Name"),        Cache.getTaskDeviceValueName(TaskIndex, x));
-          stream_next_json_object_value(F("NrDecimals"),  nrDecimals);
-          stream_last_json_object_value(F("Value"), value);
+          bool firstField = true;
+          stream_selected_json_object_value(showValueNumber, firstField, F("ValueNumber"), x + 1);
+          stream_selected_json_object_value(showValueName,   firstField, F("Name"),        Cache.getTaskDeviceValueName(TaskIndex, x));
+          stream_selected_json_object_value(showNrDecimals,  firstField, F("NrDecimals"),  static_cast<int>(nrDecimals));
+          stream_selected_json_object_value(showValue,       firstField, F("Value"),       value);
+          addHtml('\n', '}');
 
           if (x < (valueCount - 1)) {
             stream_comma_newline();
@@ -484,6 +615,7 @@ void handle_json()
 
 
       if (showSpecificTask) {
+        stream_next_json_object_value(F("UpdateToken"), String(updateToken));
         stream_next_json_object_value(F("TTL"), ttl_json * 1000);
       }
 
@@ -542,22 +674,24 @@ void handle_json()
           }
         }
         #endif // if FEATURE_I2CMULTIPLEXER
+      } else if (showValuesOnly) {
+        stream_next_json_object_value(F("TaskName"), getTaskDeviceName(TaskIndex));
       }
       stream_next_json_object_value(F("TaskEnabled"), 
         // jsonBool(Settings.TaskDeviceEnabled[TaskIndex].enabled));
         jsonBool(Settings.TaskDeviceEnabled[TaskIndex]));
 
       stream_last_json_object_value(F("TaskNumber"), TaskIndex + 1);
-
-      if (TaskIndex != lastActiveTaskIndex) {
-        addHtml(',');
-      }
-      addHtml('\n');
     }
   }
 
+  if (!firstTask) {
+    addHtml('\n');
+  }
+
   if (!showSpecificTask) {
     addHtml(F("],\n"));
+    stream_next_json_object_value(F("UpdateToken"), String(updateToken));
     stream_last_json_object_value(F("TTL"), lowest_ttl_json * 1000);
   }
 
@@ -569,6 +703,31 @@ void handle_json()
 // JSON formatted timing statistics
 // ********************************************************************************
 
+#if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
+void handle_stats_rollup_json()
+{
+  const taskIndex_t taskIndex = getFormItemInt(F("tasknr"), 0) - 1;
+  const uint8_t     tier      = PluginStats_rollup_tier::getTierIndex(webArg(F("tier")));
+  bool success                = false;
+
+  TXBuffer.startJsonStream();
+
+  if (validTaskIndex(taskIndex) && (tier < PLUGIN_STATS_ROLLUP_NR_TIERS)) {
+    PluginTaskData_base *taskData = getPluginTaskDataBaseClassOnly(taskIndex);
+
+    if (taskData != nullptr) {
+      success = taskData->plot_ChartJS_rollup(tier, true);
+    }
+  }
+
+  if (!success) {
+    addHtml(F("{}"));
+  }
+  TXBuffer.endStream();
+}
+
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
+
 #ifdef WEBSERVER_NEW_UI
 void handle_timingstats_json() {
   TXBuffer.startJsonStream();
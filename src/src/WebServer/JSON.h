@@ -24,6 +24,14 @@ void handle_timingstats_json();
 
 #endif // WEBSERVER_NEW_UI
 
+#if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
+// ********************************************************************************
+// Chart (JSON) of the long term stats of a task, read directly from the rollup file
+// /stats_json?tasknr=<nr>&tier=<1m|1h>
+// ********************************************************************************
+void handle_stats_rollup_json();
+#endif // if FEATURE_PLUGIN_STATS_ROLLUP && FEATURE_CHART_JS
+
 #ifdef WEBSERVER_NEW_UI
 #if FEATURE_ESPEASY_P2P
 void handle_nodes_list_json();
@@ -2,9 +2,14 @@
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../../ESPEasy-Globals.h"
 #include "../Commands/Diagnostic.h"
+#include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../../_Plugin_Helper.h"
+#include "../Globals/CPlugins.h"
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/EventQueue.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Static/WebStaticData.h"
 
@@ -14,80 +19,171 @@
 #  include <esp_partition.h>
 # endif // ifdef ESP32
 
+bool metrics_include(const __FlashStringHelper *section, bool defaultValue) {
+  if (!hasArg(section)) {
+    return defaultValue;
+  }
+  return !equals(webArg(section), '0');
+}
+
 void handle_metrics() {
   TXBuffer.startStream(F("text/plain"), F("*"));
-  const __FlashStringHelper *prefixHELP = F("# HELP espeasy_");
-  const __FlashStringHelper *prefixTYPE = F("# TYPE espeasy_");
 
   // uptime
-  addHtml(prefixHELP);
-  addHtml(F("uptime current device uptime in minutes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("uptime counter\n"));
+  addMetricsHeader(F("uptime"), F("current device uptime in minutes"), F("counter"));
   addHtml(F("espeasy_uptime "));
   addHtml(getValue(LabelType::UPTIME));
   addHtml('\n');
 
   // load
-  addHtml(prefixHELP);
-  addHtml(F("load device percentage load\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("load gauge\n"));
+  addMetricsHeader(F("load"), F("device percentage load"), F("gauge"));
   addHtml(F("espeasy_load "));
   addHtml(getValue(LabelType::LOAD_PCT));
   addHtml('\n');
 
+  // Scheduler idle time
+  addMetricsHeader(F("idle"), F("percentage of time the scheduler was idle"), F("gauge"));
+  addHtml(F("espeasy_idle "));
+  addHtmlFloat(Scheduler.getIdleTimePct(), 2);
+  addHtml('\n');
+
   // Free RAM
-  addHtml(prefixHELP);
-  addHtml(F("free_ram device amount of RAM free in Bytes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("free_ram gauge\n"));
+  addMetricsHeader(F("free_ram"), F("device amount of RAM free in Bytes"), F("gauge"));
   addHtml(F("espeasy_free_ram "));
   addHtml(getValue(LabelType::FREE_MEM));
   addHtml('\n');
 
   // Free RAM
-  addHtml(prefixHELP);
-  addHtml(F("free_stack device amount of Stack free in Bytes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("free_stack gauge\n"));
+  addMetricsHeader(F("free_stack"), F("device amount of Stack free in Bytes"), F("gauge"));
   addHtml(F("espeasy_free_stack "));
   addHtml(getValue(LabelType::FREE_STACK));
   addHtml('\n');
 
   // Wifi strength
-  addHtml(prefixHELP);
-  addHtml(F("wifi_rssi Wifi connection Strength\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_rssi gauge\n"));
+  addMetricsHeader(F("wifi_rssi"), F("Wifi connection Strength"), F("gauge"));
   addHtml(F("espeasy_wifi_rssi "));
   addHtml(getValue(LabelType::WIFI_RSSI));
   addHtml('\n');
 
   // Wifi uptime
-  addHtml(prefixHELP);
-  addHtml(F("wifi_connected Time wifi has been connected in milliseconds\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_connected counter\n"));
+  addMetricsHeader(F("wifi_connected"), F("Time wifi has been connected in milliseconds"), F("counter"));
   addHtml(F("espeasy_wifi_connected "));
   addHtml(getValue(LabelType::CONNECTED_MSEC));
   addHtml('\n');
 
   // Wifi reconnects
-  addHtml(prefixHELP);
-  addHtml(F("wifi_reconnects Number of times Wifi has reconnected since boot\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_reconnects counter\n"));
+  addMetricsHeader(F("wifi_reconnects"), F("Number of times Wifi has reconnected since boot"), F("counter"));
   addHtml(F("espeasy_wifi_reconnects "));
   addHtml(getValue(LabelType::NUMBER_RECONNECTS));
   addHtml('\n');
 
+  // Event queue
+  addMetricsHeader(F("event_queue"), F("Number of events waiting to be processed"), F("gauge"));
+  addHtml(F("espeasy_event_queue "));
+  addHtmlInt(static_cast<uint32_t>(eventQueue.size()));
+  addHtml('\n');
+
+  if (metrics_include(F("queues"), true)) {
+    handle_metrics_controller_queues();
+  }
+
   // devices
-  handle_metrics_devices();
+  if (metrics_include(F("tasks"), true)) {
+    handle_metrics_devices();
+  }
+
+  # if FEATURE_TIMING_STATS
+
+  if (metrics_include(F("timing"), Settings.EnableTimingStats())) {
+    handle_metrics_timing_stats();
+  }
+  # endif // if FEATURE_TIMING_STATS
 
   TXBuffer.endStream();
 }
 
+void addMetricsHeader(const __FlashStringHelper *name, const __FlashStringHelper *help, const __FlashStringHelper *type) {
+  addHtml(F("# HELP espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(help);
+  addHtml(F("\n# TYPE espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(type);
+  addHtml('\n');
+}
+
+void addMetricsLabelValue(const String& value) {
+  const size_t length = value.length();
+
+  for (size_t i = 0; i < length; ++i) {
+    const char c = value[i];
+
+    switch (c) {
+      case '"':
+      case '\\':
+        addHtml('\\');
+        addHtml(c);
+        break;
+      case '\n':
+        addHtml(F("\\n"));
+        break;
+      default:
+        addHtml(c);
+        break;
+    }
+  }
+}
+
+void handle_metrics_controller_queues() {
+  const __FlashStringHelper *names[] = {
+    F("controller_queue"),
+    F("controller_queue_max"),
+    F("controller_sent"),
+    F("controller_failed"),
+    F("controller_dropped")
+  };
+  const __FlashStringHelper *helps[] = {
+    F("Number of messages in the controller queue"),
+    F("Max. number of messages in the controller queue"),
+    F("Number of messages sent by the controller"),
+    F("Number of failed attempts to send a message"),
+    F("Number of messages removed unsent from the queue")
+  };
+
+  for (size_t i = 0; i < NR_ELEMENTS(names); ++i) {
+    bool headerAdded = false;
+
+    for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+      const ControllerDelayHandlerStruct *handler = ControllerDelayHandlerStruct::getDelayHandler(x);
+
+      if (handler == nullptr) { continue; }
+
+      if (!headerAdded) {
+        addMetricsHeader(names[i], helps[i], i < 2 ? F("gauge") : F("counter"));
+        headerAdded = true;
+      }
+      addHtml(F("espeasy_"));
+      addHtml(names[i]);
+      addHtml(F("{controller=\""));
+      addHtmlInt(x + 1);
+      addHtml(F("\",protocol=\""));
+      addHtml(get_formatted_Controller_number(getCPluginID_from_ControllerIndex(x)));
+      addHtml(F("\"} "));
+
+      switch (i) {
+        case 0: addHtmlInt(static_cast<uint32_t>(handler->sendQueue.size())); break;
+        case 1: addHtmlInt(handler->max_queue_depth); break;
+        case 2: addHtmlInt(handler->stats.sent); break;
+        case 3: addHtmlInt(handler->stats.failed); break;
+        case 4: addHtmlInt(handler->stats.dropped); break;
+      }
+      addHtml('\n');
+    }
+  }
+}
+
 void handle_metrics_devices() {
   for (taskIndex_t x = 0; validTaskIndex(x); x++) {
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
@@ -108,7 +204,7 @@ void handle_metrics_devices() {
         addHtml(deviceName);
         addHtml(F(" gauge\n"));
 
-        if (validDeviceIndex(DeviceIndex)) {
+        if (validDeviceIndex(DeviceIndex) && validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
           String customValuesString;
 
           // const bool customValues = PluginCall(PLUGIN_WEBFORM_SHOW_VALUES, &TempEvent, customValuesString);
@@ -119,15 +215,17 @@ void handle_metrics_devices() {
             struct EventStruct TempEvent(x);
 
             for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-              if (validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
-                addHtml(F("espeasy_device_"));
-                addHtml(deviceName);
-                addHtml(F("{valueName=\""));
-                addHtml(Cache.getTaskDeviceValueName(x, varNr));
-                addHtml(F("\"} "));
-                addHtml(formatUserVarNoCheck(&TempEvent, varNr));
-                addHtml('\n');
-              }
+              addHtml(F("espeasy_device_"));
+              addHtml(deviceName);
+              addHtml(F("{valueName=\""));
+              addMetricsLabelValue(Cache.getTaskDeviceValueName(x, varNr));
+              addHtml(F("\",task=\""));
+              addMetricsLabelValue(deviceName);
+              addHtml(F("\",unit=\""));
+              addHtmlInt(Settings.Unit);
+              addHtml(F("\"} "));
+              addHtml(formatUserVarNoCheck(&TempEvent, varNr));
+              addHtml('\n');
             }
           }
         }
@@ -136,4 +234,86 @@ void handle_metrics_devices() {
   }
 }
 
+# if FEATURE_TIMING_STATS
+
+// Stream a single line of a timing stats summary, the value is to be added by the caller.
+void stream_metrics_timing_line(const __FlashStringHelper *suffix,
+                                const String             & source,
+                                const String             & function,
+                                const __FlashStringHelper *quantile)
+{
+  addHtml(F("espeasy_timing_usec"));
+  addHtml(suffix);
+  addHtml(F("{source=\""));
+  addMetricsLabelValue(source);
+
+  if (!function.isEmpty()) {
+    addHtml(F("\",function=\""));
+    addHtml(function);
+  }
+
+  if (quantile != nullptr) {
+    addHtml(F("\",quantile=\""));
+    addHtml(quantile);
+  }
+  addHtml(F("\"} "));
+}
+
+void stream_metrics_timing_stats(const TimingStats& stats, const String& source, const String& function)
+{
+  const __FlashStringHelper *quantiles[] = { F("0.5"), F("0.9"), F("0.99"), F("0.999") };
+  const float percentiles[]              = { 50.0f, 90.0f, 99.0f, 99.9f };
+
+  for (size_t i = 0; i < NR_ELEMENTS(quantiles); ++i) {
+    stream_metrics_timing_line(F(""), source, function, quantiles[i]);
+    addHtmlInt(stats.getPercentile(percentiles[i]));
+    addHtml('\n');
+  }
+  uint64_t minVal, maxVal;
+  const uint32_t count = stats.getMinMax(minVal, maxVal);
+
+  stream_metrics_timing_line(F("_sum"), source, function, nullptr);
+  addHtmlFloat(stats.getAvg() * count, 0);
+  addHtml('\n');
+  stream_metrics_timing_line(F("_count"), source, function, nullptr);
+  addHtmlInt(count);
+  addHtml('\n');
+}
+
+void handle_metrics_timing_stats() {
+  addMetricsHeader(F("timing_usec"), F("Duration of internal calls in usec since the last reset of the timing stats"), F("summary"));
+
+  for (auto& x : pluginStats) {
+    if (!x.second.isEmpty()) {
+      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(x.first >> 8);
+
+      if (validDeviceIndex(deviceIndex)) {
+        stream_metrics_timing_stats(
+          x.second,
+          concat(get_formatted_Plugin_number(getPluginID_from_DeviceIndex(deviceIndex)), ' ') + getPluginNameFromDeviceIndex(deviceIndex),
+          getPluginFunctionName(x.first % 256));
+      }
+    }
+  }
+
+  for (auto& x : controllerStats) {
+    if (!x.second.isEmpty()) {
+      const protocolIndex_t protocolIndex = x.first >> 8;
+      stream_metrics_timing_stats(
+        x.second,
+        concat(get_formatted_Controller_number(getCPluginID_from_ProtocolIndex(protocolIndex)), ' ') +
+        getCPluginNameFromProtocolIndex(protocolIndex),
+        getCPluginCFunctionName(static_cast<CPlugin::Function>(x.first % 256)));
+    }
+  }
+
+  for (auto& x : miscStats) {
+    if (!x.second.isEmpty()) {
+      stream_metrics_timing_stats(x.second, getMiscStatsName(x.first), EMPTY_STRING);
+    }
+  }
+}
+
+# endif // if FEATURE_TIMING_STATS
+
 #endif // WEBSERVER_METRICS
@@ -6,8 +6,25 @@
 #ifdef WEBSERVER_METRICS
 
 void handle_metrics();
+
+// Check whether a section should be included, e.g. "/metrics?tasks=0" leaves out the task values
+bool metrics_include(const __FlashStringHelper *section,
+                     bool                       defaultValue);
+
+void addMetricsHeader(const __FlashStringHelper *name,
+                      const __FlashStringHelper *help,
+                      const __FlashStringHelper *type);
+
+// Stream a label value, escaping quotes, backslash and newline
+void addMetricsLabelValue(const String& value);
+
+void handle_metrics_controller_queues();
 void handle_metrics_devices();
 
+# if FEATURE_TIMING_STATS
+void handle_metrics_timing_stats();
+# endif // if FEATURE_TIMING_STATS
+
 #endif    // ifdef WEBSERVER_METRICS
 
 #endif
@@ -13,6 +13,9 @@
 
 # include "../Commands/Diagnostic.h"
 
+# include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+# include "../ControllerQueue/DelayQueueElements.h"
+
 # include "../CustomBuild/CompiletimeDefines.h"
 
 # include "../DataStructs/RTCStruct.h"
@@ -22,11 +25,17 @@
 # include "../ESPEasyCore/ESPEasyWifi.h"
 
 # include "../Globals/CRCValues.h"
+# ifdef USES_C016
+#  include "../Globals/C016_ControllerCache.h"
+# endif // ifdef USES_C016
 # include "../Globals/ESPEasy_time.h"
 # include "../Globals/ESPEasyWiFiEvent.h"
+# include "../Globals/EventQueue.h"
 # include "../Globals/NetworkState.h"
 # include "../Globals/RTC.h"
 # include "../Globals/Settings.h"
+# include "../Globals/SyslogQueue.h"
+# include "../Globals/UDP_ReceivePool.h"
 
 # include "../Helpers/Convert.h"
 # include "../Helpers/ESPEasyStatistics.h"
@@ -83,6 +92,39 @@ void handle_sysinfo_json() {
   json_number(F("loop_count"), String(getLoopCountPerSec()));
   json_close();
 
+  json_open(false, F("eventqueue"));
+  json_number(F("length"),       getValue(LabelType::EVENT_QUEUE_LENGTH));
+  json_number(F("capacity"),     String(eventQueue.capacity()));
+  json_number(F("peak"),         getValue(LabelType::EVENT_QUEUE_PEAK_LENGTH));
+  json_number(F("added"),        String(eventQueue.getStats().added));
+  json_number(F("processed"),    String(eventQueue.getStats().processed));
+  json_number(F("dropped"),      getValue(LabelType::EVENT_QUEUE_DROPPED));
+  json_number(F("deduplicated"), getValue(LabelType::EVENT_QUEUE_DEDUPLICATED));
+  json_number(F("coalesced"),    getValue(LabelType::EVENT_QUEUE_COALESCED));
+  json_prop(F("overflow_policy"), getValue(LabelType::EVENT_QUEUE_OVERFLOW_POLICY));
+  json_close();
+
+  json_open(false, F("syslog"));
+  json_number(F("queued"),     String(syslogQueue.size()));
+  json_number(F("usage"),      String(syslogQueue.getUsage()));
+  json_number(F("peak_usage"), String(syslogQueue.getStats().peakUsage));
+  json_number(F("added"),      String(syslogQueue.getStats().added));
+  json_number(F("sent"),       getValue(LabelType::SYSLOG_SENT));
+  json_number(F("datagrams"),  String(syslogQueue.getStats().datagrams));
+  json_number(F("dropped"),    getValue(LabelType::SYSLOG_DROPPED));
+  json_close();
+
+  {
+    const UDP_ReceivePool::Stats& stats = udpReceivePool.getStats();
+    json_open(false, F("udp"));
+    json_number(F("received"),     String(stats.received));
+    json_number(F("processed"),    String(stats.processed));
+    json_number(F("dropped"),      String(stats.dropped));
+    json_number(F("oversized"),    String(stats.oversized));
+    json_number(F("max_per_call"), String(stats.maxPerCall));
+    json_close();
+  }
+
   int freeMem = ESP.getFreeHeap();
   json_open(false, F("mem"));
   json_number(F("free"),    String(freeMem));
@@ -293,6 +335,8 @@ void handle_sysinfo() {
 
   handle_sysinfo_NetworkServices();
 
+  handle_sysinfo_ControllerQueues();
+
   handle_sysinfo_ESP_Board();
 
   handle_sysinfo_Storage();
@@ -608,6 +652,8 @@ void handle_sysinfo_SystemStatus() {
   {
     // Actual Loglevel
     LabelType::SYSLOG_LOG_LEVEL,
+    LabelType::SYSLOG_SENT,
+    LabelType::SYSLOG_DROPPED,
     LabelType::SERIAL_LOG_LEVEL,
     LabelType::WEB_LOG_LEVEL,
 # if FEATURE_SD
@@ -620,6 +666,12 @@ void handle_sysinfo_SystemStatus() {
     LabelType::CONSOLE_FALLBACK_TO_SERIAL0,
     LabelType::CONSOLE_FALLBACK_PORT,
 #endif
+    LabelType::EVENT_QUEUE_LENGTH,
+    LabelType::EVENT_QUEUE_PEAK_LENGTH,
+    LabelType::EVENT_QUEUE_DROPPED,
+    LabelType::EVENT_QUEUE_DEDUPLICATED,
+    LabelType::EVENT_QUEUE_COALESCED,
+    LabelType::EVENT_QUEUE_OVERFLOW_POLICY,
     LabelType::MAX_LABEL
   };
 
@@ -643,6 +695,19 @@ void handle_sysinfo_NetworkServices() {
   addRowLabel(F("NTP Initialized"));
   addEnabled(statusNTPInitialized);
 
+  if (Settings.UDPPort != 0) {
+    const UDP_ReceivePool::Stats& stats = udpReceivePool.getStats();
+    addRowLabel(F("UDP Packets"));
+    addHtml(strformat(
+              F("Received: %u, Processed: %u<BR>Dropped: %u, Oversized: %u<BR>Max per call: %u (pool %u bytes)"),
+              static_cast<unsigned int>(stats.received),
+              static_cast<unsigned int>(stats.processed),
+              static_cast<unsigned int>(stats.dropped),
+              static_cast<unsigned int>(stats.oversized),
+              static_cast<unsigned int>(stats.maxPerCall),
+              static_cast<unsigned int>(udpReceivePool.getMemorySize())));
+  }
+
   #if FEATURE_MQTT
   if (validControllerIndex(firstEnabledMQTT_ControllerIndex())) {
     addRowLabel(F("MQTT Client Connected"));
@@ -652,6 +717,52 @@ void handle_sysinfo_NetworkServices() {
 }
 #endif
 
+#ifndef WEBSERVER_SYSINFO_MINIMAL
+void handle_sysinfo_ControllerQueues() {
+  bool separatorAdded = false;
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    const ControllerDelayHandlerStruct *handler = ControllerDelayHandlerStruct::getDelayHandler(x);
+
+    if (handler == nullptr) { continue; }
+
+    if (!separatorAdded) {
+      addTableSeparator(F("Controller Queues"), 2, 3);
+      separatorAdded = true;
+    }
+
+    const ControllerDelayQueueStats& stats = handler->stats;
+
+    addRowLabel(concat(F("Controller "), x + 1));
+    addHtml(strformat(
+              F("%s<BR>Queue: %d / %d (%u bytes)<BR>Queued: %u, Sent: %u, Failed: %u<BR>Dropped: %u, Duplicates: %u<BR>Batches: %u (max %u / %u)"),
+              getCPluginNameFromCPluginID(getCPluginID_from_ControllerIndex(x)).c_str(),
+              static_cast<int>(handler->sendQueue.size()),
+              static_cast<int>(handler->max_queue_depth),
+              static_cast<unsigned int>(handler->getQueueMemorySize()),
+              stats.queued,
+              stats.sent,
+              stats.failed,
+              stats.dropped,
+              stats.duplicates,
+              stats.batches,
+              stats.maxBatch,
+              handler->max_batch_size));
+    # if FEATURE_MQTT
+
+    if (handler == MQTTDelayHandler) {
+      // Topics are shared by the queued messages
+      const MQTT_topic_pool& topics = MQTT_queue_element::getTopicPool();
+      addHtml(strformat(
+                F("<BR>Topics: %u (%u bytes)"),
+                static_cast<unsigned int>(topics.size()),
+                static_cast<unsigned int>(topics.getMemorySize())));
+    }
+    # endif // if FEATURE_MQTT
+  }
+}
+#endif
+
 #ifndef WEBSERVER_SYSINFO_MINIMAL
 void handle_sysinfo_ESP_Board() {
   addTableSeparator(F("ESP Board"), 2, 3);
@@ -780,6 +891,22 @@ void handle_sysinfo_Storage() {
     SpiffsTotalBytes() / 1024,
     SpiffsFreeSpace() / 1024));
 
+  # ifdef USES_C016
+
+  if (C016_CacheInitialized()) {
+    const ControllerCacheCompressionStats stats = ControllerCache.getCompressionStats();
+
+    addRowLabel(F("Cache Controller Files"));
+    addHtml(strformat(
+      F("Compression: %s<BR>Flushed since boot: %u samples, %u bytes<BR>Compression ratio: %.2f, %.1f samples/kB"),
+      ControllerCache.getCompression() ? "enabled" : "disabled",
+      stats.samples,
+      stats.storedBytes,
+      stats.storedBytes == 0 ? 1.0f : static_cast<float>(stats.rawBytes) / stats.storedBytes,
+      stats.storedBytes == 0 ? 0.0f : stats.samples * 1024.0f / stats.storedBytes));
+  }
+  # endif // ifdef USES_C016
+
   # ifndef LIMIT_BUILD_SIZE
   addRowLabel(F("Page size"));
   addHtmlInt(SpiffsPagesize());
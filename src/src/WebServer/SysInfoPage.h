@@ -40,6 +40,8 @@ void handle_sysinfo_SystemStatus();
 
 void handle_sysinfo_NetworkServices();
 
+void handle_sysinfo_ControllerQueues();
+
 void handle_sysinfo_ESP_Board();
 
 void handle_sysinfo_Storage();
@@ -9,11 +9,14 @@
 
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/RamTracker.h"
 
 #include "../Globals/Device.h"
 
+#include "../Helpers/ESPEasyStatistics.h"
+#include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -37,6 +40,10 @@ void handle_timingstats() {
       F("duty (%)"),
       F("min (ms)"),
       F("Avg (ms)"),
+      F("p50 (ms)"),
+      F("p90 (ms)"),
+      F("p99 (ms)"),
+      F("p99.9 (ms)"),
       F("max (ms)")};
     for (unsigned int i = 0; i < NR_ELEMENTS(headers); ++i) {
       html_table_header(headers[i]);
@@ -44,6 +51,10 @@ void handle_timingstats() {
   }
 
 
+  // Copy before the stats are cleared
+  const RulesEventCache_stats rulesStats = Cache.rulesHelper.getEventCacheStats();
+  const SaveFileStats saveStats = getSaveFileStats();
+  const std::map<String, WebPageStats> pageStats = webPageStats;
   const long timeSinceLastReset = stream_timing_statistics(true);
   html_end_table();
 
@@ -59,6 +70,61 @@ void handle_timingstats() {
   addHtml(F(" sec"));
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
+
+  addFormSubHeader(F("Rules Event Cache"));
+  addRowLabel(F("Lookups"));
+  addHtmlInt(rulesStats.lookups);
+  addRowLabel(F("Hits / Misses"));
+  addHtmlInt(rulesStats.hits);
+  addHtml(F(" / "));
+  addHtmlInt(rulesStats.misses);
+  addRowLabel(F("Candidates checked"));
+  addHtmlInt(rulesStats.candidates);
+  addHtml(F(" (avg "));
+  addHtmlFloat(rulesStats.getAvgCandidates(), 2);
+  addHtml(F(" per lookup)"));
+  #if FEATURE_RULES_COMPILER
+  {
+    size_t nrCompiled{};
+    size_t nrBlocks{};
+    Cache.rulesHelper.getProgramStats(nrCompiled, nrBlocks);
+    addRowLabel(F("Compiled rules blocks"));
+    addHtmlInt(static_cast<uint32_t>(nrCompiled));
+    addHtml(F(" / "));
+    addHtmlInt(static_cast<uint32_t>(nrBlocks));
+  }
+  #endif // if FEATURE_RULES_COMPILER
+
+  addFormSubHeader(getMiscStatsName(TimingStatsElements::SAVEFILE_STATS));
+  addRowLabel(F("Saves / Unchanged"));
+  addHtmlInt(saveStats.saves);
+  addHtml(F(" / "));
+  addHtmlInt(saveStats.unchanged);
+  addRowLabel(F("Bytes Written / Requested"));
+  addHtmlInt(saveStats.bytesWritten);
+  addHtml(F(" / "));
+  addHtmlInt(saveStats.bytesRequested);
+
+  if (saveStats.bytesRequested != 0) {
+    addHtml(F(" ("));
+    addHtmlFloat(100.0f * saveStats.bytesWritten / saveStats.bytesRequested, 1);
+    addHtml(F("%)"));
+  }
+
+  if (!pageStats.empty()) {
+    addFormSubHeader(F("Web Pages"));
+
+    for (auto it = pageStats.begin(); it != pageStats.end(); ++it) {
+      const WebPageStats& stats = it->second;
+      addRowLabel(it->first);
+      addHtml(strformat(
+                F("Served: %u, Avg: %u bytes in %u chunks, %s kB/s"),
+                stats.count,
+                stats.sentBytes / stats.count,
+                stats.nrChunks / stats.count,
+                toString(stats.getBytesPerMsec(), 1).c_str()));
+    }
+  }
   html_end_table();
 
   sendHeadandTail_stdtemplate(_TAIL);
@@ -108,6 +174,13 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   format_using_threshhold(minVal);
   html_TD();
   format_using_threshhold(avg);
+
+  const float percentiles[] = { 50.0f, 90.0f, 99.0f, 99.9f };
+
+  for (size_t i = 0; i < NR_ELEMENTS(percentiles); ++i) {
+    html_TD();
+    format_using_threshhold(stats.getPercentile(percentiles[i]));
+  }
   html_TD();
   format_using_threshhold(maxVal);
 }
@@ -172,10 +245,7 @@ long stream_timing_statistics(bool clearStats) {
   }
 
   if (clearStats) {
-    pluginStats.clear();
-    controllerStats.clear();
-    miscStats.clear();
-    timingstats_last_reset = millis();
+    resetTimingStatistics();
   }
   return timeSinceLastReset;
 }
@@ -0,0 +1,1792 @@
+/*********************************************************************************************\
+* Benchmark runner for the native_benchmark environment.
+*
+* Reports per benchmark the time (ns/op) and number of heap allocations (allocs/op).
+* The rules and events are taken from the rules files in test/benchmark.
+*
+* Usage: pio run -e native_benchmark -t exec
+*    or: <program> [directory with rules*.txt files]
+\*********************************************************************************************/
+
+#include "src/src/Commands/ExecuteCommand.h"
+#include "src/src/ControllerQueue/ControllerDelayHandlerStruct.h"
+#include "src/src/ControllerQueue/ControllerDelayQueue.h"
+#include "src/src/DataStructs/C013_p2p_SensorDataBatch.h"
+#include "src/src/DataStructs/ControllerCacheCodec.h"
+#include "src/src/DataStructs/ControllerCacheIndex.h"
+#include "src/src/DataStructs/EventQueue.h"
+#include "src/src/DataStructs/LogStruct.h"
+#include "src/src/DataStructs/PluginStats.h"
+#include "src/src/DataStructs/PluginStats_samples.h"
+#include "src/src/DataStructs/RulesProgram.h"
+#include "src/src/DataStructs/SyslogQueue.h"
+#include "src/src/DataTypes/EventQueueOverflowPolicy.h"
+#include "src/src/ESPEasyCore/ESPEasyRules.h"
+#include "src/src/Globals/Cache.h"
+#include "src/src/Globals/Device.h"
+#include "src/src/Globals/RuntimeData.h"
+#include "src/src/Helpers/CRC_functions.h"
+#include "src/src/Helpers/ESPEasy_Storage.h"
+#include "src/src/Helpers/FS_Helper.h"
+#include "src/src/Helpers/RulesMatcher.h"
+#include "src/src/Helpers/Rules_calculate.h"
+#include "src/src/Helpers/StringParser.h"
+#include "src/src/Helpers/msecTimerHandlerStruct.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <new>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+#ifndef NATIVE_BENCHMARK_DATA_DIR
+# define NATIVE_BENCHMARK_DATA_DIR "test/benchmark"
+#endif // ifndef NATIVE_BENCHMARK_DATA_DIR
+
+
+/*********************************************************************************************\
+* Count heap allocations
+\*********************************************************************************************/
+static uint64_t nrAllocations = 0;
+
+// The operators are not inlined, otherwise the compiler sees the malloc/free
+// inside and reports every new/delete pair as mismatched (-Wmismatched-new-delete).
+__attribute__((noinline)) void* operator new(size_t size) {
+  ++nrAllocations;
+  void *ptr = malloc(size == 0 ? 1 : size);
+
+  if (ptr == nullptr) { throw std::bad_alloc(); }
+  return ptr;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept {
+  free(ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void *ptr) noexcept {
+  free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr, size_t) noexcept {
+  free(ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void *ptr, size_t) noexcept {
+  free(ptr);
+}
+
+
+/*********************************************************************************************\
+* Benchmark helpers
+\*********************************************************************************************/
+
+// Prevent the compiler from optimizing away the result of a benchmark
+static volatile double benchmarkSink = 0;
+
+// Run func() for nrOps operations in total, func() returns the number of operations it did.
+template<typename Func>
+static void runBenchmark(const char *name, uint32_t nrOps, Func func) {
+  // Warm up, so lazy initialization and caches are not part of the measurement.
+  func();
+
+  const uint64_t allocationsStart = nrAllocations;
+  const auto     start            = std::chrono::steady_clock::now();
+  uint64_t done                   = 0;
+
+  while (done < nrOps) {
+    done += func();
+  }
+  const auto     end         = std::chrono::steady_clock::now();
+  const uint64_t allocations = nrAllocations - allocationsStart;
+  const double   nsec        = std::chrono::duration<double, std::nano>(end - start).count();
+
+  printf("%-28s %10.1f ns/op %8.2f allocs/op %10llu ops\n",
+         name,
+         nsec / done,
+         static_cast<double>(allocations) / done,
+         static_cast<unsigned long long>(done));
+}
+
+static bool readLines(const std::string& fname, std::vector<String>& lines) {
+  std::ifstream file(fname);
+
+  if (!file) { return false; }
+  std::string line;
+
+  while (std::getline(file, line)) {
+    String str(line);
+
+    // Strip comments
+    const int commentPos = str.indexOf(F("//"));
+
+    if (commentPos >= 0) {
+      str = str.substring(0, commentPos);
+    }
+    str.trim();
+
+    if (!str.isEmpty()) {
+      lines.push_back(str);
+    }
+  }
+  return true;
+}
+
+
+/*********************************************************************************************\
+* Test data, taken from the rules files
+\*********************************************************************************************/
+struct BenchmarkData {
+  // The event part of all "On ... Do" lines
+  std::vector<String>rules;
+
+  // Events which will match (some of) the rules
+  std::vector<String>events;
+
+  // Expressions which can be evaluated without system variables or task values
+  std::vector<String>expressions;
+};
+
+static void parseRules(const std::vector<String>& lines, BenchmarkData& data) {
+  for (const String& line : lines) {
+    String event, action;
+
+    if (getEventFromRulesLine(line, event, action)) {
+      data.rules.push_back(event);
+
+      // Turn a rule condition like "Test>=10" into events "Test=9", "Test=10" and "Test=11"
+      char compare;
+      int  posStart, posEnd;
+
+      if (findCompareCondition(event, compare, posStart, posEnd)) {
+        const String name = event.substring(0, posStart);
+        const long   value = event.substring(posEnd).toInt();
+
+        for (long v = value - 1; v <= value + 1; ++v) {
+          data.events.push_back(concat(name, '=') + String(v));
+        }
+      } else {
+        data.events.push_back(event);
+      }
+      continue;
+    }
+
+    // Let,<var>,<expression>
+    if (line.substring(0, 4).equalsIgnoreCase(F("Let,"))) {
+      const int pos = line.indexOf(',', 4);
+
+      if (pos > 0) {
+        const String expression = line.substring(pos + 1);
+
+        if ((expression.indexOf('[') < 0) && (expression.indexOf('%') < 0)) {
+          data.expressions.push_back(expression);
+        }
+      }
+    }
+  }
+}
+
+
+/*********************************************************************************************\
+* Benchmarks
+\*********************************************************************************************/
+static void benchmarkRulesMatcher(const BenchmarkData& data) {
+  if (data.rules.empty()) { return; }
+  runBenchmark("ruleMatch", 200000, [&]() {
+    uint32_t matches = 0;
+
+    for (const String& event : data.events) {
+      for (const String& rule : data.rules) {
+        if (ruleMatch(event, rule)) { ++matches; }
+      }
+    }
+    benchmarkSink = benchmarkSink + matches;
+    return static_cast<uint32_t>(data.events.size() * data.rules.size());
+  });
+}
+
+static void benchmarkCalculate(const BenchmarkData& data) {
+  // Some expressions as typically used in formulas, besides the ones from the rules files
+  std::vector<String> expressions = data.expressions;
+
+  expressions.push_back(F("(21.5-3)/2"));
+  expressions.push_back(F("round(23.456*10)/10"));
+  expressions.push_back(F("map(512:0:1023:0:100)"));
+  expressions.push_back(F("sin_d(30)+cos_d(60)"));
+  expressions.push_back(F("25.3*1.8+32"));
+
+  RulesCalculate_t calculate;
+
+  runBenchmark("Calculate (text)", 200000, [&]() {
+    for (const String& expression : expressions) {
+      ESPEASY_RULES_FLOAT_TYPE result{};
+      const String preprocessed = RulesCalculate_t::preProces(expression);
+      calculate.doCalculate(preprocessed.c_str(), &result);
+      benchmarkSink = benchmarkSink + result;
+    }
+    return static_cast<uint32_t>(expressions.size());
+  });
+
+#if RULES_CALCULATE_CACHE_SIZE > 0
+  {
+    // Working set which fits in the cache
+    const std::vector<String> cached(
+      expressions.begin(),
+      expressions.begin() + std::min<size_t>(expressions.size(), RULES_CALCULATE_CACHE_SIZE));
+
+    runBenchmark("Calculate (cached)", 200000, [&]() {
+      for (const String& expression : cached) {
+        ESPEASY_RULES_FLOAT_TYPE result{};
+        calculate.calculateCached(expression, result);
+        benchmarkSink = benchmarkSink + result;
+      }
+      return static_cast<uint32_t>(cached.size());
+    });
+
+    // Substituted values, every expression is different and should not be compiled
+    uint32_t n = 0;
+
+    runBenchmark("Calculate (new values)", 200000, [&]() {
+      ESPEASY_RULES_FLOAT_TYPE result{};
+      calculate.calculateCached(strformat(F("%u.25*1.8+32"), ++n), result);
+      benchmarkSink = benchmarkSink + result;
+      return 1u;
+    });
+  }
+#endif // if RULES_CALCULATE_CACHE_SIZE > 0
+
+  {
+    const __FlashStringHelper *slotNames[] = { F("%value%") };
+    RulesCalculate_program     program;
+    calculate.compile(RulesCalculate_t::preProces(F("%value%*1.8+32")), slotNames, NR_ELEMENTS(slotNames), program);
+
+    runBenchmark("Calculate (program)", 1000000, [&]() {
+      ESPEASY_RULES_FLOAT_TYPE value = benchmarkSink;
+      ESPEASY_RULES_FLOAT_TYPE result{};
+      calculate.evaluate(program, &value, 1, result);
+      benchmarkSink = result * 1e-9;
+      return 1u;
+    });
+  }
+}
+
+// Compile all "On ... Do" blocks, the same way as RulesHelperClass::compileBlock()
+static size_t compileRulesBlocks(const std::vector<String>& lines, std::vector<RulesProgram_block>& blocks) {
+  size_t nrBlocks = 0;
+  bool   inBlock  = false;
+  bool   ok       = false;
+
+  blocks.clear();
+
+  for (const String& line : lines) {
+    String event, action;
+
+    if (getEventFromRulesLine(line, event, action)) {
+      inBlock = action.isEmpty();
+      ok      = true;
+
+      if (inBlock) {
+        blocks.emplace_back();
+        ++nrBlocks;
+      }
+    } else if (inBlock) {
+      if (line.equalsIgnoreCase(F("endon"))) {
+        if (!ok || !blocks.back().finalize()) {
+          blocks.pop_back();
+        }
+        inBlock = false;
+      } else if (ok) {
+        ok = blocks.back().addLine(line);
+      }
+    }
+  }
+
+  if (inBlock) {
+    blocks.pop_back();
+  }
+  return nrBlocks;
+}
+
+static void benchmarkRulesProgram(const std::vector<String>& lines) {
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("Rules program check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  {
+    RulesProgram_block block;
+
+    for (const char *line : {
+      "if %eventvalue1%>10",
+      "LogEntry,'%eventname% %eventpar% high %eventvalue2|-1%'",
+      "elseif %eventvalue1%>5",
+      "LogEntry,'mid %eventvalue0%'",
+      "else",
+      "LogEntry,'%eventvalue|5% low'",
+      "endif",
+      "TimerSet,%eventvalue%,1"
+    }) {
+      check(block.addLine(line), "addLine");
+    }
+    check(block.finalize(), "finalize");
+    check(block.lines.size() == 8, "nr lines");
+    check((block.lines[0].opcode == RulesProgram_opcode::If) &&
+          (block.lines[0].jumpTarget == 2) && (block.lines[0].endTarget == 6), "if jump targets");
+    check((block.lines[2].opcode == RulesProgram_opcode::ElseIf) &&
+          (block.lines[2].jumpTarget == 4) && (block.lines[2].endTarget == 6), "elseif jump targets");
+    check((block.lines[4].opcode == RulesProgram_opcode::Else) && (block.lines[4].endTarget == 6), "else jump target");
+
+    // %eventvalue|Y% is not compiled, as the text based engine removes it as invalid variable
+    check(block.lines[5].hasFlag(RULES_PROGRAM_LINE_LEGACY_SUBST), "eventvalue with default, no nr");
+    check(!block.lines[7].hasFlag(RULES_PROGRAM_LINE_LEGACY_SUBST), "eventvalue without nr");
+
+    const String event(F("Sensor#Temp=12,3"));
+    RulesProgram_eventData eventData(event);
+    check(eventData.render(block.lines[1]) == F("LogEntry,'Sensor#Temp Temp high 3'"), "render eventname, eventpar");
+    check(eventData.render(block.lines[3]) == F("LogEntry,'mid 12,3'"), "render eventvalue0");
+    check(eventData.render(block.lines[7]) == F("TimerSet,12,1"), "render eventvalue");
+
+    const String event2(F("Sensor#Temp=12"));
+    RulesProgram_eventData eventData2(event2);
+    check(eventData2.render(block.lines[1]) == F("LogEntry,'Sensor#Temp Temp high -1'"), "render default value");
+
+    // Serialize and read back
+    fs::File f = ESPEASY_FS.open(F("/benchmark.bin"), "w");
+    const size_t size = block.serialize(f);
+    check((size != 0) && (size == f.size()), "serialize");
+    f.seek(0);
+    RulesProgram_block copy;
+    check(copy.deserialize(f) && (copy.lines.size() == block.lines.size()), "deserialize");
+    check(eventData.render(copy.lines[1]) == eventData.render(block.lines[1]), "render deserialized");
+  }
+  {
+    // Default value position does not fit in a uint8_t
+    RulesProgram_block block;
+    const String line = concat(F("LogEntry,%eventvalue0|"), String(std::string(300, 'x'))) + '%';
+    check(block.addLine(line) && block.finalize(), "long default");
+    check(block.lines[0].hasFlag(RULES_PROGRAM_LINE_LEGACY_SUBST), "long default not compiled");
+  }
+  {
+    RulesProgram_block block;
+    check(block.addLine(F("if 1=1")) && !block.finalize(), "unbalanced if");
+  }
+  printf("%-28s %10u checks, %u mismatches\n", "Rules program",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+
+  std::vector<RulesProgram_block> blocks;
+  size_t nrBlocks = 0;
+
+  runBenchmark("Rules compile block", 200000, [&]() {
+    nrBlocks = compileRulesBlocks(lines, blocks);
+    return static_cast<uint32_t>(nrBlocks);
+  });
+  printf("%-28s %10u of %u blocks compiled\n", "",
+         static_cast<unsigned>(blocks.size()), static_cast<unsigned>(nrBlocks));
+
+  if (blocks.empty()) { return; }
+
+  const String events[] = { F("Timer=1,10"), F("Rules#Timer=3"), F("Sensor#Temp=21.25,3,4") };
+  uint32_t n = 0;
+  String   res;
+
+  runBenchmark("Rules render compiled line", 2000000, [&]() {
+    RulesProgram_eventData eventData(events[++n % NR_ELEMENTS(events)]);
+    uint32_t nrLines = 0;
+
+    for (const RulesProgram_block& block : blocks) {
+      for (const RulesProgram_line& line : block.lines) {
+        res = eventData.render(line);
+        ++nrLines;
+      }
+    }
+    return nrLines;
+  });
+}
+
+// Store a rules file from the test data as rules set rulesNr in the in-memory file system
+static bool storeRulesFile(const std::string& fname, unsigned int rulesNr) {
+  std::ifstream file(fname, std::ios::binary);
+
+  if (!file) { return false; }
+  const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  fs::File f = tryOpenFile(getRulesFileName(rulesNr), F("w"));
+
+  return f && (f.write(reinterpret_cast<const uint8_t *>(content.data()), content.size()) == content.size());
+}
+
+// Executed commands and the rules variables set while processing a single event
+struct RulesEngineResult {
+  std::vector<String>                         commands;
+  std::map<uint32_t, ESPEASY_RULES_FLOAT_TYPE>vars;
+};
+
+static void processRulesEvent(const String& event, RulesEngineResult& result) {
+  executedCommands.clear();
+  customFloatVar.clear();
+  rulesProcessing(event);
+  result.commands = executedCommands;
+  result.vars     = customFloatVar;
+}
+
+static void setRulesCaching(bool enableRulesCaching) {
+  Settings.enableRulesCaching = enableRulesCaching;
+  Cache.clearAllCaches();
+  checkRuleSets();
+}
+
+static void benchmarkRulesEngine(const std::string& dataDir, const BenchmarkData& data) {
+  if (data.events.empty()) { return; }
+
+  unsigned int rulesNr = 0;
+
+  for (const char *fname : { "rules1.txt", "rules2.txt" }) {
+    if (storeRulesFile(dataDir + "/" + fname, rulesNr)) {
+      ++rulesNr;
+    }
+  }
+
+  Settings.UseRules       = true;
+  Settings.oldRulesEngine = true;
+
+  // Nested events (Event command) are only recorded by the host ExecuteCommand_all(),
+  // so each event is processed on its own by the text based engine and by the compiled programs.
+  std::vector<RulesEngineResult> expected(data.events.size());
+
+  setRulesCaching(false);
+
+  for (size_t i = 0; i < data.events.size(); ++i) {
+    processRulesEvent(data.events[i], expected[i]);
+  }
+
+  setRulesCaching(true);
+  size_t nrCompiled = 0;
+  size_t nrBlocks   = 0;
+
+  Cache.rulesHelper.getProgramStats(nrCompiled, nrBlocks);
+
+  uint32_t nrErrors   = 0;
+  uint32_t nrCommands = 0;
+
+  for (size_t i = 0; i < data.events.size(); ++i) {
+    RulesEngineResult result;
+    processRulesEvent(data.events[i], result);
+    nrCommands += expected[i].commands.size();
+
+    if ((result.commands != expected[i].commands) || (result.vars != expected[i].vars)) {
+      printf("Rules engine check failed: %s\n", data.events[i].c_str());
+      ++nrErrors;
+    }
+  }
+
+  setRulesCaching(false);
+  runBenchmark("rulesProcessingFile", 20000, [&]() {
+    for (const String& event : data.events) {
+      executedCommands.clear();
+      rulesProcessing(event);
+    }
+    return static_cast<uint32_t>(data.events.size());
+  });
+
+  setRulesCaching(true);
+  runBenchmark("rulesProcessing (compiled)", 200000, [&]() {
+    for (const String& event : data.events) {
+      executedCommands.clear();
+      rulesProcessing(event);
+    }
+    return static_cast<uint32_t>(data.events.size());
+  });
+  printf("%-28s %10u of %u blocks compiled, %u commands\n", "",
+         static_cast<unsigned>(nrCompiled), static_cast<unsigned>(nrBlocks), static_cast<unsigned>(nrCommands));
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(data.events.size()), static_cast<unsigned>(nrErrors));
+  executedCommands.clear();
+  customFloatVar.clear();
+}
+
+// Task 1 "Sensor" with 4 values, the "Hum" value has a formula
+static void setupBenchmarkTask() {
+  const taskIndex_t taskIndex = 0;
+
+  Device.resize(1);
+  DeviceStruct& device = Device.getDeviceStructForEdit(deviceIndex_t::toDeviceIndex(0));
+  device.Number        = 1;
+  device.VType         = Sensor_VType::SENSOR_TYPE_QUAD;
+  device.ValueCount    = 4;
+  device.FormulaOption = true;
+
+  Settings.TaskDeviceNumber[taskIndex]  = device.Number;
+  Settings.TaskDeviceEnabled[taskIndex] = true;
+
+  ExtraTaskSettings_cache_t  settings;
+  const __FlashStringHelper *valueNames[] = { F("Temp"), F("Hum"), F("Press"), F("Count") };
+
+  settings.TaskDeviceName = F("Sensor");
+
+  for (uint8_t i = 0; i < NR_ELEMENTS(valueNames); ++i) {
+    settings.TaskDeviceValueNames[i] = valueNames[i];
+    settings.decimals[i]             = 2;
+  }
+  settings.TaskDeviceFormula[1] = F("%value%*2");
+  Cache.setTaskSettings(taskIndex, settings);
+}
+
+static void benchmarkUserVar() {
+  setupBenchmarkTask();
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("UserVar check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  UserVar.setFloat(0, 0, 21.5f);
+  check(UserVar.getFloat(0, 0) == 21.5f, "no formula");
+  check(UserVar.getFloat(0, 0, true) == 21.5f, "no formula, raw");
+  UserVar.setFloat(0, 1, 40.25f);
+  check(UserVar.getFloat(0, 1) == 80.5f, "formula");
+  check(UserVar.getFloat(0, 1, true) == 40.25f, "formula, raw");
+  UserVar.setFloat(0, 1, 10.0f);
+  check(UserVar.getFloat(0, 1) == 20.0f, "formula, new value");
+  check(UserVar.getFloat(0, 0) == 21.5f, "other value unchanged");
+  printf("%-28s %10u checks, %u mismatches\n", "UserVar",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+
+  uint32_t n = 0;
+
+  runBenchmark("UserVar setFloat+getFloat", 20000000, [&]() {
+    UserVar.setFloat(0, 0, static_cast<float>(++n % 100));
+    benchmarkSink = benchmarkSink + UserVar.getFloat(0, 0);
+    return 1u;
+  });
+  runBenchmark("UserVar formula", 2000000, [&]() {
+    UserVar.setFloat(0, 1, static_cast<float>(++n % 100));
+    benchmarkSink = benchmarkSink + UserVar.getFloat(0, 1);
+    return 1u;
+  });
+}
+
+static void benchmarkParseTemplate() {
+  setupBenchmarkTask();
+  UserVar.setFloat(0, 0, 21.5f);
+  UserVar.setFloat(0, 1, 40.25f);
+  UserVar.setFloat(0, 3, 1.0f);
+  setCustomFloatVar(1, 3.25);
+
+  const struct {
+    const char *tmpl;
+    const char *expected;
+  } tests[] = {
+    { "[Sensor#Temp]",                  "21.50"           },
+    { "T=[sensor#temp] H=[Sensor#Hum]", "T=21.50 H=80.50" },
+    { "[Sensor#Count#O]",               " ON"             },
+    { "[Sensor#settings.enabled]",      "1"               },
+    { "[VAR#1] [INT#1]",                "3.25 3"          },
+    { "Heap %sysheap%",                 "Heap 1000000"    },
+    { "[Unknown#Temp]",                 ""                },
+  };
+  uint32_t nrErrors = 0;
+
+  for (size_t i = 0; i < NR_ELEMENTS(tests); ++i) {
+    String tmpl(tests[i].tmpl);
+    const String res = parseTemplate_padded(tmpl, 0);
+
+    if (res != tests[i].expected) {
+      printf("parseTemplate check failed: %s -> %s\n", tests[i].tmpl, res.c_str());
+      ++nrErrors;
+    }
+  }
+
+  runBenchmark("parseTemplate_padded", 200000, [&]() {
+    for (size_t i = 0; i < NR_ELEMENTS(tests); ++i) {
+      String tmpl(tests[i].tmpl);
+      benchmarkSink = benchmarkSink + parseTemplate_padded(tmpl, 0).length();
+    }
+    return static_cast<uint32_t>(NR_ELEMENTS(tests));
+  });
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(NR_ELEMENTS(tests)), static_cast<unsigned>(nrErrors));
+  customFloatVar.clear();
+}
+
+static void benchmarkEventQueue(const BenchmarkData& data) {
+  if (data.events.empty()) { return; }
+  EventQueueStruct queue;
+  String event;
+
+  runBenchmark("EventQueue add+getNext", 500000, [&]() {
+    for (const String& e : data.events) {
+      queue.add(e);
+    }
+
+    while (queue.getNext(event)) {}
+    return static_cast<uint32_t>(data.events.size());
+  });
+
+  runBenchmark("EventQueue add dedupe", 500000, [&]() {
+    for (const String& e : data.events) {
+      queue.add(e, true);
+      queue.add(e, true);
+    }
+
+    while (queue.getNext(event)) {}
+    return static_cast<uint32_t>(2 * data.events.size());
+  });
+
+  // Overflow, timer events must never be merged or dropped in favour of user events
+  uint32_t nrErrors = 0;
+  const uint8_t policy = Settings.overflowPolicy;
+
+  Settings.EventQueueOverflowPolicy(EventQueueOverflowPolicy_e::Coalesce);
+  queue.resetStats();
+
+  for (uint32_t i = 0; i < EVENT_QUEUE_MAX_SIZE; ++i) {
+    queue.add(strformat(F("Rules#Timer=%u"), i));
+  }
+  queue.add(F("Rules#Timer=1000"));
+  queue.add(F("Dummy#Value=1"));
+
+  const EventQueueStats& stats = queue.getStats();
+
+  if ((stats.coalesced != 0) || (stats.dropped != 2) || (queue.size() != EVENT_QUEUE_MAX_SIZE)) {
+    printf("EventQueue check failed: overflow with timer events\n");
+    ++nrErrors;
+  }
+  uint32_t expected = 0;
+
+  while (queue.getNext(event)) {
+    if (event != strformat(F("Rules#Timer=%u"), expected == EVENT_QUEUE_MAX_SIZE - 1 ? 1000 : expected + 1)) {
+      ++nrErrors;
+    }
+    ++expected;
+  }
+  Settings.overflowPolicy = policy;
+  printf("%-28s %10u checks, %u mismatches\n", "EventQueue overflow",
+         static_cast<unsigned>(1 + expected), static_cast<unsigned>(nrErrors));
+}
+
+static void benchmarkTimers() {
+  msecTimerHandlerStruct timers;
+
+  // Do not wait when no timer is due
+  timers.setEcoMode(false);
+  const uint32_t nrTimers = 256;
+  unsigned long  id       = 1;
+
+  runBenchmark("msecTimer register+get", 1000000, [&]() {
+    const unsigned long now = millis();
+
+    for (uint32_t i = 0; i < nrTimers; ++i) {
+      // Already expired, spread over the last second
+      timers.registerAt(id + i, now - ((i * 7919) % 1000));
+    }
+    unsigned long timer;
+    uint32_t nrHandled = 0;
+
+    while (timers.getNextId(timer) != 0) { ++nrHandled; }
+    benchmarkSink = benchmarkSink + nrHandled;
+    id += nrTimers;
+    return nrTimers;
+  });
+
+  // Timers set for the same moment are handled in reverse order of (re)scheduling.
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+  const unsigned long due = millis() - 10;
+
+  for (unsigned long i = 1; i <= 5; ++i) {
+    timers.registerAt(i, due);
+  }
+  timers.registerAt(2, due);
+  timers.registerAt(6, due - 1);
+
+  const unsigned long expectedOrder[] = { 6, 2, 5, 4, 3, 1 };
+  unsigned long timer;
+
+  for (size_t i = 0; i < NR_ELEMENTS(expectedOrder); ++i) {
+    ++nrChecks;
+
+    if (timers.getNextId(timer) != expectedOrder[i]) {
+      ++nrErrors;
+    }
+  }
+  ++nrChecks;
+
+  if (timers.getNextId(timer) != 0) {
+    ++nrErrors;
+  }
+
+  // Stats are only reset when asked for
+  const String stats        = timers.getQueueStats(false);
+  const String statsBefore  = timers.getQueueStats(true);
+  const String statsCleared = timers.getQueueStats(false);
+
+  nrChecks += 2;
+
+  if (stats != statsBefore) { ++nrErrors; }
+
+  if (statsCleared == statsBefore) { ++nrErrors; }
+  printf("%-28s %10u checks, %u mismatches\n", "msecTimer order",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+}
+
+struct BenchmarkQueueElement : public Queue_element_base {
+  size_t getSize() const override {
+    return sizeof(*this);
+  }
+
+  bool isDuplicate(const Queue_element_base& other) const override {
+    return other._taskIndex == _taskIndex;
+  }
+
+  const UnitMessageCount_t* getUnitMessageCount() const override {
+    return nullptr;
+  }
+
+  UnitMessageCount_t* getUnitMessageCount() override {
+    return nullptr;
+  }
+};
+
+static void benchmarkControllerQueue() {
+  ControllerDelayQueue queue;
+  const uint32_t nrElements = 25;
+
+  runBenchmark("ControllerDelayQueue", 1000000, [&]() {
+    for (uint32_t i = 0; i < nrElements; ++i) {
+      std::unique_ptr<Queue_element_base> element(new BenchmarkQueueElement());
+      element->_taskIndex = i;
+      queue.push_back(std::move(element));
+    }
+
+    while (!queue.empty()) {
+      benchmarkSink = benchmarkSink + queue.front()->_taskIndex;
+      queue.pop_front();
+    }
+    return nrElements;
+  });
+}
+
+static uint32_t nrDelayQueueSent = 0;
+static bool     delayQueueSendOk = true;
+
+static bool benchmarkDelayQueueSend(cpluginID_t cpluginID, const Queue_element_base& element, ControllerSettingsStruct& ControllerSettings) {
+  if (delayQueueSendOk) { ++nrDelayQueueSent; }
+  return delayQueueSendOk;
+}
+
+static bool addToDelayQueue(ControllerDelayHandlerStruct& handler, taskIndex_t taskIndex) {
+  std::unique_ptr<Queue_element_base> element(new BenchmarkQueueElement());
+  element->_controller_idx = handler.controllerIndex;
+  element->_taskIndex      = taskIndex;
+  element->_timestamp      = millis();
+  return handler.addToQueue(std::move(element));
+}
+
+static void processDelayQueue(ControllerDelayHandlerStruct& handler) {
+  handler.process(13, benchmarkDelayQueueSend, TimingStatsElements::C013_DELAY_QUEUE,
+                  SchedulerIntervalTimer_e::TIMER_C013_DELAY_QUEUE);
+}
+
+static void benchmarkControllerDelayHandler() {
+  // Controller 1 uses C013, which does not need the network
+  const controllerIndex_t controllerIndex = 0;
+  const uint8_t nrElements = CONTROLLER_DELAY_QUEUE_BATCH_MAX;
+
+  Settings.Protocol[controllerIndex]          = 13;
+  Settings.ControllerEnabled[controllerIndex] = true;
+
+  ControllerSettingsStruct& settings = storedControllerSettings[controllerIndex];
+
+  settings.MaxQueueDepth = nrElements;
+  settings.MaxBatchSize  = nrElements;
+  settings.deduplicate(true);
+
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("Delay queue check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  {
+    ControllerDelayHandlerStruct handler;
+    check(handler.cacheControllerSettings(controllerIndex), "cacheControllerSettings");
+    check(handler.max_batch_size == nrElements, "max batch size");
+
+    for (uint8_t i = 0; i < nrElements + 5; ++i) {
+      addToDelayQueue(handler, i);
+    }
+    check(addToDelayQueue(handler, 0), "duplicate accepted");
+    check((handler.stats.queued == nrElements) && (handler.stats.dropped == 5), "queue full");
+    check(handler.stats.duplicates == 1, "duplicate");
+
+    delayQueueSendOk = false;
+    processDelayQueue(handler);
+    check((handler.stats.failed == 1) && (handler.sendQueue.size() == nrElements), "failed send kept");
+
+    delayQueueSendOk = true;
+    nrDelayQueueSent = 0;
+    processDelayQueue(handler);
+    check((nrDelayQueueSent == nrElements) && handler.sendQueue.empty(), "single batch");
+    check((handler.stats.sent == nrElements) && (handler.stats.batches == 1) &&
+          (handler.stats.maxBatch == nrElements), "stats");
+  }
+
+  settings.deduplicate(false);
+  ControllerDelayHandlerStruct handler;
+
+  handler.cacheControllerSettings(controllerIndex);
+  nrDelayQueueSent = 0;
+
+  runBenchmark("DelayHandler add+process", 1000000, [&]() {
+    for (uint8_t i = 0; i < nrElements; ++i) {
+      addToDelayQueue(handler, i);
+    }
+    processDelayQueue(handler);
+    return static_cast<uint32_t>(nrElements);
+  });
+  check(nrDelayQueueSent == handler.stats.queued, "all sent");
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+}
+
+// Same layout as C016_binary_element
+struct BenchmarkCacheRecord {
+  float    values[4];
+  uint32_t unixTime;
+  uint8_t  TaskIndex;
+  uint8_t  pluginID;
+  uint8_t  sensorType;
+  uint8_t  valueCount;
+};
+
+struct BenchmarkCacheFile {
+  BenchmarkCacheFile() : index(sizeof(BenchmarkCacheRecord)) {}
+
+  std::vector<BenchmarkCacheRecord>records;
+  ControllerCacheIndex             index;
+};
+
+static void benchmarkControllerCacheIndex() {
+  // 16 cache files of 256 kB, 12 tasks sending a sample every 10 sec.
+  const uint32_t nrFiles        = 16;
+  const uint32_t recordsPerFile = 262144 / sizeof(BenchmarkCacheRecord);
+  const uint32_t nrTasks        = 12;
+  const uint32_t startTime      = 1700000000;
+  std::vector<BenchmarkCacheFile> files(nrFiles);
+  uint32_t unixTime = startTime;
+  uint32_t recordNr = 0;
+
+  for (BenchmarkCacheFile& file : files) {
+    file.records.resize(recordsPerFile);
+
+    for (BenchmarkCacheRecord& record : file.records) {
+      record.TaskIndex = recordNr % nrTasks;
+      record.unixTime  = unixTime;
+
+      if (record.TaskIndex == (nrTasks - 1)) { unixTime += 10; }
+      ++recordNr;
+    }
+  }
+
+  runBenchmark("CacheIndex build", 2000000, [&]() {
+    for (BenchmarkCacheFile& file : files) {
+      file.index.clear();
+
+      for (const BenchmarkCacheRecord& record : file.records) {
+        file.index.add(record.unixTime, record.TaskIndex);
+      }
+    }
+    return nrFiles * recordsPerFile;
+  });
+
+  // Query: first sample of task 3 in the last 6 hours
+  const uint32_t    from      = unixTime - 6 * 3600;
+  const taskIndex_t taskIndex = 3;
+  uint64_t recordsRead        = 0;
+  uint32_t nrQueries          = 0;
+
+  runBenchmark("CacheIndex query (scan)", 200, [&]() {
+    for (const BenchmarkCacheFile& file : files) {
+      for (const BenchmarkCacheRecord& record : file.records) {
+        ++recordsRead;
+
+        if ((record.unixTime >= from) && (record.TaskIndex == taskIndex)) {
+          benchmarkSink = benchmarkSink + record.unixTime;
+          ++nrQueries;
+          return 1u;
+        }
+      }
+    }
+    return 1u;
+  });
+  printf("%-28s %10.1f records read/query, %.1f MB\n", "",
+         static_cast<double>(recordsRead) / nrQueries,
+         nrFiles * recordsPerFile * sizeof(BenchmarkCacheRecord) / 1048576.0);
+
+  recordsRead = 0;
+  nrQueries   = 0;
+  runBenchmark("CacheIndex query (indexed)", 200000, [&]() {
+    for (const BenchmarkCacheFile& file : files) {
+      size_t blockNr = 0;
+
+      while (file.index.find(from, UINT32_MAX, taskIndex, blockNr)) {
+        const ControllerCacheBlock& block = file.index.getBlocks()[blockNr];
+        const size_t first                = block.offset / sizeof(BenchmarkCacheRecord);
+
+        for (size_t i = first; i < first + block.recordCount; ++i) {
+          const BenchmarkCacheRecord& record = file.records[i];
+          ++recordsRead;
+
+          if ((record.unixTime >= from) && (record.TaskIndex == taskIndex)) {
+            benchmarkSink = benchmarkSink + record.unixTime;
+            ++nrQueries;
+            return 1u;
+          }
+        }
+        ++blockNr;
+      }
+    }
+    return 1u;
+  });
+  printf("%-28s %10.1f records read/query\n", "",
+         static_cast<double>(recordsRead) / nrQueries);
+}
+
+static void benchmarkControllerCacheCodec() {
+  // Frames as flushed from the RTC cache on ESP32 (32 samples),
+  // 3 tasks sampling every second with slowly changing values.
+  const size_t nrFrames        = 256;
+  const size_t recordsPerFrame = 32;
+  std::vector<ControllerCacheRecord> records(nrFrames * recordsPerFrame);
+  uint32_t unixTime = 1700000000;
+
+  for (size_t i = 0; i < records.size(); ++i) {
+    ControllerCacheRecord& record = records[i];
+    const uint8_t taskIndex       = i % 3;
+    const float   values[4]       = {
+      20.0f + 0.1f * static_cast<float>((i / 30) % 50),
+      55.0f + static_cast<float>((i / 90) % 10),
+      1013.0f,
+      0.0f
+    };
+
+    memcpy(record.values, values, sizeof(values));
+    record.unixTime   = unixTime;
+    record.TaskIndex  = taskIndex;
+    record.pluginID   = 5 + taskIndex;
+    record.sensorType = 3;
+    record.valueCount = 3;
+
+    if (taskIndex == 2) { ++unixTime; }
+  }
+
+  std::vector<std::vector<uint8_t> > frames(nrFrames);
+  size_t encodedSize = 0;
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(&records[0]);
+
+  runBenchmark("CacheCodec encode", 2000000, [&]() {
+    encodedSize = 0;
+
+    for (size_t f = 0; f < nrFrames; ++f) {
+      ControllerCacheCodec::encodeFrame(raw + f * recordsPerFrame * sizeof(ControllerCacheRecord), recordsPerFrame, frames[f]);
+      encodedSize += frames[f].size();
+    }
+    return static_cast<uint32_t>(nrFrames * recordsPerFrame);
+  });
+
+  std::vector<ControllerCacheRecord> decoded(recordsPerFrame);
+  size_t nrErrors = 0;
+
+  runBenchmark("CacheCodec decode", 2000000, [&]() {
+    for (size_t f = 0; f < nrFrames; ++f) {
+      ControllerCacheFrameHeader header;
+      memcpy(&header, &frames[f][0], sizeof(header));
+
+      if (!ControllerCacheCodec::decodeFrame(header, &frames[f][sizeof(header)], reinterpret_cast<uint8_t *>(&decoded[0])) ||
+          (memcmp(&decoded[0], raw + f * recordsPerFrame * sizeof(ControllerCacheRecord),
+                  recordsPerFrame * sizeof(ControllerCacheRecord)) != 0)) {
+        ++nrErrors;
+      }
+    }
+    return static_cast<uint32_t>(nrFrames * recordsPerFrame);
+  });
+  printf("%-28s %10.2f ratio, %.1f samples/kB, %u decode errors\n", "",
+         static_cast<double>(records.size() * sizeof(ControllerCacheRecord)) / encodedSize,
+         records.size() * 1024.0 / encodedSize,
+         static_cast<unsigned>(nrErrors));
+}
+
+// Scan of all samples in the last N, as PluginStats did before keeping incremental statistics.
+struct PluginStatsScan {
+  bool usable(float value) const {
+    return !isnan(value) && !essentiallyEqual(errorValue, value);
+  }
+
+  bool compute(size_t lastNrSamples, PluginStats_samples::Summary& summary) const {
+    const size_t start = lastNrSamples < samples.size() ? samples.size() - lastNrSamples : 0;
+    double sum = 0.0;
+
+    summary = PluginStats_samples::Summary();
+
+    for (size_t i = start; i < samples.size(); ++i) {
+      if (usable(samples[i])) {
+        sum += samples[i];
+
+        if ((summary.count == 0) || (samples[i] < summary.min)) { summary.min = samples[i]; }
+
+        if ((summary.count == 0) || (samples[i] > summary.max)) { summary.max = samples[i]; }
+        ++summary.count;
+      }
+    }
+
+    if (summary.count == 0) { return false; }
+    summary.mean = sum / summary.count;
+
+    for (size_t i = start; i < samples.size(); ++i) {
+      if (usable(samples[i])) {
+        const double diff = samples[i] - summary.mean;
+        summary.m2 += diff * diff;
+      }
+    }
+    return true;
+  }
+
+  std::deque<float>samples;
+  float errorValue;
+};
+
+static bool nearlyEqual(double a, double b, double tolerance) {
+  return std::fabs(a - b) <= tolerance * (1.0 + std::fabs(a) + std::fabs(b));
+}
+
+static void benchmarkPluginStats() {
+  const float errorValue = -1.0f;
+  PluginStats_samples *stats = new PluginStats_samples(errorValue);
+  PluginStatsScan scan;
+
+  scan.errorValue = errorValue;
+
+  // Check the incremental statistics against a scan of the samples,
+  // for all window sizes, including error values, NaN and clearing the samples.
+  // Per block the mean and M2 are kept as float, so allow for float rounding.
+  uint32_t seed     = 1;
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  for (uint32_t n = 0; n < 20000; ++n) {
+    seed = seed * 1103515245u + 12345u;
+    const uint32_t r = (seed >> 8) % 1000;
+    float value      = 1013.0f + 0.01f * static_cast<float>(r % 200) + static_cast<float>(n % 500) / 50.0f;
+
+    if (r < 20) { value = errorValue; }
+    else if (r < 30) { value = NAN; }
+
+    if (n == 7777) {
+      stats->clear();
+      scan.samples.clear();
+    }
+    stats->push(value);
+    scan.samples.push_back(value);
+
+    if (scan.samples.size() > PLUGIN_STATS_NR_ELEMENTS) {
+      scan.samples.pop_front();
+    }
+
+    for (size_t lastNrSamples = 0; lastNrSamples <= PLUGIN_STATS_NR_ELEMENTS; lastNrSamples += 1 + (n % 7)) {
+      PluginStats_samples::Summary expected;
+      PluginStats_samples::Summary summary;
+      const bool expectedValid = scan.compute(lastNrSamples, expected);
+      const bool valid         = stats->getSummary(lastNrSamples, summary, true);
+
+      ++nrChecks;
+
+      if ((expectedValid != valid) ||
+          (valid &&
+           ((expected.count != summary.count) ||
+            (expected.min != summary.min) ||
+            (expected.max != summary.max) ||
+            !nearlyEqual(expected.mean, summary.mean, 1e-7) ||
+            !nearlyEqual(std::sqrt(expected.m2 / expected.count), std::sqrt(summary.m2 / summary.count), 1e-4)))) {
+        ++nrErrors;
+      }
+    }
+  }
+
+  PluginStats_samples::Summary summary;
+
+  runBenchmark("PluginStats all (scan)", 2000000, [&]() {
+    scan.compute(PLUGIN_STATS_NR_ELEMENTS, summary);
+    benchmarkSink = summary.mean + summary.max;
+    return 1u;
+  });
+  runBenchmark("PluginStats all", 20000000, [&]() {
+    stats->getSummary(PLUGIN_STATS_NR_ELEMENTS, summary, true);
+    benchmarkSink = summary.mean + summary.max;
+    return 1u;
+  });
+  runBenchmark("PluginStats last 100 (scan)", 2000000, [&]() {
+    scan.compute(100, summary);
+    benchmarkSink = summary.mean + summary.max;
+    return 1u;
+  });
+  runBenchmark("PluginStats last 100", 20000000, [&]() {
+    stats->getSummary(100, summary, true);
+    benchmarkSink = summary.mean + summary.max;
+    return 1u;
+  });
+  uint32_t sampleNr = 0;
+
+  runBenchmark("PluginStats push", 20000000, [&]() {
+    stats->push(static_cast<float>(++sampleNr % 100));
+    return 1u;
+  });
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+  delete stats;
+}
+
+static void benchmarkPluginStatsClass() {
+  const float errorValue = -1.0f;
+  PluginStats stats(2, errorValue);
+  const uint32_t nrValues = 50;
+  double sum = 0;
+
+  stats.setLabel(F("Temp"));
+
+  for (uint32_t i = 1; i <= nrValues; ++i) {
+    stats.push(static_cast<float>(i));
+    stats.trackPeak(static_cast<float>(i));
+    sum += i;
+  }
+  stats.push(errorValue);
+
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("PluginStats check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  check(stats.getNrSamples() == nrValues + 1, "nr samples");
+  check(nearlyEqual(stats.getSampleAvg(), sum / nrValues, 1e-6), "average");
+  check(nearlyEqual(stats.getSampleAvg(11), (nrValues + nrValues - 9) / 2.0, 1e-6), "average last 10 values");
+  check(nearlyEqual(stats.getSampleStdDev(), std::sqrt((nrValues * nrValues - 1) / 12.0), 1e-4), "std. dev");
+  check((stats.getSampleExtreme(nrValues + 1, false) == 1.0f) &&
+        (stats.getSampleExtreme(nrValues + 1, true) == nrValues), "extremes");
+  check((stats.getPeakLow() == 1.0f) && (stats.getPeakHigh() == nrValues), "peaks");
+  check((stats.getSample(-1) == 1.0f) && (stats.getSample(1) == errorValue), "first and last sample");
+  stats.clearSamples();
+  check((stats.getNrSamples() == 0) && (stats.getSampleAvg() == errorValue), "cleared");
+
+  uint32_t sampleNr = 0;
+
+  runBenchmark("PluginStats push+avg", 20000000, [&]() {
+    stats.push(static_cast<float>(++sampleNr % 100));
+    benchmarkSink = stats.getSampleAvg();
+    return 1u;
+  });
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+}
+
+static void benchmarkLog() {
+  // Check the deferred formatting against printf
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](const LogEntry_t& entry, const String& expected) {
+                 ++nrChecks;
+
+                 if (!entry.toString().equals(expected)) {
+                   printf("Log mismatch: \"%s\" expected: \"%s\"\n", entry.toString().c_str(), expected.c_str());
+                   ++nrErrors;
+                 }
+               };
+
+  {
+    LogEntry_t entry;
+    entry.setFormat(LOG_LEVEL_INFO, F("EVENT: %s Processing: %d ms"));
+    entry.addArg(String(F("Rules#Timer=1,2")));
+    entry.addArg(12ul);
+    check(entry, strformat(F("EVENT: %s Processing: %d ms"), "Rules#Timer=1,2", 12));
+  }
+  {
+    LogEntry_t entry;
+    entry.setFormat(LOG_LEVEL_INFO, F("MQTT C%03d : %s %s %%"));
+    entry.addArg(static_cast<uint8_t>(5));
+    entry.addArg("ESP_Easy/BME280/Temperature");
+    entry.addArg(F("21.25"));
+    check(entry, strformat(F("MQTT C%03d : %s %s %%"), 5, "ESP_Easy/BME280/Temperature", "21.25"));
+  }
+  {
+    LogEntry_t entry;
+    entry.setFormat(LOG_LEVEL_INFO, F("%5.2f|%-6s|%08X|%u|%d|%c|%.3e"));
+    entry.addArg(3.14159f);
+    entry.addArg("ab");
+    entry.addArg(0xBEEFu);
+    entry.addArg(UINT32_MAX);
+    entry.addArg(INT32_MIN);
+    entry.addArg('x');
+    entry.addArg(1234.5678);
+    check(entry, strformat(F("%5.2f|%-6s|%08X|%u|%d|%c|%.3e"), 3.14159f, "ab", 0xBEEFu, UINT32_MAX, INT32_MIN, 'x', 1234.5678));
+  }
+  {
+    LogEntry_t entry;
+    entry.setFormat(LOG_LEVEL_INFO, F("%lld %llu %llx"));
+    entry.addArg(INT64_MIN);
+    entry.addArg(UINT64_MAX);
+    entry.addArg(0x123456789abcull);
+    check(entry, strformat(F("%lld %llu %llx"), INT64_MIN, UINT64_MAX, 0x123456789abcull));
+  }
+  {
+    // Long string arguments are truncated to the size of the entry
+    LogEntry_t entry;
+    const String longString(std::string(200, 'a'));
+    entry.setFormat(LOG_LEVEL_INFO, F("%s%d"));
+    entry.addArg(longString);
+    entry.addArg(1);
+    check(entry, String(std::string(LOG_STRUCT_MESSAGE_SIZE - 1 - sizeof(PGM_P) - 2, 'a')));
+  }
+  {
+    // Referenced string arguments, as rendered for the serial log, are never truncated
+    LogEntry_t entry;
+    const String longString(std::string(300, 'a'));
+    entry.setFormat(LOG_LEVEL_INFO, F("%s|%-4s|%s|%d"), false);
+    entry.addArgs(longString, "ab", longString, 1);
+    check(entry, longString + F("|ab  |") + longString + F("|1"));
+
+    LogStruct log;
+    log.add(entry);
+    ++nrChecks;
+
+    if (!log.isEmpty()) {
+      printf("Log check failed: entry with string references stored\n");
+      ++nrErrors;
+    }
+  }
+
+  // Adding log lines when only the web log is active
+  LogStruct textLog;
+  LogStruct deferredLog;
+  const String events[] = { F("Rules#Timer=1"), F("Clock#Time=Mon,12:30"), F("BME280#Temperature=21.25") };
+  uint32_t n = 0;
+
+  runBenchmark("Log add strformat", 2000000, [&]() {
+    const String& event = events[++n % NR_ELEMENTS(events)];
+    textLog.add(LOG_LEVEL_INFO, strformat(F("EVENT: %s Processing: %d ms"), event.c_str(), n % 20));
+    return 1u;
+  });
+  runBenchmark("Log add deferred", 2000000, [&]() {
+    const String& event = events[++n % NR_ELEMENTS(events)];
+    LogEntry_t entry;
+    entry.setFormat(LOG_LEVEL_INFO, F("EVENT: %s Processing: %d ms"));
+    entry.addArg(event);
+    entry.addArg(n % 20);
+    deferredLog.add(entry);
+    return 1u;
+  });
+
+  bool logLinesAvailable = false;
+  unsigned long timestamp{};
+  String message;
+  uint8_t loglevel{};
+
+  runBenchmark("Log read deferred", 2000000, [&]() {
+    uint32_t nrRead = 0;
+
+    for (int i = 0; i < 10; ++i) {
+      const String& event = events[++n % NR_ELEMENTS(events)];
+      LogEntry_t entry;
+      entry.setFormat(LOG_LEVEL_INFO, F("EVENT: %s Processing: %d ms"));
+      entry.addArg(event);
+      entry.addArg(n % 20);
+      deferredLog.add(entry);
+    }
+
+    while (deferredLog.getNext(logLinesAvailable, timestamp, message, loglevel)) {
+      benchmarkSink = message.length();
+      ++nrRead;
+    }
+    return nrRead;
+  });
+  printf("%-28s %10u entries in %u bytes (text), %u (deferred)\n", "",
+         static_cast<unsigned>(textLog.getEstimatedCapacity()),
+         static_cast<unsigned>(LOG_STRUCT_BUFFER_SIZE),
+         static_cast<unsigned>(deferredLog.getEstimatedCapacity()));
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+}
+
+static void benchmarkSyslog() {
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("Syslog check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  std::string datagram;
+  auto writer = [&](const char *data, size_t length) {
+                  datagram.append(data, length);
+                };
+
+  {
+    SyslogQueue queue;
+    queue.setHeader(F("esp-easy-1_EspEasy:"));
+    queue.add(13,  F("first"));
+    queue.add(131, F("second"));
+    queue.add(7,   F("third"));
+
+    datagram.clear();
+    check(queue.nextDatagram(false, SYSLOG_MAX_DATAGRAM_SIZE, writer) == 1, "single line");
+    check(datagram == "<13>esp-easy-1_EspEasy:first", "single line format");
+
+    datagram.clear();
+    check(queue.nextDatagram(true, SYSLOG_MAX_DATAGRAM_SIZE, writer) == 2, "combined lines");
+    check(datagram == "<131>esp-easy-1_EspEasy:second\n<7>esp-easy-1_EspEasy:third", "combined lines format");
+    check(queue.isEmpty() && (queue.getUsage() == 0), "empty after send");
+  }
+  {
+    // Fill the queue, new lines are dropped and the order of the queued lines is kept.
+    SyslogQueue queue;
+    uint32_t    nrQueued = 0;
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+      if (queue.add(13, strformat(F("%u"), i))) {
+        ++nrQueued;
+      }
+    }
+    check(queue.getStats().dropped == (1000 - nrQueued), "drop counter");
+
+    uint32_t expected = 0;
+    bool     inOrder  = true;
+
+    while (!queue.isEmpty()) {
+      datagram.clear();
+      queue.nextDatagram(false, SYSLOG_MAX_DATAGRAM_SIZE, writer);
+      inOrder &= (datagram == strformat(F("<13>%u"), expected).c_str());
+      ++expected;
+    }
+    check(inOrder && (expected == nrQueued), "order after overflow");
+  }
+  {
+    // Wrap around with lines of different length
+    SyslogQueue queue;
+    uint32_t    nrAdded = 0;
+    uint32_t    nrRead  = 0;
+    bool        inOrder = true;
+
+    for (uint32_t i = 0; i < 20000; ++i) {
+      const String line = strformat(F("%u %s"), nrAdded, std::string(i % 200, 'x').c_str());
+
+      if (queue.add(13, line)) {
+        ++nrAdded;
+      }
+
+      if ((i % 3) != 0) {
+        datagram.clear();
+
+        if (queue.nextDatagram(false, SYSLOG_MAX_DATAGRAM_SIZE, writer) == 1) {
+          inOrder &= (strtoul(datagram.c_str() + 4, nullptr, 10) == nrRead);
+          ++nrRead;
+        }
+      }
+    }
+    check(inOrder, "order after wrap around");
+  }
+  {
+    SyslogQueue queue;
+    uint32_t    nrAllowed = 0;
+
+    for (int i = 0; i < 100; ++i) {
+      if (queue.allowDatagram()) {
+        ++nrAllowed;
+      }
+    }
+    check(nrAllowed == SYSLOG_MAX_DATAGRAMS_PER_SEC, "rate limit burst");
+  }
+
+  const String message = F("EVENT: BME280#Temperature=21.25 Processing: 2 ms");
+
+  for (const bool combineLines : { false, true }) {
+    SyslogQueue queue;
+    queue.setHeader(F("esp-easy-1_EspEasy:"));
+
+    runBenchmark(combineLines ? "Syslog add+send combined" : "Syslog add+send", 2000000, [&]() {
+      for (int i = 0; i < 10; ++i) {
+        queue.add(13, message);
+      }
+
+      while (!queue.isEmpty()) {
+        datagram.clear();
+        queue.nextDatagram(combineLines, SYSLOG_MAX_DATAGRAM_SIZE, writer);
+        benchmarkSink = datagram.size();
+      }
+      return 10u;
+    });
+  }
+
+  // Send the datagrams to a local UDP listener and check the order of the received lines.
+  const int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+  const int sender   = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in address{};
+
+  address.sin_family      = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port        = 0;
+  socklen_t addressLength = sizeof(address);
+
+  if ((receiver < 0) || (sender < 0) ||
+      (bind(receiver, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) ||
+      (getsockname(receiver, reinterpret_cast<sockaddr *>(&address), &addressLength) != 0)) {
+    printf("Syslog UDP listener not available\n");
+  } else {
+    timeval timeout{};
+    timeout.tv_sec = 1;
+    setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    for (const bool combineLines : { false, true }) {
+      SyslogQueue queue;
+      queue.setHeader(F("esp-easy-1_EspEasy:"));
+
+      constexpr uint32_t nrLines   = 100000;
+      uint32_t nrAdded             = 0;
+      uint32_t nrReceived          = 0;
+      uint32_t nrDatagrams         = 0;
+      bool     inOrder             = true;
+      char     buffer[SYSLOG_MAX_DATAGRAM_SIZE + SYSLOG_MAX_MESSAGE_LENGTH + 64];
+      const auto start             = std::chrono::steady_clock::now();
+
+      while (nrReceived < nrLines) {
+        while ((nrAdded < nrLines) && queue.add(13, strformat(F("seq=%u %s"), nrAdded, message.c_str()))) {
+          ++nrAdded;
+        }
+
+        // Send in bursts, so the socket buffer of the listener does not overflow
+        uint32_t nrSent = 0;
+
+        while (!queue.isEmpty() && (nrSent < 32)) {
+          datagram.clear();
+          queue.nextDatagram(combineLines, SYSLOG_MAX_DATAGRAM_SIZE, writer);
+          sendto(sender, datagram.data(), datagram.size(), 0, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+          ++nrSent;
+        }
+
+        for (; nrSent > 0; --nrSent) {
+          const ssize_t received = recv(receiver, buffer, sizeof(buffer) - 1, 0);
+
+          if (received <= 0) {
+            break;
+          }
+          buffer[received] = 0;
+          ++nrDatagrams;
+
+          for (const char *line = buffer; line != nullptr;) {
+            const char *seq = strstr(line, "seq=");
+
+            inOrder &= (seq != nullptr) && (strtoul(seq + 4, nullptr, 10) == nrReceived);
+            ++nrReceived;
+            line = strchr(line, '\n');
+
+            if (line != nullptr) { ++line; }
+          }
+        }
+
+        if (nrSent != 0) {
+          // Lost datagram or timeout
+          break;
+        }
+      }
+      const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      printf("%-28s %10.0f lines/s %8.2f lines/datagram\n",
+             combineLines ? "Syslog UDP combined" : "Syslog UDP",
+             nrReceived / sec,
+             nrDatagrams == 0 ? 0.0 : static_cast<double>(nrReceived) / nrDatagrams);
+      check(inOrder && (nrReceived == nrLines), "UDP listener order");
+    }
+  }
+
+  if (receiver >= 0) { close(receiver); }
+
+  if (sender >= 0) { close(sender); }
+
+  printf("%-28s %10u checks, %u mismatches\n", "",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+}
+
+static void benchmarkC013Batch() {
+  uint32_t nrChecks = 0;
+  uint32_t nrErrors = 0;
+
+  auto check = [&](bool ok, const char *what) {
+                 ++nrChecks;
+
+                 if (!ok) {
+                   printf("C013 batch check failed: %s\n", what);
+                   ++nrErrors;
+                 }
+               };
+
+  struct Input {
+    uint8_t  sourceTaskIndex;
+    uint8_t  destTaskIndex;
+    uint8_t  deviceNumber;
+    uint8_t  sensorType;
+    uint32_t timestamp_sec;
+    uint16_t timestamp_frac;
+    float    values[VARS_PER_TASK];
+  };
+
+  const Input inputs[] = {
+    { 0, 2,  33, 3, 1700000000, 0x8000, { 21.5f, 55.0f, 1013.25f, 0.0f } },
+    { 1, 1,  5,  2, 1700000000, 0x9000, { -3.25f, 80.0f, 0.0f, 0.0f } },
+    { 4, 7,  1,  1, 1700000001, 0x0100, { 1.0f, 0.0f, 0.0f, 0.0f } },
+    { 9, 31, 49, 4, 1700000042, 0xFFFF, { 1e6f, -1e-6f, 3.0f, 4.0f } }
+  };
+  const size_t nrInputs = sizeof(inputs) / sizeof(inputs[0]);
+
+  C013_SensorDataBatch batch;
+  std::vector<C013_SensorDataBatch::Sample> decoded;
+  auto collect = [&](const C013_SensorDataBatch::Sample& sample) {
+                   decoded.push_back(sample);
+                 };
+
+  {
+    // Round trip
+    check(batch.begin(12, 255, 20871), "begin");
+
+    for (size_t i = 0; i < nrInputs; ++i) {
+      const Input& in = inputs[i];
+      check(batch.add(in.sourceTaskIndex, in.destTaskIndex, in.deviceNumber, in.sensorType,
+                      reinterpret_cast<const uint8_t *>(in.values), in.timestamp_sec, in.timestamp_frac), "add");
+    }
+    size_t size{};
+    const uint8_t *frame = batch.finish(size);
+    check(size == sizeof(C013_SensorDataBatchHeader) + nrInputs * sizeof(C013_SensorDataBatchSample), "frame size");
+
+    decoded.clear();
+    check(C013_SensorDataBatch::decode(frame, size, collect), "decode");
+    check(decoded.size() == nrInputs, "nr decoded samples");
+
+    bool fieldsMatch = decoded.size() == nrInputs;
+    bool timeMatch   = fieldsMatch;
+
+    for (size_t i = 0; fieldsMatch && i < nrInputs; ++i) {
+      const Input& in                         = inputs[i];
+      const C013_SensorDataBatch::Sample& out = decoded[i];
+      fieldsMatch &= out.sourceUnit == 12 && out.destUnit == 255 && out.sourceNodeBuild == 20871 &&
+                     out.sourceTaskIndex == in.sourceTaskIndex && out.destTaskIndex == in.destTaskIndex &&
+                     out.deviceNumber == in.deviceNumber && out.sensorType == in.sensorType &&
+                     memcmp(out.taskValues_Data, in.values, sizeof(in.values)) == 0;
+
+      // Delta timestamps have a resolution of 1 msec
+      const int64_t expected = (static_cast<int64_t>(in.timestamp_sec) << 16) | in.timestamp_frac;
+      const int64_t actual   = (static_cast<int64_t>(out.timestamp_sec) << 16) | out.timestamp_frac;
+      timeMatch &= std::llabs(expected - actual) <= 33;
+    }
+    check(fieldsMatch, "decoded fields");
+    check(timeMatch,   "decoded timestamps");
+  }
+  {
+    // Without system time all timestamps are 0
+    batch.begin(12, 255, 20871);
+    batch.add(0, 0, 1, 1, nullptr, 0, 0);
+    batch.add(1, 1, 1, 1, nullptr, 0, 0x1234);
+    check(!batch.add(2, 2, 1, 1, nullptr, 1700000000, 0), "time set after first sample");
+    size_t size{};
+    const uint8_t *frame = batch.finish(size);
+    decoded.clear();
+    check(C013_SensorDataBatch::decode(frame, size, collect) && (decoded.size() == 2) &&
+          (decoded[0].timestamp_sec == 0) && (decoded[1].timestamp_sec == 0) && (decoded[1].timestamp_frac == 0),
+          "no system time");
+  }
+  {
+    // Delta must fit in 16 bit msec and time may not go back
+    batch.begin(12, 255, 20871);
+    check(batch.add(0, 0, 1, 1, nullptr, 1700000000, 0),  "first sample");
+    check(!batch.add(1, 1, 1, 1, nullptr, 1699999999, 0), "time went back");
+    check(batch.add(1, 1, 1, 1, nullptr, 1700000065, 0),  "65 sec delta");
+    check(!batch.add(1, 1, 1, 1, nullptr, 1700000066, 0), "66 sec delta");
+  }
+  {
+    // Capacity
+    batch.begin(12, 255, 20871);
+    size_t nrAdded = 0;
+
+    while (batch.add(nrAdded % 32, nrAdded % 32, 1, 1, nullptr, 1700000000, 0)) {
+      ++nrAdded;
+    }
+    size_t size{};
+    batch.finish(size);
+    check(nrAdded == (C013_BATCH_MAX_SIZE - sizeof(C013_SensorDataBatchHeader)) / sizeof(C013_SensorDataBatchSample), "samples per frame");
+    check((size <= C013_BATCH_MAX_SIZE) && (size < UDP_PACKETSIZE_MAX), "frame fits receive buffer");
+    check(batch.nrSamples() == nrAdded, "sample counter");
+    batch.clear();
+    check(batch.isEmpty(), "clear");
+  }
+  {
+    // Rejected frames
+    batch.begin(12, 255, 20871);
+
+    for (size_t i = 0; i < nrInputs; ++i) {
+      batch.add(i, i, 1, 1, reinterpret_cast<const uint8_t *>(inputs[i].values), inputs[i].timestamp_sec, 0);
+    }
+    size_t size{};
+    const uint8_t *frame = batch.finish(size);
+    std::vector<uint8_t> copy(frame, frame + size);
+    auto ignore = [](const C013_SensorDataBatch::Sample&) {};
+
+    check(!C013_SensorDataBatch::decode(&copy[0], size - 1, ignore), "truncated frame");
+    copy[sizeof(C013_SensorDataBatchHeader) + 8] ^= 0x01;
+    check(!C013_SensorDataBatch::decode(&copy[0], size, ignore), "corrupted value");
+    copy.assign(frame, frame + size);
+    copy[offsetof(C013_SensorDataBatchHeader, version)] = C013_BATCH_VERSION + 1;
+    check(!C013_SensorDataBatch::decode(&copy[0], size, ignore), "unknown version");
+    copy.assign(frame, frame + size);
+    copy[1] = 5;
+    check(!C013_SensorDataBatch::decode(&copy[0], size, ignore), "single sample message");
+  }
+  {
+    // Samples with members appended by a later version are decoded by their known part.
+    const size_t extra      = 3;
+    const size_t sampleSize = sizeof(C013_SensorDataBatchSample) + extra;
+    C013_SensorDataBatchHeader header;
+    header.sampleSize    = sampleSize;
+    header.nrSamples     = 2;
+    header.timestamp_sec = 1700000000;
+
+    std::vector<uint8_t> frame(sizeof(header) + 2 * sampleSize, 0xAA);
+
+    for (uint8_t i = 0; i < 2; ++i) {
+      C013_SensorDataBatchSample sample;
+      sample.sourceTaskIndex = i;
+      sample.destTaskIndex   = i + 1;
+      sample.timestamp_delta = 1000 * i;
+      memcpy(&frame[sizeof(header) + i * sampleSize], &sample, sizeof(sample));
+    }
+    memcpy(&frame[0], &header, sizeof(header));
+    const size_t checksumPos = offsetof(C013_SensorDataBatchHeader, checksum);
+    uint32_t     crc         = calc_CRC32(&frame[0], checksumPos);
+    crc = calc_CRC32(&frame[checksumPos + 4], frame.size() - checksumPos - 4, crc);
+    memcpy(&frame[checksumPos], &crc, sizeof(crc));
+
+    decoded.clear();
+    check(C013_SensorDataBatch::decode(&frame[0], frame.size(), collect) && (decoded.size() == 2) &&
+          (decoded[1].sourceTaskIndex == 1) && (decoded[1].destTaskIndex == 2) &&
+          (decoded[1].timestamp_sec == 1700000001) && (decoded[1].timestamp_frac == 0),
+          "larger sample size");
+  }
+  printf("%-28s %10u checks, %u mismatches\n", "C013 batch",
+         static_cast<unsigned>(nrChecks), static_cast<unsigned>(nrErrors));
+
+  // Throughput: full frames, 4 values per sample, sampled 10 msec apart
+  const float values[VARS_PER_TASK] = { 21.5f, 55.0f, 1013.25f, 0.0f };
+  size_t   frameSize{};
+  uint32_t samplesPerFrame{};
+
+  runBenchmark("C013 batch encode", 200000, [&]() {
+    batch.begin(12, 255, 20871);
+    uint32_t n = 0;
+
+    while (batch.add(n % 32, n % 32, 33, 3, reinterpret_cast<const uint8_t *>(values), 1700000000 + n / 100, (n % 100) * 655)) {
+      ++n;
+    }
+    batch.finish(frameSize);
+    samplesPerFrame = n;
+    return n;
+  });
+
+  const uint8_t *frame = batch.finish(frameSize);
+  uint32_t sum         = 0;
+
+  runBenchmark("C013 batch decode", 200000, [&]() {
+    uint32_t n = 0;
+    C013_SensorDataBatch::decode(frame, frameSize, [&](const C013_SensorDataBatch::Sample& sample) {
+      sum += sample.destTaskIndex + sample.timestamp_frac;
+      ++n;
+    });
+    return n;
+  });
+  benchmarkSink = sum;
+  printf("%-28s %10u samples/frame, %.1f bytes/sample\n", "",
+         static_cast<unsigned>(samplesPerFrame),
+         static_cast<double>(frameSize) / samplesPerFrame);
+}
+
+int main(int argc, char *argv[]) {
+  const std::string dataDir = argc > 1 ? argv[1] : NATIVE_BENCHMARK_DATA_DIR;
+  std::vector<String> lines;
+
+  for (const char *fname : { "rules1.txt", "rules2.txt" }) {
+    if (!readLines(dataDir + "/" + fname, lines)) {
+      printf("Cannot read %s/%s\n", dataDir.c_str(), fname);
+    }
+  }
+
+  BenchmarkData data;
+
+  parseRules(lines, data);
+  printf("%u rules, %u events, %u expressions\n\n",
+         static_cast<unsigned>(data.rules.size()),
+         static_cast<unsigned>(data.events.size()),
+         static_cast<unsigned>(data.expressions.size()));
+
+  benchmarkRulesMatcher(data);
+  benchmarkCalculate(data);
+  benchmarkRulesProgram(lines);
+  benchmarkRulesEngine(dataDir, data);
+  benchmarkUserVar();
+  benchmarkParseTemplate();
+  benchmarkEventQueue(data);
+  benchmarkTimers();
+  benchmarkControllerQueue();
+  benchmarkControllerDelayHandler();
+  benchmarkControllerCacheIndex();
+  benchmarkControllerCacheCodec();
+  benchmarkPluginStats();
+  benchmarkPluginStatsClass();
+  benchmarkLog();
+  benchmarkSyslog();
+  benchmarkC013Batch();
+  return 0;
+}
@@ -0,0 +1,400 @@
+#ifndef NATIVE_BENCHMARK_ARDUINO_H
+#define NATIVE_BENCHMARK_ARDUINO_H
+
+/*********************************************************************************************\
+* Minimal host replacement of the Arduino core, as far as used by the sources
+* which are built in the native_benchmark environment.
+* String follows the Arduino API, but is implemented using std::string.
+\*********************************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+class __FlashStringHelper;
+
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define PROGMEM
+#define IRAM_ATTR
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define snprintf_P snprintf
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strncpy_P strncpy
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+
+// A function like in the ESP cores, not a macro for sprintf.
+// The firmware sizes its buffers for the actual value ranges,
+// which the compiler cannot check for the worst case of the format.
+inline int sprintf_P(char *str, const char *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  const int res = vsprintf(str, format, args);
+  va_end(args);
+  return res;
+}
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+using std::isinf;
+using std::isnan;
+
+#ifndef PI
+# define PI 3.1415926535897932384626433832795
+#endif // ifndef PI
+
+inline double degrees(double rad) {
+  return rad * 180.0 / PI;
+}
+
+inline double radians(double deg) {
+  return deg * PI / 180.0;
+}
+
+inline bool isDigit(char c) {
+  return isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+inline bool isAlpha(char c) {
+  return isalpha(static_cast<unsigned char>(c)) != 0;
+}
+
+inline bool isAlphaNumeric(char c) {
+  return isalnum(static_cast<unsigned char>(c)) != 0;
+}
+
+inline bool isSpace(char c) {
+  return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define _min(a, b) ((a) < (b) ? (a) : (b))
+#define _max(a, b) ((a) > (b) ? (a) : (b))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+typedef bool boolean;
+
+// Arduino avr-libc helper: format a double with a minimal width and fixed decimals
+inline char* dtostrf(double value, signed char width, unsigned char prec, char *buf) {
+  sprintf(buf, "%*.*f", width, prec, value);
+  return buf;
+}
+
+inline uint16_t makeWord(uint8_t h, uint8_t l) {
+  return (static_cast<uint16_t>(h) << 8) | l;
+}
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          yield();
+
+class String {
+public:
+
+  String() = default;
+  String(const char *cstr) : _s(cstr == nullptr ? "" : cstr) {}
+
+  String(const __FlashStringHelper *str) : String(reinterpret_cast<const char *>(str)) {}
+
+  String(const std::string& str) : _s(str) {}
+
+  explicit String(char c) : _s(1, c) {}
+
+  explicit String(int value, unsigned char base = 10) : _s(toBase(static_cast<long long>(value), base)) {}
+
+  explicit String(unsigned int value, unsigned char base = 10) : _s(toBase(static_cast<long long>(value), base)) {}
+
+  explicit String(long value, unsigned char base = 10) : _s(toBase(static_cast<long long>(value), base)) {}
+
+  explicit String(unsigned long value, unsigned char base = 10) : _s(toBase(static_cast<long long>(value), base)) {}
+
+  explicit String(long long value, unsigned char base = 10) : _s(toBase(value, base)) {}
+
+  explicit String(unsigned long long value, unsigned char base = 10) : _s(toBase(static_cast<long long>(value), base)) {}
+
+  explicit String(float value, unsigned char decimalPlaces = 2) : String(static_cast<double>(value), decimalPlaces) {}
+
+  explicit String(double value, unsigned char decimalPlaces = 2) {
+    char buf[64];
+
+    snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+    _s = buf;
+  }
+
+  const char* c_str() const {
+    return _s.c_str();
+  }
+
+  unsigned int length() const {
+    return static_cast<unsigned int>(_s.length());
+  }
+
+  bool isEmpty() const {
+    return _s.empty();
+  }
+
+  void clear() {
+    _s.clear();
+  }
+
+  bool reserve(unsigned int size) {
+    _s.reserve(size);
+    return true;
+  }
+
+  void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+    if ((bufsize == 0) || (buf == nullptr)) { return; }
+    const size_t len = index < _s.length() ? std::min<size_t>(bufsize - 1, _s.length() - index) : 0;
+
+    memcpy(buf, _s.data() + std::min<size_t>(index, _s.length()), len);
+    buf[len] = 0;
+  }
+
+  char charAt(unsigned int index) const {
+    return index < _s.length() ? _s[index] : 0;
+  }
+
+  void setCharAt(unsigned int index, char c) {
+    if (index < _s.length()) { _s[index] = c; }
+  }
+
+  char operator[](unsigned int index) const {
+    return charAt(index);
+  }
+
+  char& operator[](unsigned int index) {
+    return _s[index];
+  }
+
+  String& operator=(const char *cstr) {
+    _s = cstr == nullptr ? "" : cstr;
+    return *this;
+  }
+
+  String& operator=(const __FlashStringHelper *str) {
+    return *this = reinterpret_cast<const char *>(str);
+  }
+
+  String& operator=(char c) {
+    _s.assign(1, c);
+    return *this;
+  }
+
+  bool concat(const String& str) {
+    _s += str._s;
+    return true;
+  }
+
+  bool concat(const char *cstr) {
+    if (cstr != nullptr) { _s += cstr; }
+    return true;
+  }
+
+  bool concat(const char *cstr, unsigned int length) {
+    if (cstr != nullptr) { _s.append(cstr, length); }
+    return true;
+  }
+
+  bool concat(const __FlashStringHelper *str) {
+    return concat(reinterpret_cast<const char *>(str));
+  }
+
+  bool concat(char c) {
+    _s += c;
+    return true;
+  }
+
+  template<typename T>
+  bool concat(T value) {
+    return concat(String(value));
+  }
+
+  template<typename T>
+  String& operator+=(const T& rhs) {
+    concat(rhs);
+    return *this;
+  }
+
+  bool equals(const String& str) const {
+    return _s == str._s;
+  }
+
+  bool equals(const char *cstr) const {
+    return cstr != nullptr && _s == cstr;
+  }
+
+  bool equalsIgnoreCase(const String& str) const {
+    return (_s.length() == str._s.length()) &&
+           (strncasecmp(_s.c_str(), str._s.c_str(), _s.length()) == 0);
+  }
+
+  bool startsWith(const String& prefix, unsigned int offset = 0) const {
+    return (offset + prefix._s.length() <= _s.length()) &&
+           (_s.compare(offset, prefix._s.length(), prefix._s) == 0);
+  }
+
+  bool endsWith(const String& suffix) const {
+    return (suffix._s.length() <= _s.length()) &&
+           (_s.compare(_s.length() - suffix._s.length(), suffix._s.length(), suffix._s) == 0);
+  }
+
+  int indexOf(char c, unsigned int fromIndex = 0) const {
+    return toIndex(_s.find(c, fromIndex));
+  }
+
+  int indexOf(const String& str, unsigned int fromIndex = 0) const {
+    return toIndex(_s.find(str._s, fromIndex));
+  }
+
+  int lastIndexOf(char c) const {
+    return toIndex(_s.rfind(c));
+  }
+
+  int lastIndexOf(const String& str) const {
+    return toIndex(_s.rfind(str._s));
+  }
+
+  String substring(unsigned int beginIndex) const {
+    return beginIndex < _s.length() ? String(_s.substr(beginIndex)) : String();
+  }
+
+  String substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) { std::swap(beginIndex, endIndex); }
+
+    if (beginIndex >= _s.length()) { return String(); }
+    return String(_s.substr(beginIndex, endIndex - beginIndex));
+  }
+
+  void replace(char find, char replace) {
+    std::replace(_s.begin(), _s.end(), find, replace);
+  }
+
+  void replace(const String& find, const String& replace) {
+    if (find._s.empty()) { return; }
+    size_t pos = 0;
+
+    while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+      _s.replace(pos, find._s.length(), replace._s);
+      pos += replace._s.length();
+    }
+  }
+
+  void remove(unsigned int index) {
+    if (index < _s.length()) { _s.erase(index); }
+  }
+
+  void remove(unsigned int index, unsigned int count) {
+    if (index < _s.length()) { _s.erase(index, count); }
+  }
+
+  void toLowerCase() {
+    for (char& c : _s) { c = static_cast<char>(tolower(static_cast<unsigned char>(c))); }
+  }
+
+  void toUpperCase() {
+    for (char& c : _s) { c = static_cast<char>(toupper(static_cast<unsigned char>(c))); }
+  }
+
+  void trim() {
+    const size_t first = _s.find_first_not_of(" \t\r\n");
+
+    if (first == std::string::npos) {
+      _s.clear();
+      return;
+    }
+    _s = _s.substr(first, _s.find_last_not_of(" \t\r\n") - first + 1);
+  }
+
+  long toInt() const {
+    return strtol(_s.c_str(), nullptr, 10);
+  }
+
+  float toFloat() const {
+    return strtof(_s.c_str(), nullptr);
+  }
+
+  double toDouble() const {
+    return strtod(_s.c_str(), nullptr);
+  }
+
+  friend bool operator==(const String& lhs, const String& rhs) {
+    return lhs._s == rhs._s;
+  }
+
+  friend bool operator!=(const String& lhs, const String& rhs) {
+    return lhs._s != rhs._s;
+  }
+
+  friend bool operator<(const String& lhs, const String& rhs) {
+    return lhs._s < rhs._s;
+  }
+
+  template<typename T>
+  friend String operator+(const String& lhs, const T& rhs) {
+    String res(lhs);
+
+    res.concat(rhs);
+    return res;
+  }
+
+private:
+
+  static int toIndex(size_t pos) {
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+  }
+
+  static std::string toBase(long long value, unsigned char base) {
+    if (base == 10) { return std::to_string(value); }
+    std::string res;
+    unsigned long long v = static_cast<unsigned long long>(value);
+
+    do {
+      const int digit = static_cast<int>(v % base);
+      res.insert(res.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10));
+      v /= base;
+    } while (v != 0);
+    return res;
+  }
+
+  std::string _s;
+};
+
+inline String operator+(char lhs, const String& rhs) {
+  String res(lhs);
+
+  res.concat(rhs);
+  return res;
+}
+
+inline String operator+(const char *lhs, const String& rhs) {
+  String res(lhs);
+
+  res.concat(rhs);
+  return res;
+}
+
+extern const String emptyString;
+
+#endif // ifndef NATIVE_BENCHMARK_ARDUINO_H
@@ -0,0 +1,173 @@
+#ifndef NATIVE_BENCHMARK_FS_H
+#define NATIVE_BENCHMARK_FS_H
+
+/*********************************************************************************************\
+* Minimal host replacement of the Arduino file system API.
+* FS keeps all files in memory. A File refers to the contents of a file,
+* which is shared between all File objects opened on the same file,
+* so it can be written and read back via another File object.
+\*********************************************************************************************/
+
+#include <Arduino.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace fs {
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File {
+public:
+
+  typedef std::shared_ptr<std::vector<uint8_t> > Data_ptr;
+
+  // Not opened, like the Arduino File
+  File() = default;
+
+  File(Data_ptr data, const String& name) : _data(std::move(data)), _name(name) {}
+
+  size_t write(const uint8_t *buf, size_t size) {
+    if (!_data) { return 0; }
+
+    if ((_pos + size) > _data->size()) {
+      _data->resize(_pos + size);
+    }
+    memcpy(_data->data() + _pos, buf, size);
+    _pos += size;
+    return size;
+  }
+
+  size_t write(uint8_t c) {
+    return write(&c, 1);
+  }
+
+  size_t read(uint8_t *buf, size_t size) {
+    size = std::min<size_t>(size, available());
+
+    if (size != 0) {
+      memcpy(buf, _data->data() + _pos, size);
+      _pos += size;
+    }
+    return size;
+  }
+
+  int read() {
+    uint8_t c;
+
+    return read(&c, 1) == 1 ? c : -1;
+  }
+
+  int peek() const {
+    return available() > 0 ? (*_data)[_pos] : -1;
+  }
+
+  int available() const {
+    return (_data && (_pos < _data->size())) ? static_cast<int>(_data->size() - _pos) : 0;
+  }
+
+  bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+    if (!_data) { return false; }
+
+    if (mode == SeekCur) {
+      pos += _pos;
+    } else if (mode == SeekEnd) {
+      pos += _data->size();
+    }
+
+    if (pos > _data->size()) {
+      return false;
+    }
+    _pos = pos;
+    return true;
+  }
+
+  size_t position() const {
+    return _pos;
+  }
+
+  size_t size() const {
+    return _data ? _data->size() : 0;
+  }
+
+  const char* name() const {
+    return _name.c_str();
+  }
+
+  void flush() {}
+
+  void close() {
+    _data.reset();
+    _pos = 0;
+  }
+
+  explicit operator bool() const {
+    return _data != nullptr;
+  }
+
+private:
+
+  Data_ptr _data;
+  String   _name;
+  size_t   _pos = 0;
+};
+
+class FS {
+public:
+
+  // Modes "r", "w" and "a", "r+", "w+" and "a+" are handled like "r", "w" and "a"
+  File open(const String& path, const char *mode = "r") {
+    auto it = _files.find(path);
+
+    if ((mode == nullptr) || (mode[0] == 'r')) {
+      return it == _files.end() ? File() : File(it->second, path);
+    }
+
+    if ((it == _files.end()) || (mode[0] == 'w')) {
+      _files[path] = std::make_shared<std::vector<uint8_t> >();
+      it           = _files.find(path);
+    }
+    File f(it->second, path);
+
+    if (mode[0] == 'a') {
+      f.seek(0, SeekEnd);
+    }
+    return f;
+  }
+
+  bool exists(const String& path) const {
+    return _files.find(path) != _files.end();
+  }
+
+  // Files still opened keep their contents, as on LittleFS
+  bool remove(const String& path) {
+    return _files.erase(path) != 0;
+  }
+
+  bool rename(const String& pathFrom, const String& pathTo) {
+    auto it = _files.find(pathFrom);
+
+    if ((it == _files.end()) || exists(pathTo)) { return false; }
+    _files[pathTo] = it->second;
+    _files.erase(it);
+    return true;
+  }
+
+  void format() {
+    _files.clear();
+  }
+
+private:
+
+  std::map<String, File::Data_ptr> _files;
+};
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // ifndef NATIVE_BENCHMARK_FS_H
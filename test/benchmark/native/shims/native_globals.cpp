@@ -0,0 +1,508 @@
+#include <native_shims.h>
+
+#include "src/_Plugin_Helper.h"
+
+#include "src/src/Commands/ExecuteCommand.h"
+#include "src/src/Commands/GPIO.h"
+#include "src/src/DataStructs/ControllerSettingsStruct.h"
+#include "src/src/ESPEasyCore/ESPEasy_backgroundtasks.h"
+#include "src/src/Globals/CPlugins.h"
+#include "src/src/Globals/Cache.h"
+#include "src/src/Globals/Device.h"
+#include "src/src/Globals/ESPEasy_Scheduler.h"
+#include "src/src/Globals/ESPEasy_time.h"
+#include "src/src/Globals/ExtraTaskSettings.h"
+#include "src/src/Globals/RulesCalculate.h"
+#include "src/src/Globals/RuntimeData.h"
+#include "src/src/Globals/TimeZone.h"
+#include "src/src/Helpers/ESPEasy_Storage.h"
+#include "src/src/Helpers/ESPEasy_time_calc.h"
+#include "src/src/Helpers/FS_Helper.h"
+#include "src/src/Helpers/Memory.h"
+#include "src/src/Helpers/Misc.h"
+#include "src/src/Helpers/Networking.h"
+#include "src/src/Helpers/Numerical.h"
+#include "src/src/Helpers/StringConverter.h"
+#include "src/src/Helpers/_CPlugin_init.h"
+#include "src/src/WebServer/HTML_wrappers.h"
+#include "src/src/WebServer/Markup.h"
+#include "src/src/WebServer/Markup_Forms.h"
+
+// Host definitions of the globals and functions declared in the shims tree.
+// Where the firmware implementation does not depend on hardware, it is copied.
+
+
+Caches Cache;
+ExtraTaskSettingsStruct  ExtraTaskSettings;
+ControllerSettingsStruct storedControllerSettings[CONTROLLER_MAX];
+ESPEasy_Scheduler  Scheduler;
+ESPEasy_time       node_time;
+ESPEasy_time_zone  time_zone;
+fs::FS             LittleFS;
+std::vector<String> executedCommands;
+
+
+/*********************************************************************************************\
+* Cache
+\*********************************************************************************************/
+void clearAllCaches() {
+  Cache.clearAllCaches();
+}
+
+void clearAllButTaskCaches() {
+  Cache.clearAllButTaskCaches();
+}
+
+void clearTaskCache(taskIndex_t TaskIndex) {
+  Cache.clearTaskCache(TaskIndex);
+}
+
+void clearFileCaches() {
+  Cache.clearFileCaches();
+}
+
+
+/*********************************************************************************************\
+* Storage
+\*********************************************************************************************/
+String patch_fname(const String& fname) {
+  if (fname.startsWith(F("/"))) {
+    return fname;
+  }
+  return String('/') + fname;
+}
+
+bool fileExists(const __FlashStringHelper *fname)
+{
+  return fileExists(String(fname));
+}
+
+bool fileExists(const String& fname) {
+  const String patched_fname = patch_fname(fname);
+  auto search                = Cache.fileExistsMap.find(patched_fname);
+
+  if (search != Cache.fileExistsMap.end()) {
+    return search->second;
+  }
+  const bool res = ESPEASY_FS.exists(patched_fname);
+
+  Cache.fileExistsMap.emplace(
+    std::make_pair(
+      patched_fname,
+      res));
+
+  if (Cache.fileCacheClearMoment == 0) {
+    // Any non-zero value, like the firmware does when there is no time source
+    Cache.fileCacheClearMoment = node_time.getLocalUnixTime() + 1;
+  }
+  return res;
+}
+
+fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e destination) {
+  fs::File f;
+
+  if (fname.isEmpty() || equals(fname, '/')) {
+    return f;
+  }
+
+  if (!fileExists(fname)) {
+    if (equals(mode, 'r')) {
+      return f;
+    }
+    clearFileCaches();
+  }
+
+  if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
+    f = ESPEASY_FS.open(patch_fname(fname), mode.c_str());
+  }
+  return f;
+}
+
+bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination) {
+  clearFileCaches();
+
+  if (fileExists(fname_old) && !fileExists(fname_new)) {
+    clearAllButTaskCaches();
+
+    if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
+      return ESPEASY_FS.rename(patch_fname(fname_old), patch_fname(fname_new));
+    }
+  }
+  return false;
+}
+
+bool tryDeleteFile(const String& fname, FileDestination_e destination) {
+  if (fname.length() > 0)
+  {
+    clearAllButTaskCaches();
+
+    bool res = false;
+
+    if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
+      res = ESPEASY_FS.remove(patch_fname(fname));
+    }
+    clearFileCaches();
+    return res;
+  }
+  return false;
+}
+
+// filenr = 0...3 for files rules1.txt ... rules4.txt
+String getRulesFileName(unsigned int filenr) {
+  String result;
+
+  if (filenr < RULESETS_MAX) {
+    result += F("rules");
+    result += filenr + 1;
+    result += F(".txt");
+  }
+  return result;
+}
+
+String LoadTaskSettings(taskIndex_t TaskIndex) {
+  ExtraTaskSettings.TaskIndex = TaskIndex;
+  return EMPTY_STRING;
+}
+
+String LoadControllerSettings(controllerIndex_t ControllerIndex, ControllerSettingsStruct& controller_settings) {
+  if (!validControllerIndex(ControllerIndex)) {
+    return F("LoadControllerSettings: invalid controller index");
+  }
+  controller_settings = storedControllerSettings[ControllerIndex];
+  return EMPTY_STRING;
+}
+
+
+/*********************************************************************************************\
+* Plugins
+\*********************************************************************************************/
+bool validDeviceIndex(deviceIndex_t index) {
+  return index.value < Device.size();
+}
+
+deviceIndex_t getDeviceIndex_from_TaskIndex(taskIndex_t taskIndex) {
+  if (validTaskIndex(taskIndex)) {
+    return getDeviceIndex(pluginID_t::toPluginID(Settings.TaskDeviceNumber[taskIndex]));
+  }
+  return INVALID_DEVICE_INDEX;
+}
+
+pluginID_t getPluginID_from_TaskIndex(taskIndex_t taskIndex) {
+  if (validDeviceIndex(getDeviceIndex_from_TaskIndex(taskIndex))) {
+    return pluginID_t::toPluginID(Settings.TaskDeviceNumber[taskIndex]);
+  }
+  return INVALID_PLUGIN_ID;
+}
+
+deviceIndex_t getDeviceIndex(pluginID_t pluginID) {
+  if (validPluginID(pluginID)) {
+    for (deviceIndex_t x = deviceIndex_t::toDeviceIndex(0); x.value < Device.size(); ++x) {
+      if (Device[x].getPluginID() == pluginID) {
+        return x;
+      }
+    }
+  }
+  return INVALID_DEVICE_INDEX;
+}
+
+// Answers the calls to get the value count and value type from the DeviceStruct,
+// as the plugins do which do not support a configurable output type.
+bool PluginCall(uint8_t Function, struct EventStruct *event, String& str) {
+  if ((event == nullptr) || !validTaskIndex(event->TaskIndex)) {
+    return false;
+  }
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(event->TaskIndex);
+
+  if (!validDeviceIndex(DeviceIndex)) {
+    return false;
+  }
+  event->BaseVarIndex = event->TaskIndex * VARS_PER_TASK;
+
+  switch (Function) {
+    case PLUGIN_GET_DEVICEVALUECOUNT:
+      event->Par1 = Device[DeviceIndex].ValueCount;
+      break;
+    case PLUGIN_GET_DEVICEVTYPE:
+      event->sensorType = Device[DeviceIndex].VType;
+      break;
+  }
+  return false;
+}
+
+String getTaskDeviceName(taskIndex_t TaskIndex) {
+  return Cache.getTaskDeviceName(TaskIndex);
+}
+
+String getTaskValueName(taskIndex_t TaskIndex, uint8_t TaskValueIndex) {
+  const int valueCount = getValueCountForTask(TaskIndex);
+
+  if (TaskValueIndex < valueCount) {
+    return Cache.getTaskDeviceValueName(TaskIndex, TaskValueIndex);
+  }
+  return EMPTY_STRING;
+}
+
+
+/*********************************************************************************************\
+* Controllers
+\*********************************************************************************************/
+bool anyControllerEnabled() {
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; x++) {
+    if (Settings.ControllerEnabled[x] && validCPluginID(Settings.Protocol[x])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool validProtocolIndex(protocolIndex_t index) {
+  return index != INVALID_PROTOCOL_INDEX;
+}
+
+bool validCPluginID(cpluginID_t cpluginID) {
+  return getProtocolIndex_from_CPluginID(cpluginID) != INVALID_PROTOCOL_INDEX;
+}
+
+protocolIndex_t getProtocolIndex_from_ControllerIndex(controllerIndex_t index) {
+  if (validControllerIndex(index)) {
+    return getProtocolIndex_from_CPluginID(Settings.Protocol[index]);
+  }
+  return INVALID_PROTOCOL_INDEX;
+}
+
+protocolIndex_t getProtocolIndex_from_CPluginID(cpluginID_t cpluginID) {
+  if ((cpluginID == INVALID_C_PLUGIN_ID) || (cpluginID > CPLUGIN_MAX)) {
+    return INVALID_PROTOCOL_INDEX;
+  }
+  return cpluginID - 1;
+}
+
+cpluginID_t getCPluginID_from_ProtocolIndex(protocolIndex_t index) {
+  if (validProtocolIndex(index)) {
+    return index + 1;
+  }
+  return INVALID_C_PLUGIN_ID;
+}
+
+cpluginID_t getCPluginID_from_ControllerIndex(controllerIndex_t index) {
+  return getCPluginID_from_ProtocolIndex(getProtocolIndex_from_ControllerIndex(index));
+}
+
+ProtocolStruct& getProtocolStruct(protocolIndex_t protocolIndex) {
+  static ProtocolStruct protocol;
+
+  return protocol;
+}
+
+bool NetworkConnected(uint32_t timeout_ms) {
+  return true;
+}
+
+unsigned long FreeMem() {
+  return 1000000ul;
+}
+
+
+/*********************************************************************************************\
+* Scheduler
+\*********************************************************************************************/
+void ESPEasy_Scheduler::scheduleNextDelayQueue(SchedulerIntervalTimer_e id, unsigned long nextTime) {
+  _nextTime[static_cast<uint8_t>(id)] = nextTime;
+}
+
+unsigned long ESPEasy_Scheduler::getNextDelayQueueTime(SchedulerIntervalTimer_e id) const {
+  return _nextTime[static_cast<uint8_t>(id)];
+}
+
+void backgroundtasks() {}
+
+
+/*********************************************************************************************\
+* Time, copied from the firmware ESPEasy_time.cpp
+\*********************************************************************************************/
+uint32_t ESPEasy_time::getUnixTime() const
+{
+  const uint64_t unixtime_usec = getMicros64() + unixTime_usec_uptime_offset;
+
+  return static_cast<uint32_t>(unixtime_usec / 1000000ull);
+}
+
+uint32_t ESPEasy_time::getUnixTime(uint32_t& unix_time_frac) const
+{
+  return systemMicros_to_Unixtime(getMicros64(), unix_time_frac);
+}
+
+unsigned long ESPEasy_time::getLocalUnixTime() const
+{
+  return time_zone.toLocal(getUnixTime());
+}
+
+unsigned long ESPEasy_time::getLocalUnixTime(uint32_t& unix_time_frac) const
+{
+  return time_zone.toLocal(getUnixTime(unix_time_frac));
+}
+
+int64_t ESPEasy_time::Unixtime_to_systemMicros(const uint32_t& unix_time_sec, uint32_t unix_time_frac) const
+{
+  const int64_t res =
+    (static_cast<int64_t>(unix_time_sec) * 1000000ll) +
+    unix_time_frac_to_micros(unix_time_frac);
+
+  if (unixTime_usec_uptime_offset == 0) {
+    // Time has not been set
+    return res;
+  }
+  return res - unixTime_usec_uptime_offset;
+}
+
+uint32_t ESPEasy_time::systemMicros_to_Unixtime(const int64_t& systemMicros, uint32_t& unix_time_frac) const
+{
+  return micros_to_sec_time_frac(systemMicros + unixTime_usec_uptime_offset, unix_time_frac);
+}
+
+int ESPEasy_time::weekday() const
+{
+  struct tm tmp;
+
+  breakTime(getLocalUnixTime(), tmp);
+  return tmp.tm_wday;
+}
+
+static String sunTimeString(uint32_t localTimeOfDay, char delimiter, int secOffset)
+{
+  struct tm tmp;
+
+  breakTime(localTimeOfDay + secOffset, tmp);
+  return formatTimeString(tmp, delimiter, false, false);
+}
+
+String ESPEasy_time::getSunriseTimeString(char delimiter, int secOffset) const
+{
+  return sunTimeString(6 * 3600, delimiter, secOffset);
+}
+
+String ESPEasy_time::getSunsetTimeString(char delimiter, int secOffset) const
+{
+  return sunTimeString(18 * 3600, delimiter, secOffset);
+}
+
+int ESPEasy_time::getSecOffset(const String& format) {
+  int position_minus = format.indexOf('-');
+  int position_plus  = format.indexOf('+');
+
+  if ((position_minus == -1) && (position_plus == -1)) {
+    return 0;
+  }
+  int sign_position    = _max(position_minus, position_plus);
+  int position_percent = format.indexOf('%', sign_position);
+
+  if (position_percent == -1) {
+    return 0;
+  }
+
+  int32_t value;
+
+  if (!validIntFromString(format.substring(sign_position, position_percent), value)) {
+    return 0;
+  }
+
+  switch (format.charAt(position_percent - 1)) {
+    case 'm':
+    case 'M':
+      return value * 60;
+    case 'h':
+    case 'H':
+      return value * 3600;
+  }
+  return value;
+}
+
+uint32_t getUnixTime() {
+  return node_time.getUnixTime();
+}
+
+
+/*********************************************************************************************\
+* Commands
+\*********************************************************************************************/
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, const char *Line)
+  : _source(source), _Line(Line) {}
+
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, const String& Line)
+  : _source(source), _Line(Line) {}
+
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, String&& Line)
+  : _source(source), _Line(std::move(Line)) {}
+
+// Like the firmware Command_Rules_Let
+static void executeLet(const char *Line)
+{
+  String TmpStr1;
+
+  if (GetArgv(Line, TmpStr1, 2)) {
+    const int index = TmpStr1.toInt();
+
+    if ((index >= 0) && GetArgv(Line, TmpStr1, 3)) {
+      ESPEASY_RULES_FLOAT_TYPE result{};
+
+      if (!isError(Calculate(TmpStr1, result))) {
+        setCustomFloatVar(index, result);
+      }
+    }
+  }
+}
+
+bool ExecuteCommand_all(ExecuteCommandArgs&& args, bool addToQueue) {
+  String cmd;
+
+  if (GetArgv(args._Line.c_str(), cmd, 1) && cmd.equalsIgnoreCase(F("let"))) {
+    executeLet(args._Line.c_str());
+  }
+  executedCommands.push_back(std::move(args._Line));
+  return true;
+}
+
+bool getGPIOPinStateValues(String& str) {
+  return false;
+}
+
+
+/*********************************************************************************************\
+* Web server, the generated HTML is discarded
+\*********************************************************************************************/
+void addHtml(const char& char1) {}
+
+void addHtml(const char& char1, const char& char2) {}
+
+void addHtml(const __FlashStringHelper *html) {}
+
+void addHtml(const String& html) {}
+
+void addHtml(String&& html) {}
+
+void addHtmlInt(int32_t int_val) {}
+
+void addHtmlInt(uint32_t int_val) {}
+
+void addHtmlInt(int64_t int_val) {}
+
+void addHtmlInt(uint64_t int_val) {}
+
+void addHtmlFloat(const float& value, unsigned int nrDecimals) {}
+
+#if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+void addHtmlFloat(const double& value, unsigned int nrDecimals) {}
+
+#endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+void addUnit(const __FlashStringHelper *unit) {}
+
+void addUnit(const String& unit) {}
+
+void addUnit(char unit) {}
+
+void addRowLabel(const __FlashStringHelper *label) {}
+
+void addRowLabel(const String& label, const String& id) {}
+
+void addFormSeparator(int clspan) {}
@@ -0,0 +1,145 @@
+#include <native_shims.h>
+
+#include "src/src/DataTypes/EventQueueOverflowPolicy.h"
+#include "src/src/Helpers/ESPEasy_time_calc.h"
+
+#include <chrono>
+#include <thread>
+
+
+const String EMPTY_STRING;
+const String emptyString;
+
+NativeSettingsStruct Settings;
+
+
+/*********************************************************************************************\
+* Arduino core
+\*********************************************************************************************/
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return static_cast<unsigned long>(static_cast<uint32_t>(
+                                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::steady_clock::now() - startTime).count()));
+}
+
+unsigned long micros() {
+  return static_cast<unsigned long>(static_cast<uint32_t>(getMicros64()));
+}
+
+uint64_t getMicros64() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {}
+
+
+/*********************************************************************************************\
+* Logging, disabled
+\*********************************************************************************************/
+bool loglevelActiveFor(uint8_t logLevel) {
+  return false;
+}
+
+void addLog(uint8_t logLevel, const __FlashStringHelper *str) {}
+
+void addLog(uint8_t logLevel, const char *line) {}
+
+void addLog(uint8_t logLevel, const String& str) {}
+
+void addLog(uint8_t logLevel, String&& str) {}
+
+
+/*********************************************************************************************\
+* Settings
+\*********************************************************************************************/
+EventQueueOverflowPolicy_e NativeSettingsStruct::EventQueueOverflowPolicy() const {
+  return static_cast<EventQueueOverflowPolicy_e>(overflowPolicy);
+}
+
+void NativeSettingsStruct::EventQueueOverflowPolicy(EventQueueOverflowPolicy_e value) {
+  overflowPolicy = static_cast<uint8_t>(value);
+}
+
+
+/*********************************************************************************************\
+* String helpers
+\*********************************************************************************************/
+String concat(const __FlashStringHelper *str, const String& val) {
+  return concat(String(str), val);
+}
+
+String concat(const String& str, const String& val) {
+  String res;
+
+  res.reserve(str.length() + val.length());
+  res += str;
+  res += val;
+  return res;
+}
+
+bool equals(const String& str, const __FlashStringHelper *f_str) {
+  return str.equals(String(f_str));
+}
+
+bool equals(const String& str, const char& c) {
+  return (str.length() == 1) && (str[0] == c);
+}
+
+void move_special(String& dest, String&& source) {
+  dest = std::move(source);
+}
+
+String move_special(String&& source) {
+  return std::move(source);
+}
+
+bool reserve_special(String& str, size_t size) {
+  if (str.length() >= size) { return true; }
+  return str.reserve(size);
+}
+
+static String vstrformat(const char *format, va_list args) {
+  va_list args_copy;
+
+  va_copy(args_copy, args);
+  const int len = vsnprintf(nullptr, 0, format, args_copy);
+
+  va_end(args_copy);
+
+  if (len <= 0) { return String(); }
+  std::vector<char> buf(len + 1);
+
+  vsnprintf(&buf[0], buf.size(), format, args);
+  return String(&buf[0]);
+}
+
+String strformat(const String& format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  String res = vstrformat(format.c_str(), args);
+
+  va_end(args);
+  return res;
+}
+
+String strformat(const __FlashStringHelper *format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  String res = vstrformat(reinterpret_cast<const char *>(format), args);
+
+  va_end(args);
+  return res;
+}
+
+void* special_calloc(size_t num, size_t size) {
+  return calloc(num, size);
+}
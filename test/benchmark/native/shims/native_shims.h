@@ -0,0 +1,182 @@
+#ifndef NATIVE_BENCHMARK_NATIVE_SHIMS_H
+#define NATIVE_BENCHMARK_NATIVE_SHIMS_H
+
+/*********************************************************************************************\
+* Host replacements of the ESPEasy globals and helpers used by the sources
+* built in the native_benchmark environment.
+* The header files in this directory tree take the place of the firmware headers
+* with the same path and all include this file.
+\*********************************************************************************************/
+
+#include <Arduino.h>
+
+#include <cstdarg>
+#include <vector>
+
+
+#ifndef BUILD_NO_DEBUG
+# define BUILD_NO_DEBUG
+#endif // ifndef BUILD_NO_DEBUG
+
+#ifndef BUILD_NO_RAM_TRACKER
+# define BUILD_NO_RAM_TRACKER
+#endif // ifndef BUILD_NO_RAM_TRACKER
+
+#define NR_ELEMENTS(ARR)   (sizeof (ARR) / sizeof *(ARR))
+#define ZERO_FILL(S)  memset((S), 0, sizeof(S))
+
+#ifndef FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE 1
+#endif // ifndef FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+#if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define ESPEASY_RULES_FLOAT_TYPE double
+#else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define ESPEASY_RULES_FLOAT_TYPE float
+#endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+#ifndef FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES
+# define FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES 1
+#endif // ifndef FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES
+
+#define FEATURE_TIMING_STATS 0
+#define FEATURE_CHART_JS 0
+#define FEATURE_RTC_CACHE_STORAGE 1
+#define FEATURE_PLUGIN_STATS 1
+#define FEATURE_RULES_COMPILER 1
+#define USES_C013
+
+#define PLUGIN_STATS_NR_ELEMENTS 250
+
+#define TASKS_MAX             32
+#define CONTROLLER_MAX        3
+#define NOTIFICATION_MAX      3
+#define VARS_PER_TASK         4
+#define USERVAR_MAX_INDEX     (VARS_PER_TASK * TASKS_MAX)
+#define PLUGIN_CONFIGVAR_MAX  8
+#define DEVICE_INDEX_MAX      255
+#define PLUGIN_MAX            255
+#define CPLUGIN_MAX           255
+#define NPLUGIN_MAX           4
+#define RULESETS_MAX          4
+#define EVENT_QUEUE_MAX_SIZE  160
+#define UDP_PACKETSIZE_MAX    512
+#define RULES_MAX_NESTING_LEVEL    3
+#define RULES_IF_MAX_NESTING_LEVEL 4
+#define RULES_BUFFER_SIZE          64
+
+#define EVENT_QUEUE_PROCESS_BUDGET_MSEC 20
+
+
+typedef uint8_t  taskIndex_t;
+typedef uint8_t  controllerIndex_t;
+typedef uint16_t userVarIndex_t;
+
+extern const taskIndex_t INVALID_TASK_INDEX;
+extern controllerIndex_t INVALID_CONTROLLER_INDEX;
+
+extern const String EMPTY_STRING;
+
+
+// Logging
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_INFO   2
+#define LOG_LEVEL_DEBUG  3
+#define LOG_LEVEL_DEBUG_MORE 4
+#define LOG_LEVEL_DEBUG_DEV  9
+
+bool loglevelActiveFor(uint8_t logLevel);
+void addLog(uint8_t logLevel, const __FlashStringHelper *str);
+void addLog(uint8_t logLevel, const char *line);
+void addLog(uint8_t logLevel, const String& str);
+void addLog(uint8_t logLevel, String&& str);
+
+#define addLogMove(L, S)  addLog(L, std::move(S))
+
+
+// Settings
+enum class EventQueueOverflowPolicy_e : uint8_t;
+
+struct NativeSettingsStruct {
+  EventQueueOverflowPolicy_e EventQueueOverflowPolicy() const;
+  void                       EventQueueOverflowPolicy(EventQueueOverflowPolicy_e value);
+
+  bool JSONBoolWithoutQuotes() const {
+    return false;
+  }
+
+  bool OldRulesEngine() const {
+    return oldRulesEngine;
+  }
+
+  bool EnableRulesCaching() const {
+    return enableRulesCaching;
+  }
+
+  bool EnableRulesEventReorder() const {
+    return enableRulesEventReorder;
+  }
+
+  bool TolerantLastArgParse() const {
+    return false;
+  }
+
+  bool CombineTaskValues_SingleEvent(taskIndex_t taskIndex) const {
+    return false;
+  }
+
+  bool          UseRules = true;
+  uint8_t       SerialLogLevel = 0;
+  uint8_t       Protocol[CONTROLLER_MAX]{};
+  unsigned long TaskDeviceTimer[TASKS_MAX]{};
+  bool          TaskDeviceEnabled[TASKS_MAX]{};
+  uint8_t       TaskDeviceNumber[TASKS_MAX]{}; // Plugin ID, 0 = no plugin
+  bool          ControllerEnabled[CONTROLLER_MAX]{};
+  unsigned int  TaskDeviceID[CONTROLLER_MAX][TASKS_MAX]{};
+  bool          TaskDeviceSendData[CONTROLLER_MAX][TASKS_MAX]{};
+
+  bool    oldRulesEngine          = true;
+  bool    enableRulesCaching      = true;
+  bool    enableRulesEventReorder = false;
+  uint8_t overflowPolicy          = 0;
+};
+
+extern NativeSettingsStruct Settings;
+
+
+// String helpers
+String concat(const __FlashStringHelper *str, const String& val);
+String concat(const String& str, const String& val);
+
+template<typename T>
+String concat(const __FlashStringHelper *str, const T& val) {
+  return concat(str, String(val));
+}
+
+template<typename T>
+String concat(const String& str, const T& val) {
+  return concat(str, String(val));
+}
+
+bool equals(const String& str, const __FlashStringHelper *f_str);
+bool equals(const String& str, const char& c);
+
+template<typename T>
+bool equals(const String& str, const T& val) {
+  return str.equals(String(val));
+}
+
+void   move_special(String& dest, String&& source);
+String move_special(String&& source);
+bool   reserve_special(String& str, size_t size);
+
+String strformat(const String& format, ...);
+String strformat(const __FlashStringHelper *format, ...);
+
+
+// Memory
+void* special_calloc(size_t num, size_t size);
+
+
+#endif // ifndef NATIVE_BENCHMARK_NATIVE_SHIMS_H
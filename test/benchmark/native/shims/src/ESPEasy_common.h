@@ -0,0 +1,15 @@
+#ifndef ESPEASY_COMMON_H
+#define ESPEASY_COMMON_H
+
+// Host replacement of ESPEasy_common.h for the native_benchmark environment.
+
+#include <Arduino.h>
+#include <cmath>
+
+#include <native_shims.h>
+
+#include "src/Globals/RamTracker.h"
+#include "src/ESPEasyCore/ESPEasy_Log.h"
+#include "src/Helpers/ESPEasy_math.h"
+
+#endif // ESPEASY_COMMON_H
@@ -0,0 +1,26 @@
+#include "_Plugin_Helper.h"
+
+// Copied from the firmware _Plugin_Helper.cpp, which also handles the plugin task data.
+
+int getValueCountForTask(taskIndex_t taskIndex) {
+  struct EventStruct TempEvent(taskIndex);
+  String dummy;
+
+  PluginCall(PLUGIN_GET_DEVICEVALUECOUNT, &TempEvent, dummy);
+  return TempEvent.Par1;
+}
+
+int checkDeviceVTypeForTask(struct EventStruct *event) {
+  // TD-er:  Do not use event->getSensorType() here
+  if (event->sensorType == Sensor_VType::SENSOR_TYPE_NOT_SET) {
+    if (validTaskIndex(event->TaskIndex)) {
+      String dummy;
+
+      event->idx = -1;
+      if (PluginCall(PLUGIN_GET_DEVICEVTYPE, event, dummy)) {
+        return event->idx; // pconfig_index
+      }
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,51 @@
+#ifndef PLUGIN_HELPER_H
+#define PLUGIN_HELPER_H
+
+// Host replacement of _Plugin_Helper.h for the native_benchmark environment.
+// Includes the subset of the firmware headers which is available on the host.
+
+#include "ESPEasy_common.h"
+
+#include "src/CustomBuild/ESPEasyLimits.h"
+
+#include "src/DataStructs/DeviceStruct.h"
+#include "src/DataStructs/ESPEasy_EventStruct.h"
+
+#include "src/DataTypes/ESPEasy_plugin_functions.h"
+
+#include "src/ESPEasyCore/ESPEasy_Log.h"
+#include "src/ESPEasyCore/Serial.h"
+
+#include "src/Globals/Cache.h"
+#include "src/Globals/Device.h"
+#include "src/Globals/ESPEasy_Scheduler.h"
+#include "src/Globals/ESPEasy_time.h"
+#include "src/Globals/EventQueue.h"
+#include "src/Globals/ExtraTaskSettings.h"
+#include "src/Globals/Plugins.h"
+#include "src/Globals/RuntimeData.h"
+#include "src/Globals/Settings.h"
+
+#include "src/Helpers/ESPEasy_math.h"
+#include "src/Helpers/ESPEasy_Storage.h"
+#include "src/Helpers/ESPEasy_time_calc.h"
+#include "src/Helpers/Hardware.h"
+#include "src/Helpers/Misc.h"
+#include "src/Helpers/Numerical.h"
+#include "src/Helpers/StringConverter.h"
+#include "src/Helpers/StringGenerator_GPIO.h"
+#include "src/Helpers/StringParser.h"
+#include "src/Helpers/_Plugin_SensorTypeHelper.h"
+
+#include "src/WebServer/Chart_JS.h"
+#include "src/WebServer/HTML_wrappers.h"
+#include "src/WebServer/Markup.h"
+#include "src/WebServer/Markup_Forms.h"
+
+int getValueCountForTask(taskIndex_t taskIndex);
+
+// Check if the DeviceVType is set and update if it isn't.
+// Return pconfig_index
+int checkDeviceVTypeForTask(struct EventStruct *event);
+
+#endif // PLUGIN_HELPER_H
@@ -0,0 +1,32 @@
+#ifndef NATIVE_SHIM_COMMANDS_EXECUTECOMMAND_H
+#define NATIVE_SHIM_COMMANDS_EXECUTECOMMAND_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/EventValueSource.h"
+#include "../DataTypes/TaskIndex.h"
+
+struct ExecuteCommandArgs {
+  ExecuteCommandArgs(EventValueSource::Enum source,
+                     const char            *Line);
+
+  ExecuteCommandArgs(EventValueSource::Enum source,
+                     const String         & Line);
+
+  ExecuteCommandArgs(EventValueSource::Enum source,
+                     String              && Line);
+
+  taskIndex_t            _taskIndex = INVALID_TASK_INDEX;
+  EventValueSource::Enum _source    = EventValueSource::Enum::VALUE_SOURCE_NOT_SET;
+  String                 _Line;
+};
+
+// There are no commands on the host.
+// Each executed command line is appended to executedCommands,
+// only the "Let" command is executed to set the rules variables.
+extern std::vector<String> executedCommands;
+
+bool ExecuteCommand_all(ExecuteCommandArgs&& args,
+                        bool                 addToQueue = false);
+
+#endif // ifndef NATIVE_SHIM_COMMANDS_EXECUTECOMMAND_H
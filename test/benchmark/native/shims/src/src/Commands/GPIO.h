@@ -0,0 +1,9 @@
+#ifndef NATIVE_SHIM_COMMANDS_GPIO_H
+#define NATIVE_SHIM_COMMANDS_GPIO_H
+
+#include <native_shims.h>
+
+// There are no GPIO pins on the host, so there is never a pin state to fill in.
+bool getGPIOPinStateValues(String& str);
+
+#endif // ifndef NATIVE_SHIM_COMMANDS_GPIO_H
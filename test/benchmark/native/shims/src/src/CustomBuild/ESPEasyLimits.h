@@ -0,0 +1,6 @@
+#ifndef NATIVE_SHIM_CUSTOMBUILD_ESPEASYLIMITS_H
+#define NATIVE_SHIM_CUSTOMBUILD_ESPEASYLIMITS_H
+
+#include <native_shims.h>
+
+#endif // ifndef NATIVE_SHIM_CUSTOMBUILD_ESPEASYLIMITS_H
@@ -0,0 +1,258 @@
+#include "../DataStructs/Caches.h"
+
+#include "../Globals/RulesCalculate.h"
+#include "../Helpers/StringConverter.h"
+
+// Copied from the firmware Caches.cpp, without the parts which load the task settings from file,
+// the controller settings and the MQTT topics.
+
+void Caches::clearAllCaches()
+{
+  clearAllButTaskCaches();
+  clearAllTaskCaches();
+}
+
+void Caches::clearAllButTaskCaches() {
+  clearFileCaches();
+  rulesHelper.closeAllFiles();
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+}
+
+void Caches::clearAllTaskCaches() {
+  taskIndexName.clear();
+  taskIndexValueName.clear();
+  taskDeviceFormulaPrograms.clear();
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  ++taskSettingsGeneration;
+}
+
+void Caches::clearTaskCache(taskIndex_t TaskIndex) {
+  clearTaskIndexFromMaps(TaskIndex);
+  clearTaskDeviceFormulaPrograms(TaskIndex);
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  // Templates may refer to the old name of the task or its values
+  templatePrograms.clear();
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+  ++taskSettingsGeneration;
+}
+
+void Caches::clearFileCaches()
+{
+  fileExistsMap.clear();
+  fileCacheClearMoment = 0;
+}
+
+uint8_t Caches::getTaskDeviceValueDecimals(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.decimals[rel_index];
+    }
+  }
+  return 0;
+}
+
+String Caches::getTaskDeviceName(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.TaskDeviceName;
+    }
+  }
+  return EMPTY_STRING;
+}
+
+String Caches::getTaskDeviceValueName(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.TaskDeviceValueNames[rel_index];
+    }
+  }
+
+  return EMPTY_STRING;
+}
+
+bool Caches::hasFormula(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return bitRead(it->second.hasFormula, 2 * rel_index);
+    }
+  }
+  return false;
+}
+
+bool Caches::hasFormula(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.hasFormula != 0;
+    }
+  }
+  return false;
+}
+
+bool Caches::hasFormula_with_prevValue(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return bitRead(it->second.hasFormula, 2 * rel_index + 1);
+    }
+  }
+  return false;
+}
+
+String Caches::getTaskDeviceFormula(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if ((rel_index < VARS_PER_TASK) && hasFormula(TaskIndex, rel_index)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.TaskDeviceFormula[rel_index];
+    }
+  }
+  return EMPTY_STRING;
+}
+
+const RulesCalculate_program * Caches::getTaskDeviceFormulaProgram(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (!hasFormula(TaskIndex, rel_index)) {
+    return nullptr;
+  }
+  const uint16_t key = makeWord(TaskIndex, rel_index);
+  auto it            = taskDeviceFormulaPrograms.find(key);
+
+  if (it == taskDeviceFormulaPrograms.end()) {
+    const __FlashStringHelper * const slotNames[] = { F("%value%"), F("%pvalue%") };
+    const String formula                          = RulesCalculate_t::preProces(getTaskDeviceFormula(TaskIndex, rel_index));
+
+    RulesCalculate_program program;
+
+    // Any other reference like [task#value], %sysvar% or {...} needs parseTemplate()
+    // and thus cannot be compiled.
+    String check(formula);
+
+    for (size_t i = 0; i < NR_ELEMENTS(slotNames); ++i) {
+      check.replace(slotNames[i], EMPTY_STRING);
+    }
+
+    if ((check.indexOf('%') == -1) &&
+        (check.indexOf('[') == -1) &&
+        (check.indexOf('{') == -1)) {
+      RulesCalculate.compile(formula, slotNames, NR_ELEMENTS(slotNames), program);
+    }
+
+    it = taskDeviceFormulaPrograms.emplace(key, std::move(program)).first;
+  }
+  return &(it->second);
+}
+
+bool Caches::enabledPluginStats(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.pluginStatsConfig[rel_index].isEnabled();
+    }
+  }
+  return false;
+}
+
+PluginStats_Config_t Caches::getPluginStatsConfig(taskIndex_t TaskIndex, taskVarIndex_t taskVarIndex)
+{
+  if (validTaskIndex(TaskIndex) && (taskVarIndex < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings.end()) {
+      return it->second.pluginStatsConfig[taskVarIndex];
+    }
+  }
+  return PluginStats_Config_t(0);
+}
+
+void Caches::setTaskSettings(taskIndex_t TaskIndex, const ExtraTaskSettings_cache_t& settings)
+{
+  if (!validTaskIndex(TaskIndex)) {
+    return;
+  }
+  ExtraTaskSettings_cache_t tmp(settings);
+
+  tmp.hasFormula = 0;
+
+  for (size_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (!tmp.TaskDeviceFormula[i].isEmpty()) {
+      bitSet(tmp.hasFormula, 2 * i);
+
+      if (tmp.TaskDeviceFormula[i].indexOf(F("%pvalue%")) != -1) {
+        bitSet(tmp.hasFormula, 2 * i + 1);
+      }
+    }
+  }
+  extraTaskSettings[TaskIndex] = std::move(tmp);
+  clearTaskCache(TaskIndex);
+}
+
+ExtraTaskSettingsMap::const_iterator Caches::getExtraTaskSettings(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    return extraTaskSettings.find(TaskIndex);
+  }
+  return extraTaskSettings.end();
+}
+
+void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
+{
+  {
+    auto it = taskIndexName.begin();
+
+    for (; it != taskIndexName.end();) {
+      if (it->second == TaskIndex) {
+        it = taskIndexName.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  {
+    const String searchstr = String('#') + TaskIndex;
+    auto it                = taskIndexValueName.begin();
+
+    for (; it != taskIndexValueName.end();) {
+      if (it->first.endsWith(searchstr)) {
+        it = taskIndexValueName.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void Caches::clearTaskDeviceFormulaPrograms(taskIndex_t TaskIndex)
+{
+  for (uint8_t rel_index = 0; rel_index < VARS_PER_TASK; ++rel_index) {
+    auto it = taskDeviceFormulaPrograms.find(makeWord(TaskIndex, rel_index));
+
+    if (it != taskDeviceFormulaPrograms.end()) {
+      taskDeviceFormulaPrograms.erase(it);
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#ifndef NATIVE_SHIM_DATASTRUCTS_CACHES_H
+#define NATIVE_SHIM_DATASTRUCTS_CACHES_H
+
+#include <native_shims.h>
+
+#include "../DataStructs/PluginStats_Config.h"
+#include "../DataTypes/TaskIndex.h"
+#include "../Globals/Plugins.h"
+#include "../Helpers/RulesHelper.h"
+#include "../Helpers/Rules_calculate.h"
+#include "../Helpers/TemplateProgram.h"
+
+#include <map>
+
+// The cached part of the task settings, as kept on ESP32.
+// On the host this is the only copy, set via Caches::setTaskSettings().
+struct ExtraTaskSettings_cache_t {
+  String               TaskDeviceValueNames[VARS_PER_TASK];
+  String               TaskDeviceFormula[VARS_PER_TASK];
+  String               TaskDeviceName;
+  uint8_t              decimals[VARS_PER_TASK] = { 0 };
+  PluginStats_Config_t pluginStatsConfig[VARS_PER_TASK] = {};
+  uint8_t              hasFormula = 0; // Bitmap which task value has formula and whether a formula needs previous value
+};
+
+typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
+typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
+typedef std::map<String, uint8_t>                        FilePresenceMap;
+typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
+
+// Key is makeWord(TaskIndex, rel_index)
+typedef std::map<uint16_t, RulesCalculate_program>       TaskDeviceFormulaProgramMap;
+
+struct Caches {
+  void    clearAllCaches();
+  void    clearAllButTaskCaches();
+
+  void    clearAllTaskCaches();
+  void    clearTaskCache(taskIndex_t TaskIndex);
+
+  void    clearFileCaches();
+
+  uint8_t getTaskDeviceValueDecimals(taskIndex_t TaskIndex,
+                                     uint8_t     rel_index);
+
+  String  getTaskDeviceName(taskIndex_t TaskIndex);
+
+  String  getTaskDeviceValueName(taskIndex_t TaskIndex,
+                                 uint8_t     rel_index);
+
+  bool    hasFormula(taskIndex_t TaskIndex, uint8_t rel_index);
+  bool    hasFormula(taskIndex_t TaskIndex);
+  bool    hasFormula_with_prevValue(taskIndex_t TaskIndex, uint8_t rel_index);
+
+  String  getTaskDeviceFormula(taskIndex_t TaskIndex,
+                               uint8_t     rel_index);
+
+  const RulesCalculate_program* getTaskDeviceFormulaProgram(taskIndex_t TaskIndex,
+                                                            uint8_t     rel_index);
+
+  bool                 enabledPluginStats(taskIndex_t TaskIndex,
+                                          uint8_t     rel_index);
+
+  PluginStats_Config_t getPluginStatsConfig(taskIndex_t    TaskIndex,
+                                            taskVarIndex_t taskVarIndex);
+
+  // Host only, takes the place of SaveTaskSettings()
+  // hasFormula is computed from the formulas.
+  void setTaskSettings(taskIndex_t                      TaskIndex,
+                       const ExtraTaskSettings_cache_t& settings);
+
+private:
+
+  ExtraTaskSettingsMap::const_iterator getExtraTaskSettings(taskIndex_t TaskIndex);
+
+  void                                 clearTaskIndexFromMaps(taskIndex_t TaskIndex);
+
+  void                                 clearTaskDeviceFormulaPrograms(taskIndex_t TaskIndex);
+
+public:
+
+  TaskIndexNameMap      taskIndexName;
+  TaskIndexValueNameMap taskIndexValueName;
+  FilePresenceMap       fileExistsMap;  // Filesize. -1 if not present
+  RulesHelperClass      rulesHelper;
+
+  #if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+  // Compiled templates of parseTemplate(), refer to task and value names
+  TemplateProgramCache templatePrograms;
+  #endif // if TEMPLATE_PROGRAM_CACHE_SIZE > 0
+
+private:
+
+  // Not cleared along with the other task caches, as there is nothing to reload it from
+  ExtraTaskSettingsMap extraTaskSettings;
+
+  TaskDeviceFormulaProgramMap taskDeviceFormulaPrograms;
+
+public:
+
+  uint32_t fileCacheClearMoment   = 0;
+  uint32_t taskSettingsGeneration = 0;
+};
+
+#endif // ifndef NATIVE_SHIM_DATASTRUCTS_CACHES_H
@@ -0,0 +1,85 @@
+#ifndef NATIVE_SHIM_DATASTRUCTS_CONTROLLERSETTINGSSTRUCT_H
+#define NATIVE_SHIM_DATASTRUCTS_CONTROLLERSETTINGSSTRUCT_H
+
+#include <native_shims.h>
+
+#include "../Helpers/Memory.h"
+
+#include <memory> // For std::shared_ptr
+#include <new>    // for std::nothrow
+
+// The queue related part of the controller settings.
+// The firmware struct also holds the network settings, which need IPAddress and WiFiClient.
+
+#ifndef CONTROLLER_DELAY_QUEUE_DELAY_MAX
+# define CONTROLLER_DELAY_QUEUE_DELAY_MAX   3600000
+#endif // ifndef CONTROLLER_DELAY_QUEUE_DELAY_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_DELAY_DFLT
+# define CONTROLLER_DELAY_QUEUE_DELAY_DFLT  100
+#endif // ifndef CONTROLLER_DELAY_QUEUE_DELAY_DFLT
+
+#ifndef CONTROLLER_DELAY_QUEUE_DEPTH_MAX
+# define CONTROLLER_DELAY_QUEUE_DEPTH_MAX   50
+#endif // ifndef CONTROLLER_DELAY_QUEUE_DEPTH_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_DEPTH_DFLT
+# define CONTROLLER_DELAY_QUEUE_DEPTH_DFLT  10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_DEPTH_DFLT
+
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+# define CONTROLLER_DELAY_QUEUE_BATCH_MAX   25
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_DFLT
+# define CONTROLLER_DELAY_QUEUE_BATCH_DFLT  1
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_DFLT
+
+#ifndef CONTROLLER_DELAY_QUEUE_RETRY_MAX
+# define CONTROLLER_DELAY_QUEUE_RETRY_MAX   10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
+# define CONTROLLER_DELAY_QUEUE_RETRY_DFLT  10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
+
+#ifndef CONTROLLER_CLIENTTIMEOUT_MAX
+# define CONTROLLER_CLIENTTIMEOUT_MAX     4000
+#endif // ifndef CONTROLLER_CLIENTTIMEOUT_MAX
+#ifndef CONTROLLER_CLIENTTIMEOUT_DFLT
+# define CONTROLLER_CLIENTTIMEOUT_DFLT     100
+#endif // ifndef CONTROLLER_CLIENTTIMEOUT_DFLT
+
+struct ControllerSettingsStruct
+{
+  bool allowExpire() const { return VariousBits1.allowExpire; }
+  void allowExpire(bool value) { VariousBits1.allowExpire = value; }
+
+  bool deduplicate() const { return VariousBits1.deduplicate; }
+  void deduplicate(bool value) { VariousBits1.deduplicate = value; }
+
+  bool useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
+  void useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
+
+  unsigned int MinimalTimeBetweenMessages = 0;
+  unsigned int MaxQueueDepth              = 0;
+  unsigned int MaxRetry                   = 0;
+  bool         DeleteOldest               = false; // Action to perform when buffer full, delete oldest, or ignore newest.
+  uint8_t      MaxBatchSize               = 0;     // Max. number of messages sent per queue run, 0 = default
+  unsigned int ClientTimeout              = 0;
+  bool         MustCheckReply             = false; // When set to false, a sent message is considered always successful.
+
+  struct {
+    uint32_t allowExpire        : 1;
+    uint32_t deduplicate        : 1;
+    uint32_t useLocalSystemTime : 1;
+  } VariousBits1{};
+};
+
+// Host only, the settings returned by LoadControllerSettings()
+extern ControllerSettingsStruct storedControllerSettings[CONTROLLER_MAX];
+
+typedef std::shared_ptr<ControllerSettingsStruct> ControllerSettingsStruct_ptr_type;
+
+#define MakeControllerSettings(T) void * calloc_ptr = special_calloc(1,sizeof(ControllerSettingsStruct)); ControllerSettingsStruct_ptr_type T(new (calloc_ptr)  ControllerSettingsStruct());
+
+// Check to see if MakeControllerSettings was successful
+#define AllocatedControllerSettings() (ControllerSettings.get() != nullptr)
+
+#endif // ifndef NATIVE_SHIM_DATASTRUCTS_CONTROLLERSETTINGSSTRUCT_H
@@ -0,0 +1,6 @@
+#ifndef NATIVE_SHIM_ESPEASYCORE_ESPEASY_LOG_H
+#define NATIVE_SHIM_ESPEASYCORE_ESPEASY_LOG_H
+
+#include <native_shims.h>
+
+#endif // ifndef NATIVE_SHIM_ESPEASYCORE_ESPEASY_LOG_H
@@ -0,0 +1,8 @@
+#ifndef NATIVE_SHIM_ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
+#define NATIVE_SHIM_ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
+
+#include <native_shims.h>
+
+void backgroundtasks();
+
+#endif // ifndef NATIVE_SHIM_ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
@@ -0,0 +1,6 @@
+#ifndef NATIVE_SHIM_ESPEASYCORE_SERIAL_H
+#define NATIVE_SHIM_ESPEASYCORE_SERIAL_H
+
+#include <native_shims.h>
+
+#endif // ifndef NATIVE_SHIM_ESPEASYCORE_SERIAL_H
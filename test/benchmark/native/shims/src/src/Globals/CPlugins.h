@@ -0,0 +1,29 @@
+#ifndef NATIVE_SHIM_GLOBALS_CPLUGINS_H
+#define NATIVE_SHIM_GLOBALS_CPLUGINS_H
+
+#include <native_shims.h>
+
+#include "../DataStructs/ControllerSettingsStruct.h"
+#include "../DataTypes/CPluginID.h"
+#include "../DataTypes/ControllerIndex.h"
+#include "../DataTypes/ESPEasy_plugin_functions.h"
+#include "../DataTypes/ProtocolIndex.h"
+
+// No controller plugins are built for the host.
+// Protocol index N refers to the controller plugin with ID N + 1,
+// the protocols themselves are described by getProtocolStruct().
+
+bool              anyControllerEnabled();
+
+bool              validProtocolIndex(protocolIndex_t index);
+
+#define validControllerIndex(C_X)  ((C_X) < CONTROLLER_MAX)
+
+bool              validCPluginID(cpluginID_t cpluginID);
+
+protocolIndex_t   getProtocolIndex_from_ControllerIndex(controllerIndex_t index);
+protocolIndex_t   getProtocolIndex_from_CPluginID(cpluginID_t cpluginID);
+cpluginID_t       getCPluginID_from_ProtocolIndex(protocolIndex_t index);
+cpluginID_t       getCPluginID_from_ControllerIndex(controllerIndex_t index);
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_CPLUGINS_H
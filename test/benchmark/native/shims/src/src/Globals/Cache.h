@@ -0,0 +1,18 @@
+#ifndef NATIVE_SHIM_GLOBALS_CACHE_H
+#define NATIVE_SHIM_GLOBALS_CACHE_H
+
+#include <native_shims.h>
+
+#include "../DataStructs/Caches.h"
+
+void clearAllCaches();
+
+void clearAllButTaskCaches();
+
+void clearTaskCache(taskIndex_t TaskIndex);
+
+void clearFileCaches();
+
+extern Caches Cache;
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_CACHE_H
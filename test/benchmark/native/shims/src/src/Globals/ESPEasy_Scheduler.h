@@ -0,0 +1,10 @@
+#ifndef NATIVE_SHIM_GLOBALS_ESPEASY_SCHEDULER_H
+#define NATIVE_SHIM_GLOBALS_ESPEASY_SCHEDULER_H
+
+#include <native_shims.h>
+
+#include "../Helpers/Scheduler.h"
+
+extern ESPEasy_Scheduler Scheduler;
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_ESPEASY_SCHEDULER_H
@@ -0,0 +1,42 @@
+#ifndef NATIVE_SHIM_GLOBALS_ESPEASY_TIME_H
+#define NATIVE_SHIM_GLOBALS_ESPEASY_TIME_H
+
+#include <native_shims.h>
+
+// The time conversions of the firmware ESPEasy_time class.
+// There is no time source on the host, so the system time is not set
+// and the unix time equals the uptime.
+class ESPEasy_time {
+public:
+
+  uint32_t      getUnixTime() const;
+  uint32_t      getUnixTime(uint32_t& unix_time_frac) const;
+
+  unsigned long getLocalUnixTime() const;
+  unsigned long getLocalUnixTime(uint32_t& unix_time_frac) const;
+
+  int64_t       Unixtime_to_systemMicros(const uint32_t& unix_time_sec,
+                                         uint32_t        unix_time_frac = 0) const;
+
+  uint32_t      systemMicros_to_Unixtime(const int64_t& systemMicros,
+                                         uint32_t     & unix_time_frac) const;
+
+  // Sunday = 1
+  int           weekday() const;
+
+  // No location is set on the host, sunrise is at 06:00 and sunset at 18:00 local time.
+  String        getSunriseTimeString(char delimiter,
+                                     int  secOffset = 0) const;
+  String        getSunsetTimeString(char delimiter,
+                                    int  secOffset = 0) const;
+
+  static int    getSecOffset(const String& format);
+
+  uint64_t unixTime_usec_uptime_offset = 0;
+};
+
+extern ESPEasy_time node_time;
+
+uint32_t getUnixTime();
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_ESPEASY_TIME_H
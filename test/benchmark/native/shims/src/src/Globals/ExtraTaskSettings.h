@@ -0,0 +1,15 @@
+#ifndef NATIVE_SHIM_GLOBALS_EXTRATASKSETTINGS_H
+#define NATIVE_SHIM_GLOBALS_EXTRATASKSETTINGS_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/TaskIndex.h"
+
+// Only keeps track of the loaded task, the task settings themselves are kept in the Cache
+struct ExtraTaskSettingsStruct {
+  taskIndex_t TaskIndex = INVALID_TASK_INDEX;
+};
+
+extern ExtraTaskSettingsStruct ExtraTaskSettings;
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_EXTRATASKSETTINGS_H
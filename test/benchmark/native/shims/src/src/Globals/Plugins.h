@@ -0,0 +1,29 @@
+#ifndef NATIVE_SHIM_GLOBALS_PLUGINS_H
+#define NATIVE_SHIM_GLOBALS_PLUGINS_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/DeviceIndex.h"
+#include "../DataTypes/PluginID.h"
+#include "../DataTypes/TaskIndex.h"
+
+// No plugins are built for the host.
+// The devices added to the Device vector take their place,
+// so only the plugin calls answered from DeviceStruct are supported.
+
+struct EventStruct;
+
+bool validDeviceIndex(deviceIndex_t index);
+
+#define validTaskIndex(X) ((X) < (TASKS_MAX))
+#define validPluginID(P_ID) ((P_ID) != (INVALID_PLUGIN_ID))
+#define validUserVarIndex(U_VAR_X)  ((U_VAR_X) < (USERVAR_MAX_INDEX))
+#define validTaskVarIndex(T_VAR_X)  ((T_VAR_X) < (VARS_PER_TASK))
+
+deviceIndex_t getDeviceIndex_from_TaskIndex(taskIndex_t taskIndex);
+pluginID_t    getPluginID_from_TaskIndex(taskIndex_t taskIndex);
+deviceIndex_t getDeviceIndex(pluginID_t pluginID);
+
+bool PluginCall(uint8_t Function, struct EventStruct *event, String& str);
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_PLUGINS_H
@@ -0,0 +1,17 @@
+#ifndef NATIVE_SHIM_GLOBALS_TIMEZONE_H
+#define NATIVE_SHIM_GLOBALS_TIMEZONE_H
+
+#include <native_shims.h>
+
+// The host runs in UTC
+class ESPEasy_time_zone {
+public:
+
+  uint32_t toLocal(uint32_t utc) const {
+    return utc;
+  }
+};
+
+extern ESPEasy_time_zone time_zone;
+
+#endif // ifndef NATIVE_SHIM_GLOBALS_TIMEZONE_H
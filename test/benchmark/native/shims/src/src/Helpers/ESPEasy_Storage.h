@@ -0,0 +1,39 @@
+#ifndef NATIVE_SHIM_HELPERS_ESPEASY_STORAGE_H
+#define NATIVE_SHIM_HELPERS_ESPEASY_STORAGE_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/ControllerIndex.h"
+#include "../DataTypes/ESPEasyFileType.h"
+#include "../DataTypes/TaskIndex.h"
+
+#include <FS.h>
+
+// File access as on ESP32, using the in-memory file system of FS_Helper.h.
+// There are no settings files on the host, task and controller settings are set in memory.
+
+struct ControllerSettingsStruct;
+
+String patch_fname(const String& fname);
+
+bool fileExists(const __FlashStringHelper *fname);
+bool fileExists(const String& fname);
+
+enum class FileDestination_e : uint8_t {
+  ANY   = 0,
+  FLASH = 1,
+  SD    = 2,
+};
+
+fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e destination = FileDestination_e::ANY);
+
+bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination = FileDestination_e::ANY);
+
+bool tryDeleteFile(const String& fname, FileDestination_e destination = FileDestination_e::ANY);
+
+// Only sets ExtraTaskSettings.TaskIndex, the task settings are kept in the Cache
+String LoadTaskSettings(taskIndex_t TaskIndex);
+
+String LoadControllerSettings(controllerIndex_t ControllerIndex, ControllerSettingsStruct& controller_settings);
+
+#endif // ifndef NATIVE_SHIM_HELPERS_ESPEASY_STORAGE_H
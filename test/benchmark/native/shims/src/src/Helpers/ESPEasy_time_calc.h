@@ -0,0 +1,61 @@
+#ifndef NATIVE_SHIM_HELPERS_ESPEASY_TIME_CALC_H
+#define NATIVE_SHIM_HELPERS_ESPEASY_TIME_CALC_H
+
+#include <native_shims.h>
+
+#include <time.h>
+
+// The firmware header reads the ESP timers in getMicros64(), the other functions are built
+// from the firmware ESPEasy_time_calc.cpp
+uint64_t getMicros64();
+
+inline int32_t timeDiff(const unsigned long prev, const unsigned long next) {
+  return ((int32_t)(next - prev));
+}
+
+inline int64_t timeDiff64(uint64_t prev, uint64_t next) {
+  return ((int64_t)(next - prev));
+}
+
+inline long timePassedSince(const uint32_t& timestamp) {
+  return timeDiff(timestamp, millis());
+}
+
+inline int64_t usecPassedSince(const uint64_t& timestamp) {
+  return timeDiff64(timestamp, getMicros64());
+}
+
+inline bool timeOutReached(unsigned long timer) {
+  return timePassedSince(timer) >= 0;
+}
+
+inline bool usecTimeOutReached(const uint64_t& timer) {
+  return usecPassedSince(timer) >= 0;
+}
+
+uint32_t unix_time_frac_to_millis(uint32_t unix_time_frac);
+uint32_t unix_time_frac_to_micros(uint32_t unix_time_frac);
+uint32_t millis_to_unix_time_frac(uint32_t millis);
+uint32_t micros_to_unix_time_frac(uint32_t micros);
+uint32_t micros_to_sec_time_frac(int64_t micros, uint32_t& unix_time_frac);
+uint64_t sec_time_frac_to_Micros(uint32_t seconds, uint32_t time_frac);
+uint32_t micros_to_sec_usec(int64_t micros, uint32_t& usec);
+uint64_t sec_time_frac_to_uptime_offset_usec(const uint32_t& seconds,
+                                             uint32_t        time_frac = 0);
+
+bool     isLeapYear(int year);
+uint8_t  getMonthDays(int year, uint8_t month);
+uint8_t  getMonthDays(const struct tm& tm);
+uint32_t makeTime(const struct tm& tm);
+void     breakTime(unsigned long timeInput, struct tm& tm);
+
+String formatDateString(const struct tm& ts, char delimiter);
+String formatTimeString(const struct tm& ts);
+String formatTimeString(const struct tm& ts, char delimiter, bool am_pm, bool show_seconds, char hour_prefix = '\0');
+String formatDateTimeString(const struct tm& ts, char dateDelimiter = '-', char timeDelimiter = ':',  char dateTimeDelimiter = ' ', bool am_pm = false);
+
+String        timeLong2String(unsigned long lngTime);
+unsigned long string2TimeLong(const String& str);
+bool          matchClockEvent(unsigned long clockEvent, unsigned long clockSet);
+
+#endif // ifndef NATIVE_SHIM_HELPERS_ESPEASY_TIME_CALC_H
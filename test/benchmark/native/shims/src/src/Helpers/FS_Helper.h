@@ -0,0 +1,12 @@
+#ifndef NATIVE_SHIM_HELPERS_FS_HELPER_H
+#define NATIVE_SHIM_HELPERS_FS_HELPER_H
+
+#include <native_shims.h>
+
+#include <FS.h>
+
+extern fs::FS LittleFS;
+
+#define ESPEASY_FS LittleFS
+
+#endif // ifndef NATIVE_SHIM_HELPERS_FS_HELPER_H
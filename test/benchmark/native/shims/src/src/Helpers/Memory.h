@@ -0,0 +1,9 @@
+#ifndef NATIVE_SHIM_HELPERS_MEMORY_H
+#define NATIVE_SHIM_HELPERS_MEMORY_H
+
+#include <native_shims.h>
+
+// Heap is never the limiting factor on the host
+unsigned long FreeMem();
+
+#endif // ifndef NATIVE_SHIM_HELPERS_MEMORY_H
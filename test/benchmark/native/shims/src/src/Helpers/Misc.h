@@ -0,0 +1,16 @@
+#ifndef NATIVE_SHIM_HELPERS_MISC_H
+#define NATIVE_SHIM_HELPERS_MISC_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/TaskIndex.h"
+
+#define bitSetULL(value, bit) ((value) |= (1ULL << (bit)))
+#define bitClearULL(value, bit) ((value) &= ~(1ULL << (bit)))
+#define bitWriteULL(value, bit, bitvalue) (bitvalue ? bitSetULL(value, bit) : bitClearULL(value, bit))
+
+String getTaskDeviceName(taskIndex_t TaskIndex);
+
+String getTaskValueName(taskIndex_t TaskIndex, uint8_t TaskValueIndex);
+
+#endif // ifndef NATIVE_SHIM_HELPERS_MISC_H
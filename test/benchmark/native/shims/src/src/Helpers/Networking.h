@@ -0,0 +1,9 @@
+#ifndef NATIVE_SHIM_HELPERS_NETWORKING_H
+#define NATIVE_SHIM_HELPERS_NETWORKING_H
+
+#include <native_shims.h>
+
+// The host is always connected
+bool NetworkConnected(uint32_t timeout_ms);
+
+#endif // ifndef NATIVE_SHIM_HELPERS_NETWORKING_H
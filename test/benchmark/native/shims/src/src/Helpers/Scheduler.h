@@ -0,0 +1,22 @@
+#ifndef NATIVE_SHIM_HELPERS_SCHEDULER_H
+#define NATIVE_SHIM_HELPERS_SCHEDULER_H
+
+#include <native_shims.h>
+
+#include "../DataTypes/SchedulerIntervalTimer.h"
+
+// Only keeps the time set for each interval timer, nothing is scheduled on the host.
+class ESPEasy_Scheduler {
+public:
+
+  void          scheduleNextDelayQueue(SchedulerIntervalTimer_e id,
+                                       unsigned long            nextTime);
+
+  unsigned long getNextDelayQueueTime(SchedulerIntervalTimer_e id) const;
+
+private:
+
+  unsigned long _nextTime[256]{};
+};
+
+#endif // ifndef NATIVE_SHIM_HELPERS_SCHEDULER_H
@@ -0,0 +1,6 @@
+#ifndef NATIVE_SHIM_HELPERS_STRINGPROVIDER_H
+#define NATIVE_SHIM_HELPERS_STRINGPROVIDER_H
+
+#include <native_shims.h>
+
+#endif // ifndef NATIVE_SHIM_HELPERS_STRINGPROVIDER_H
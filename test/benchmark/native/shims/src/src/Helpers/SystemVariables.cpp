@@ -0,0 +1,487 @@
+#include "../Helpers/SystemVariables.h"
+
+#include "../DataStructs/TimingStats.h"
+
+#include "../ESPEasyCore/ESPEasy_Log.h"
+
+#include "../Globals/ESPEasy_time.h"
+#include "../Globals/RulesCalculate.h"
+#include "../Globals/RuntimeData.h"
+
+#include "../Helpers/ESPEasy_math.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
+#include "../Helpers/StringConverter.h"
+
+// Copied from the firmware SystemVariables.cpp, except for getSystemVariable().
+// The host has no network, WiFi, build info or hardware to report,
+// so only the time, uptime, heap and character variables get a value.
+
+
+String getReplacementString(const String& format, const String& s) {
+  int startpos = s.indexOf(format);
+  int endpos   = s.indexOf('%', startpos + 1);
+  if (endpos == -1) {
+    addLog(LOG_LEVEL_ERROR, concat(F("SunTime syntax error: "), format));
+    return format;
+  }
+  String R     = s.substring(startpos, endpos + 1);
+
+
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("ReplacementString SunTime: ");
+    log += R;
+    log += F(" offset: ");
+    log += ESPEasy_time::getSecOffset(R);
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  return R;
+}
+
+void replSunRiseTimeString(const String& format, String& s, boolean useURLencode) {
+  const String R(getReplacementString(format, s));
+
+  repl(R, node_time.getSunriseTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
+}
+
+void replSunSetTimeString(const String& format, String& s, boolean useURLencode) {
+  const String R(getReplacementString(format, s));
+
+  repl(R, node_time.getSunsetTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
+}
+
+String timeReplacement_leadZero(int value)
+{
+  char valueString[5] = { 0 };
+
+  sprintf_P(valueString, PSTR("%02d"), value);
+  return valueString;
+}
+
+String SystemVariables::getSystemVariable(SystemVariables::Enum enumval) {
+  constexpr int INT_NOT_SET = std::numeric_limits<int>::min();
+
+  int intvalue = INT_NOT_SET;
+
+  struct tm local_tm;
+  breakTime(node_time.getLocalUnixTime(), local_tm);
+
+  switch (enumval)
+  {
+    case CR:                return String('\r');
+    case ISVAR_DOUBLE:      intvalue =
+                            #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+                            1;
+                            #else
+                            0;
+                            #endif
+                            break;
+    case ISLIMITED_BUILD:   intvalue = 0; break;
+    case LF:                return String('\n');
+    case SPACE:             return String(' ');
+    case SYSDAY:            intvalue = local_tm.tm_mday; break;
+    case SYSDAY_0:          return timeReplacement_leadZero(local_tm.tm_mday);
+    case SYSHEAP:           intvalue = FreeMem(); break;
+    case SYSHOUR:           intvalue = local_tm.tm_hour; break;
+    case SYSHOUR_0:         return timeReplacement_leadZero(local_tm.tm_hour);
+    case SYSMIN:            intvalue = local_tm.tm_min; break;
+    case SYSMIN_0:          return timeReplacement_leadZero(local_tm.tm_min);
+    case SYSMONTH:          intvalue = local_tm.tm_mon + 1; break;
+    case SYSSEC:            intvalue = local_tm.tm_sec; break;
+    case SYSSEC_0:          return timeReplacement_leadZero(local_tm.tm_sec);
+    case SYSSEC_D:          intvalue = ((local_tm.tm_hour * 60) + local_tm.tm_min) * 60 + local_tm.tm_sec; break;
+    case SYSTIME:           return formatTimeString(local_tm, ':', false, true);
+    case SYSTM_HM:          return formatTimeString(local_tm, ':', false, false);
+    case SYS_MONTH_0:       return timeReplacement_leadZero(local_tm.tm_mon + 1);
+    case SYSWEEKDAY:        intvalue = node_time.weekday(); break;
+    case SYSYEAR_0:
+    case SYSYEAR:           intvalue = local_tm.tm_year + 1900; break;
+    case S_CR:              return F("\\r");
+    case S_LF:              return F("\\n");
+    case UNIXDAY:           intvalue = node_time.getUnixTime() / 86400; break;
+    case UNIXDAY_SEC:       intvalue = node_time.getUnixTime() % 86400; break;
+    case UNIXTIME:          return String(node_time.getUnixTime());
+    case UPTIME:            intvalue = getMicros64() / 60000000ull; break;
+    case UPTIME_MS:         return ull2String(getMicros64() / 1000);
+    case VCC:               intvalue = -1; break;
+
+    default:
+      return EMPTY_STRING;
+  }
+
+  if (intvalue != INT_NOT_SET) {
+    return String(intvalue);
+  }
+
+  return EMPTY_STRING;
+}
+
+/*
+#define SMART_REPL_T(T, S) \
+  while (s.indexOf(T) != -1) { (S((T), s, useURLencode)); }
+*/
+
+#define SMART_REPL_T(T, S) \
+  const String T_str(T); int __pos__ = s.indexOf(T_str); \
+  while (__pos__ != -1) { (S((T_str), s, useURLencode)); __pos__ = s.indexOf(T_str, __pos__ + 1);}
+
+// Parse %vN% to replace ESPEasy variables
+bool parse_pct_v_num_pct(String& s, boolean useURLencode, int start_pos)
+{
+  const String key_prefix = F("%v");
+  int v_index = s.indexOf(key_prefix, start_pos);
+
+  bool somethingReplaced = false;
+
+  while ((v_index != -1)) {
+    // Exclude "%valname% or %value%"
+    // FIXME TD-er: Must find a more elegant way to fix this
+    if (!isalpha(s.charAt(v_index + 2))) {
+      // Check for:
+      // - Calculations indicated with leading '='
+      // - nested indirections like %v%v1%%
+      if ((s.charAt(v_index + 2) == '=') ||
+          (s.charAt(v_index + 2) == '%' && s.charAt(v_index + 3) == 'v')) {
+        // FIXME TD-er: This may lead to stack overflow if we do an awful lot of nested user variables
+        if (parse_pct_v_num_pct(s, useURLencode, v_index + 2)) {
+          somethingReplaced = true;
+        }
+      }
+
+      uint32_t i{};
+      // variable index may contain a calculation
+      // Calculations are enforced by a leading '='
+      // like: %v=1+%v2%%
+      const int pos_closing_pct = s.indexOf('%', v_index + 1);
+      const String arg = s.substring(v_index + 2, pos_closing_pct);
+      i = CalculateParam(arg, -1);
+      //addLog(LOG_LEVEL_INFO, strformat(F("calc parse: %s => %u"), arg.c_str(), i));
+      if (i >= 0) {
+        // Need to replace the entire arg and not just the 'i'
+        const String key = strformat(F("%%v%s%%"), arg.c_str());
+
+        if (s.indexOf(key) != -1) {
+          const bool trimTrailingZeros = true;
+          const ESPEASY_RULES_FLOAT_TYPE floatvalue = getCustomFloatVar(i);
+          const unsigned char nr_decimals = maxNrDecimals_fpType(floatvalue);
+          #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+          const String value = doubleToString(floatvalue, nr_decimals, trimTrailingZeros);
+          #else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+          const String value = floatToString(floatvalue, nr_decimals, trimTrailingZeros);
+          #endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+          if (repl(key, value, s, useURLencode)) {
+            somethingReplaced = true;
+          }
+        }
+      }
+    }
+    v_index = s.indexOf(key_prefix, v_index + 1); // Find next occurance
+    //addLog(LOG_LEVEL_INFO, strformat(F("parse: %s"), s.c_str()));
+  }
+  return somethingReplaced;
+}
+
+void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
+{
+  START_TIMER
+
+  if (s.indexOf('%') == -1) {
+    STOP_TIMER(PARSE_SYSVAR_NOCHANGE);
+    return;
+  }
+
+  bool somethingReplaced = false;
+
+  // Parse ESPEasy user variables first as they might be combined 
+  // as arument or index for other variables
+  parse_pct_v_num_pct(s, useURLencode, 0);
+
+  do {
+    int last_percent_pos = -1;
+    somethingReplaced = false;
+    SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(0);
+    do {
+      enumval = SystemVariables::nextReplacementEnum(s, enumval, last_percent_pos);
+
+      switch (enumval)
+      {
+        case SUNRISE: {
+          SMART_REPL_T(SystemVariables::toString(enumval), replSunRiseTimeString);
+          somethingReplaced = true;
+          break;
+        }
+        case SUNSET: {
+          SMART_REPL_T(SystemVariables::toString(enumval), replSunSetTimeString);
+          somethingReplaced = true;
+          break;
+        }
+        case VARIABLE:
+        {
+          // Should not be present anymore, but just in case...
+          if (parse_pct_v_num_pct(s, useURLencode, 0))
+            somethingReplaced = true;
+    
+          break;
+        }
+        case UNKNOWN:
+
+          // Do not replace
+          break;
+        default:
+        {
+          const String sysvar_str(SystemVariables::toString(enumval));
+          if (s.indexOf(sysvar_str) != -1) {
+            if (repl(
+              sysvar_str, 
+              getSystemVariable(enumval), 
+              s, 
+              useURLencode))
+              somethingReplaced = true;
+          }
+          break;
+        }
+      }
+    }
+    while (enumval != SystemVariables::Enum::UNKNOWN);
+  }
+  while (somethingReplaced);
+
+  STOP_TIMER(PARSE_SYSVAR);
+}
+
+#undef SMART_REPL_T
+
+
+SystemVariables::Enum SystemVariables::nextReplacementEnum(const String& str, SystemVariables::Enum last_tested, int& last_percent_pos)
+{
+  SystemVariables::Enum nextTested;
+  int percent_pos = last_percent_pos;
+
+  do {
+    // Find first position in string which might be a good candidate to look for a system variable.
+    // Look for "%N" where 'N' is the first letter of a variable name we support.
+    percent_pos = str.indexOf('%', percent_pos + 1);
+
+    if (percent_pos == -1) {
+      return Enum::UNKNOWN;
+    }
+
+    nextTested = SystemVariables::startIndex_beginWith(str[percent_pos + 1]);
+  } while (Enum::UNKNOWN == nextTested);
+
+  if (last_percent_pos < percent_pos) {
+    last_percent_pos = percent_pos;
+    last_tested      = nextTested;
+  }
+
+  if (last_tested > nextTested) {
+    // Iterate over the possible system variables
+    nextTested = static_cast<SystemVariables::Enum>(last_tested + 1);
+    const char firstChar_nextTested = static_cast<char>(pgm_read_byte(SystemVariables::toFlashString(nextTested)));
+    const char firstChar_expected = str[percent_pos + 1];
+
+    if (firstChar_nextTested != firstChar_expected) {
+      nextTested = Enum::UNKNOWN;
+    }
+  }
+
+  if (nextTested >= Enum::UNKNOWN) {
+    // We have tested all possible system variables
+    // Skip unsupported ones or maybe it is just a single percentage symbol in a string.
+    percent_pos = str.indexOf('%', percent_pos + 1);
+
+    if (percent_pos == -1) {
+      return Enum::UNKNOWN;
+    }
+    last_percent_pos = percent_pos;
+    return SystemVariables::startIndex_beginWith(str[percent_pos + 1]);
+  }
+
+  const __FlashStringHelper *fstr_sysvar = SystemVariables::toFlashString(nextTested);
+  String str_prefix        = strformat(F("%%%c"), static_cast<char>(pgm_read_byte(fstr_sysvar)));
+  bool   str_prefix_exists = str.indexOf(str_prefix) != -1;
+
+  for (int i = nextTested; i < Enum::UNKNOWN; ++i) {
+    SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
+    fstr_sysvar = SystemVariables::toFlashString(enumval);
+    const String new_str_prefix = strformat(F("%%%c"), static_cast<char>(pgm_read_byte(fstr_sysvar)));
+
+    if ((str_prefix == new_str_prefix) && !str_prefix_exists) {
+      // Just continue
+    } else {
+      str_prefix        = new_str_prefix;
+      str_prefix_exists = str.indexOf(str_prefix) != -1;
+
+      if (str_prefix_exists) {
+        if (str.indexOf(SystemVariables::toString(enumval)) != -1) {
+          return enumval;
+        }
+      }
+    }
+  }
+
+  return Enum::UNKNOWN;
+}
+
+String SystemVariables::toString(Enum enumval)
+{
+  if ((enumval == Enum::SUNRISE) || (enumval == Enum::SUNSET) || enumval == Enum::VARIABLE) {
+    // These need variables, so only prepend a %, not wrap.
+    return String('%') + SystemVariables::toFlashString(enumval);
+  }
+
+  return wrap_String(SystemVariables::toFlashString(enumval), '%');
+}
+
+SystemVariables::Enum SystemVariables::startIndex_beginWith(char beginchar)
+{
+  switch (tolower(beginchar))
+  {
+    case 'b': return Enum::BOARD_NAME;
+    case 'c': return Enum::CLIENTIP;
+    case 'd': return Enum::DNS;
+#if FEATURE_ETHERNET
+    case 'e': return Enum::ETHCONNECTED;
+#endif // if FEATURE_ETHERNET
+    case 'f': return Enum::FLASH_CHIP_MODEL;
+    case 'g': return Enum::GATEWAY;
+#if FEATURE_INTERNAL_TEMPERATURE
+    case 'i': return Enum::INTERNAL_TEMPERATURE;
+#else // if FEATURE_INTERNAL_TEMPERATURE
+    case 'i': return Enum::IP4;
+#endif // if FEATURE_INTERNAL_TEMPERATURE
+    case 'l': return Enum::LCLTIME;
+    case 'm': return Enum::SUNRISE_M;
+    case 'n': return Enum::S_LF;
+    case 'r': return Enum::S_CR;
+    case 's': return Enum::SPACE;
+    case 'u': return Enum::UNIT_sysvar;
+    // case 'v': return Enum::VARIABLE; // Can not be the first 'v' variable, as the name is only 1 character long
+    case 'v': return Enum::VCC;
+    case 'w': return Enum::WI_CH;
+  }
+
+  return Enum::UNKNOWN;
+}
+
+const __FlashStringHelper * SystemVariables::toFlashString(SystemVariables::Enum enumval)
+{
+  switch (enumval) {
+    case Enum::BOARD_NAME:         return F("board_name");
+    case Enum::BOOT_CAUSE:         return F("bootcause");
+    case Enum::BSSID:              return F("bssid");
+    case Enum::CLIENTIP:           return F("clientip");
+    case Enum::CR:                 return F("CR");
+    case Enum::ESP_CHIP_CORES:     return F("cpu_cores");
+    case Enum::ESP_CHIP_FREQ:      return F("cpu_freq");
+    case Enum::ESP_CHIP_ID:        return F("cpu_id");
+    case Enum::ESP_CHIP_MODEL:     return F("cpu_model");
+    case Enum::ESP_CHIP_REVISION:  return F("cpu_rev");
+    case Enum::DNS:                return F("dns");
+    case Enum::DNS_1:              return F("dns1");
+    case Enum::DNS_2:              return F("dns2");
+#if FEATURE_ETHERNET
+    case Enum::ETHCONNECTED:       return F("ethconnected");
+    case Enum::ETHDUPLEX:          return F("ethduplex");
+    case Enum::ETHSPEED:           return F("ethspeed");
+    case Enum::ETHSPEEDSTATE:      return F("ethspeedstate");
+    case Enum::ETHSTATE:           return F("ethstate");
+    case Enum::ETHWIFIMODE:        return F("ethwifimode");
+#endif // if FEATURE_ETHERNET
+
+    case Enum::FLASH_CHIP_MODEL:   return F("flash_chip_model");
+    case Enum::FLASH_CHIP_VENDOR:  return F("flash_chip_vendor");
+    case Enum::FLASH_FREQ:         return F("flash_freq");
+    case Enum::FLASH_SIZE:         return F("flash_size");
+    case Enum::FS_FREE:            return F("fs_free");
+    case Enum::FS_SIZE:            return F("fs_size");
+    case Enum::GATEWAY:            return F("gateway");
+#if FEATURE_INTERNAL_TEMPERATURE
+    case Enum::INTERNAL_TEMPERATURE: return F("inttemp");
+#endif // if FEATURE_INTERNAL_TEMPERATURE
+
+    case Enum::IP4:                return F("ip4");
+    case Enum::IP:                 return F("ip");
+#if FEATURE_USE_IPV6
+    case Enum::IP6_LOCAL:          return F("ipv6local");
+#endif
+    case Enum::ISVAR_DOUBLE:       return F("isvar_double");
+    case Enum::ISLIMITED_BUILD:    return F("islimited_build");
+    case Enum::ISMQTT:             return F("ismqtt");
+    case Enum::ISMQTTIMP:          return F("ismqttimp");
+    case Enum::ISNTP:              return F("isntp");
+    case Enum::ISWIFI:             return F("iswifi");
+    case Enum::LCLTIME:            return F("lcltime");
+    case Enum::LCLTIME_AM:         return F("lcltime_am");
+    case Enum::LF:                 return F("LF");
+    case Enum::SUNRISE_M:          return F("m_sunrise");
+    case Enum::SUNSET_M:           return F("m_sunset");
+    case Enum::MAC:                return F("mac");
+    case Enum::MAC_INT:            return F("mac_int");
+    case Enum::S_LF:               return F("N");
+    case Enum::S_CR:               return F("R");
+    case Enum::RSSI:               return F("rssi");
+    case Enum::SPACE:              return F("SP");
+    case Enum::SSID:               return F("ssid");
+    case Enum::SUBNET:             return F("subnet");
+    case Enum::SUNRISE:            return F("sunrise");
+    case Enum::SUNRISE_S:          return F("s_sunrise");
+    case Enum::SUNSET:             return F("sunset");
+    case Enum::SUNSET_S:           return F("s_sunset");
+    case Enum::SYSBUILD_DATE:      return F("sysbuild_date");
+    case Enum::SYSBUILD_DESCR:     return F("sysbuild_desc");
+    case Enum::SYSBUILD_FILENAME:  return F("sysbuild_filename");
+    case Enum::SYSBUILD_GIT:       return F("sysbuild_git");
+    case Enum::SYSBUILD_TIME:      return F("sysbuild_time");
+    case Enum::SYSDAY:             return F("sysday");
+    case Enum::SYSDAY_0:           return F("sysday_0");
+    case Enum::SYSHEAP:            return F("sysheap");
+    case Enum::SYSHOUR:            return F("syshour");
+    case Enum::SYSHOUR_0:          return F("syshour_0");
+    case Enum::SYSLOAD:            return F("sysload");
+    case Enum::SYSMIN:             return F("sysmin");
+    case Enum::SYSMIN_0:           return F("sysmin_0");
+    case Enum::SYSMONTH:           return F("sysmonth");
+    case Enum::SYSMONTH_S:         return F("sysmonth_s");
+    case Enum::SYSNAME:            return F("sysname");
+    case Enum::SYSSEC:             return F("syssec");
+    case Enum::SYSSEC_0:           return F("syssec_0");
+    case Enum::SYSSEC_D:           return F("syssec_d");
+    case Enum::SYSSTACK:           return F("sysstack");
+    case Enum::SYSTIME:            return F("systime");
+    case Enum::SYSTIME_AM:         return F("systime_am");
+    case Enum::SYSTIME_AM_0:       return F("systime_am_0");
+    case Enum::SYSTIME_AM_SP:      return F("systime_am_sp");
+    case Enum::SYSTM_HM:           return F("systm_hm");
+    case Enum::SYSTM_HM_0:         return F("systm_hm_0");
+    case Enum::SYSTM_HM_AM:        return F("systm_hm_am");
+    case Enum::SYSTM_HM_AM_0:      return F("systm_hm_am_0");
+    case Enum::SYSTM_HM_AM_SP:     return F("systm_hm_am_sp");
+    case Enum::SYSTM_HM_SP:        return F("systm_hm_sp");
+    case Enum::SYSTZOFFSET:        return F("systzoffset");
+    case Enum::SYSWEEKDAY:         return F("sysweekday");
+    case Enum::SYSWEEKDAY_S:       return F("sysweekday_s");
+    case Enum::SYSYEAR:            return F("sysyear");
+    case Enum::SYSYEARS:           return F("sysyears");
+    case Enum::SYSYEAR_0:          return F("sysyear_0");
+    case Enum::SYS_MONTH_0:        return F("sysmonth_0");
+    case Enum::UNIT_sysvar:        return F("unit");
+#if FEATURE_ZEROFILLED_UNITNUMBER
+    case Enum::UNIT_0_sysvar:      return F("unit_0");
+#endif // FEATURE_ZEROFILLED_UNITNUMBER
+    case Enum::UNIXDAY:            return F("unixday");
+    case Enum::UNIXDAY_SEC:        return F("unixday_sec");
+    case Enum::UNIXTIME:           return F("unixtime");
+    case Enum::UPTIME:             return F("uptime");
+    case Enum::UPTIME_MS:          return F("uptime_ms");
+    case Enum::VCC:                return F("vcc");
+    case Enum::VARIABLE:           return F("v"); // Can not be the first 'v' variable, as the name is only 1 character long
+    case Enum::WI_CH:              return F("wi_ch");
+
+    case Enum::UNKNOWN: break;
+  }
+  return F("Unknown");
+}
@@ -0,0 +1,17 @@
+#ifndef NATIVE_SHIM_HELPERS__CPLUGIN_HELPER_H
+#define NATIVE_SHIM_HELPERS__CPLUGIN_HELPER_H
+
+#include <native_shims.h>
+
+#include "../../_Plugin_Helper.h"
+
+#include "../DataStructs/ControllerSettingsStruct.h"
+#include "../Globals/CPlugins.h"
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Helpers/_CPlugin_init.h"
+#include "../Helpers/Misc.h"
+#include "../Helpers/Networking.h"
+#include "../Helpers/Numerical.h"
+#include "../Helpers/StringConverter.h"
+
+#endif // ifndef NATIVE_SHIM_HELPERS__CPLUGIN_HELPER_H
@@ -0,0 +1,12 @@
+#ifndef NATIVE_SHIM_HELPERS__CPLUGIN_INIT_H
+#define NATIVE_SHIM_HELPERS__CPLUGIN_INIT_H
+
+#include <native_shims.h>
+
+#include "../DataStructs/ProtocolStruct.h"
+#include "../DataTypes/ProtocolIndex.h"
+
+// Host only, all protocols are described by the same ProtocolStruct
+ProtocolStruct& getProtocolStruct(protocolIndex_t protocolIndex);
+
+#endif // ifndef NATIVE_SHIM_HELPERS__CPLUGIN_INIT_H
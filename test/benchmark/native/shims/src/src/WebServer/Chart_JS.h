@@ -0,0 +1,6 @@
+#ifndef NATIVE_SHIM_WEBSERVER_CHART_JS_H
+#define NATIVE_SHIM_WEBSERVER_CHART_JS_H
+
+#include <native_shims.h>
+
+#endif // ifndef NATIVE_SHIM_WEBSERVER_CHART_JS_H
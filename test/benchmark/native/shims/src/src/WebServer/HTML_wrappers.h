@@ -0,0 +1,22 @@
+#ifndef NATIVE_SHIM_WEBSERVER_HTML_WRAPPERS_H
+#define NATIVE_SHIM_WEBSERVER_HTML_WRAPPERS_H
+
+#include <native_shims.h>
+
+// There is no web server on the host, the generated HTML is discarded.
+
+void addHtml(const char& char1);
+void addHtml(const char& char1, const char& char2);
+void addHtml(const __FlashStringHelper * html);
+void addHtml(const String& html);
+void addHtml(String&& html);
+void addHtmlInt(int32_t int_val);
+void addHtmlInt(uint32_t int_val);
+void addHtmlInt(int64_t int_val);
+void addHtmlInt(uint64_t int_val);
+void addHtmlFloat(const float& value, unsigned int nrDecimals = 2u);
+#if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+void addHtmlFloat(const double& value, unsigned int nrDecimals = 2u);
+#endif
+
+#endif // ifndef NATIVE_SHIM_WEBSERVER_HTML_WRAPPERS_H
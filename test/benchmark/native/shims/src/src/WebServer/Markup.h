@@ -0,0 +1,14 @@
+#ifndef NATIVE_SHIM_WEBSERVER_MARKUP_H
+#define NATIVE_SHIM_WEBSERVER_MARKUP_H
+
+#include <native_shims.h>
+
+void addUnit(const __FlashStringHelper *unit);
+void addUnit(const String& unit);
+void addUnit(char unit);
+
+void addRowLabel(const __FlashStringHelper *label);
+void addRowLabel(const String& label,
+                 const String& id = EMPTY_STRING);
+
+#endif // ifndef NATIVE_SHIM_WEBSERVER_MARKUP_H
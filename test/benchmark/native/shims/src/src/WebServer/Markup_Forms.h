@@ -0,0 +1,8 @@
+#ifndef NATIVE_SHIM_WEBSERVER_MARKUP_FORMS_H
+#define NATIVE_SHIM_WEBSERVER_MARKUP_FORMS_H
+
+#include <native_shims.h>
+
+void addFormSeparator(int clspan);
+
+#endif // ifndef NATIVE_SHIM_WEBSERVER_MARKUP_FORMS_H
@@ -0,0 +1,183 @@
+# Build a few core parts of ESPEasy for the host, together with a benchmark runner.
+#
+# The firmware sources listed below are copied into a separate tree in the build directory,
+# next to the host replacements of the headers they depend on (test/benchmark/native/shims).
+# Since the firmware sources include their dependencies using relative paths,
+# a header in the shims tree takes the place of the firmware header with the same path.
+#
+# Usage: pio run -e native_benchmark -t exec
+
+import os
+import shutil
+import sys
+
+# Firmware sources, relative to src/
+# The Settings, Cache, task and controller globals and the in-memory file system (LittleFS)
+# they use are defined in shims/native_globals.cpp.
+# Firmware sources which are not built, or only partly copied into the shims tree:
+# - StringConverter.cpp: the IP address helpers need IPAddress, the rest is copied.
+# - SystemVariables.cpp: getSystemVariable() reports the network, WiFi, build and hardware state.
+#   Only the time, uptime, heap and character variables are implemented, the parsing is copied.
+# - Caches.cpp: loads the task settings from the settings files, which are kept in memory instead.
+# - ESPEasy_Storage.cpp: settings files, SD card and RTC memory. The file helpers are copied.
+# - ESPEasy_time.cpp: the NTP, GPS and RTC time sources. Sunrise and sunset need a location.
+# - ControllerSettingsStruct.cpp: needs IPAddress, WiFiClient and DNS.
+# - _Plugin_Helper.cpp, Plugins.cpp and CPlugins.cpp: call into all plugins and controllers.
+#   The host has plain devices, which only report their value count and type.
+# - ExecuteCommand.cpp: dispatches to all plugins and internal commands.
+#   The executed command lines are recorded, only "Let" is executed.
+FIRMWARE_SOURCES = [
+    "src/ControllerQueue/ControllerDelayHandlerStruct.h",
+    "src/ControllerQueue/ControllerDelayHandlerStruct.cpp",
+    "src/ControllerQueue/ControllerDelayQueue.h",
+    "src/ControllerQueue/ControllerDelayQueue.cpp",
+    "src/ControllerQueue/Queue_element_base.h",
+    "src/ControllerQueue/Queue_element_base.cpp",
+    "src/DataStructs/C013_p2p_SensorDataBatch.h",
+    "src/DataStructs/C013_p2p_SensorDataBatch.cpp",
+    "src/DataStructs/ChartJS_dataset_config.h",
+    "src/DataStructs/ControllerCacheCodec.h",
+    "src/DataStructs/ControllerCacheCodec.cpp",
+    "src/DataStructs/ControllerCacheIndex.h",
+    "src/DataStructs/ControllerCacheIndex.cpp",
+    "src/DataStructs/DeviceStruct.h",
+    "src/DataStructs/DeviceStruct.cpp",
+    "src/DataStructs/ESPEasy_EventStruct.h",
+    "src/DataStructs/ESPEasy_EventStruct.cpp",
+    "src/DataStructs/EventQueue.h",
+    "src/DataStructs/EventQueue.cpp",
+    "src/DataStructs/LogEntry.h",
+    "src/DataStructs/LogEntry.cpp",
+    "src/DataStructs/LogStruct.h",
+    "src/DataStructs/LogStruct.cpp",
+    "src/DataStructs/PluginStats.h",
+    "src/DataStructs/PluginStats.cpp",
+    "src/DataStructs/PluginStats_Config.h",
+    "src/DataStructs/PluginStats_Config.cpp",
+    "src/DataStructs/PluginStats_samples.h",
+    "src/DataStructs/PluginStats_samples.cpp",
+    "src/DataStructs/PluginStats_size.h",
+    "src/DataStructs/PluginStats_timestamp.h",
+    "src/DataStructs/PluginStats_timestamp.cpp",
+    "src/DataStructs/ProtocolStruct.h",
+    "src/DataStructs/ProtocolStruct.cpp",
+    "src/DataStructs/RulesEventCache.h",
+    "src/DataStructs/RulesEventCache.cpp",
+    "src/DataStructs/RulesProgram.h",
+    "src/DataStructs/RulesProgram.cpp",
+    "src/DataStructs/SyslogQueue.h",
+    "src/DataStructs/SyslogQueue.cpp",
+    "src/DataStructs/TimingStats.h",
+    "src/DataStructs/UnitMessageCount.h",
+    "src/DataStructs/UnitMessageCount.cpp",
+    "src/DataStructs/UserVarStruct.h",
+    "src/DataStructs/UserVarStruct.cpp",
+    "src/DataTypes/CPluginID.h",
+    "src/DataTypes/CPluginID.cpp",
+    "src/DataTypes/ControllerIndex.h",
+    "src/DataTypes/ControllerIndex.cpp",
+    "src/DataTypes/DeviceIndex.h",
+    "src/DataTypes/DeviceIndex.cpp",
+    "src/DataTypes/ESPEasyFileType.h",
+    "src/DataTypes/ESPEasy_plugin_functions.h",
+    "src/DataTypes/EventQueueOverflowPolicy.h",
+    "src/DataTypes/EventQueueOverflowPolicy.cpp",
+    "src/DataTypes/EventValueSource.h",
+    "src/DataTypes/NotifierIndex.h",
+    "src/DataTypes/PluginID.h",
+    "src/DataTypes/PluginID.cpp",
+    "src/DataTypes/ProtocolIndex.h",
+    "src/DataTypes/ProtocolIndex.cpp",
+    "src/DataTypes/SchedulerIntervalTimer.h",
+    "src/DataTypes/SensorVType.h",
+    "src/DataTypes/SensorVType.cpp",
+    "src/DataTypes/TaskIndex.h",
+    "src/DataTypes/TaskIndex.cpp",
+    "src/DataTypes/TaskValues_Data.h",
+    "src/DataTypes/TaskValues_Data.cpp",
+    "src/ESPEasyCore/ESPEasyRules.h",
+    "src/ESPEasyCore/ESPEasyRules.cpp",
+    "src/Globals/Device.h",
+    "src/Globals/Device.cpp",
+    "src/Globals/EventQueue.h",
+    "src/Globals/EventQueue.cpp",
+    "src/Globals/Plugins_other.h",
+    "src/Globals/Plugins_other.cpp",
+    "src/Globals/RulesCalculate.h",
+    "src/Globals/RulesCalculate.cpp",
+    "src/Globals/RuntimeData.h",
+    "src/Globals/RuntimeData.cpp",
+    "src/Helpers/CRC_functions.h",
+    "src/Helpers/CRC_functions.cpp",
+    "src/Helpers/Convert.h",
+    "src/Helpers/Convert.cpp",
+    "src/Helpers/ESPEasy_math.h",
+    "src/Helpers/ESPEasy_math.cpp",
+    "src/Helpers/ESPEasy_time_calc.cpp",
+    "src/Helpers/Numerical.h",
+    "src/Helpers/Numerical.cpp",
+    "src/Helpers/Rules_calculate.h",
+    "src/Helpers/Rules_calculate.cpp",
+    "src/Helpers/RulesHelper.h",
+    "src/Helpers/RulesHelper.cpp",
+    "src/Helpers/RulesMatcher.h",
+    "src/Helpers/RulesMatcher.cpp",
+    "src/Helpers/StringConverter_Numerical.h",
+    "src/Helpers/StringConverter_Numerical.cpp",
+    "src/Helpers/StringGenerator_GPIO.h",
+    "src/Helpers/StringParser.h",
+    "src/Helpers/StringParser.cpp",
+    "src/Helpers/SystemVariables.h",
+    "src/Helpers/TemplateProgram.h",
+    "src/Helpers/TemplateProgram.cpp",
+    "src/Helpers/msecTimerHandlerStruct.h",
+    "src/Helpers/msecTimerHandlerStruct.cpp",
+]
+
+# Header-only libraries, relative to lib/
+LIBRARY_HEADERS = [
+    "CircularBuffer/CircularBuffer.h",
+    "CircularBuffer/CircularBuffer.tpp",
+]
+
+
+def prepare_native_tree(project_dir, target_dir):
+    benchmark_dir = os.path.join(project_dir, "test", "benchmark", "native")
+
+    if os.path.exists(target_dir):
+        shutil.rmtree(target_dir)
+
+    shutil.copytree(os.path.join(benchmark_dir, "shims"), target_dir)
+
+    for source in FIRMWARE_SOURCES:
+        dest = os.path.join(target_dir, "src", source)
+        os.makedirs(os.path.dirname(dest), exist_ok=True)
+        shutil.copy2(os.path.join(project_dir, "src", source), dest)
+
+    for header in LIBRARY_HEADERS:
+        shutil.copy2(os.path.join(project_dir, "lib", header), target_dir)
+
+    for file in os.listdir(benchmark_dir):
+        if file.endswith(".cpp"):
+            shutil.copy2(os.path.join(benchmark_dir, file), target_dir)
+
+
+if __name__ == "__main__":
+    # Prepare the tree only, e.g. to build it without PlatformIO:
+    # python tools/pio/native_benchmark.py <target dir>
+    prepare_native_tree(os.getcwd(), sys.argv[1])
+else:
+    Import("env")
+
+    project_dir = env.subst("$PROJECT_DIR")
+    target_dir = os.path.join(env.subst("$BUILD_DIR"), "native_benchmark_src")
+
+    print("\u001b[32m Prepare native benchmark sources in {} \u001b[0m".format(target_dir))
+    prepare_native_tree(project_dir, target_dir)
+
+    env.Append(
+        CPPPATH=[target_dir],
+        CPPDEFINES=[
+            ("NATIVE_BENCHMARK_DATA_DIR", env.StringifyMacro(os.path.join(project_dir, "test", "benchmark")))
+        ])
+    env.BuildSources(os.path.join("$BUILD_DIR", "native_benchmark"), target_dir)